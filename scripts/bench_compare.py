@@ -0,0 +1,73 @@
+# Copyright (c) 2026 Microsoft Corporation
+"""
+Compare two runs of the bench_kernels unit test and fail on regressions.
+
+Usage:
+    test-z3 bench_kernels > baseline.json
+    ... apply changes, rebuild ...
+    test-z3 bench_kernels > current.json
+    python scripts/bench_compare.py baseline.json current.json [--threshold 10]
+
+Lines that are not JSON benchmark records (e.g. the PASS markers printed
+by the test driver) are ignored, so the raw test output can be used
+directly. Exits with status 1 if any benchmark slowed down by more than
+the threshold percentage.
+"""
+
+import argparse
+import json
+import sys
+
+
+def read_results(path):
+    results = {}
+    with open(path) as f:
+        for line in f:
+            line = line.strip()
+            if not line.startswith("{"):
+                continue
+            try:
+                record = json.loads(line)
+            except ValueError:
+                continue
+            if "benchmark" in record and "time_ms" in record:
+                results[record["benchmark"]] = record
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="maximal tolerated slowdown in percent (default 10)")
+    args = parser.parse_args()
+
+    baseline = read_results(args.baseline)
+    current = read_results(args.current)
+    if not baseline or not current:
+        sys.exit("no benchmark records found")
+
+    regressed = []
+    print("%-28s %12s %12s %8s" % ("benchmark", "base ms", "curr ms", "delta"))
+    for name in sorted(baseline):
+        if name not in current:
+            print("%-28s %12.3f %12s" % (name, baseline[name]["time_ms"], "missing"))
+            regressed.append(name)
+            continue
+        base = baseline[name]["time_ms"]
+        curr = current[name]["time_ms"]
+        delta = 100.0 * (curr - base) / base if base > 0 else 0.0
+        print("%-28s %12.3f %12.3f %+7.1f%%" % (name, base, curr, delta))
+        if delta > args.threshold:
+            regressed.append(name)
+    for name in sorted(set(current) - set(baseline)):
+        print("%-28s %12s %12.3f" % (name, "new", current[name]["time_ms"]))
+
+    if regressed:
+        print("regressions above %.1f%%: %s" % (args.threshold, ", ".join(regressed)))
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
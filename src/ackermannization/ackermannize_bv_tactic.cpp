@@ -40,7 +40,13 @@ public:
         ptr_vector<expr> flas;
         const unsigned sz = g->size();
         for (unsigned i = 0; i < sz; i++) flas.push_back(g->form(i));
+        if (!m_cache)
+            m_cache = alloc(ackr_cache, m);
         lackr lackr(m, m_p, m_st, flas, nullptr);
+        // Amortize ackermannization over structurally-overlapping goals:
+        // abstraction constants and simplified congruence constraints are
+        // shared across the applications of this tactic object.
+        lackr.set_cache(m_cache.get());
 
         // mk result
         goal_ref resg(alloc(goal, *g, true));
@@ -86,6 +92,7 @@ private:
     ast_manager&                         m;
     params_ref                           m_p;
     lackr_stats                          m_st;
+    scoped_ptr<ackr_cache>               m_cache;
     double                               m_lemma_limit;
 };
 
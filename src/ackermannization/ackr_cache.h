@@ -0,0 +1,82 @@
+ /*++
+ Copyright (c) 2016 Microsoft Corporation
+
+ Module Name:
+
+  ackr_cache.h
+
+ Abstract:
+
+  Cache shared by successive ackermannizations of structurally overlapping
+  queries. It persists the association between a function application and
+  the constant introduced for it, so that the same term is abstracted by
+  the same constant in every query, and it memoizes the simplified form of
+  the abstracted congruence constraints. With stable constants the
+  constraint built for a pair of applications is syntactically identical
+  across queries, so queries after the first pay for simplification only
+  on pairs they are the first to see.
+
+  The cache assumes that the introduced constants do not occur in the
+  input formulas, which holds as long as the output of the tactic is not
+  fed back as its input.
+
+ Author:
+
+ Mikolas Janota
+
+ Revision History:
+ --*/
+#pragma once
+
+#include "util/obj_hashtable.h"
+#include "ast/ast.h"
+
+class ackr_cache {
+public:
+    ackr_cache(ast_manager& m) : m(m) {}
+
+    ~ackr_cache() {
+        for (auto & kv : m_t2c) {
+            m.dec_ref(kv.m_key);
+            m.dec_ref(kv.m_value);
+        }
+        for (auto & kv : m_simplified) {
+            m.dec_ref(kv.m_key);
+            m.dec_ref(kv.m_value);
+        }
+    }
+
+    /** \brief Return the constant introduced for term by an earlier query, or nullptr. **/
+    app * find_abstr(app * term) const {
+        app * c = nullptr;
+        m_t2c.find(term, c);
+        return c;
+    }
+
+    void set_abstr(app * term, app * c) {
+        SASSERT(!m_t2c.contains(term));
+        m_t2c.insert(term, c);
+        m.inc_ref(term);
+        m.inc_ref(c);
+    }
+
+    /** \brief Retrieve the simplified form of an abstracted congruence constraint. **/
+    bool find_lemma(expr * cga, expr *& simplified) const {
+        return m_simplified.find(cga, simplified);
+    }
+
+    void set_lemma(expr * cga, expr * simplified) {
+        SASSERT(!m_simplified.contains(cga));
+        m_simplified.insert(cga, simplified);
+        m.inc_ref(cga);
+        m.inc_ref(simplified);
+    }
+
+private:
+    typedef obj_map<app, app*>   t2ct;
+    typedef obj_map<expr, expr*> lemma_map;
+    ast_manager& m;
+
+    t2ct      m_t2c;        // terms to their ackermann constants
+    lemma_map m_simplified; // abstracted congruence constraints to their simplified form
+};
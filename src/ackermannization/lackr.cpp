@@ -31,6 +31,7 @@ lackr::lackr(ast_manager& m, const params_ref& p, lackr_stats& st,
       m_formulas(formulas),
       m_autil(m),
       m_abstr(m),
+      m_cache(nullptr),
       m_solver(uffree_solver),
       m_ackr_helper(m),
       m_simp(m),
@@ -122,7 +123,20 @@ bool lackr::ackr(app * const t1, app * const t2) {
     expr_ref rhs(m.mk_eq(a1, a2),m);
     expr_ref cg(m.mk_implies(lhs, rhs), m);
     expr_ref cga = m_info->abstract(cg); // constraint needs abstraction due to nested applications
-    m_simp(cga);
+    // The cache reuses the abstraction constants, so overlapping queries produce
+    // syntactically identical abstracted constraints and the simplified form
+    // carries over. Keying on the abstracted constraint keeps this sound when a
+    // nested application is abstracted in one query but pruned in another.
+    expr * cached = nullptr;
+    if (m_cache && m_cache->find_lemma(cga, cached)) {
+        cga = cached;
+    }
+    else {
+        expr_ref key(cga);
+        m_simp(cga);
+        if (m_cache)
+            m_cache->set_lemma(key, cga);
+    }
     TRACE("ackermannize", 
           tout << "abstr1 " << mk_ismt2_pp(a1, m, 2) << "\n";
           tout << "abstr2 " << mk_ismt2_pp(a2, m, 2) << "\n";
@@ -171,18 +185,30 @@ void lackr::ackr(app_set const* ts) {
     }
 }
 
+//
+// Constant used to abstract t. With a cache, the constant introduced by an
+// earlier query for the same term is reused.
+//
+app* lackr::mk_abstr_const(func_decl* fd, app* t) {
+    app * fc = m_cache ? m_cache->find_abstr(t) : nullptr;
+    if (!fc) {
+        fc = m.mk_fresh_const(fd->get_name(), t->get_sort());
+        if (m_cache)
+            m_cache->set_abstr(t, fc);
+    }
+    return fc;
+}
+
 void lackr::abstract_fun(fun2terms_map const& apps) {
     for (auto const& kv : apps) {
         func_decl* fd = kv.m_key;
         for (app * t : kv.m_value->var_args) {
-            app * fc = m.mk_fresh_const(fd->get_name(), t->get_sort());
             SASSERT(t->get_decl() == fd);
-            m_info->set_abstr(t, fc);
+            m_info->set_abstr(t, mk_abstr_const(fd, t));
         }
         for (app * t : kv.m_value->const_args) {
-            app * fc = m.mk_fresh_const(fd->get_name(), t->get_sort());
             SASSERT(t->get_decl() == fd);
-            m_info->set_abstr(t, fc);
+            m_info->set_abstr(t, mk_abstr_const(fd, t));
         }
     }
 
@@ -192,12 +218,10 @@ void lackr::abstract_sel(sel2terms_map const& apps) {
     for (auto const& kv : apps) {
         func_decl * fd = kv.m_key->get_decl();
         for (app * t : kv.m_value->const_args) {
-            app * fc = m.mk_fresh_const(fd->get_name(), t->get_sort());
-            m_info->set_abstr(t, fc);
+            m_info->set_abstr(t, mk_abstr_const(fd, t));
         }
         for (app * t : kv.m_value->var_args) {
-            app * fc = m.mk_fresh_const(fd->get_name(), t->get_sort());
-            m_info->set_abstr(t, fc);
+            m_info->set_abstr(t, mk_abstr_const(fd, t));
         }
     }
 }
@@ -26,6 +26,7 @@
 #include "tactic/goal.h"
 #include "ackermannization/ackr_info.h"
 #include "ackermannization/ackr_helper.h"
+#include "ackermannization/ackr_cache.h"
 
 struct lackr_stats {
     lackr_stats() : m_it(0), m_ackrs_sz(0) {}
@@ -60,6 +61,12 @@ class lackr {
         **/
         bool mk_ackermann(/*out*/goal_ref& g, double lemmas_upper_bound);
 
+        /** \brief
+          Share abstraction constants and simplified congruence constraints
+          with ackermannizations of other queries (see ackr_cache).
+        **/
+        void set_cache(ackr_cache* cache) { m_cache = cache; }
+
         //
         // getters
         //
@@ -86,6 +93,7 @@ class lackr {
         fun2terms_map                        m_fun2terms;
         sel2terms_map                        m_sel2terms;
         ackr_info_ref                        m_info;
+        ackr_cache*                          m_cache;
         solver*                              m_solver;
         ackr_helper                          m_ackr_helper;
         th_rewriter                          m_simp;
@@ -115,6 +123,8 @@ class lackr {
 
         void abstract();
 
+        app* mk_abstr_const(func_decl* fd, app* t);
+
         void push_abstraction();
 
         void add_term(app* a);
@@ -24,6 +24,7 @@ Revision History:
 #include "ast/datatype_decl_plugin.h"
 #include "ast/array_decl_plugin.h"
 #include "ast/pb_decl_plugin.h"
+#include "ast/ast_binary.h"
 #include "ast/ast_translation.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -1045,6 +1046,24 @@ extern "C" {
         Z3_CATCH_RETURN("");
     }
 
+    Z3_string Z3_API Z3_serialize_ast(Z3_context c, Z3_ast a) {
+        Z3_TRY;
+        LOG_Z3_serialize_ast(c, a);
+        RESET_ERROR_CODE();
+        return mk_c(c)->mk_external_string(serialize_ast(mk_c(c)->m(), to_ast(a)));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
+    Z3_ast Z3_API Z3_deserialize_ast(Z3_context c, Z3_string data) {
+        Z3_TRY;
+        LOG_Z3_deserialize_ast(c, data);
+        RESET_ERROR_CODE();
+        ast_ref a = deserialize_ast(mk_c(c)->m(), data, static_cast<unsigned>(strlen(data)));
+        mk_c(c)->save_ast_trail(a.get());
+        RETURN_Z3(of_ast(a.get()));
+        Z3_CATCH_RETURN(nullptr);
+    }
+
     Z3_decl_kind Z3_API Z3_get_decl_kind(Z3_context c, Z3_func_decl d) {
         Z3_TRY;
         LOG_Z3_get_decl_kind(c, d);
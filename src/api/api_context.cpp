@@ -67,15 +67,41 @@ namespace api {
         }
     }
 
+    void context::inc_ref(ast* a) {
+        // cancel the increment against a pending decrement on the same ast.
+        if (m_num_pending_decs > 0) {
+            auto* e = m_pending_decs.find_core(a);
+            if (e) {
+                if (--e->get_data().m_value == 0)
+                    m_pending_decs.remove(a);
+                --m_num_pending_decs;
+                return;
+            }
+        }
+        m().inc_ref(a);
+    }
+
+    static const unsigned g_max_pending_decs = 1024;
+
     void context::dec_ref(ast* a) {
 #ifndef SINGLE_THREAD
         if (m_concurrent_dec_ref) {
             lock_guard lock(m_mux);
             m_asts_to_flush.push_back(a);
+            return;
         }
-        else
 #endif
-            m().dec_ref(a);
+        m_pending_decs.insert_if_not_there(a, 0)++;
+        if (++m_num_pending_decs >= g_max_pending_decs)
+            flush_pending_decs();
+    }
+
+    void context::flush_pending_decs() {
+        for (auto& kv : m_pending_decs)
+            for (unsigned i = kv.m_value; i-- > 0; )
+                m().dec_ref(kv.m_key);
+        m_pending_decs.reset();
+        m_num_pending_decs = 0;
     }
 
     void context::flush_objects() {
@@ -154,6 +180,7 @@ namespace api {
         if (m_parser)
             smt2::free_parser(m_parser);
         m_last_obj = nullptr;
+        flush_pending_decs();
         flush_objects();
         for (auto& kv : m_allocated_objects) {
             api::object* val = kv.m_value;
@@ -422,14 +449,14 @@ extern "C" {
         LOG_Z3_inc_ref(c, a);
         RESET_ERROR_CODE();
         mk_c(c)->flush_objects();
-        mk_c(c)->m().inc_ref(to_ast(a));
+        mk_c(c)->inc_ref(to_ast(a));
         Z3_CATCH;
     }
 
     void Z3_API Z3_dec_ref(Z3_context c, Z3_ast a) {
         Z3_TRY;
         LOG_Z3_dec_ref(c, a);
-        if (a && to_ast(a)->get_ref_count() == 0) {
+        if (a && to_ast(a)->get_ref_count() <= mk_c(c)->pending_decs(to_ast(a))) {
             // the error is unchecked (but should not happen) in GC'ed wrappers
             RESET_ERROR_CODE();
             SET_ERROR_CODE(Z3_DEC_REF_ERROR, nullptr);
@@ -441,6 +468,23 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_dec_ref_array(Z3_context c, unsigned n, Z3_ast const asts[]) {
+        Z3_TRY;
+        LOG_Z3_dec_ref_array(c, n, asts);
+        for (unsigned i = 0; i < n; ++i) {
+            Z3_ast a = asts[i];
+            if (a && to_ast(a)->get_ref_count() <= mk_c(c)->pending_decs(to_ast(a))) {
+                RESET_ERROR_CODE();
+                SET_ERROR_CODE(Z3_DEC_REF_ERROR, nullptr);
+                return;
+            }
+            if (a) {
+                mk_c(c)->dec_ref(to_ast(a));
+            }
+        }
+        Z3_CATCH;
+    }
+
 
     void Z3_API Z3_get_version(unsigned * major, 
                                unsigned * minor, 
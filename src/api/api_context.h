@@ -104,6 +104,14 @@ namespace api {
         ptr_vector<api::object>    m_objects_to_flush, m_objects_to_flush2;
 #endif
 
+        // Deferred decrements from Z3_dec_ref. A queued decrement cancels
+        // against a later Z3_inc_ref on the same ast before the ast_manager
+        // is touched, and the remainder is flushed in batches. Deferring a
+        // decrement only delays garbage collection: the counts seen by the
+        // ast_manager over-approximate the counts held by the user.
+        obj_map<ast, unsigned>     m_pending_decs;
+        unsigned                   m_num_pending_decs = 0;
+
         ast_ref_vector             m_ast_trail;        
         ref<api::object>           m_last_obj; //!< reference to the last API object returned by the APIs
         u_map<api::object*>        m_allocated_objects; // !< table containing current set of allocated API objects
@@ -186,12 +194,16 @@ namespace api {
 #ifdef SINGLE_THREAD
             set_error_code(Z3_EXCEPTION, "Can't use concurrent features with a single-thread build");
 #else
+            flush_pending_decs();
             m_concurrent_dec_ref = true;
 #endif
         }
         unsigned add_object(api::object* o);
         void del_object(api::object* o);
+        void inc_ref(ast* a);
         void dec_ref(ast* a);
+        unsigned pending_decs(ast* a) const { unsigned n = 0; m_pending_decs.find(a, n); return n; }
+        void flush_pending_decs();
         void flush_objects();
 
         Z3_ast_print_mode get_print_mode() const { return m_print_mode; }
@@ -38,6 +38,10 @@ extern "C" {
 
     struct Z3_parser_context_ref : public api::object {
         scoped_ptr<cmd_context> ctx;
+        // Persistent parser session: keeps scanner buffers, cached symbols and
+        // the sort/term stacks warm across parse calls on this parser context.
+        // Same motivation as api::context::m_parser for Z3_eval_smtlib2_string.
+        smt2::parser* parser = nullptr;
 
         Z3_parser_context_ref(api::context& c): api::object(c) {
             ast_manager& m = c.m();
@@ -45,10 +49,15 @@ extern "C" {
             install_dl_cmds(*ctx.get());
             install_proof_cmds(*ctx.get());
             install_opt_cmds(*ctx.get());
-            install_smt2_extra_cmds(*ctx.get());            
+            install_smt2_extra_cmds(*ctx.get());
             ctx->register_plist();
             ctx->set_ignore_check(true);
         }
+
+        ~Z3_parser_context_ref() override {
+            if (parser)
+                smt2::free_parser(parser);
+        }
     };
 
     inline Z3_parser_context_ref * to_parser_context(Z3_parser_context pc) { return reinterpret_cast<Z3_parser_context_ref*>(pc); }
@@ -126,14 +135,15 @@ extern "C" {
         Z3_CATCH;
     }
 
-    static Z3_ast_vector Z3_parser_context_parse_stream(Z3_context c, scoped_ptr<cmd_context>& ctx, bool owned, std::istream& is) {
+    static Z3_ast_vector Z3_parser_context_parse_stream(Z3_context c, scoped_ptr<cmd_context>& ctx, bool owned, std::istream& is, smt2::parser** session = nullptr) {
         Z3_TRY;
         Z3_ast_vector_ref * v = alloc(Z3_ast_vector_ref, *mk_c(c), mk_c(c)->m());
-        mk_c(c)->save_object(v);        
+        mk_c(c)->save_object(v);
         std::stringstream errstrm;
         ctx->set_regular_stream(errstrm);
         try {
-            if (!parse_smt2_commands(*ctx, is)) {
+            bool ok = session ? parse_smt2_commands_with_parser(*session, *ctx, is) : parse_smt2_commands(*ctx, is);
+            if (!ok) {
                 if (owned)
                     ctx = nullptr;
                 SET_ERROR_CODE(Z3_PARSER_ERROR, errstrm.str());
@@ -159,7 +169,7 @@ extern "C" {
         LOG_Z3_parser_context_from_string(c, pc, str);
         std::istringstream is(str);
         auto& ctx = to_parser_context(pc)->ctx;
-        Z3_ast_vector r = Z3_parser_context_parse_stream(c, ctx, false, is);
+        Z3_ast_vector r = Z3_parser_context_parse_stream(c, ctx, false, is, &to_parser_context(pc)->parser);
         RETURN_Z3(r);
         Z3_CATCH_RETURN(nullptr);
     }
@@ -528,6 +528,20 @@ extern "C" {
         Z3_CATCH;
     }
 
+    void Z3_API Z3_solver_assert_many(Z3_context c, Z3_solver s, unsigned n, Z3_ast const fmls[]) {
+        Z3_TRY;
+        LOG_Z3_solver_assert_many(c, s, n, fmls);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+        for (unsigned i = 0; i < n; ++i) {
+            CHECK_FORMULA(fmls[i],);
+        }
+        for (unsigned i = 0; i < n; ++i) {
+            to_solver(s)->assert_expr(to_expr(fmls[i]));
+        }
+        Z3_CATCH;
+    }
+
     void Z3_API Z3_solver_assert_and_track(Z3_context c, Z3_solver s, Z3_ast a, Z3_ast p) {
         Z3_TRY;
         LOG_Z3_solver_assert_and_track(c, s, a, p);
@@ -689,6 +703,39 @@ extern "C" {
         Z3_CATCH_RETURN(Z3_L_UNDEF);
     }
     
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s, void* user_context, Z3_solver_check_eh check_eh) {
+        Z3_TRY;
+        LOG_Z3_solver_check_async(c, s, user_context, check_eh);
+        RESET_ERROR_CODE();
+        init_solver(c, s);
+#ifdef SINGLE_THREAD
+        Z3_lbool r = _solver_check(c, s, 0, nullptr);
+        to_solver(s)->m_async_result = static_cast<lbool>(r);
+        if (check_eh)
+            check_eh(user_context, r);
+#else
+        // at most one check per solver is in flight
+        to_solver(s)->wait_check();
+        to_solver(s)->m_async_result = l_undef;
+        to_solver(s)->m_check_thread = std::thread([c, s, user_context, check_eh]() {
+            Z3_lbool r = _solver_check(c, s, 0, nullptr);
+            to_solver(s)->m_async_result = static_cast<lbool>(r);
+            if (check_eh)
+                check_eh(user_context, r);
+        });
+#endif
+        Z3_CATCH;
+    }
+
+    Z3_lbool Z3_API Z3_solver_check_wait(Z3_context c, Z3_solver s) {
+        Z3_TRY;
+        LOG_Z3_solver_check_wait(c, s);
+        RESET_ERROR_CODE();
+        to_solver(s)->wait_check();
+        return static_cast<Z3_lbool>(to_solver(s)->m_async_result);
+        Z3_CATCH_RETURN(Z3_L_UNDEF);
+    }
+
     Z3_model Z3_API Z3_solver_get_model(Z3_context c, Z3_solver s) {
         Z3_TRY;
         LOG_Z3_solver_get_model(c, s);
@@ -20,6 +20,9 @@ Revision History:
 #include "util/mutex.h"
 #include "api/api_util.h"
 #include "solver/solver.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 struct solver2smt2_pp {
     ast_pp_util     m_pp_util;
@@ -48,17 +51,29 @@ struct Z3_solver_ref : public api::object {
     scoped_ptr<cmd_context>    m_cmd_context;
     mutex                      m_mux;
     event_handler*             m_eh;
+#ifndef SINGLE_THREAD
+    std::thread                m_check_thread;
+#endif
+    lbool                      m_async_result = l_undef;
 
-    Z3_solver_ref(api::context& c, solver_factory * f): 
+    Z3_solver_ref(api::context& c, solver_factory * f):
         api::object(c), m_solver_factory(f), m_solver(nullptr), m_logic(symbol::null), m_eh(nullptr) {}
 
-    Z3_solver_ref(api::context& c, solver * s): 
+    Z3_solver_ref(api::context& c, solver * s):
         api::object(c), m_solver_factory(nullptr), m_solver(s), m_logic(symbol::null), m_eh(nullptr) {}
 
+    ~Z3_solver_ref() override { wait_check(); }
+
     void assert_expr(expr* e);
     void assert_expr(expr* e, expr* t);
     void set_eh(event_handler* eh);
     void set_cancel();
+    void wait_check() {
+#ifndef SINGLE_THREAD
+        if (m_check_thread.joinable())
+            m_check_thread.join();
+#endif
+    }
 
 };
 
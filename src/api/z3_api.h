@@ -1438,6 +1438,11 @@ Z3_DECLARE_CLOSURE(Z3_created_eh, void, (void* ctx, Z3_solver_callback cb, Z3_as
 Z3_DECLARE_CLOSURE(Z3_decide_eh,  void, (void* ctx, Z3_solver_callback cb, Z3_ast* t, unsigned* idx, Z3_lbool* phase));
 Z3_DECLARE_CLOSURE(Z3_on_clause_eh, void, (void* ctx, Z3_ast proof_hint, Z3_ast_vector literals));
 
+/**
+   \brief completion callback for asynchronous check (See #Z3_solver_check_async).
+*/
+Z3_DECLARE_CLOSURE(Z3_solver_check_eh, void, (void* ctx, Z3_lbool result));
+
 
 /**
    \brief A Goal is essentially a set of formulas.
@@ -1668,6 +1673,15 @@ extern "C" {
     */
     void Z3_API Z3_dec_ref(Z3_context c, Z3_ast a);
 
+    /**
+       \brief Decrement the reference counters of an array of ASTs in one call.
+       The context \c c should have been created using #Z3_mk_context_rc.
+       This function is a NOOP if \c c was created using #Z3_mk_context.
+
+       def_API('Z3_dec_ref_array', VOID, (_in(CONTEXT), _in(UINT), _in_array(1, AST)))
+    */
+    void Z3_API Z3_dec_ref_array(Z3_context c, unsigned n, Z3_ast const asts[]);
+
     /**
        \brief Set a value of a context parameter.
 
@@ -5849,6 +5863,33 @@ extern "C" {
                                                    Z3_ast const assumptions[],
                                                    Z3_ast formula);
 
+    /**
+       \brief Serialize the given AST node into a compact binary format.
+
+       The result is a zero-free byte sequence, so it can be handled as a
+       regular C string. It can be reconstructed, also in a different
+       context, using #Z3_deserialize_ast. The binary format is much more
+       compact than the textual printers and decodes without parsing.
+
+       \warning The result buffer is statically allocated by Z3. It will
+       be automatically deallocated when #Z3_del_context is invoked.
+       So, the buffer is invalidated in the next call to \c Z3_serialize_ast.
+
+       \sa Z3_deserialize_ast
+
+       def_API('Z3_serialize_ast', STRING, (_in(CONTEXT), _in(AST)))
+    */
+    Z3_string Z3_API Z3_serialize_ast(Z3_context c, Z3_ast a);
+
+    /**
+       \brief Reconstruct an AST node from a string produced by #Z3_serialize_ast.
+
+       \sa Z3_serialize_ast
+
+       def_API('Z3_deserialize_ast', AST, (_in(CONTEXT), _in(STRING)))
+    */
+    Z3_ast Z3_API Z3_deserialize_ast(Z3_context c, Z3_string data);
+
     /**@}*/
 
     /** @name Parser interface */
@@ -6910,6 +6951,21 @@ extern "C" {
     */
     void Z3_API Z3_solver_assert(Z3_context c, Z3_solver s, Z3_ast a);
 
+    /**
+       \brief Assert \c n constraints into the solver in one call.
+
+       Equivalent to invoking #Z3_solver_assert on each element of \c fmls,
+       but the per-call overhead (logging, error handling, solver
+       initialization) is paid once for the whole batch. Useful for
+       frontends that assert a large number of formulas at once.
+
+       \sa Z3_solver_assert
+       \sa Z3_solver_assert_and_track
+
+       def_API('Z3_solver_assert_many', VOID, (_in(CONTEXT), _in(SOLVER), _in(UINT), _in_array(2, AST)))
+    */
+    void Z3_API Z3_solver_assert_many(Z3_context c, Z3_solver s, unsigned n, Z3_ast const fmls[]);
+
     /**
        \brief Assert a constraint \c a into the solver, and track it (in the unsat) core using
        the Boolean constant \c p.
@@ -7189,6 +7245,41 @@ extern "C" {
     Z3_lbool Z3_API Z3_solver_check_assumptions(Z3_context c, Z3_solver s,
                                                 unsigned num_assumptions, Z3_ast const assumptions[]);
 
+    /**
+       \brief Check the assertions in the given solver without blocking the
+       calling thread.
+
+       The check runs on a background thread and \c check_eh is invoked from
+       that thread with \c user_context and the verdict once the check
+       completes. The context and the solver must not be accessed between
+       this call and the completion of the check; use #Z3_solver_check_wait
+       to synchronize. The check can be cancelled from other threads through
+       #Z3_solver_interrupt or #Z3_interrupt, which trip the resource limit
+       of the running check.
+
+       A solver has at most one asynchronous check in flight: issuing a new
+       one first waits for the previous check to complete. In single thread
+       mode the check runs synchronously and the callback is invoked before
+       the function returns.
+
+       \sa Z3_solver_check
+       \sa Z3_solver_check_wait
+
+       def_API('Z3_solver_check_async', VOID, (_in(CONTEXT), _in(SOLVER), _in(VOID_PTR), _fnptr(Z3_solver_check_eh)))
+    */
+    void Z3_API Z3_solver_check_async(Z3_context c, Z3_solver s, void* user_context, Z3_solver_check_eh check_eh);
+
+    /**
+       \brief Wait for the asynchronous check issued on \c s, if any, and
+       return its verdict. Once this function returns, models, proofs and
+       cores can be retrieved from the solver as after #Z3_solver_check.
+
+       \sa Z3_solver_check_async
+
+       def_API('Z3_solver_check_wait', LBOOL, (_in(CONTEXT), _in(SOLVER)))
+    */
+    Z3_lbool Z3_API Z3_solver_check_wait(Z3_context c, Z3_solver s);
+
     /**
        \brief Retrieve congruence class representatives for terms.
 
@@ -34,9 +34,16 @@ void throw_invalid_reference() {
     throw z3_replayer_exception("invalid argument reference");
 }
 
+#define Z3_REPLAYER_BUFFER_SZ 65536
+
 struct z3_replayer::imp {
     z3_replayer &            m_owner;
     std::istream &           m_stream;
+    // the log is decoded from this buffer; it is refilled in bulk so that
+    // next() does not pay for a stream access per character.
+    char                     m_buffer[Z3_REPLAYER_BUFFER_SZ];
+    unsigned                 m_buffer_pos;
+    unsigned                 m_buffer_sz;
     int                      m_curr;  // current char;
     int                      m_line;  // line
     svector<char>            m_string;
@@ -115,6 +122,8 @@ struct z3_replayer::imp {
     imp(z3_replayer & o, std::istream & in):
         m_owner(o),
         m_stream(in),
+        m_buffer_pos(0),
+        m_buffer_sz(0),
         m_curr(0),
         m_line(1) {
         next();
@@ -163,7 +172,23 @@ struct z3_replayer::imp {
 
     int curr() const { return m_curr; }
     void new_line() { m_line++; }
-    void next() { m_curr = m_stream.get(); }
+
+    void fill_buffer() {
+        m_stream.read(m_buffer, Z3_REPLAYER_BUFFER_SZ);
+        m_buffer_sz  = static_cast<unsigned>(m_stream.gcount());
+        m_buffer_pos = 0;
+    }
+
+    void next() {
+        if (m_buffer_pos == m_buffer_sz) {
+            fill_buffer();
+            if (m_buffer_sz == 0) {
+                m_curr = EOF;
+                return;
+            }
+        }
+        m_curr = static_cast<unsigned char>(m_buffer[m_buffer_pos++]);
+    }
 
     void read_string_core(char delimiter) {
         if (curr() != delimiter)
@@ -1416,6 +1416,7 @@ static void mark_array_ref(ast_mark& mark, unsigned sz, parameter const * a) {
 ast_manager::~ast_manager() {
     SASSERT(is_format_manager() || !m_family_manager.has_family(symbol("format")));
 
+    disable_deferred_gc();
     dec_ref(m_bool_sort);
     dec_ref(m_proof_sort);
     dec_ref(m_true);
@@ -1576,14 +1577,22 @@ void ast_manager::copy_families_plugins(ast_manager const & from) {
               if (m_family_manager.has_family(fid)) tout << get_family_id(fid_name) << "\n";);
         TRACE("copy_families_plugins", tout << "target fid: " << get_family_id(fid_name) << "\n";);
         SASSERT(fid == get_family_id(fid_name));
-        if (from.has_plugin(fid) && !has_plugin(fid)) {
-            decl_plugin * new_p = from.get_plugin(fid)->mk_fresh();
-            register_plugin(fid, new_p);
-            SASSERT(new_p->get_family_id() == fid);
-            SASSERT(has_plugin(fid));
+        if (from.has_lazy_plugin(fid)) {
+            // The source plugin was never used: propagate the pending factory
+            // so that neither manager pays for instantiating it here.
+            if (!has_lazy_plugin(fid) && !has_plugin(fid))
+                register_plugin_factory(fid_name, from.m_plugin_factories[fid]);
         }
-        if (from.has_plugin(fid)) {
-            get_plugin(fid)->inherit(from.get_plugin(fid), trans);
+        else {
+            if (from.has_plugin(fid) && !has_plugin(fid)) {
+                decl_plugin * new_p = from.get_plugin(fid)->mk_fresh();
+                register_plugin(fid, new_p);
+                SASSERT(new_p->get_family_id() == fid);
+                SASSERT(has_plugin(fid));
+            }
+            if (from.has_plugin(fid)) {
+                get_plugin(fid)->inherit(from.get_plugin(fid), trans);
+            }
         }
         SASSERT(from.m_family_manager.has_family(fid) == m_family_manager.has_family(fid));
         SASSERT(from.get_family_id(fid_name) == get_family_id(fid_name));
@@ -1621,8 +1630,24 @@ void ast_manager::register_plugin(symbol const & s, decl_plugin * plugin) {
     register_plugin(id, plugin);
 }
 
+void ast_manager::register_plugin_factory(symbol const & s, decl_plugin_factory mk) {
+    family_id id = m_family_manager.mk_family_id(s);
+    SASSERT(m_plugins.get(id, 0) == 0);
+    if (static_cast<unsigned>(id) >= m_plugin_factories.size())
+        m_plugin_factories.resize(id + 1, nullptr);
+    m_plugin_factories[id] = mk;
+}
+
 decl_plugin * ast_manager::get_plugin(family_id fid) const {
-    return m_plugins.get(fid, 0);
+    decl_plugin * p = m_plugins.get(fid, 0);
+    if (!p && has_lazy_plugin(fid)) {
+        ast_manager & m = const_cast<ast_manager&>(*this);
+        decl_plugin_factory mk = m_plugin_factories[fid];
+        m.m_plugin_factories[fid] = nullptr;
+        m.register_plugin(fid, mk());
+        p = m_plugins.get(fid, 0);
+    }
+    return p;
 }
 
 
@@ -1688,6 +1713,8 @@ quantifier* ast_manager::is_lambda_def(func_decl* f) {
 
 void ast_manager::register_plugin(family_id id, decl_plugin * plugin) {
     SASSERT(m_plugins.get(id, 0) == 0);
+    if (has_lazy_plugin(id))
+        m_plugin_factories[id] = nullptr; // directly registered plugin supersedes the factory
     m_plugins.setx(id, plugin, 0);
     plugin->set_manager(this, id);
 }
@@ -1736,7 +1763,31 @@ ast * ast_manager::register_node_core(ast * n) {
     CASSERT("nondet_bug", contains || slow_not_contains(n));
 #endif
 
-    ast* r = m_ast_table.insert_if_not_there(n);    
+    if (in_bulk_mode()) {
+        // The candidate was allocated from m_bulk_region. Probe before
+        // inserting: on a hit the arena copy is abandoned (reclaimed when the
+        // bulk scope exits), on a miss the node is relocated into m_alloc so
+        // that it survives the scope. ast nodes are flat blobs without
+        // self-references, so a bitwise copy relocates them safely.
+        ast * const * entry = m_ast_table.find_core(n);
+        if (entry) {
+            ast * r0 = *entry;
+            SASSERT(r0->m_hash == h);
+            if (is_func_decl(r0) && to_func_decl(r0)->get_range() != to_func_decl(n)->get_range()) {
+                std::ostringstream buffer;
+                buffer << "Recycling of declaration for the same name '" << to_func_decl(r0)->get_name().str()
+                       << "' and domain, but different range type is not permitted";
+                throw ast_exception(buffer.str());
+            }
+            return r0;
+        }
+        unsigned sz = ::get_node_size(n);
+        void * mem  = m_alloc.allocate(sz);
+        memcpy(mem, n, sz);
+        n = static_cast<ast*>(mem);
+    }
+
+    ast* r = m_ast_table.insert_if_not_there(n);
 
     SASSERT(r->m_hash == h);
     if (r != n) {
@@ -1920,6 +1971,37 @@ void ast_manager::delete_node(ast * n) {
     }
 }
 
+void ast_manager::defer_delete(ast * n) {
+    if (!n->m_gc_queued) {
+        n->m_gc_queued = true;
+        m_gc_candidates.push_back(n);
+    }
+    // Reclamation triggered by a dying reference is skipped while a
+    // reclamation is already in progress: deleting a sort or declaration
+    // may release parameter asts through dec_ref, and the outer loop
+    // accounts for the budget.
+    if (!m_gc_reclaiming)
+        reclaim_garbage(m_gc_budget);
+}
+
+unsigned ast_manager::reclaim_garbage(unsigned max_nodes) {
+    unsigned reclaimed = 0;
+    flet<bool> _reclaiming(m_gc_reclaiming, true);
+    while (reclaimed < max_nodes && !m_gc_candidates.empty()) {
+        ast * n = m_gc_candidates.back();
+        m_gc_candidates.pop_back();
+        n->m_gc_queued = false;
+        // A queued node can be resurrected by the unique table before it is
+        // reclaimed; it is then kept. Children released by delete_node are
+        // queued rather than cascaded, so each iteration frees one node.
+        if (n->get_ref_count() == 0) {
+            delete_node(n);
+            ++reclaimed;
+        }
+    }
+    return reclaimed;
+}
+
 
 sort * ast_manager::mk_sort(family_id fid, decl_kind k, unsigned num_parameters, parameter const * parameters) {
     decl_plugin * p = get_plugin(fid);
@@ -33,6 +33,7 @@ Revision History:
 #include "util/tptr.h"
 #include "util/memory_manager.h"
 #include "util/small_object_allocator.h"
+#include "util/region.h"
 #include "util/obj_ref.h"
 #include "util/ref_vector.h"
 #include "util/ref_pair_vector.h"
@@ -468,6 +469,10 @@ protected:
     //    shared_occs used one of the public marks.
     //  - This was a constant source of assertion violations.
     unsigned m_mark_shared_occs:1;
+    // Set while the node sits in the manager's deferred deletion queue;
+    // prevents double enqueuing when a node dies, is resurrected by the
+    // unique table, and dies again before being reclaimed.
+    unsigned m_gc_queued:1;
     friend class shared_occs_mark;
     void mark_so(bool flag) { m_mark_shared_occs = flag; }
     void reset_mark_so() { m_mark_shared_occs = false; }
@@ -490,7 +495,7 @@ protected:
         --m_ref_count;
     }
 
-    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_ref_count(0) {
+    ast(ast_kind k):m_id(UINT_MAX), m_kind(k), m_mark1(false), m_mark2(false), m_mark_shared_occs(false), m_gc_queued(false), m_ref_count(0) {
         DEBUG_CODE({
             m_mark1_owner = 0;
             m_mark2_owner = 0;
@@ -1490,14 +1495,20 @@ public:
 protected:
     reslimit                  m_limit;
     small_object_allocator    m_alloc;
+    region                    m_bulk_region;
+    unsigned                  m_bulk_scopes = 0;
     family_manager            m_family_manager;
     expr_array_manager        m_expr_array_manager;
     expr_dependency_manager   m_expr_dependency_manager;
     expr_dependency_array_manager m_expr_dependency_array_manager;
     ptr_vector<decl_plugin>   m_plugins;
+    svector<decl_plugin * (*)()> m_plugin_factories; // indexed by family id; see register_plugin_factory
     proof_gen_mode            m_proof_mode;
     bool                      m_int_real_coercions; // If true, use hack that automatically introduces to_int/to_real when needed.
     ast_table                 m_ast_table;
+    ptr_vector<ast>           m_gc_candidates; // dead nodes awaiting deferred reclamation; still in m_ast_table
+    unsigned                  m_gc_budget = 0; // 0: eager deletion, otherwise max nodes reclaimed per dying reference
+    bool                      m_gc_reclaiming = false;
     obj_map<func_decl, quantifier*> m_lambda_defs;
     id_gen                    m_expr_id_gen;
     id_gen                    m_decl_id_gen;
@@ -1589,6 +1600,21 @@ public:
 
     void register_plugin(family_id id, decl_plugin * plugin);
 
+    typedef decl_plugin * (*decl_plugin_factory)();
+
+    /**
+       \brief Register a factory for the plugin associated with \c s.
+       The plugin is only allocated and attached to the manager when the
+       family is used for the first time; managers that never touch the
+       theory do not pay for its tables.
+    */
+    void register_plugin_factory(symbol const & s, decl_plugin_factory mk);
+
+    // true if a factory is registered for fid and the plugin was not instantiated yet
+    bool has_lazy_plugin(family_id fid) const {
+        return static_cast<unsigned>(fid) < m_plugin_factories.size() && m_plugin_factories[fid] != nullptr;
+    }
+
     decl_plugin * get_plugin(family_id fid) const;
 
     bool has_plugin(family_id fid) const { return get_plugin(fid) != nullptr; }
@@ -1647,11 +1673,26 @@ public:
     void dec_ref(ast* n) {
         if (n) {
             n->dec_ref();
-            if (n->get_ref_count() == 0)
-                delete_node(n);
+            if (n->get_ref_count() == 0) {
+                if (m_gc_budget == 0)
+                    delete_node(n);
+                else
+                    defer_delete(n);
+            }
         }
     }
 
+    // Deferred garbage collection: when enabled, nodes whose reference count
+    // drops to zero are queued instead of being deleted eagerly, and at most
+    // m_gc_budget queued nodes are reclaimed per dying reference. This bounds
+    // the pause caused by releasing a large term graph at once. Queued nodes
+    // remain in the unique table, so a node that is recreated before it is
+    // reclaimed is resurrected for free.
+    void enable_deferred_gc(unsigned max_reclaim_per_op) { m_gc_budget = max_reclaim_per_op; }
+    void disable_deferred_gc() { if (m_gc_budget != 0) { reclaim_garbage(UINT_MAX); m_gc_budget = 0; } }
+    bool deferred_gc_enabled() const { return m_gc_budget != 0; }
+    unsigned reclaim_garbage(unsigned max_nodes);
+
     template<typename T>
     void inc_array_ref(unsigned sz, T * const * a) {
         for(unsigned i = 0; i < sz; i++) {
@@ -1672,6 +1713,40 @@ public:
         return m_alloc.get_allocation_size();
     }
 
+    /**
+       \brief Scoped bulk construction mode.
+
+       While a bulk scope is active, candidate nodes are allocated from an
+       arena instead of m_alloc.  A candidate that turns out to be already
+       hash-consed is simply abandoned in the arena, a genuinely new node is
+       relocated into m_alloc before it is interned.  The arena is reclaimed
+       wholesale when the outermost scope exits, so rewriters that
+       speculatively build many terms avoid per-node allocator round-trips.
+
+       Bulk mode is disabled while a trace stream is attached: tracing relies
+       on pointer identity of freshly registered nodes, which relocation breaks.
+    */
+    void begin_bulk() {
+        m_bulk_scopes++;
+    }
+
+    void end_bulk() {
+        SASSERT(m_bulk_scopes > 0);
+        if (--m_bulk_scopes == 0)
+            m_bulk_region.reset();
+    }
+
+    bool in_bulk_mode() const {
+        return m_bulk_scopes > 0 && !m_trace_stream;
+    }
+
+    class scoped_bulk {
+        ast_manager & m_manager;
+    public:
+        scoped_bulk(ast_manager & m):m_manager(m) { m_manager.begin_bulk(); }
+        ~scoped_bulk() { m_manager.end_bulk(); }
+    };
+
     std::ostream& display(std::ostream& out) const;
 
 protected:
@@ -1685,10 +1760,16 @@ protected:
     void delete_node(ast * n);
 
     void * allocate_node(unsigned size) {
+        if (in_bulk_mode())
+            return m_bulk_region.allocate(size);
         return m_alloc.allocate(size);
     }
 
     void deallocate_node(ast * n, unsigned sz) {
+        // In bulk mode unregistered candidates (id still UINT_MAX) live in
+        // m_bulk_region and are reclaimed wholesale when the scope exits.
+        if (in_bulk_mode() && n->get_id() == UINT_MAX)
+            return;
         m_alloc.deallocate(sz, n);
     }
 
@@ -2364,10 +2445,17 @@ protected:
     bool check_nnf_proof_parents(unsigned num_proofs, proof * const * proofs) const;
 
 private:
+    void defer_delete(ast * n);
+
     void push_dec_ref(ast * n) {
         n->dec_ref();
         if (n->get_ref_count() == 0) {
-            m_ast_table.push_erase(n);
+            if (m_gc_budget == 0)
+                m_ast_table.push_erase(n);
+            else if (!n->m_gc_queued) {
+                n->m_gc_queued = true;
+                m_gc_candidates.push_back(n);
+            }
         }
     }
 
@@ -0,0 +1,564 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.cpp
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2026-08-28.
+
+--*/
+#include "ast/ast_binary.h"
+#include "util/map.h"
+#include <cstring>
+#include <sstream>
+
+namespace {
+
+    // record tags. tags, like every other byte of the stream, are never 0.
+    enum record_tag {
+        TAG_SORT  = 1,
+        TAG_DECL  = 2,
+        TAG_APP   = 3,
+        TAG_VAR   = 4,
+        TAG_QUANT = 5
+    };
+
+    // symbol records
+    enum sym_marker {
+        SYM_NULL    = 0,
+        SYM_STRING  = 1,
+        SYM_NUMERIC = 2,
+        SYM_REF     = 3 // marker - SYM_REF is an index into the symbol table
+    };
+
+    // parameter records
+    enum param_tag {
+        PARAM_TAG_INT      = 1,
+        PARAM_TAG_AST      = 2,
+        PARAM_TAG_SYMBOL   = 3,
+        PARAM_TAG_ZSTRING  = 4,
+        PARAM_TAG_RATIONAL = 5,
+        PARAM_TAG_DOUBLE   = 6
+    };
+
+    static const char magic0 = 'Z', magic1 = '3', magic2 = 'B';
+    static const unsigned format_version = 1;
+
+    // Variable-length encoding of unsigned values that never produces a
+    // zero byte: all chunks but the last carry 7 bits and have the high
+    // bit set; the last chunk is stored incremented by one, so it lies
+    // in [1, 127].
+    class writer {
+        std::string m_buffer;
+    public:
+        void put_uint(uint64_t v) {
+            while (v > 126) {
+                m_buffer.push_back(static_cast<char>(0x80 | (v & 0x7F)));
+                v >>= 7;
+            }
+            m_buffer.push_back(static_cast<char>(v + 1));
+        }
+        void put_int(int v) {
+            // zig-zag
+            put_uint((static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(static_cast<int64_t>(v) >> 63));
+        }
+        void put_string(char const * s, unsigned n) {
+            put_uint(n);
+            m_buffer.append(s, n);
+        }
+        std::string take() { return std::move(m_buffer); }
+    };
+
+    class reader {
+        char const * m_data;
+        unsigned     m_size;
+        unsigned     m_pos = 0;
+        unsigned char next() {
+            if (m_pos >= m_size)
+                throw default_exception("binary AST stream is truncated");
+            return static_cast<unsigned char>(m_data[m_pos++]);
+        }
+    public:
+        reader(char const * data, unsigned size): m_data(data), m_size(size) {}
+        bool eof() const { return m_pos == m_size; }
+        uint64_t get_uint() {
+            uint64_t r = 0;
+            unsigned shift = 0;
+            while (true) {
+                unsigned char b = next();
+                if (b == 0 || shift > 63)
+                    throw default_exception("binary AST stream is malformed");
+                if (b & 0x80) {
+                    r |= static_cast<uint64_t>(b & 0x7F) << shift;
+                    shift += 7;
+                }
+                else {
+                    r |= static_cast<uint64_t>(b - 1) << shift;
+                    return r;
+                }
+            }
+        }
+        unsigned get_unsigned() {
+            uint64_t r = get_uint();
+            if (r > UINT_MAX)
+                throw default_exception("binary AST stream is malformed");
+            return static_cast<unsigned>(r);
+        }
+        int get_int() {
+            uint64_t u = get_uint();
+            return static_cast<int>((u >> 1) ^ (0 - (u & 1)));
+        }
+        std::string get_string() {
+            unsigned n = get_unsigned();
+            if (n > m_size - m_pos)
+                throw default_exception("binary AST stream is truncated");
+            std::string r(m_data + m_pos, n);
+            m_pos += n;
+            return r;
+        }
+    };
+
+    class encoder {
+        ast_manager &          m;
+        writer                 m_out;
+        obj_map<ast, unsigned> m_ids;
+        map<symbol, unsigned, symbol_hash_proc, symbol_eq_proc> m_sym_ids;
+
+        void put_symbol(symbol const & s) {
+            if (s == symbol::null) {
+                m_out.put_uint(SYM_NULL);
+                return;
+            }
+            unsigned id;
+            if (m_sym_ids.find(s, id)) {
+                m_out.put_uint(SYM_REF + id);
+                return;
+            }
+            if (s.is_numerical()) {
+                m_out.put_uint(SYM_NUMERIC);
+                m_out.put_uint(s.get_num());
+            }
+            else {
+                char const * str = s.bare_str();
+                m_out.put_uint(SYM_STRING);
+                m_out.put_string(str, static_cast<unsigned>(strlen(str)));
+            }
+            m_sym_ids.insert(s, m_sym_ids.size());
+        }
+
+        void put_param(parameter const & p) {
+            switch (p.get_kind()) {
+            case parameter::PARAM_INT:
+                m_out.put_uint(PARAM_TAG_INT);
+                m_out.put_int(p.get_int());
+                break;
+            case parameter::PARAM_AST:
+                m_out.put_uint(PARAM_TAG_AST);
+                m_out.put_uint(m_ids[p.get_ast()]);
+                break;
+            case parameter::PARAM_SYMBOL:
+                m_out.put_uint(PARAM_TAG_SYMBOL);
+                put_symbol(p.get_symbol());
+                break;
+            case parameter::PARAM_ZSTRING: {
+                zstring const & zs = p.get_zstring();
+                m_out.put_uint(PARAM_TAG_ZSTRING);
+                m_out.put_uint(zs.length());
+                for (unsigned i = 0; i < zs.length(); ++i)
+                    m_out.put_uint(zs[i]);
+                break;
+            }
+            case parameter::PARAM_RATIONAL: {
+                std::ostringstream strm;
+                strm << p.get_rational();
+                std::string s = strm.str();
+                m_out.put_uint(PARAM_TAG_RATIONAL);
+                m_out.put_string(s.c_str(), static_cast<unsigned>(s.size()));
+                break;
+            }
+            case parameter::PARAM_DOUBLE: {
+                uint64_t bits;
+                double d = p.get_double();
+                memcpy(&bits, &d, sizeof(bits));
+                m_out.put_uint(PARAM_TAG_DOUBLE);
+                m_out.put_uint(bits);
+                break;
+            }
+            default:
+                throw default_exception("AST with external parameters cannot be serialized");
+            }
+        }
+
+        void put_params(unsigned n, parameter const * ps) {
+            m_out.put_uint(n);
+            for (unsigned i = 0; i < n; ++i)
+                put_param(ps[i]);
+        }
+
+        void children(ast * n, ptr_vector<ast> & cs) {
+            auto add_params = [&](unsigned num, parameter const * ps) {
+                for (unsigned i = 0; i < num; ++i)
+                    if (ps[i].is_ast())
+                        cs.push_back(ps[i].get_ast());
+            };
+            switch (n->get_kind()) {
+            case AST_SORT:
+                add_params(to_sort(n)->get_num_parameters(), to_sort(n)->get_parameters());
+                break;
+            case AST_FUNC_DECL: {
+                func_decl * f = to_func_decl(n);
+                add_params(f->get_num_parameters(), f->get_parameters());
+                for (unsigned i = 0; i < f->get_arity(); ++i)
+                    cs.push_back(f->get_domain(i));
+                cs.push_back(f->get_range());
+                break;
+            }
+            case AST_APP: {
+                app * a = to_app(n);
+                cs.push_back(a->get_decl());
+                for (expr * arg : *a)
+                    cs.push_back(arg);
+                break;
+            }
+            case AST_VAR:
+                cs.push_back(to_var(n)->get_sort());
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                for (unsigned i = 0; i < q->get_num_decls(); ++i)
+                    cs.push_back(q->get_decl_sort(i));
+                cs.push_back(q->get_expr());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    cs.push_back(q->get_pattern(i));
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    cs.push_back(q->get_no_pattern(i));
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+        void put_node(ast * n) {
+            switch (n->get_kind()) {
+            case AST_SORT: {
+                sort * s = to_sort(n);
+                m_out.put_uint(TAG_SORT);
+                if (s->get_family_id() == null_family_id) {
+                    put_symbol(symbol::null);
+                    put_symbol(s->get_name());
+                }
+                else {
+                    put_symbol(m.get_family_name(s->get_family_id()));
+                    m_out.put_int(s->get_decl_kind());
+                }
+                put_params(s->get_num_parameters(), s->get_parameters());
+                break;
+            }
+            case AST_FUNC_DECL: {
+                func_decl * f = to_func_decl(n);
+                m_out.put_uint(TAG_DECL);
+                if (f->get_family_id() == null_family_id) {
+                    put_symbol(symbol::null);
+                    put_symbol(f->get_name());
+                }
+                else {
+                    put_symbol(m.get_family_name(f->get_family_id()));
+                    m_out.put_int(f->get_decl_kind());
+                    put_params(f->get_num_parameters(), f->get_parameters());
+                }
+                m_out.put_uint(f->get_arity());
+                for (unsigned i = 0; i < f->get_arity(); ++i)
+                    m_out.put_uint(m_ids[f->get_domain(i)]);
+                m_out.put_uint(m_ids[f->get_range()]);
+                break;
+            }
+            case AST_APP: {
+                app * a = to_app(n);
+                m_out.put_uint(TAG_APP);
+                m_out.put_uint(m_ids[a->get_decl()]);
+                m_out.put_uint(a->get_num_args());
+                for (expr * arg : *a)
+                    m_out.put_uint(m_ids[arg]);
+                break;
+            }
+            case AST_VAR:
+                m_out.put_uint(TAG_VAR);
+                m_out.put_uint(to_var(n)->get_idx());
+                m_out.put_uint(m_ids[to_var(n)->get_sort()]);
+                break;
+            case AST_QUANTIFIER: {
+                quantifier * q = to_quantifier(n);
+                m_out.put_uint(TAG_QUANT);
+                m_out.put_uint(static_cast<unsigned>(q->get_kind()));
+                m_out.put_uint(q->get_num_decls());
+                for (unsigned i = 0; i < q->get_num_decls(); ++i) {
+                    put_symbol(q->get_decl_name(i));
+                    m_out.put_uint(m_ids[q->get_decl_sort(i)]);
+                }
+                m_out.put_uint(m_ids[q->get_expr()]);
+                m_out.put_int(q->get_weight());
+                put_symbol(q->get_qid());
+                put_symbol(q->get_skid());
+                m_out.put_uint(q->get_num_patterns());
+                for (unsigned i = 0; i < q->get_num_patterns(); ++i)
+                    m_out.put_uint(m_ids[q->get_pattern(i)]);
+                m_out.put_uint(q->get_num_no_patterns());
+                for (unsigned i = 0; i < q->get_num_no_patterns(); ++i)
+                    m_out.put_uint(m_ids[q->get_no_pattern(i)]);
+                break;
+            }
+            default:
+                UNREACHABLE();
+            }
+        }
+
+    public:
+        encoder(ast_manager & m): m(m) {}
+
+        std::string operator()(ast * root) {
+            std::string hdr;
+            hdr.push_back(magic0);
+            hdr.push_back(magic1);
+            hdr.push_back(magic2);
+            m_out.put_uint(format_version);
+            ptr_vector<ast> todo, cs;
+            todo.push_back(root);
+            while (!todo.empty()) {
+                ast * n = todo.back();
+                if (m_ids.contains(n)) {
+                    todo.pop_back();
+                    continue;
+                }
+                cs.reset();
+                children(n, cs);
+                bool ready = true;
+                for (ast * c : cs)
+                    if (!m_ids.contains(c)) {
+                        todo.push_back(c);
+                        ready = false;
+                    }
+                if (!ready)
+                    continue;
+                todo.pop_back();
+                put_node(n);
+                m_ids.insert(n, m_ids.size());
+            }
+            return hdr + m_out.take();
+        }
+    };
+
+    class decoder {
+        ast_manager &  m;
+        reader         m_in;
+        ast_ref_vector m_nodes;
+
+        ast * get_node(unsigned id) {
+            if (id >= m_nodes.size())
+                throw default_exception("binary AST stream is malformed");
+            return m_nodes.get(id);
+        }
+        sort * get_sort(unsigned id) {
+            ast * n = get_node(id);
+            if (!is_sort(n))
+                throw default_exception("binary AST stream is malformed");
+            return to_sort(n);
+        }
+        expr * get_expr(unsigned id) {
+            ast * n = get_node(id);
+            if (!is_expr(n))
+                throw default_exception("binary AST stream is malformed");
+            return to_expr(n);
+        }
+
+        symbol get_symbol() {
+            uint64_t marker = m_in.get_uint();
+            switch (marker) {
+            case SYM_NULL:
+                return symbol::null;
+            case SYM_STRING: {
+                symbol s(m_in.get_string().c_str());
+                m_symbols.push_back(s);
+                return s;
+            }
+            case SYM_NUMERIC: {
+                symbol s(m_in.get_unsigned());
+                m_symbols.push_back(s);
+                return s;
+            }
+            default: {
+                uint64_t id = marker - SYM_REF;
+                if (id >= m_symbols.size())
+                    throw default_exception("binary AST stream is malformed");
+                return m_symbols[static_cast<unsigned>(id)];
+            }
+            }
+        }
+
+        parameter get_param() {
+            switch (m_in.get_uint()) {
+            case PARAM_TAG_INT:
+                return parameter(m_in.get_int());
+            case PARAM_TAG_AST:
+                return parameter(get_node(m_in.get_unsigned()));
+            case PARAM_TAG_SYMBOL:
+                return parameter(get_symbol());
+            case PARAM_TAG_ZSTRING: {
+                unsigned n = m_in.get_unsigned();
+                zstring zs;
+                for (unsigned i = 0; i < n; ++i)
+                    zs = zs + zstring(m_in.get_unsigned());
+                return parameter(std::move(zs));
+            }
+            case PARAM_TAG_RATIONAL:
+                return parameter(rational(m_in.get_string().c_str()));
+            case PARAM_TAG_DOUBLE: {
+                uint64_t bits = m_in.get_uint();
+                double d;
+                memcpy(&d, &bits, sizeof(d));
+                return parameter(d);
+            }
+            default:
+                throw default_exception("binary AST stream is malformed");
+            }
+        }
+
+        void get_params(vector<parameter> & ps) {
+            unsigned n = m_in.get_unsigned();
+            for (unsigned i = 0; i < n; ++i)
+                ps.push_back(get_param());
+        }
+
+        svector<symbol> m_symbols;
+
+        void get_record() {
+            vector<parameter> params;
+            switch (m_in.get_uint()) {
+            case TAG_SORT: {
+                symbol family = get_symbol();
+                if (family == symbol::null) {
+                    symbol name = get_symbol();
+                    get_params(params);
+                    m_nodes.push_back(m.mk_uninterpreted_sort(name, params.size(), params.data()));
+                }
+                else {
+                    decl_kind k = m_in.get_int();
+                    get_params(params);
+                    sort * s = m.mk_sort(m.mk_family_id(family), k, params.size(), params.data());
+                    if (!s)
+                        throw default_exception("binary AST stream contains an unknown sort");
+                    m_nodes.push_back(s);
+                }
+                break;
+            }
+            case TAG_DECL: {
+                symbol family = get_symbol();
+                symbol name;
+                decl_kind k = null_decl_kind;
+                if (family == symbol::null)
+                    name = get_symbol();
+                else {
+                    k = m_in.get_int();
+                    get_params(params);
+                }
+                unsigned arity = m_in.get_unsigned();
+                ptr_vector<sort> domain;
+                for (unsigned i = 0; i < arity; ++i)
+                    domain.push_back(get_sort(m_in.get_unsigned()));
+                sort * range = get_sort(m_in.get_unsigned());
+                func_decl * f;
+                if (family == symbol::null)
+                    f = m.mk_func_decl(name, arity, domain.data(), range);
+                else
+                    f = m.mk_func_decl(m.mk_family_id(family), k, params.size(), params.data(), arity, domain.data(), range);
+                if (!f)
+                    throw default_exception("binary AST stream contains an unknown declaration");
+                m_nodes.push_back(f);
+                break;
+            }
+            case TAG_APP: {
+                ast * d = get_node(m_in.get_unsigned());
+                if (!is_func_decl(d))
+                    throw default_exception("binary AST stream is malformed");
+                func_decl * f = to_func_decl(d);
+                unsigned num_args = m_in.get_unsigned();
+                ptr_vector<expr> args;
+                for (unsigned i = 0; i < num_args; ++i)
+                    args.push_back(get_expr(m_in.get_unsigned()));
+                m_nodes.push_back(m.mk_app(f, num_args, args.data()));
+                break;
+            }
+            case TAG_VAR: {
+                unsigned idx = m_in.get_unsigned();
+                m_nodes.push_back(m.mk_var(idx, get_sort(m_in.get_unsigned())));
+                break;
+            }
+            case TAG_QUANT: {
+                quantifier_kind k = static_cast<quantifier_kind>(m_in.get_unsigned());
+                unsigned num_decls = m_in.get_unsigned();
+                svector<symbol> names;
+                ptr_vector<sort> sorts;
+                for (unsigned i = 0; i < num_decls; ++i) {
+                    names.push_back(get_symbol());
+                    sorts.push_back(get_sort(m_in.get_unsigned()));
+                }
+                expr * body = get_expr(m_in.get_unsigned());
+                int weight = m_in.get_int();
+                symbol qid = get_symbol();
+                symbol skid = get_symbol();
+                ptr_vector<expr> patterns, no_patterns;
+                unsigned num_patterns = m_in.get_unsigned();
+                for (unsigned i = 0; i < num_patterns; ++i)
+                    patterns.push_back(get_expr(m_in.get_unsigned()));
+                unsigned num_no_patterns = m_in.get_unsigned();
+                for (unsigned i = 0; i < num_no_patterns; ++i)
+                    no_patterns.push_back(get_expr(m_in.get_unsigned()));
+                m_nodes.push_back(m.mk_quantifier(k, num_decls, sorts.data(), names.data(), body,
+                                                  weight, qid, skid,
+                                                  num_patterns, patterns.data(),
+                                                  num_no_patterns, no_patterns.data()));
+                break;
+            }
+            default:
+                throw default_exception("binary AST stream is malformed");
+            }
+        }
+
+    public:
+        decoder(ast_manager & m, char const * data, unsigned size):
+            m(m),
+            m_in(data, size),
+            m_nodes(m) {
+            if (size < 4 || data[0] != magic0 || data[1] != magic1 || data[2] != magic2)
+                throw default_exception("not a binary AST stream");
+            m_in = reader(data + 3, size - 3);
+            if (m_in.get_uint() != format_version)
+                throw default_exception("binary AST stream has an unsupported version");
+        }
+
+        ast_ref operator()() {
+            while (!m_in.eof())
+                get_record();
+            if (m_nodes.empty())
+                throw default_exception("binary AST stream is empty");
+            return ast_ref(m_nodes.back(), m);
+        }
+    };
+}
+
+std::string serialize_ast(ast_manager & m, ast * a) {
+    encoder enc(m);
+    return enc(a);
+}
+
+ast_ref deserialize_ast(ast_manager & m, char const * data, unsigned size) {
+    decoder dec(m, data, size);
+    return dec();
+}
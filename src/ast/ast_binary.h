@@ -0,0 +1,41 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    ast_binary.h
+
+Abstract:
+
+    Compact binary serialization of ASTs.
+
+    Nodes are emitted in topological order with interned symbols, so a
+    stream decodes directly into the unique tables of the receiving
+    ast_manager without going through a parser. All multi-byte values
+    are encoded so that no byte of the stream is zero; a serialized AST
+    is therefore a valid C string and can be shipped through interfaces
+    that expect one.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2026-08-28.
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include <string>
+
+/**
+   \brief Serialize \c a into a compact, zero-free byte string.
+   Throws default_exception if the AST contains node kinds that cannot
+   be serialized (e.g., declarations with external parameters).
+*/
+std::string serialize_ast(ast_manager & m, ast * a);
+
+/**
+   \brief Reconstruct an AST from \c size bytes at \c data.
+   Throws default_exception if the stream is malformed or was produced
+   by an incompatible version.
+*/
+ast_ref deserialize_ast(ast_manager & m, char const * data, unsigned size);
@@ -367,9 +367,14 @@ namespace euf {
             m_nodes.pop_back();
             m_exprs.pop_back();
         };
+        // Unwinding the trail is proportional to the number of updates since
+        // the push point, not to the size of the e-graph: each record undoes
+        // one table/merge mutation. Iterate over raw pointers; this loop is
+        // hot on workloads that push/pop every few hundred assertions.
         unsigned sz = m_updates.size();
-        for (unsigned i = sz; i-- > num_updates; ) {
-            auto const& p = m_updates[i];
+        update_record const* first = m_updates.data() + num_updates;
+        for (update_record const* u = m_updates.data() + sz; u-- > first; ) {
+            auto const& p = *u;
             switch (p.tag) {
             case update_record::tag_t::is_add_node:
                 undo_node();
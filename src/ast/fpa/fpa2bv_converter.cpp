@@ -19,6 +19,7 @@ Notes:
 #include<math.h>
 
 #include "ast/ast_smt2_pp.h"
+#include "ast/rewriter/expr_safe_replace.h"
 #include "ast/ast_pp.h"
 #include "ast/well_sorted.h"
 #include "ast/rewriter/th_rewriter.h"
@@ -585,9 +586,59 @@ void fpa2bv_converter::mk_add(func_decl * f, unsigned num, expr * const * args,
     rm = to_app(args[0])->get_arg(0);
     x = args[1];
     y = args[2];
+    if (mk_binary_templated(static_cast<bin_op>(&fpa2bv_converter::mk_add), f, rm, x, y, result))
+        return;
     mk_add(f->get_range(), rm, x, y, result);
 }
 
+/**
+   \brief Instantiate the circuit for a binary operation from a cached
+   template. The template is built once per (operation, rounding mode) over
+   fresh operand components; occurrences with numeral components take the
+   direct path so that constant folding is not lost. Since every converted
+   float is an fp-application of its components, substituting the actual
+   components for the holes reproduces exactly the circuit that would have
+   been built directly, up to simplifications enabled by numerals.
+*/
+bool fpa2bv_converter::mk_binary_templated(bin_op op, func_decl * f, expr * rm, expr * x, expr * y, expr_ref & result) {
+    if (!m_util.is_fp(x) || !m_util.is_fp(y))
+        return false;
+    expr * xc[3];
+    expr * yc[3];
+    for (unsigned i = 0; i < 3; i++) {
+        xc[i] = to_app(x)->get_arg(i);
+        yc[i] = to_app(y)->get_arg(i);
+        if (m_bv_util.is_numeral(xc[i]) || m_bv_util.is_numeral(yc[i]))
+            return false;
+    }
+    op_template * t = nullptr;
+    if (!m_op_templates.find(f, rm, t)) {
+        sort * s = f->get_range();
+        unsigned ebits = m_util.get_ebits(s);
+        unsigned sbits = m_util.get_sbits(s);
+        t = alloc(op_template, m);
+        for (unsigned i = 0; i < 2; i++) {
+            t->m_holes.push_back(m.mk_fresh_const("fpa2bv.sgn", m_bv_util.mk_sort(1)));
+            t->m_holes.push_back(m.mk_fresh_const("fpa2bv.exp", m_bv_util.mk_sort(ebits)));
+            t->m_holes.push_back(m.mk_fresh_const("fpa2bv.sig", m_bv_util.mk_sort(sbits - 1)));
+        }
+        expr_ref rm_e(rm, m);
+        expr_ref hx(m_util.mk_fp(t->m_holes.get(0), t->m_holes.get(1), t->m_holes.get(2)), m);
+        expr_ref hy(m_util.mk_fp(t->m_holes.get(3), t->m_holes.get(4), t->m_holes.get(5)), m);
+        (this->*op)(s, rm_e, hx, hy, t->m_result);
+        m.inc_ref(f);
+        m.inc_ref(rm);
+        m_op_templates.insert(f, rm, t);
+    }
+    expr_safe_replace sub(m);
+    for (unsigned i = 0; i < 3; i++) {
+        sub.insert(t->m_holes.get(i), xc[i]);
+        sub.insert(t->m_holes.get(3 + i), yc[i]);
+    }
+    sub(t->m_result, result);
+    return true;
+}
+
 void fpa2bv_converter::mk_add(sort * s, expr_ref & rm, expr_ref & x, expr_ref & y, expr_ref & result) {
     expr_ref nan(m), nzero(m), pzero(m);
     mk_nan(s, nan);
@@ -761,6 +812,8 @@ void fpa2bv_converter::mk_mul(func_decl * f, unsigned num, expr * const * args,
     rm = to_app(args[0])->get_arg(0);
     x = args[1];
     y = args[2];
+    if (mk_binary_templated(static_cast<bin_op>(&fpa2bv_converter::mk_mul), f, rm, x, y, result))
+        return;
     mk_mul(f->get_range(), rm, x, y, result);
 }
 
@@ -910,6 +963,8 @@ void fpa2bv_converter::mk_div(func_decl * f, unsigned num, expr * const * args,
     rm = to_app(args[0])->get_arg(0);
     x = args[1];
     y = args[2];
+    if (mk_binary_templated(static_cast<bin_op>(&fpa2bv_converter::mk_div), f, rm, x, y, result))
+        return;
     mk_div(f->get_range(), rm, x, y, result);
 }
 
@@ -4299,6 +4354,12 @@ void fpa2bv_converter::reset() {
     }
     m_uf2bvuf.reset();
     m_min_max_ufs.reset();
+    for (auto const& kd : m_op_templates) {
+        m.dec_ref(kd.get_key1());
+        m.dec_ref(kd.get_key2());
+        dealloc(kd.get_value());
+    }
+    m_op_templates.reset();
     m_extra_assertions.reset();
 }
 
@@ -19,6 +19,7 @@ Notes:
 #pragma once
 
 #include "ast/ast.h"
+#include "util/obj_pair_hashtable.h"
 #include "util/obj_hashtable.h"
 #include "util/ref_util.h"
 #include "ast/fpa_decl_plugin.h"
@@ -55,6 +56,20 @@ protected:
     uf2bvuf_t                  m_uf2bvuf;
     special_t                  m_min_max_ufs;
 
+    // Templates for the expensive binary circuits (add, mul, div): each
+    // distinct (operation, rounding mode) pair is expanded once over fresh
+    // operand components and later occurrences are instantiated by
+    // substituting the actual components for the holes.
+    struct op_template {
+        expr_ref        m_result;
+        expr_ref_vector m_holes; // sgn/exp/sig of both operands
+        op_template(ast_manager & m) : m_result(m), m_holes(m) {}
+    };
+    typedef void (fpa2bv_converter::*bin_op)(sort *, expr_ref &, expr_ref &, expr_ref &, expr_ref &);
+    obj_pair_map<func_decl, expr, op_template*> m_op_templates;
+
+    bool mk_binary_templated(bin_op op, func_decl * f, expr * rm, expr * x, expr * y, expr_ref & result);
+
     friend class fpa2bv_model_converter;
     friend class bv2fpa_converter;
 
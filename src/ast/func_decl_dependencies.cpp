@@ -24,19 +24,21 @@ struct collect_dependencies_proc {
     ast_manager &     m_manager;
     func_decl_set &   m_set;
     bool              m_ng_only; // collect only declarations in non ground expressions
-   
-    collect_dependencies_proc(ast_manager & m, func_decl_set & s, bool ng_only):
+    bool              m_consts;  // collect constants as well
+
+    collect_dependencies_proc(ast_manager & m, func_decl_set & s, bool ng_only, bool consts = false):
         m_manager(m),
         m_set(s),
-        m_ng_only(ng_only) {}
+        m_ng_only(ng_only),
+        m_consts(consts) {}
 
     void operator()(var * n) {}
-    
+
     void operator()(quantifier * n) {}
-    
-    void operator()(app * n) {        
+
+    void operator()(app * n) {
         // We do not need to track dependencies on constants ...
-        if (n->get_num_args()==0) 
+        if (!m_consts && n->get_num_args()==0)
             return;
         if (m_ng_only && is_ground(n))
             return;
@@ -53,6 +55,11 @@ void collect_func_decls(ast_manager & m, expr * n, func_decl_set & r, bool ng_on
     for_each_expr(proc, n);
 }
 
+void collect_uninterp_decls(ast_manager & m, expr * n, func_decl_set & r) {
+    collect_dependencies_proc proc(m, r, false, true);
+    for_each_expr(proc, n);
+}
+
 void func_decl_dependencies::reset() {
     dependency_graph::iterator it  = m_deps.begin();
     dependency_graph::iterator end = m_deps.end();
@@ -29,6 +29,11 @@ typedef obj_hashtable<func_decl> func_decl_set;
 */
 void collect_func_decls(ast_manager & m, expr * n, func_decl_set & r, bool ng_only = false);
 
+/**
+   \brief Collect all uninterpreted declarations, including constants, occurring in \c n.
+*/
+void collect_uninterp_decls(ast_manager & m, expr * n, func_decl_set & r);
+
 /**
    \brief Auxiliary data-structure used for tracking dependencies between function declarations.
 
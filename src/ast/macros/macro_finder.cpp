@@ -18,6 +18,7 @@ Revision History:
 --*/
 
 #include "ast/macros/macro_finder.h"
+#include "ast/array_decl_plugin.h"
 #include "ast/occurs.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -272,22 +273,70 @@ macro_finder::macro_finder(ast_manager & m, macro_manager & mm):
 macro_finder::~macro_finder() {
 }
 
-bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps,  expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps) {
+/**
+   \brief Check whether n mentions a symbol in decls. Used to skip formulas
+   that cannot be affected by macros discovered in the previous pass.
+*/
+bool macro_finder::mentions(expr * n, func_decl_set const & decls) const {
+    array_util autil(m);
+    ptr_vector<expr> todo;
+    expr_mark visited;
+    todo.push_back(n);
+    while (!todo.empty()) {
+        expr * cur = todo.back();
+        todo.pop_back();
+        if (visited.is_marked(cur))
+            continue;
+        visited.mark(cur, true);
+        if (is_quantifier(cur)) {
+            todo.push_back(to_quantifier(cur)->get_expr());
+        }
+        else if (is_app(cur)) {
+            app * a = to_app(cur);
+            func_decl * d = a->get_decl(), * d2 = nullptr;
+            if (decls.contains(d))
+                return true;
+            if ((autil.is_as_array(d, d2) || autil.is_map(d, d2)) && decls.contains(d2))
+                return true;
+            for (expr * arg : *a)
+                todo.push_back(arg);
+        }
+    }
+    return false;
+}
+
+bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector const& prs, expr_dependency_ref_vector const& deps,  expr_ref_vector & new_exprs, proof_ref_vector & new_prs, expr_dependency_ref_vector & new_deps, func_decl_set const * changed) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
     bool found_new_macro = false;
     unsigned num = exprs.size();
     bool deps_valid = deps.size() == exprs.size();
     SASSERT(deps_valid || deps.empty());
+    bool_vector rescan;
+    rescan.swap(m_rescan);
     for (unsigned i = 0; i < num; i++) {
         expr * n       = exprs[i];
         proof * pr     = m.proofs_enabled() ? prs[i] : nullptr;
         expr_dependency * dep = deps.get(i, nullptr);
+        // Only formulas produced by the last pass or mentioning a symbol
+        // whose macro status changed can yield anything new.
+        if (changed && !(i < rescan.size() && rescan[i]) &&
+            (changed->empty() || !mentions(n, *changed))) {
+            new_exprs.push_back(n);
+            if (m.proofs_enabled())
+                new_prs.push_back(pr);
+            if (deps_valid)
+                new_deps.push_back(dep);
+            m_rescan.push_back(false);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
         m_macro_manager.expand_macros(n, pr, dep, new_n, new_pr, new_dep);
         app_ref head(m), t(m);
+        unsigned old_sz = new_exprs.size();
+        bool fresh = false;
         if (is_macro(new_n, head, def) && m_macro_manager.insert(head->get_decl(), to_quantifier(new_n.get()), new_pr, new_dep)) {
             TRACE("macro_finder", tout << "found new macro: " << head->get_decl()->get_name() << "\n" << new_n << "\n";);
             found_new_macro = true;
@@ -295,11 +344,13 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
         else if (is_arith_macro(new_n, new_pr, deps_valid, new_dep, new_exprs, new_prs, new_deps)) {
             TRACE("macro_finder", tout << "found new arith macro:\n" << new_n << "\n";);
             found_new_macro = true;
+            fresh = true;
         }
         else if (m_util.is_pseudo_predicate_macro(new_n, head, t, def)) {
             TRACE("macro_finder", tout << "found new pseudo macro:\n" << head->get_decl()->get_name() << "\n" << t << "\n" << def << "\n";);
             pseudo_predicate_macro2macro(m, head, t, def, to_quantifier(new_n), new_pr, deps_valid, new_dep, new_exprs, new_prs, new_deps);
             found_new_macro = true;
+            fresh = true;
         }
         else {
             new_exprs.push_back(new_n);
@@ -308,6 +359,8 @@ bool macro_finder::expand_macros(expr_ref_vector const& exprs, proof_ref_vector
             if (deps_valid)
                 new_deps.push_back(new_dep);
         }
+        for (unsigned j = old_sz; j < new_exprs.size(); j++)
+            m_rescan.push_back(fresh);
         SASSERT(exprs.size() != deps.size() || new_exprs.size() == new_deps.size());
         // SASSERT(!m.proofs_enabled() || new_exprs.size() == new_prs.size());
 
@@ -321,8 +374,14 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
     proof_ref_vector  _new_prs(m);
     expr_dependency_ref_vector _new_deps(m);
     unsigned num = exprs.size();
+    unsigned next_macro_idx = m_macro_manager.get_num_macros();
     if (expand_macros(exprs, prs, deps, _new_exprs, _new_prs, _new_deps)) {
         for (unsigned i = 0; i < num; ++i) {
+            func_decl_set changed;
+            unsigned num_macros = m_macro_manager.get_num_macros();
+            for (unsigned j = next_macro_idx; j < num_macros; j++)
+                changed.insert(m_macro_manager.get_macro_func_decl(j));
+            next_macro_idx = num_macros;
             expr_ref_vector  old_exprs(m);
             proof_ref_vector old_prs(m);
             expr_dependency_ref_vector old_deps(m);
@@ -333,7 +392,7 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
             SASSERT(_new_prs.empty());
             SASSERT(_new_deps.empty());
             if (!expand_macros(old_exprs, old_prs, old_deps,
-                               _new_exprs, _new_prs, _new_deps))
+                               _new_exprs, _new_prs, _new_deps, &changed))
                 break;
         }
     }
@@ -344,18 +403,30 @@ void macro_finder::operator()(expr_ref_vector const& exprs, proof_ref_vector con
 
 
 
-bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vector<justified_expr>& new_fmls) {
+bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vector<justified_expr>& new_fmls, func_decl_set const * changed) {
     TRACE("macro_finder", tout << "starting expand_macros:\n";
           m_macro_manager.display(tout););
     bool found_new_macro = false;
+    bool_vector rescan;
+    rescan.swap(m_rescan);
     for (unsigned i = 0; i < num; i++) {
         expr * n       = fmls[i].get_fml();
         proof * pr     = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
+        // Only formulas produced by the last pass or mentioning a symbol
+        // whose macro status changed can yield anything new.
+        if (changed && !(i < rescan.size() && rescan[i]) &&
+            (changed->empty() || !mentions(n, *changed))) {
+            new_fmls.push_back(fmls[i]);
+            m_rescan.push_back(false);
+            continue;
+        }
         expr_ref new_n(m), def(m);
         proof_ref new_pr(m);
         expr_dependency_ref new_dep(m);
         m_macro_manager.expand_macros(n, pr, nullptr, new_n, new_pr, new_dep);
         app_ref head(m), t(m);
+        unsigned old_sz = new_fmls.size();
+        bool fresh = false;
         if (is_macro(new_n, head, def) && m_macro_manager.insert(head->get_decl(), to_quantifier(new_n.get()), new_pr)) {
             TRACE("macro_finder", tout << "found new macro: " << head->get_decl()->get_name() << "\n" << new_n << "\n";);
             found_new_macro = true;
@@ -363,15 +434,19 @@ bool macro_finder::expand_macros(unsigned num, justified_expr const * fmls, vect
         else if (is_arith_macro(new_n, new_pr, new_fmls)) {
             TRACE("macro_finder", tout << "found new arith macro:\n" << new_n << "\n";);
             found_new_macro = true;
+            fresh = true;
         }
-        else if (m_util.is_pseudo_predicate_macro(new_n, head, t, def)) { 
+        else if (m_util.is_pseudo_predicate_macro(new_n, head, t, def)) {
             TRACE("macro_finder", tout << "found new pseudo macro:\n" << head << "\n" << t << "\n" << def << "\n";);
             pseudo_predicate_macro2macro(m, head, t, def, to_quantifier(new_n), new_pr, new_fmls);
             found_new_macro = true;
+            fresh = true;
         }
         else {
             new_fmls.push_back(justified_expr(m, new_n, new_pr));
         }
+        for (unsigned j = old_sz; j < new_fmls.size(); j++)
+            m_rescan.push_back(fresh);
     }
     return found_new_macro;
 }
@@ -389,12 +464,18 @@ void macro_finder::operator()(unsigned n, justified_expr const* fmls, vector<jus
     m_macro_manager.unsafe_macros().reset();
     TRACE("macro_finder", tout << "processing macros...\n";);
     vector<justified_expr> _new_fmls;
+    unsigned next_macro_idx = m_macro_manager.get_num_macros();
     if (expand_macros(n, fmls, _new_fmls)) {
         while (true) {
+            func_decl_set changed;
+            unsigned num_macros = m_macro_manager.get_num_macros();
+            for (unsigned j = next_macro_idx; j < num_macros; j++)
+                changed.insert(m_macro_manager.get_macro_func_decl(j));
+            next_macro_idx = num_macros;
             vector<justified_expr> old_fmls;
             _new_fmls.swap(old_fmls);
             SASSERT(_new_fmls.empty());
-            if (!expand_macros(old_fmls.size(), old_fmls.data(), _new_fmls))
+            if (!expand_macros(old_fmls.size(), old_fmls.data(), _new_fmls, &changed))
                 break;
         }
     }
@@ -41,9 +41,6 @@ macro_manager::macro_manager(ast_manager & m):
     m_util.set_forbidden_set(&m_forbidden_set);
 }
 
-macro_manager::~macro_manager() {
-}
-
 void macro_manager::push_scope() {
     m_scopes.push_back(scope());
     scope & s              = m_scopes.back();
@@ -73,6 +70,8 @@ void macro_manager::restore_decls(unsigned old_sz) {
     if (m.proofs_enabled())
         m_macro_prs.shrink(old_sz);
     m_macro_deps.shrink(old_sz);
+    if (sz != old_sz)
+        m_expander = nullptr;
 }
 
 void macro_manager::restore_forbidden(unsigned old_sz) {
@@ -94,6 +93,8 @@ void macro_manager::reset() {
     m_forbidden_set.reset();
     m_forbidden.reset();
     m_deps.reset();
+    m_expander = nullptr;
+    m_has_macro_deps = false;
 }
 
 void macro_manager::copy_to(macro_manager& dst) {
@@ -147,6 +148,9 @@ bool macro_manager::insert(func_decl * f, quantifier * q, proof * pr, expr_depen
     }
     m_macro_deps.push_back(dep);
     m_decl2macro_dep.insert(f, dep);
+    if (dep)
+        m_has_macro_deps = true;
+    m_expander = nullptr;
 
     TRACE("macro_insert", tout << "A macro was successfully created for: " << f->get_name() << "\n";);
 
@@ -354,13 +358,50 @@ struct macro_manager::macro_expander_rw : public rewriter_tpl<macro_manager::mac
 
     macro_expander_rw(ast_manager& m, macro_manager& mm):
         rewriter_tpl<macro_manager::macro_expander_cfg>(m, m.proofs_enabled(), m_cfg),
-        m_cfg(m, mm) 
+        m_cfg(m, mm)
     {}
 };
 
+macro_manager::~macro_manager() {
+}
+
+/**
+   \brief Quick check whether n contains an occurrence of a macro head symbol.
+   Most assertions in large benchmarks do not, and the check lets expand_macros
+   skip the rewriter for them. Patterns are ignored, matching the expander,
+   which does not rewrite them.
+*/
+bool macro_manager::uses_macros(expr * n) const {
+    array_util autil(m);
+    ptr_vector<expr> todo;
+    expr_mark visited;
+    todo.push_back(n);
+    while (!todo.empty()) {
+        expr * cur = todo.back();
+        todo.pop_back();
+        if (visited.is_marked(cur))
+            continue;
+        visited.mark(cur, true);
+        if (is_quantifier(cur)) {
+            todo.push_back(to_quantifier(cur)->get_expr());
+        }
+        else if (is_app(cur)) {
+            app * a = to_app(cur);
+            func_decl * d = a->get_decl(), * d2 = nullptr;
+            if (m_decl2macro.contains(d))
+                return true;
+            // as-array and map occurrences matter for unsafe macro tracking
+            if ((autil.is_as_array(d, d2) || autil.is_map(d, d2)) && m_decl2macro.contains(d2))
+                return true;
+            for (expr * arg : *a)
+                todo.push_back(arg);
+        }
+    }
+    return false;
+}
 
 void macro_manager::expand_macros(expr * n, proof * pr, expr_dependency * dep, expr_ref & r, proof_ref & new_pr, expr_dependency_ref & new_dep) {
-    if (has_macros()) {
+    if (has_macros() && uses_macros(n)) {
         // Expand macros with "real" proof production support (NO rewrite*)
         expr_ref old_n(m);
         proof_ref old_pr(m);
@@ -369,14 +410,35 @@ void macro_manager::expand_macros(expr * n, proof * pr, expr_dependency * dep, e
         old_pr = pr;
         old_dep = dep;
         bool change = false;
+        // The expander is kept between calls so that its rewriter cache
+        // amortizes repeated expansion. Proofs are cached alongside results,
+        // but macro dependencies accumulate in the configuration and must
+        // start fresh for each formula, so reuse is off in those modes.
+        bool reuse = !m.proofs_enabled() && !m_has_macro_deps;
+        scoped_ptr<macro_expander_rw> local;
         for (;;) {
-            macro_expander_rw proc(m, *this);
+            macro_expander_rw * proc;
+            if (reuse) {
+                if (!m_expander)
+                    m_expander = alloc(macro_expander_rw, m, *this);
+                proc = m_expander.get();
+            }
+            else {
+                local = alloc(macro_expander_rw, m, *this);
+                proc = local.get();
+            }
+            unsigned unsafe_sz = m_unsafe_macros.size();
             proof_ref n_eq_r_pr(m);
             SASSERT(!old_pr || m.get_fact(old_pr) == old_n);
             TRACE("macro_manager_bug", tout << "expand_macros:\n" << mk_pp(n, m) << "\n";);
-            proc(old_n, r, n_eq_r_pr);
+            (*proc)(old_n, r, n_eq_r_pr);
             new_pr = m.mk_modus_ponens(old_pr, n_eq_r_pr);
-            new_dep = m.mk_join(old_dep, proc.m_cfg.m_used_macro_dependencies); 
+            new_dep = m.mk_join(old_dep, proc->m_cfg.m_used_macro_dependencies);
+            // unsafe macros are registered per top-level run; results obtained
+            // while registering one must not be replayed from the cache, or a
+            // later run would miss the registration.
+            if (m_unsafe_macros.size() > unsafe_sz)
+                m_expander = nullptr;
             if (r.get() == old_n.get())
                 break;
             old_n  = r;
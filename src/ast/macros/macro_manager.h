@@ -48,6 +48,7 @@ class macro_manager {
     obj_hashtable<func_decl>         m_forbidden_set;
     func_decl_ref_vector             m_forbidden;
     obj_hashtable<func_decl>         m_unsafe_macros;
+    bool                             m_has_macro_deps = false;
     struct scope {
         unsigned m_decls_lim;
         unsigned m_forbidden_lim;
@@ -58,10 +59,16 @@ class macro_manager {
 
     void restore_decls(unsigned old_sz);
     void restore_forbidden(unsigned old_sz);
-    
+
     struct macro_expander_cfg;
     struct macro_expander_rw;
 
+    // expander kept between expand_macros calls so that the rewriter cache
+    // amortizes repeated expansion; invalidated whenever the macro set changes.
+    scoped_ptr<macro_expander_rw>    m_expander;
+
+    bool uses_macros(expr * n) const;
+
 public:
     macro_manager(ast_manager & m);
     ~macro_manager();
@@ -357,8 +357,12 @@ void quasi_macros::apply_macros(expr_ref_vector & exprs, proof_ref_vector & prs,
         expr_dependency_ref dep(m);
         proof * p = m.proofs_enabled() ? prs.get(i) : nullptr;
         m_macro_manager.expand_macros(exprs.get(i), p, deps.get(i), r, pr, dep);
-        m_rewriter(r, rr, prr);
-        if (pr) pr = m.mk_modus_ponens(pr, prr);
+        if (r.get() != exprs.get(i)) {
+            m_rewriter(r, rr, prr);
+            if (pr) pr = m.mk_modus_ponens(pr, prr);
+        }
+        else
+            rr = r;
         exprs[i] = rr;
         prs[i] = pr;
         deps[i] = dep;
@@ -383,8 +387,12 @@ void quasi_macros::apply_macros(unsigned n, justified_expr const* fmls, vector<j
         proof * p = m.proofs_enabled() ? fmls[i].get_proof() : nullptr;
         expr_dependency_ref dep(m);
         m_macro_manager.expand_macros(fmls[i].get_fml(), p, nullptr, r, pr, dep);
-        m_rewriter(r, rr, prr);
-        if (pr) pr = m.mk_modus_ponens(pr, prr);
+        if (r.get() != fmls[i].get_fml()) {
+            m_rewriter(r, rr, prr);
+            if (pr) pr = m.mk_modus_ponens(pr, prr);
+        }
+        else
+            rr = r;
         new_fmls.push_back(justified_expr(m, rr, pr));
     }
 }
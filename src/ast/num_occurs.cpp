@@ -24,7 +24,9 @@ void num_occurs::process(expr * t, expr_fast_mark1 & visited) {
     
 #define VISIT(ARG) {                                                                                    \
         if (!m_ignore_ref_count1 || ARG->get_ref_count() > 1) {                                         \
-            m_num_occurs.insert_if_not_there(ARG, 0)++; \
+            unsigned id = ARG->get_id();                                                                \
+            m_num_occurs.reserve(id + 1, 0);                                                            \
+            m_num_occurs[id]++;                                                                         \
         }                                                                                               \
         if (!visited.is_marked(ARG)) {                                                                  \
             visited.mark(ARG, true);                                                                    \
@@ -59,12 +61,6 @@ void num_occurs::process(expr * t, expr_fast_mark1 & visited) {
     }
 }
 
-void num_occurs::validate() {
-    for (auto & kv : m_num_occurs) {
-        VERIFY(0 < kv.m_key->get_ref_count());
-    }
-}
-
 void num_occurs::operator()(expr * t) {
     expr_fast_mark1   visited;
     process(t, visited);
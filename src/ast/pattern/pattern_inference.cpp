@@ -21,12 +21,14 @@ Revision History:
 #include "ast/pattern/pattern_inference.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_pp.h"
+#include "ast/ast_smt_pp.h"
 #include "ast/ast_util.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/normal_forms/pull_quant.h"
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
 #include "ast/rewriter/rewriter_def.h"
+#include<fstream>
 
 void smaller_pattern::save(expr * p1, expr * p2) {
     expr_pair e(p1, p2);
@@ -113,11 +115,50 @@ pattern_inference_cfg::pattern_inference_cfg(ast_manager & m, pattern_inference_
     m_pattern_weight_lt(m_candidates_info),
     m_collect(m, *this),
     m_contains_subpattern(*this),
-    m_database(m) {
+    m_database(m),
+    m_inferred(m) {
     if (params.m_pi_arith == AP_NO)
         register_forbidden_family(m_afid);
 }
 
+pattern_inference_cfg::~pattern_inference_cfg() {
+    dump_inferred();
+}
+
+void pattern_inference_cfg::init_database() {
+    if (m_database_initialized)
+        return;
+    m_database_initialized = true;
+    std::string spec;
+    if (m_params.m_pi_database_file.is_non_empty_string()) {
+        std::ifstream in(m_params.m_pi_database_file.str());
+        if (!in)
+            warning_msg("could not open pattern database file '%s'", m_params.m_pi_database_file.bare_str());
+        else
+            spec.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    if (m_params.m_pi_use_database)
+        spec += g_pattern_database;
+    if (!spec.empty())
+        m_database.initialize(spec.c_str());
+}
+
+void pattern_inference_cfg::dump_inferred() {
+    if (m_inferred.empty())
+        return;
+    std::ofstream out(m_params.m_pi_dump_inferred.str());
+    if (!out) {
+        warning_msg("could not open file '%s' for dumping inferred patterns", m_params.m_pi_dump_inferred.bare_str());
+        return;
+    }
+    ast_smt_pp pp(m);
+    pp.set_benchmark_name("inferred_patterns");
+    pp.set_status("unknown");
+    for (unsigned i = 0; i + 1 < m_inferred.size(); i++)
+        pp.add_assumption(m_inferred.get(i));
+    pp.display_smt2(out, m_inferred.back());
+}
+
 void pattern_inference_cfg::collect::operator()(expr * n, unsigned num_bindings) {
     SASSERT(m_info.empty());
     SASSERT(m_todo.empty());
@@ -588,9 +629,9 @@ bool pattern_inference_cfg::reduce_quantifier(
 
     int weight = q->get_weight();
 
-    if (m_params.m_pi_use_database) {
+    if (m_params.m_pi_use_database || m_params.m_pi_database_file.is_non_empty_string()) {
         app_ref_vector new_patterns(m);
-        m_database.initialize(g_pattern_database);
+        init_database();
         unsigned new_weight;
         if (m_database.match_quantifier(q, new_patterns, new_weight)) {
             DEBUG_CODE(for (unsigned i = 0; i < new_patterns.size(); i++) { SASSERT(is_well_sorted(m, new_patterns.get(i))); });
@@ -715,6 +756,9 @@ bool pattern_inference_cfg::reduce_quantifier(
 
     result = new_q;
 
+    if (m_params.m_pi_dump_inferred.is_non_empty_string() && new_q->get_num_patterns() > 0)
+        m_inferred.push_back(new_q);
+
     IF_VERBOSE(10,
         verbose_stream() << "(smt.inferred-patterns :qid " << q->get_qid() << "\n";
         for (unsigned i = 0; i < new_patterns.size(); i++)
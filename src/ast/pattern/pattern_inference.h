@@ -187,6 +187,22 @@ class pattern_inference_cfg :  public default_rewriter_cfg {
 
     ptr_vector<pre_pattern>      m_pre_patterns;
     expr_pattern_match           m_database;
+    bool                         m_database_initialized = false;
+    expr_ref_vector              m_inferred; // quantifiers annotated by inference, collected when pi.dump_inferred is set
+
+    /**
+       \brief Compile the pattern databases on demand: the built-in database
+       (when pi.use_database is set) and the user supplied database file
+       (when pi.database_file is set).
+    */
+    void init_database();
+
+    /**
+       \brief Write the quantifiers annotated by this round of inference as a
+       self-contained SMT2 benchmark that can be loaded back through
+       pi.database_file.
+    */
+    void dump_inferred();
 
     void candidates2unary_patterns(ptr_vector<app> const & candidate_patterns,
                                    ptr_vector<app> & remaining_candidate_patterns,
@@ -213,7 +229,8 @@ class pattern_inference_cfg :  public default_rewriter_cfg {
     
 public:
     pattern_inference_cfg(ast_manager & m, pattern_inference_params const & params);
-    
+    ~pattern_inference_cfg();
+
     void register_forbidden_family(family_id fid) {
         SASSERT(fid != m_bfid);
         m_forbidden.push_back(fid);
@@ -30,38 +30,28 @@ Revision History:
 #include "ast/fpa_decl_plugin.h"
 #include "ast/special_relations_decl_plugin.h"
 
-void reg_decl_plugins(ast_manager & m) {
-    if (!m.get_plugin(m.mk_family_id(symbol("arith")))) {
-        m.register_plugin(symbol("arith"), alloc(arith_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("bv")))) {
-        m.register_plugin(symbol("bv"), alloc(bv_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("array")))) {
-        m.register_plugin(symbol("array"), alloc(array_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("datatype")))) {
-        m.register_plugin(symbol("datatype"), alloc(datatype_decl_plugin));    
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("recfun")))) {
-        m.register_plugin(symbol("recfun"), alloc(recfun::decl::plugin));    
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("datalog_relation")))) {
-        m.register_plugin(symbol("datalog_relation"), alloc(datalog::dl_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("char")))) {
-        m.register_plugin(symbol("char"), alloc(char_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("seq")))) {
-        m.register_plugin(symbol("seq"), alloc(seq_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("fpa")))) {
-        m.register_plugin(symbol("fpa"), alloc(fpa_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("pb")))) {
-        m.register_plugin(symbol("pb"), alloc(pb_decl_plugin));
-    }
-    if (!m.get_plugin(m.mk_family_id(symbol("specrels")))) {
-        m.register_plugin(symbol("specrels"), alloc(special_relations_decl_plugin));
+template<typename PLUGIN>
+static void reg_plugin(ast_manager & m, char const * name) {
+    symbol s(name);
+    family_id fid = m.mk_family_id(s);
+    if (!m.has_lazy_plugin(fid) && !m.get_plugin(fid)) {
+        m.register_plugin_factory(s, []() -> decl_plugin * { return alloc(PLUGIN); });
     }
 }
+
+void reg_decl_plugins(ast_manager & m) {
+    // Plugins are only instantiated when their family is used for the first
+    // time; managers that stick to a few theories do not pay for building
+    // the declaration tables of the others.
+    reg_plugin<arith_decl_plugin>(m, "arith");
+    reg_plugin<bv_decl_plugin>(m, "bv");
+    reg_plugin<array_decl_plugin>(m, "array");
+    reg_plugin<datatype_decl_plugin>(m, "datatype");
+    reg_plugin<recfun::decl::plugin>(m, "recfun");
+    reg_plugin<datalog::dl_decl_plugin>(m, "datalog_relation");
+    reg_plugin<char_decl_plugin>(m, "char");
+    reg_plugin<seq_decl_plugin>(m, "seq");
+    reg_plugin<fpa_decl_plugin>(m, "fpa");
+    reg_plugin<pb_decl_plugin>(m, "pb");
+    reg_plugin<special_relations_decl_plugin>(m, "specrels");
+}
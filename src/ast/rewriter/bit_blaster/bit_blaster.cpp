@@ -126,5 +126,61 @@ template class bit_blaster_tpl<bit_blaster_cfg>;
 bit_blaster::bit_blaster(ast_manager & m, bit_blaster_params const & params):
     bit_blaster_tpl<bit_blaster_cfg>(bit_blaster_cfg(m_util, params, m_rw)),
     m_util(m),
-    m_rw(m) {
+    m_rw(m),
+    m_cache_pinned(m) {
+}
+
+bit_blaster::~bit_blaster() {
+    reset_cache();
+}
+
+void bit_blaster::reset_cache() {
+    for (auto & kv : m_adder_cache)
+        dealloc(kv.m_value);
+    m_adder_cache.reset();
+    for (auto & kv : m_multiplier_cache)
+        dealloc(kv.m_value);
+    m_multiplier_cache.reset();
+    m_cache_pinned.reset();
+}
+
+bool bit_blaster::find_cached(encoding_cache const & cache, ptr_vector<expr> const & key, expr_ref_vector & out_bits) {
+    expr_ref_vector * bits = nullptr;
+    if (!cache.find(key, bits))
+        return false;
+    out_bits.append(*bits);
+    return true;
+}
+
+void bit_blaster::insert_cached(encoding_cache & cache, ptr_vector<expr> const & key, unsigned old_sz, expr_ref_vector const & out_bits) {
+    if (cache.size() >= max_cache_size)
+        reset_cache();
+    expr_ref_vector * bits = alloc(expr_ref_vector, m());
+    for (unsigned i = old_sz; i < out_bits.size(); i++)
+        bits->push_back(out_bits.get(i));
+    for (expr * e : key)
+        m_cache_pinned.push_back(e);
+    cache.insert(key, bits);
+}
+
+void bit_blaster::mk_adder(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
+    ptr_vector<expr> key;
+    key.append(sz, a_bits);
+    key.append(sz, b_bits);
+    if (find_cached(m_adder_cache, key, out_bits))
+        return;
+    unsigned old_sz = out_bits.size();
+    bit_blaster_tpl<bit_blaster_cfg>::mk_adder(sz, a_bits, b_bits, out_bits);
+    insert_cached(m_adder_cache, key, old_sz, out_bits);
+}
+
+void bit_blaster::mk_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits) {
+    ptr_vector<expr> key;
+    key.append(sz, a_bits);
+    key.append(sz, b_bits);
+    out_bits.reset();
+    if (find_cached(m_multiplier_cache, key, out_bits))
+        return;
+    bit_blaster_tpl<bit_blaster_cfg>::mk_multiplier(sz, a_bits, b_bits, out_bits);
+    insert_cached(m_multiplier_cache, key, 0, out_bits);
 }
@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "util/rational.h"
+#include "util/map.h"
 #include "ast/bv_decl_plugin.h"
 #include "params/bit_blaster_params.h"
 #include "ast/rewriter/bool_rewriter.h"
@@ -56,10 +57,40 @@ public:
 class bit_blaster : public bit_blaster_tpl<bit_blaster_cfg> {
     bv_util                 m_util;
     bool_rewriter           m_rw;
+
+    // Scope-independent memo for the expensive circuit encodings. The
+    // argument bits are hash-consed, so structurally identical adders and
+    // multipliers have identical keys no matter when they are blasted. The
+    // table references keys and encoded bits and is not undone on
+    // backtracking: re-internalizing a multiplier after a pop is a lookup.
+    struct key_hash {
+        unsigned operator()(ptr_vector<expr> const & k) const {
+            return string_hash(reinterpret_cast<char const*>(k.data()),
+                               static_cast<unsigned>(k.size() * sizeof(expr*)), 11);
+        }
+    };
+    struct key_eq {
+        bool operator()(ptr_vector<expr> const & k1, ptr_vector<expr> const & k2) const {
+            return k1 == k2;
+        }
+    };
+    typedef map<ptr_vector<expr>, expr_ref_vector*, key_hash, key_eq> encoding_cache;
+    static const unsigned   max_cache_size = 4096;
+    encoding_cache          m_adder_cache;
+    encoding_cache          m_multiplier_cache;
+    expr_ref_vector         m_cache_pinned;
+
+    bool find_cached(encoding_cache const & cache, ptr_vector<expr> const & key, expr_ref_vector & out_bits);
+    void insert_cached(encoding_cache & cache, ptr_vector<expr> const & key, unsigned old_sz, expr_ref_vector const & out_bits);
 public:
     bit_blaster(ast_manager & m, bit_blaster_params const & params);
+    ~bit_blaster();
     bit_blaster_params const & get_params() const { return this->m_params; }
     void set_flat_and_or(bool f) { m_rw.set_flat_and_or(f); }
+
+    void mk_adder(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
+    void mk_multiplier(unsigned sz, expr * const * a_bits, expr * const * b_bits, expr_ref_vector & out_bits);
+    void reset_cache();
 };
 
 
@@ -20,7 +20,7 @@ Revision History:
 #include "ast/rewriter/rewriter_def.h"
 
 bool cached_var_subst::key_eq_proc::operator()(cached_var_subst::key * k1, cached_var_subst::key * k2) const {
-    if (k1->m_qa != k2->m_qa)
+    if (k1->m_body != k2->m_body)
         return false;
     if (k1->m_num_bindings != k2->m_num_bindings)
         return false;
@@ -44,12 +44,12 @@ void cached_var_subst::reset() {
     m_key = nullptr;
 }
 
-expr** cached_var_subst::operator()(quantifier* qa, unsigned num_bindings) {
+expr** cached_var_subst::operator()(expr* body, unsigned num_bindings) {
     m_new_keys.reserve(num_bindings+1, 0);
     m_key = m_new_keys[num_bindings];
     if (m_key == nullptr)
         m_key = static_cast<key*>(m_region.allocate(sizeof(key) + sizeof(expr*)*num_bindings));
-    m_key->m_qa           = qa;
+    m_key->m_body         = body;
     m_key->m_num_bindings = num_bindings;
     return m_key->m_bindings;
 }
@@ -75,7 +75,7 @@ expr_ref cached_var_subst::operator()() {
 
     SASSERT(entry->get_data().m_value == 0);
     try {
-        result = m_proc(m_key->m_qa->get_expr(), m_key->m_num_bindings, m_key->m_bindings);
+        result = m_proc(m_key->m_body, m_key->m_num_bindings, m_key->m_bindings);
     }
     catch (...) {
         // CMW: The var_subst reducer was interrupted and m_instances is
@@ -91,7 +91,7 @@ expr_ref cached_var_subst::operator()() {
     m_new_keys[num_bindings] = nullptr;
 
     // increment reference counters
-    m_refs.push_back(m_key->m_qa);
+    m_refs.push_back(m_key->m_body);
     for (unsigned i = 0; i < m_key->m_num_bindings; i++)
         m_refs.push_back(m_key->m_bindings[i]);
     m_refs.push_back(result);
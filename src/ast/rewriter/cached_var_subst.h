@@ -23,13 +23,13 @@ Revision History:
 
 class cached_var_subst {
     struct key {
-        quantifier * m_qa;
+        expr *       m_body;
         unsigned     m_num_bindings;
         expr *       m_bindings[0];
     };
     struct key_hash_proc {
         unsigned operator()(key * k) const {
-            return string_hash(reinterpret_cast<char const *>(k->m_bindings), sizeof(expr *) * k->m_num_bindings, k->m_qa->get_id());
+            return string_hash(reinterpret_cast<char const *>(k->m_bindings), sizeof(expr *) * k->m_num_bindings, k->m_body->get_id());
         }
     };
     struct key_eq_proc {
@@ -45,7 +45,8 @@ class cached_var_subst {
     key*             m_key { nullptr };
 public:
     cached_var_subst(ast_manager & m);
-    expr** operator()(quantifier * qa, unsigned num_bindings);
+    expr** operator()(expr * body, unsigned num_bindings);
+    expr** operator()(quantifier * qa, unsigned num_bindings) { return operator()(qa->get_expr(), num_bindings); }
     expr_ref operator()();
     void reset();
 };
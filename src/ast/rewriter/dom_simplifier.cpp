@@ -130,6 +130,11 @@ void expr_dominators::extract_tree() {
 }
 
 bool expr_dominators::compile(expr * e) {
+    // Expressions are hash-consed, so an unchanged goal compiles to the same
+    // root. In that case the dominator tree is still valid and the walk over
+    // the goal can be skipped.
+    if (m_root.get() == e && !m_doms.empty())
+        return true;
     reset();
     m_root = e;
     compute_post_order();
@@ -28,6 +28,19 @@ void expr_safe_replace::insert(expr* src, expr* dst) {
     m_src.push_back(src);
     m_dst.push_back(dst);
     m_cache.clear();
+    m_all_repls_ground = l_undef;
+}
+
+bool expr_safe_replace::all_repls_ground() {
+    if (m_all_repls_ground == l_undef) {
+        bool all_ground = true;
+        for (unsigned i = 0, e = m_src.size(); all_ground && i < e; ++i) {
+            all_ground &= is_ground(m_src.get(i));
+            all_ground &= is_ground(m_dst.get(i));
+        }
+        m_all_repls_ground = to_lbool(all_ground);
+    }
+    return m_all_repls_ground == l_true;
 }
 
 void expr_safe_replace::operator()(expr_ref_vector& es) {
@@ -100,13 +113,7 @@ void expr_safe_replace::operator()(expr* e, expr_ref& res) {
             expr_ref_vector pats(m), nopats(m);
 
             // fast-path for when all src/dst rewrite patterns are ground
-            bool all_repls_ground = true;
-            for (unsigned i = 0, e = m_src.size(); all_repls_ground && i < e; ++i) {
-                all_repls_ground &= is_ground(m_src.get(i));
-                all_repls_ground &= is_ground(m_dst.get(i));
-            }
-
-            if (all_repls_ground) {
+            if (all_repls_ground()) {
                 bool has_all_data = true;
                 new_body = m_cache[q->get_expr()];
                 if (!new_body) {
@@ -182,6 +189,7 @@ void expr_safe_replace::reset() {
     m_dst.reset();
     m_refs.finalize();
     m_cache.clear();
+    m_all_repls_ground = l_undef;
 }
 
 void expr_safe_replace::apply_substitution(expr* s, expr* def, expr_ref& t) {
@@ -201,6 +209,7 @@ void expr_safe_replace::pop_scope(unsigned n) {
         m_cache.clear();
         m_src.shrink(old_sz);
         m_dst.shrink(old_sz);
+        m_all_repls_ground = l_undef;
     }
     m_limit.shrink(m_limit.size() - n);
 }
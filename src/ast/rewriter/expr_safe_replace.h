@@ -21,6 +21,7 @@ Revision History:
 
 #pragma once
 
+#include "util/lbool.h"
 #include "ast/ast.h"
 #include <unordered_map>
 
@@ -32,6 +33,9 @@ class expr_safe_replace {
     ptr_vector<expr> m_todo, m_args;
     expr_ref_vector m_refs;
     std::unordered_map<expr*,expr*> m_cache;
+    lbool m_all_repls_ground = l_undef; // cached per substitution set
+
+    bool all_repls_ground();
 
 public:
     expr_safe_replace(ast_manager& m): m(m), m_src(m), m_dst(m), m_refs(m) {}
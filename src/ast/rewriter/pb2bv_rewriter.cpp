@@ -56,6 +56,13 @@ struct pb2bv_rewriter::imp {
         bv_util      bv;
         expr_ref_vector m_trail;
         expr_ref_vector m_args;
+        // Cache of sorted wires per input multiset. Workloads with many
+        // cardinality constraints over overlapping literal sets re-sort the
+        // same literals; the sorted outputs only depend on the input
+        // multiset, so the subnetwork is compiled once and its wires are
+        // shared by all constraints over the same literals. The cache is
+        // reset on pop, when the defining lemmas are retracted.
+        obj_map<expr, ptr_vector<expr>*> m_sorted_cache;
         rational     m_k;
         vector<rational> m_coeffs;
         bool m_keep_cardinality_constraints;
@@ -519,7 +526,7 @@ struct pb2bv_rewriter::imp {
                       tout << "\n";
                       );
                 ptr_vector<expr> out;
-                m_sort.sorting(carry.size(), carry.data(), out);
+                sorting(carry.size(), carry.data(), out);
                 
                 expr_ref gt = mod_ge(out, B, d_i + 1);
                 expr_ref ge = mod_ge(out, B, d_i);
@@ -596,7 +603,7 @@ struct pb2bv_rewriter::imp {
             for (unsigned i = 0, seg_size = 0; i < sz; i += seg_size) {
                 seg_size = segment_size(i);
                 ptr_vector<expr> out;
-                m_sort.sorting(seg_size, args + i, out);
+                sorting(seg_size, args + i, out);
                 out.push_back(m.mk_false());
                 outs.push_back(out);
                 coeffs.push_back(m_coeffs[i]);
@@ -763,6 +770,34 @@ struct pb2bv_rewriter::imp {
             m_min_arity(9)
         {}
 
+        ~card2bv_rewriter() {
+            reset_sorted_cache();
+        }
+
+        void sorting(unsigned n, expr* const* args, ptr_vector<expr>& out) {
+            if (n <= 1) {
+                m_sort.sorting(n, args, out);
+                return;
+            }
+            ptr_vector<expr> norm(n, args);
+            std::sort(norm.begin(), norm.end(), ast_lt_proc());
+            expr_ref key(m.mk_or(norm.size(), norm.data()), m);
+            ptr_vector<expr>* cached = nullptr;
+            if (m_sorted_cache.find(key, cached)) {
+                out.append(*cached);
+                return;
+            }
+            m_sort.sorting(n, args, out);
+            trail(key);
+            m_sorted_cache.insert(key, alloc(ptr_vector<expr>, out));
+        }
+
+        void reset_sorted_cache() {
+            for (auto& kv : m_sorted_cache)
+                dealloc(kv.m_value);
+            m_sorted_cache.reset();
+        }
+
         void set_pb_solver(symbol const& s) { m_pb_solver = s; }
 
         bool mk_app(bool full, func_decl * f, unsigned sz, expr * const* args, expr_ref & result) {
@@ -1100,6 +1135,7 @@ struct pb2bv_rewriter::imp {
             m_fresh.resize(lim);
             m_fresh_lim.resize(new_sz);
         }
+        m_rw.m_cfg.m_r.reset_sorted_cache();
         m_rw.reset();
     }
 
@@ -98,6 +98,23 @@ void rewriter_core::reset_cache() {
     }
 }
 
+act_cache * rewriter_core::detach_cache() {
+    SASSERT(m_frame_stack.empty());
+    SASSERT(m_cache == m_cache_stack[0]);
+    act_cache * r = m_cache_stack[0];
+    m_cache = alloc(cache, m());
+    m_cache_stack[0] = m_cache;
+    return r;
+}
+
+void rewriter_core::attach_cache(act_cache * c) {
+    SASSERT(m_frame_stack.empty());
+    SASSERT(m_cache == m_cache_stack[0]);
+    dealloc(m_cache_stack[0]);
+    m_cache = c;
+    m_cache_stack[0] = c;
+}
+
 // free memory allocated by the rewriter
 void rewriter_core::free_memory() {
     del_cache_stack();
@@ -122,6 +122,16 @@ public:
     ast_manager & m() const { return m_manager; }
     void reset();
     void cleanup();
+    /**
+       \brief Detach the top-level cache, replacing it with a fresh one.
+       Ownership of the result is transferred to the caller.
+       It allows preserving cached results across cleanup().
+    */
+    act_cache * detach_cache();
+    /**
+       \brief Replace the top-level cache with c, taking ownership of it.
+    */
+    void attach_cache(act_cache * c);
     void set_cancel_check(bool f) { m_cancel_check = f; }
 #ifdef _TRACE
     void display_stack(std::ostream & out, unsigned pp_depth);
@@ -19,6 +19,7 @@ Notes:
 #pragma once
 
 #include "ast/rewriter/rewriter.h"
+#include "util/self_profiler.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_pp.h"
@@ -716,6 +717,7 @@ void rewriter_tpl<Config>::update_binding_at(unsigned i, expr* binding) {
 template<typename Config>
 template<bool ProofGen>
 void rewriter_tpl<Config>::main_loop(expr * t, expr_ref & result, proof_ref & result_pr) {
+    scoped_profile_tag _prof(self_profiler::SUB_REWRITE);
     result_pr = nullptr;
     if (!m().inc()) {
         if (m_cancel_check) {
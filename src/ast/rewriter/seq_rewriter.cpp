@@ -246,6 +246,14 @@ eautomaton* re2automaton::mk_product(eautomaton* a1, eautomaton* a2) {
     return m_sa->mk_product(*a1, *a2);
 }
 
+lbool re2automaton::is_product_empty(eautomaton* a1, eautomaton* a2) {
+    return m_sa ? m_sa->is_product_empty(*a1, *a2) : l_undef;
+}
+
+eautomaton* re2automaton::mk_empty_automaton() {
+    return alloc(eautomaton, sm);
+}
+
 eautomaton* re2automaton::operator()(expr* e) { 
     eautomaton* r = re2aut(e); 
     if (r) {        
@@ -844,7 +852,7 @@ br_status seq_rewriter::mk_seq_length(expr* a, expr_ref& result) {
         return BR_DONE;
     }
     if (j != m_es.size() || j != 1) {
-        expr_ref_vector es(m());        
+        expr_ref_buffer es(m());
         for (unsigned i = 0; i < j; ++i) {
             es.push_back(str().mk_length(m_es.get(i)));
         }
@@ -1993,11 +2001,11 @@ br_status seq_rewriter::mk_seq_replace(expr* a, expr* b, expr* c, expr_ref& resu
             return BR_REWRITE_FULL;            
         }
         if (cmp == l_true) {
-            expr_ref_vector es(m());
+            expr_ref_buffer es(m());
             es.append(i, m_lhs.data());
             es.push_back(c);
             es.append(m_lhs.size()-i-m_rhs.size(), m_lhs.data()+i+m_rhs.size());
-            result = str().mk_concat(es, sort_a);
+            result = str().mk_concat(es.size(), es.data(), sort_a);
             return BR_REWRITE_FULL;        
         }
         break;
@@ -2410,12 +2418,12 @@ br_status seq_rewriter::mk_seq_suffix(expr* a, expr* b, expr_ref& result) {
 br_status seq_rewriter::mk_str_units(func_decl* f, expr_ref& result) {
     zstring s;
     VERIFY(str().is_string(f, s));
-    expr_ref_vector es(m());
+    expr_ref_buffer es(m());
     unsigned sz = s.length();
     for (unsigned j = 0; j < sz; ++j) {
         es.push_back(str().mk_unit(str().mk_char(s, j)));
     }        
-    result = str().mk_concat(es, f->get_range());    
+    result = str().mk_concat(es.size(), es.data(), f->get_range());    
     return BR_DONE;
 }
 
@@ -6017,11 +6025,34 @@ void seq_rewriter::op_cache::insert(decl_kind op, expr* a, expr* b, expr* c, exp
 }
 
 void seq_rewriter::op_cache::cleanup() {
-    if (m_table.size() >= m_max_cache_size) {
+    if (m_table.size() < m_max_cache_size) 
+        return;
+    // Derivative and nullability entries are expensive to recompute and are
+    // reused across backtracking and across check-sat calls, so retain them
+    // and evict only the remaining entries.
+    svector<op_entry> kept;
+    for (op_entry const& e : m_table) 
+        if (e.k == OP_RE_DERIVATIVE || e.k == _OP_RE_IS_NULLABLE)
+            kept.push_back(e);
+    if (2 * kept.size() >= m_max_cache_size) {
         m_trail.reset();
         m_table.reset();
         STRACE("seq_regex", tout << "Op cache reset!" << std::endl;);
         STRACE("seq_regex_brief", tout << "(OP CACHE RESET) ";);
         STRACE("seq_verbose", tout << "Derivative op cache reset" << std::endl;);
+        return;
     }
+    expr_ref_vector trail(m_trail.get_manager());
+    for (op_entry const& e : kept) {
+        if (e.a) trail.push_back(e.a);
+        if (e.b) trail.push_back(e.b);
+        if (e.c) trail.push_back(e.c);
+        if (e.r) trail.push_back(e.r);
+    }
+    m_table.reset();
+    m_trail.reset();
+    m_trail.append(trail);
+    for (op_entry const& e : kept) 
+        m_table.insert(e);
+    STRACE("seq_regex", tout << "Op cache evicted down to " << m_table.size() << " derivative entries" << std::endl;);
 }
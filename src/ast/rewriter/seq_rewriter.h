@@ -107,6 +107,8 @@ public:
     void set_solver(expr_solver* solver);
     bool has_solver() const { return m_solver; }
     eautomaton* mk_product(eautomaton *a1, eautomaton *a2);
+    lbool is_product_empty(eautomaton *a1, eautomaton *a2);
+    eautomaton* mk_empty_automaton();
 };
 
 /**
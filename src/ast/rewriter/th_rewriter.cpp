@@ -143,12 +143,44 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         return BR_FAILED;
     }
 
+    typedef br_status (th_rewriter_cfg::*reduce_fn)(func_decl *, unsigned, expr * const *, expr_ref &);
+    // family-id indexed jump table replacing a cascade of fid comparisons.
+    svector<reduce_fn> m_dispatch;
+
+    void set_reduce_fn(family_id fid, reduce_fn fn) {
+        SASSERT(fid != null_family_id);
+        if (static_cast<unsigned>(fid) >= m_dispatch.size())
+            m_dispatch.resize(fid + 1, nullptr);
+        m_dispatch[fid] = fn;
+    }
+
+    void init_dispatch() {
+        set_reduce_fn(m_b_rw.get_fid(),    &th_rewriter_cfg::reduce_bool_app);
+        set_reduce_fn(m_a_rw.get_fid(),    &th_rewriter_cfg::reduce_arith_app);
+        set_reduce_fn(m_bv_rw.get_fid(),   &th_rewriter_cfg::reduce_bv_app);
+        set_reduce_fn(m_ar_rw.get_fid(),   &th_rewriter_cfg::reduce_array_app);
+        set_reduce_fn(m_dt_rw.get_fid(),   &th_rewriter_cfg::reduce_dt_app);
+        set_reduce_fn(m_f_rw.get_fid(),    &th_rewriter_cfg::reduce_fpa_app);
+        set_reduce_fn(m_dl_rw.get_fid(),   &th_rewriter_cfg::reduce_dl_app);
+        set_reduce_fn(m_pb_rw.get_fid(),   &th_rewriter_cfg::reduce_pb_app);
+        set_reduce_fn(m_seq_rw.get_fid(),  &th_rewriter_cfg::reduce_seq_app);
+        set_reduce_fn(m_char_rw.get_fid(), &th_rewriter_cfg::reduce_char_app);
+        set_reduce_fn(m_rec_rw.get_fid(),  &th_rewriter_cfg::reduce_rec_app);
+    }
+
     br_status reduce_app_core(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
         family_id fid = f->get_family_id();
         if (fid == null_family_id)
             return BR_FAILED;
+        reduce_fn fn = static_cast<unsigned>(fid) < m_dispatch.size() ? m_dispatch[fid] : nullptr;
+        if (!fn)
+            return BR_FAILED;
+        return (this->*fn)(f, num, args, result);
+    }
+
+    br_status reduce_bool_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
         br_status st = BR_FAILED;
-        if (fid == m_b_rw.get_fid()) {
+        {
             decl_kind k = f->get_decl_kind();
             if (k == OP_EQ) {
                 // theory dispatch for =
@@ -189,37 +221,57 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
 
             return m_b_rw.mk_app_core(f, num, args, result);
         }
-        if (fid == m_a_rw.get_fid() && OP_LE == f->get_decl_kind() && m_seq_rw.u().has_seq()) {
+    }
+
+    br_status reduce_arith_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        br_status st = BR_FAILED;
+        if (OP_LE == f->get_decl_kind() && m_seq_rw.u().has_seq()) {
             st = m_seq_rw.mk_le_core(args[0], args[1], result);
             if (st != BR_FAILED)
                 return st;
         }
-        if (fid == m_a_rw.get_fid() && OP_GE == f->get_decl_kind() && m_seq_rw.u().has_seq()) {
+        if (OP_GE == f->get_decl_kind() && m_seq_rw.u().has_seq()) {
             st = m_seq_rw.mk_le_core(args[1], args[0], result);
             if (st != BR_FAILED)
                 return st;
         }
-        if (fid == m_a_rw.get_fid())
-            return m_a_rw.mk_app_core(f, num, args, result);
-        if (fid == m_bv_rw.get_fid())
-            return m_bv_rw.mk_app_core(f, num, args, result);
-        if (fid == m_ar_rw.get_fid())
-            return m_ar_rw.mk_app_core(f, num, args, result);
-        if (fid == m_dt_rw.get_fid())
-            return m_dt_rw.mk_app_core(f, num, args, result);
-        if (fid == m_f_rw.get_fid())
-            return m_f_rw.mk_app_core(f, num, args, result);
-        if (fid == m_dl_rw.get_fid())
-            return m_dl_rw.mk_app_core(f, num, args, result);
-        if (fid == m_pb_rw.get_fid())
-            return m_pb_rw.mk_app_core(f, num, args, result);
-        if (fid == m_seq_rw.get_fid())
-            return m_seq_rw.mk_app_core(f, num, args, result);
-        if (fid == m_char_rw.get_fid())
-            return m_char_rw.mk_app_core(f, num, args, result);
-        if (fid == m_rec_rw.get_fid())
-            return m_rec_rw.mk_app_core(f, num, args, result);
-        return BR_FAILED;
+        return m_a_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_bv_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_bv_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_array_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_ar_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_dt_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_dt_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_fpa_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_f_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_dl_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_dl_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_pb_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_pb_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_seq_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_seq_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_char_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_char_rw.mk_app_core(f, num, args, result);
+    }
+
+    br_status reduce_rec_app(func_decl * f, unsigned num, expr * const * args, expr_ref & result) {
+        return m_rec_rw.mk_app_core(f, num, args, result);
     }
 
     // auxiliary function for pull_ite_core
@@ -843,6 +895,7 @@ struct th_rewriter_cfg : public default_rewriter_cfg {
         m_pinned(m),
         m_used_dependencies(m) {
         updt_local_params(p);
+        init_dispatch();
     }
 
     void set_substitution(expr_substitution * s) {
@@ -902,6 +955,8 @@ ast_manager & th_rewriter::m() const {
 void th_rewriter::updt_params(params_ref const & p) {
     m_params.append(p);
     m_imp->cfg().updt_params(m_params);
+    // cached results may not be normal forms under the new parameters
+    set_substitution(m_imp->cfg().m_subst); // reset cache preserving subst
 }
 
 void th_rewriter::get_param_descrs(param_descrs & r) {
@@ -934,8 +989,18 @@ unsigned th_rewriter::get_num_steps() const {
 
 void th_rewriter::cleanup() {
     ast_manager & m = m_imp->m();
+    // Keep the top-level rewrite cache across cleanup, so that repeated
+    // simplification of the same terms in incremental sessions remains cheap.
+    // The cache maintains a bounded number of unused entries, so it does not
+    // defeat the memory-release purpose of cleanup. It cannot be preserved in
+    // proof mode, because the proof cache is rebuilt from scratch, nor when a
+    // substitution is set, because the new imp starts without it.
+    bool persist = !m.proofs_enabled() && m_imp->cfg().m_subst == nullptr;
+    act_cache * c = persist ? m_imp->detach_cache() : nullptr;
     m_imp->~imp();
     new (m_imp) imp(m, m_params);
+    if (c)
+        m_imp->attach_cache(c);
 }
 
 void th_rewriter::reset() {
@@ -945,15 +1010,18 @@ void th_rewriter::reset() {
 
 void th_rewriter::operator()(expr_ref & term) {
     expr_ref result(term.get_manager());
+    ast_manager::scoped_bulk bulk(term.get_manager());
     m_imp->operator()(term, result);
     term = std::move(result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result) {
+    ast_manager::scoped_bulk bulk(m_imp->m());
     m_imp->operator()(t, result);
 }
 
 void th_rewriter::operator()(expr * t, expr_ref & result, proof_ref & result_pr) {
+    ast_manager::scoped_bulk bulk(m_imp->m());
     m_imp->operator()(t, result, result_pr);
 }
 
@@ -24,6 +24,50 @@ Notes:
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
 
+/**
+   \brief Build the substitution of a small body directly, without priming the
+   full rewriter. Only ground bindings are substituted and at most \c budget
+   non-ground nodes are visited; on any other input the function returns false
+   and the caller falls back to the beta reducer. The caller has already ruled
+   out quantifiers in \c n, so no beta redex can arise and substitution is
+   plain reconstruction.
+*/
+bool var_subst::substitute_shallow(expr * n, unsigned num_args, expr * const * args, unsigned & budget, expr_ref & result) {
+    ast_manager& m = m_reducer.m();
+    if (is_ground(n)) {
+        result = n;
+        return true;
+    }
+    if (budget == 0)
+        return false;
+    --budget;
+    if (is_var(n)) {
+        unsigned idx = to_var(n)->get_idx();
+        if (idx >= num_args)
+            return false;
+        expr* b = args[m_std_order ? num_args - idx - 1 : idx];
+        if (!b) {
+            result = n;
+            return true;
+        }
+        if (!is_ground(b))
+            return false;
+        result = b;
+        return true;
+    }
+    if (!is_app(n))
+        return false;
+    app* a = to_app(n);
+    ptr_buffer<expr> new_args;
+    for (expr* arg : *a) {
+        if (!substitute_shallow(arg, num_args, args, budget, result))
+            return false;
+        new_args.push_back(result);
+    }
+    result = m.mk_app(a->get_decl(), new_args.size(), new_args.data());
+    return true;
+}
+
 expr_ref var_subst::operator()(expr * n, unsigned num_args, expr * const * args) {
     ast_manager& m = m_reducer.m();
     expr_ref result(m);
@@ -52,6 +96,14 @@ expr_ref var_subst::operator()(expr * n, unsigned num_args, expr * const * args)
         rep(n, result);
         return result;
     }
+    // Quantifier instantiation calls this functor millions of times with small
+    // ground substitutions; for shallow bodies the direct copier is much
+    // cheaper than resetting and priming the rewriter.
+    unsigned budget = 32;
+    if (substitute_shallow(n, num_args, args, budget, result)) {
+        SASSERT(is_well_sorted(m, result));
+        return result;
+    }
     SASSERT(is_well_sorted(result.m(), n));
     m_reducer.reset();
     if (m_std_order)
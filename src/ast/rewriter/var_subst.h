@@ -34,6 +34,8 @@ typedef var_shifter shift_vars;
 class var_subst {
     beta_reducer   m_reducer;
     bool           m_std_order;
+
+    bool substitute_shallow(expr * n, unsigned num_args, expr * const * args, unsigned & budget, expr_ref & result);
 public:
     var_subst(ast_manager & m, bool std_order = true):m_reducer(m), m_std_order(std_order) {}
     bool std_order() const { return m_std_order; }
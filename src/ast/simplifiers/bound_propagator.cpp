@@ -19,6 +19,8 @@ Revision History:
 --*/
 #include "ast/simplifiers/bound_propagator.h"
 #include<cmath>
+#include<limits>
+#include<algorithm>
 
 // -------------------------------
 // Bound Relaxation configuration
@@ -117,11 +119,13 @@ void bound_propagator::updt_params(params_ref const & p) {
     m_threshold       = p.get_double("bound_threshold", 0.05);
     m_small_interval  = p.get_double("bound_small_interval", 128);
     m_strict2double   = p.get_double("strict2double", 0.00001);
+    m_propagation_budget = p.get_uint("bound_propagation_budget", 1 << 20);
 }
 
 void bound_propagator::get_param_descrs(param_descrs & r) {
     r.insert("bound_max_refinements", CPK_UINT, "(default: 16) maximum number of bound refinements (per round) for unbounded variables.");
     r.insert("bound_threshold", CPK_DOUBLE, "(default: 0.05) bound propagation improvement threshold ratio.");
+    r.insert("bound_propagation_budget", CPK_UINT, "(default: 2^20) maximum number of bound updates processed per propagation round, used to cut off slowly converging fixpoints.");
 }
 
 void bound_propagator::collect_statistics(statistics & st) const {
@@ -455,18 +459,44 @@ void bound_propagator::check_feasibility(var x) {
 
 void bound_propagator::propagate() {
     m_to_reset_ts.reset();
+    if (m_in_queue.size() < 2 * m_lowers.size())
+        m_in_queue.resize(2 * m_lowers.size(), 0);
+    unsigned budget = m_propagation_budget;
 
-    while (m_qhead < m_trail.size()) {
+    while (m_qhead < m_trail.size() || !m_queue.empty()) {
         if (inconsistent())
             break;
-        trail_info & info = m_trail[m_qhead];
-        var x = info.x();
-        bool is_lower = info.is_lower();
+        // Drain the trail into the priority queue. Entries are coalesced
+        // per variable and bound side: processing reads the current bound,
+        // so only the tightest pending bound survives, and the pending
+        // update with the largest improvement is processed first.
+        while (m_qhead < m_trail.size()) {
+            trail_info & info = m_trail[m_qhead];
+            m_qhead++;
+            var x = info.x();
+            bool is_lower = info.is_lower();
+            bound * b = is_lower ? m_lowers[x] : m_uppers[x];
+            SASSERT(b);
+            double score = b->m_prev ? std::fabs(b->m_approx_k - b->m_prev->m_approx_k) : std::numeric_limits<double>::max();
+            unsigned key = (x << 1) + static_cast<unsigned>(is_lower);
+            m_queue.push_back(queue_entry(score, key));
+            std::push_heap(m_queue.begin(), m_queue.end());
+            m_in_queue[key] = 1;
+        }
+        if (m_queue.empty())
+            break;
+        std::pop_heap(m_queue.begin(), m_queue.end());
+        unsigned key = m_queue.back().m_key;
+        m_queue.pop_back();
+        if (!m_in_queue[key])
+            continue; // stale entry, superseded by a tighter pending bound
+        m_in_queue[key] = 0;
+        var x = key >> 1;
+        bool is_lower = (key & 1) != 0;
         bound * b   = is_lower ? m_lowers[x] : m_uppers[x];
         SASSERT(b);
-        unsigned ts = b->m_timestamp; 
+        unsigned ts = b->m_timestamp;
         TRACE("bound_propagator_detail", tout << "propagating x" << x << "\n";);
-        m_qhead++;
         wlist const & wl = m_watches[x];
         for (unsigned c_idx : wl) {
             constraint & c = m_constraints[c_idx];
@@ -476,13 +506,22 @@ void bound_propagator::propagate() {
             if (ts >= c.m_timestamp) {
                 if (c.m_timestamp == 0)
                     m_to_reset_ts.push_back(c_idx);
-                c.m_timestamp = m_timestamp; 
+                c.m_timestamp = m_timestamp;
                 propagate(c_idx);
             }
         }
+        if (budget != UINT_MAX && --budget == 0) {
+            // convergence budget exhausted: the pending bounds are already
+            // asserted, only their downstream tightening is cut short.
+            break;
+        }
     }
 
-    for (unsigned c : m_to_reset_ts) 
+    for (queue_entry const & e : m_queue)
+        m_in_queue[e.m_key] = 0;
+    m_queue.reset();
+
+    for (unsigned c : m_to_reset_ts)
         m_constraints[c].m_timestamp = 0;
 }
 
@@ -133,11 +133,28 @@ protected:
 
     unsigned_vector    m_to_reset_ts; // temp field: ids of the constraints we must reset the field m_timestamp
 
+    /**
+       \brief Entry of the propagation priority queue. Bound updates are
+       processed in decreasing order of improvement magnitude instead of
+       trail (FIFO) order. The key uses the trail_info encoding (x << 1) + is_lower.
+    */
+    struct queue_entry {
+        double    m_score;
+        unsigned  m_key;
+        queue_entry():m_score(0.0), m_key(UINT_MAX) {}
+        queue_entry(double score, unsigned key):m_score(score), m_key(key) {}
+        bool operator<(queue_entry const & other) const { return m_score < other.m_score; }
+    };
+
+    svector<queue_entry> m_queue;    // temp field: max-heap of pending bound updates
+    svector<char>        m_in_queue; // temp field: per (var, side) membership flag used to coalesce stale entries
+
     // config
     unsigned           m_max_refinements; // maximum number of refinements per round
     double             m_small_interval;
     double             m_threshold; // improvement threshold
     double             m_strict2double;
+    unsigned           m_propagation_budget; // maximum number of bound updates processed per propagate() round
 
     // statistics
     unsigned           m_conflicts;
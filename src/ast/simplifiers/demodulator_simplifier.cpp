@@ -13,6 +13,11 @@ Author:
 
 #include "ast/simplifiers/demodulator_simplifier.h"
 
+demodulator_index::fwd_entry::~fwd_entry() {
+    for (auto& [k, v] : m_by_arg)
+        dealloc(v);
+}
+
 demodulator_index::~demodulator_index() {
     reset();
 }
@@ -26,6 +31,39 @@ void demodulator_index::reset() {
     m_bwd_index.reset();
 }
 
+// root symbol of the first argument of lhs, or nullptr if there is no
+// discriminating position.
+static func_decl* fwd_arg_decl(app* lhs) {
+    if (lhs->get_num_args() == 0)
+        return nullptr;
+    expr* a = lhs->get_arg(0);
+    return is_app(a) ? to_app(a)->get_decl() : nullptr;
+}
+
+void demodulator_index::insert_fwd(app* lhs, unsigned i) {
+    fwd_entry* e;
+    if (!m_fwd_index.find(lhs->get_decl(), e)) {
+        e = alloc(fwd_entry);
+        m_fwd_index.insert(lhs->get_decl(), e);
+    }
+    func_decl* g = fwd_arg_decl(lhs);
+    if (g)
+        add(g, i, e->m_by_arg);
+    else
+        e->m_flexible.insert(i);
+}
+
+void demodulator_index::remove_fwd(app* lhs, unsigned i) {
+    fwd_entry* e;
+    if (!m_fwd_index.find(lhs->get_decl(), e))
+        return;
+    func_decl* g = fwd_arg_decl(lhs);
+    if (g)
+        del(g, i, e->m_by_arg);
+    else
+        e->m_flexible.remove(i);
+}
+
 void demodulator_index::add(func_decl* f, unsigned i, obj_map<func_decl, uint_set*>& map) {
     uint_set* s;
     if (!map.find(f, s)) {
@@ -73,8 +111,12 @@ void demodulator_index::remove_bwd(expr* e, unsigned i) {
 
 std::ostream& demodulator_index::display(std::ostream& out) const {
     out << "forward\n";
-    for (auto& [k, v] : m_fwd_index)
-        out << mk_pp(k, m) << " : " << *v << "\n";
+    for (auto& [k, v] : m_fwd_index) {
+        out << mk_pp(k, m) << " : " << v->m_flexible;
+        for (auto& [g, s] : v->m_by_arg)
+            out << " " << g->get_name() << " -> " << *s;
+        out << "\n";
+    }
     out << "backward\n";
     for (auto& [k, v] : m_bwd_index)
         out << mk_pp(k, m) << " : " << *v << "\n";
@@ -111,14 +153,38 @@ void demodulator_simplifier::rewrite(unsigned i) {
     m_fmls.update(i, dependent_expr(m, r, nullptr, d));
 }
 
+// Sound prefilter for matching: a pattern position headed by a function
+// symbol can only match a term headed by the same symbol, while variables
+// in the pattern match anything.
+static bool may_match(app* lhs, expr_ref_vector const& args) {
+    for (unsigned j = 0; j < args.size(); ++j) {
+        expr* p = lhs->get_arg(j);
+        if (!is_app(p))
+            continue;
+        expr* t = args.get(j);
+        if (!is_app(t) || to_app(p)->get_decl() != to_app(t)->get_decl())
+            return false;
+    }
+    return true;
+}
+
 bool demodulator_simplifier::rewrite1(func_decl* f, expr_ref_vector const& args, expr_ref& np) {
-    uint_set* set;
-    if (!m_index.find_fwd(f, set))
+    demodulator_index::fwd_entry* e = m_index.find_fwd(f);
+    if (!e)
         return false;
 
     TRACE("demodulator", tout << "trying to rewrite: " << f->get_name() << " args:" << args << "\n"; m_index.display(tout));
 
-    for (unsigned i : *set) {
+    uint_set* set = nullptr;
+    if (!args.empty() && is_app(args.get(0)) && e->m_by_arg.find(to_app(args.get(0))->get_decl(), set) && try_rewrite(*set, args, np))
+        return true;
+
+    return try_rewrite(e->m_flexible, args, np);
+}
+
+bool demodulator_simplifier::try_rewrite(uint_set const& set, expr_ref_vector const& args, expr_ref& np) {
+
+    for (unsigned i : set) {
 
         auto const& [lhs, rhs] = m_rewrites[i];
 
@@ -127,8 +193,8 @@ bool demodulator_simplifier::rewrite1(func_decl* f, expr_ref_vector const& args,
         if (lhs->get_num_args() != args.size())
             continue;
 
-        SASSERT(lhs->get_decl() == f);
-
+        if (!may_match(lhs, args))
+            continue;
 
         if (m_match_subst(lhs, rhs, args.data(), np)) {
             TRACE("demodulator_bug", tout << "succeeded...\n" << mk_pp(rhs, m) << "\n===>\n" << np << "\n");
@@ -151,7 +217,9 @@ void demodulator_simplifier::reschedule_processed(func_decl* f) {
             tmp.insert(i);
     for (auto i : tmp) {
         m_processed.remove(i);
-        m_index.remove_fwd(f, i);
+        app_expr_pair p;
+        if (m_rewrites.find(i, p))
+            m_index.remove_fwd(p.first, i);
         m_index.remove_bwd(fml(i), i);
         m_todo.push_back(i);
     }
@@ -169,7 +237,7 @@ void demodulator_simplifier::reschedule_demodulators(func_decl* f, expr* lhs) {
         if (!m_match_subst.can_rewrite(fml(i), lhs))
             continue;
         SASSERT(f == p.first->get_decl());
-        m_index.remove_fwd(f, i);
+        m_index.remove_fwd(p.first, i);
         m_index.remove_bwd(fml(i), i);
         m_todo.push_back(i);
     }
@@ -202,7 +270,7 @@ void demodulator_simplifier::reduce() {
             TRACE("demodulator", tout << i << " " << mk_pp(fml(i), m) << ": " << large << " ==> " << small << "\n");
             reschedule_processed(f);
             reschedule_demodulators(f, large);
-            m_index.insert_fwd(f, i);
+            m_index.insert_fwd(large, i);
             m_rewrites.insert(i, app_expr_pair(large, small));
             m_pinned.push_back(large);
             m_pinned.push_back(small);
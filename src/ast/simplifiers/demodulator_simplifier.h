@@ -18,19 +18,34 @@ Author:
 #include "util/uint_set.h"
 
 class demodulator_index {
+ public:
+    /**
+       Demodulators are indexed by the root symbol of the left-hand side and
+       discriminated further by the root symbol of the first argument. Rules
+       whose first argument is a variable, or whose left-hand side is a
+       constant, are kept in a flexible set that is compatible with every
+       query term.
+    */
+    struct fwd_entry {
+        obj_map<func_decl, uint_set*> m_by_arg;
+        uint_set                      m_flexible;
+        ~fwd_entry();
+    };
+ private:
     ast_manager& m;
-    obj_map<func_decl, uint_set*> m_fwd_index, m_bwd_index; 
+    obj_map<func_decl, fwd_entry*> m_fwd_index;
+    obj_map<func_decl, uint_set*> m_bwd_index;
     void add(func_decl* f, unsigned i, obj_map<func_decl, uint_set*>& map);
     void del(func_decl* f, unsigned i, obj_map<func_decl, uint_set*>& map);
  public:
     demodulator_index(ast_manager& m): m(m) {}
     ~demodulator_index();
     void reset();
-    void insert_fwd(func_decl* f, unsigned i) { add(f, i, m_fwd_index); }
-    void remove_fwd(func_decl* f, unsigned i) { del(f, i, m_fwd_index); }
+    void insert_fwd(app* lhs, unsigned i);
+    void remove_fwd(app* lhs, unsigned i);
     void insert_bwd(expr* e, unsigned i);
     void remove_bwd(expr* e, unsigned i);
-    bool find_fwd(func_decl* f, uint_set*& s) { return m_fwd_index.find(f, s); }
+    fwd_entry* find_fwd(func_decl* f) { fwd_entry* e = nullptr; m_fwd_index.find(f, e); return e; }
     bool find_bwd(func_decl* f, uint_set*& s) { return m_bwd_index.find(f, s); }
     bool empty() const { return m_fwd_index.empty(); }
     std::ostream& display(std::ostream& out) const;
@@ -49,6 +64,7 @@ class demodulator_simplifier : public dependent_expr_simplifier {
 
     void rewrite(unsigned i);
     bool rewrite1(func_decl* f, expr_ref_vector const& args, expr_ref& np);
+    bool try_rewrite(uint_set const& set, expr_ref_vector const& args, expr_ref& np);
     expr* fml(unsigned i) { return m_fmls[i].fml(); }
     expr_dependency* dep(unsigned i) { return m_fmls[i].dep(); }
     void reschedule_processed(func_decl* f);
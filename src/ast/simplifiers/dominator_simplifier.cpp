@@ -215,7 +215,8 @@ void dominator_simplifier::reduce() {
     m_trail.reset();
     m_args.reset();
     m_result.reset();
-    m_dominators.reset();
+    // m_dominators is kept; compile() reuses the tree when the goal
+    // conjunction is unchanged since the previous pass.
 
     SASSERT(scope_level() == 0);
     bool change = true;
@@ -48,6 +48,7 @@ monotonicity or reflexivity rules.
 
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_pp.h"
+#include "ast/for_each_expr.h"
 #include "ast/recfun_decl_plugin.h"
 #include "ast/simplifiers/elim_unconstrained.h"
 
@@ -404,7 +405,37 @@ void elim_unconstrained::update_model_trail(generic_model_converter& mc, vector<
     trail.push(sub.detach(), old_fmls);
 }
 
+/**
+* The simplifier is rerun between check-sat calls over the formulas added
+* since the last call. Most increments in long-running incremental queries
+* range over symbols that are already frozen, so check for an eligible
+* variable with a single cheap traversal before building the node graph.
+*/
+bool elim_unconstrained::has_candidates() {
+    m_fmls.freeze_suffix();
+    struct proc {
+        dependent_expr_state& fmls;
+        bool m_found = false;
+        proc(dependent_expr_state& fmls) : fmls(fmls) {}
+        void operator()(app* t) {
+            if (is_uninterp_const(t) && !fmls.frozen(t))
+                m_found = true;
+        }
+        void operator()(ast*) {}
+    };
+    proc p(m_fmls);
+    expr_fast_mark1 visited;
+    for (unsigned i : indices()) {
+        quick_for_each_expr(p, visited, m_fmls[i].fml());
+        if (p.m_found)
+            return true;
+    }
+    return false;
+}
+
 void elim_unconstrained::reduce() {
+    if (!has_candidates())
+        return;
     generic_model_converter_ref mc = alloc(generic_model_converter, m, "elim-unconstrained");
     m_inverter.set_model_converter(mc.get());
     m_created_compound = true;
@@ -65,6 +65,7 @@ class elim_unconstrained : public dependent_expr_simplifier {
     void freeze_rec(expr* r);
     void gc(expr* t);
     expr* get_parent(unsigned n) const;
+    bool has_candidates();
     void init_terms(expr_ref_vector const& terms);
     void init_nodes();
     void eliminate();
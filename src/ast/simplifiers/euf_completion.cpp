@@ -58,6 +58,10 @@ namespace euf {
         m_ff = m_egraph.mk(m.mk_false(), 0, 0, nullptr);
         m_rewriter.set_order_eq(true);
         m_rewriter.set_flat_and_or(false);
+        std::function<void(enode*, enode*)> on_merge = [&](enode* root, enode* other) {
+            m_merged.push_back(root);
+        };
+        m_egraph.set_on_merge(on_merge);
     }
 
     void completion::reduce() {
@@ -65,8 +69,11 @@ namespace euf {
         for (unsigned rounds = 0; m_has_new_eq && rounds <= 3 && !m_fmls.inconsistent(); ++rounds) {
             ++m_epoch;
             m_has_new_eq = false;
+            m_all_dirty = rounds == 0;
+            m_merged.reset();
             add_egraph();
             map_canonical();
+            mark_dirty();
             read_egraph();
             IF_VERBOSE(11, verbose_stream() << "(euf.completion :rounds " << rounds << ")\n");
         }
@@ -104,6 +111,41 @@ namespace euf {
         m_egraph.propagate();
     }
 
+    // Close the set of classes merged during this round under congruence
+    // parents. These are exactly the classes whose canonical form can have
+    // changed, so re-simplification is restricted to formulas that overlap
+    // with them.
+    void completion::mark_dirty() {
+        m_dirty.reset();
+        if (m_all_dirty)
+            return;
+        enode_vector todo(m_merged);
+        while (!todo.empty()) {
+            enode* n = todo.back()->get_root();
+            todo.pop_back();
+            if (m_dirty.contains(n->get_id()))
+                continue;
+            m_dirty.insert(n->get_id());
+            for (enode* k : enode_class(n))
+                for (enode* p : enode_parents(k))
+                    if (!m_dirty.contains(p->get_root()->get_id()))
+                        todo.push_back(p);
+        }
+    }
+
+    bool completion::is_dirty(expr* f) {
+        auto dirty = [&](expr* e) {
+            enode* n = m_egraph.find(e);
+            return !n || m_dirty.contains(n->get_root()->get_id());
+        };
+        expr* x, * y;
+        if (m.is_eq(f, x, y))
+            return dirty(x) || dirty(y);
+        if (m.is_not(f, x))
+            return dirty(x);
+        return dirty(f);
+    }
+
     void completion::read_egraph() {
 
         if (m_egraph.inconsistent()) {
@@ -116,7 +158,10 @@ namespace euf {
         unsigned sz = qtail();
         for (unsigned i = qhead(); i < sz; ++i) {
             auto [f, p, d] = m_fmls[i]();
-            
+
+            if (!m_all_dirty && !is_dirty(f))
+                continue;
+
             expr_dependency_ref dep(d, m);
             expr_ref g = canonize_fml(f, dep);
             if (g != f) {
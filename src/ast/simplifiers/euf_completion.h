@@ -20,6 +20,7 @@ Author:
 #include "ast/simplifiers/dependent_expr_state.h"
 #include "ast/euf/euf_egraph.h"
 #include "ast/rewriter/th_rewriter.h"
+#include "util/uint_set.h"
 
 namespace euf {
 
@@ -41,6 +42,9 @@ namespace euf {
         th_rewriter            m_rewriter;
         stats                  m_stats;
         bool                   m_has_new_eq = false;
+        bool                   m_all_dirty = true;   // revisit all formulas (first round of a reduce call)
+        enode_vector           m_merged;             // classes merged during the current round
+        uint_set               m_dirty;              // roots whose canonical form may have changed
 
         enode* mk_enode(expr* e);
         bool is_new_eq(expr* a, expr* b);
@@ -49,6 +53,8 @@ namespace euf {
         void add_egraph();
         void map_canonical();
         void read_egraph();
+        void mark_dirty();
+        bool is_dirty(expr* f);
         expr_ref canonize(expr* f, expr_dependency_ref& dep);
         expr_ref canonize_fml(expr* f, expr_dependency_ref& dep);
         expr* get_canonical(expr* f, expr_dependency_ref& d);
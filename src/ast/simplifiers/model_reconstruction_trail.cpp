@@ -71,6 +71,7 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
         
         if (t->is_def()) {
             macro_replacer mrp(m);
+            ast_mark defined_vars;
             for (auto const& [d, def, dep] : t->m_defs) {
                 app_ref head(m);
                 ptr_buffer<expr> args;
@@ -81,9 +82,13 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
                 TRACE("simplifier", tout << mk_pp(d, m) << " " << mk_pp(def,m) << " " << "\n");
                 dependent_expr de(m, def, nullptr, dep);
                 add_vars(de, free_vars);
+                defined_vars.mark(d, true);
             }
-            
+
             for (unsigned i = qhead; i < st.qtail(); ++i) {
+                // only formulas that mention a defined symbol are in the cone of the update
+                if (!intersects(defined_vars, st[i]))
+                    continue;
                 auto [f, p, dep1] = st[i]();
                 expr_ref g(m);
                 expr_dependency_ref dep2(m);
@@ -94,6 +99,8 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
             }
             for (unsigned i = 0; i < assumptions.size(); ++i) {
                 expr* a = assumptions.get(i);
+                if (!intersects(defined_vars, a))
+                    continue;
                 expr_ref g(m);
                 expr_dependency_ref dep(m);
                 mrp(a, nullptr, g, dep);
@@ -105,12 +112,25 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
         }
 
         rp->set_substitution(t->m_subst.get());
+        ast_mark subst_vars;
+        for (auto const& [k, v] : t->m_subst->sub())
+            subst_vars.mark(to_app(k)->get_decl(), true);
         // rigid entries:
         // apply substitution to added in case of rigid model convertions
         ptr_vector<expr> dep_exprs;
         expr_ref_vector trail(m);
         for (unsigned i = qhead; i < st.qtail(); ++i) {
             auto [f, p, dep1] = st[i]();
+            // only formulas whose symbols or dependencies intersect the domain
+            // of the substitution are re-written
+            bool in_cone = intersects(subst_vars, f);
+            if (!in_cone && dep1) {
+                dep_exprs.reset();
+                m.linearize(dep1, dep_exprs);
+                in_cone = any_of(dep_exprs, [&](expr* d) { return intersects(subst_vars, d); });
+            }
+            if (!in_cone)
+                continue;
             auto [g, dep2] = rp->replace_with_dep(f);
             if (dep1) {
                 dep_exprs.reset();
@@ -135,11 +155,13 @@ void model_reconstruction_trail::replay(unsigned qhead, expr_ref_vector& assumpt
         
         for (unsigned i = 0; i < assumptions.size(); ++i) {
             expr* a = assumptions.get(i);
+            if (!intersects(subst_vars, a))
+                continue;
             auto [g, dep2] = rp->replace_with_dep(a);
             if (a != g)
                 assumptions[i] = g;
             // ignore dep.
-        }        
+        }
     }
 }
 
@@ -127,12 +127,16 @@ class model_reconstruction_trail {
         add_vars(d.fml(), free_vars);
     }
 
-    bool intersects(ast_mark const& free_vars, dependent_expr const& d) {
-        expr_ref term(d.fml(), m);
+    bool intersects(ast_mark const& free_vars, expr* e) {
+        expr_ref term(e, m);
         auto iter = subterms::all(term);
         return any_of(iter, [&](expr* t) { return is_app(t) && free_vars.is_marked(to_app(t)->get_decl()); });
     }
 
+    bool intersects(ast_mark const& free_vars, dependent_expr const& d) {
+        return intersects(free_vars, d.fml());
+    }
+
     bool intersects(ast_mark const& free_vars, vector<dependent_expr> const& added) {
         return any_of(added, [&](dependent_expr const& d) { return intersects(free_vars, d); });
     }
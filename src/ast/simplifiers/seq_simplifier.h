@@ -78,6 +78,13 @@ public:
         }      
     }
     
+    bool supports_proofs() const override {
+        for (auto* s : m_simplifiers)
+            if (!s->supports_proofs())
+                return false;
+        return true;
+    }
+
     void collect_statistics(statistics& st) const override {
         for (auto* s : m_simplifiers)
             s->collect_statistics(st);
@@ -663,7 +663,66 @@ void static_features::display(std::ostream & out) const {
     out << "END_STATIC_FEATURES" << "\n";
 }
 
+/**
+   \brief Export the scalar metrics as a flat feature vector for external
+   complexity/latency estimators. The order is fixed; new features must only
+   be appended so that models trained on older vectors remain usable.
+*/
 void static_features::get_feature_vector(vector<double> & result) {
+    result.reset();
+    result.push_back(m_cnf ? 1.0 : 0.0);
+    result.push_back(m_num_exprs);
+    result.push_back(m_num_roots);
+    result.push_back(m_max_depth);
+    result.push_back(m_num_quantifiers);
+    result.push_back(m_num_quantifiers_with_patterns);
+    result.push_back(m_num_quantifiers_with_multi_patterns);
+    result.push_back(m_num_clauses);
+    result.push_back(m_num_bin_clauses);
+    result.push_back(m_num_units);
+    result.push_back(m_sum_clause_size);
+    result.push_back(m_num_nested_formulas);
+    result.push_back(m_num_bool_exprs);
+    result.push_back(m_num_bool_constants);
+    result.push_back(m_num_ite_trees);
+    result.push_back(m_max_ite_tree_depth);
+    result.push_back(m_sum_ite_tree_depth);
+    result.push_back(m_num_ands);
+    result.push_back(m_num_ors);
+    result.push_back(m_num_iffs);
+    result.push_back(m_num_ite_formulas);
+    result.push_back(m_num_ite_terms);
+    result.push_back(m_num_sharing);
+    result.push_back(m_num_interpreted_exprs);
+    result.push_back(m_num_uninterpreted_exprs);
+    result.push_back(m_num_interpreted_constants);
+    result.push_back(m_num_uninterpreted_constants);
+    result.push_back(m_num_uninterpreted_functions);
+    result.push_back(m_num_eqs);
+    result.push_back(m_has_rational ? 1.0 : 0.0);
+    result.push_back(m_has_int ? 1.0 : 0.0);
+    result.push_back(m_has_real ? 1.0 : 0.0);
+    result.push_back(m_has_bv ? 1.0 : 0.0);
+    result.push_back(m_has_fpa ? 1.0 : 0.0);
+    result.push_back(m_has_sr ? 1.0 : 0.0);
+    result.push_back(m_has_str ? 1.0 : 0.0);
+    result.push_back(m_has_seq_non_str ? 1.0 : 0.0);
+    result.push_back(m_has_arrays ? 1.0 : 0.0);
+    result.push_back(m_has_ext_arrays ? 1.0 : 0.0);
+    result.push_back(m_arith_k_sum.get_double());
+    result.push_back(m_num_arith_terms);
+    result.push_back(m_num_arith_eqs);
+    result.push_back(m_num_arith_ineqs);
+    result.push_back(m_num_diff_terms);
+    result.push_back(m_num_diff_eqs);
+    result.push_back(m_num_diff_ineqs);
+    result.push_back(m_num_simple_eqs);
+    result.push_back(m_num_simple_ineqs);
+    result.push_back(m_num_non_linear);
+    result.push_back(m_num_aliens);
+    result.push_back(m_num_theories);
+    result.push_back(has_uf() ? 1.0 : 0.0);
+    result.push_back(is_dense() ? 1.0 : 0.0);
 }
 
 bool static_features::is_dense() const {
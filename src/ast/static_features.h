@@ -155,6 +155,7 @@ struct static_features {
     }
 
     bool arith_k_sum_is_small() const { return m_arith_k_sum < rational(INT_MAX / 8); }
+    bool arith_k_sum_is_small64() const { return m_arith_k_sum < rational(INT64_MAX / 8, rational::i64()); }
 
     void inc_num_apps(func_decl const * d) { unsigned id = d->get_small_id(); m_num_apps.reserve(id+1, 0); m_num_apps[id]++; }
     void inc_theory_terms(family_id fid) { m_num_theory_terms.reserve(fid+1, 0); m_num_theory_terms[fid]++; }
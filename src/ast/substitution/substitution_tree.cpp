@@ -200,12 +200,26 @@ void substitution_tree::reset_compiler() {
     });
 }
 
+/**
+   \brief Nodes are small and traversed in bulk during retrieval; allocating
+   them from m_alloc keeps them packed in a few pages instead of scattered
+   over the heap.
+*/
+substitution_tree::node * substitution_tree::mk_node(bool leaf) {
+    return new (m_alloc.allocate(sizeof(node))) node(leaf);
+}
+
+void substitution_tree::recycle_node(node * n) {
+    n->~node();
+    m_alloc.deallocate(sizeof(node), n);
+}
+
 /**
    \brief Create a node with the linearization for all registers in todo.
    Attach new_expr to it.
 */
 substitution_tree::node * substitution_tree::mk_node_for(expr * new_expr) {
-    node * n = alloc(node, true);
+    node * n = mk_node(true);
     linearize(n->m_subst);
     n->m_expr = new_expr;
     m_manager.inc_ref(new_expr);
@@ -357,7 +371,7 @@ void substitution_tree::insert(app * new_expr) {
             
             node * n      = mk_node_for(new_expr);
 
-            node * incomp = alloc(node, r->m_leaf);
+            node * incomp = mk_node(r->m_leaf);
             incomp->m_subst.swap(m_incompatible);
             if (r->m_leaf) {
                 incomp->m_expr = r->m_expr;
@@ -514,7 +528,7 @@ void substitution_tree::erase(app * e) {
                 else 
                     parent->m_first_child = other_child->m_first_child;
                 delete_node(r);
-                dealloc(other_child); // Remark: I didn't use delete_node since its resources were sent to parent.
+                recycle_node(other_child); // Remark: I didn't use delete_node since its resources were sent to parent.
             }
             m_size --;
             return;
@@ -553,7 +567,7 @@ void substitution_tree::delete_node(node * n) {
                 c = c->m_next_sibling;
             }
         }
-        dealloc(n);
+        recycle_node(n);
     }
 }
 
@@ -885,6 +899,7 @@ void substitution_tree::display(std::ostream & out) const {
 
 substitution_tree::substitution_tree(ast_manager & m):
     m_manager(m),
+    m_alloc("substitution-tree"),
     m_max_reg(0),
     m_size(0) {
 }
@@ -20,6 +20,7 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/substitution/substitution.h"
+#include "util/small_object_allocator.h"
 
 /**
    \brief Substitution tree visitor.
@@ -53,6 +54,7 @@ class substitution_tree {
     };
 
     ast_manager &     m_manager;
+    small_object_allocator m_alloc;
     ptr_vector<node>  m_roots;
     unsigned          m_max_reg;
     ptr_vector<expr>  m_registers;
@@ -87,6 +89,8 @@ class substitution_tree {
     unsigned get_compatibility_measure(svector<subst> const & sv);
     node * find_best_child(node * r);
     void reset_compiler();
+    node * mk_node(bool leaf);
+    void recycle_node(node * n);
     node * mk_node_for(expr * new_expr);
     void mark_used_reg(unsigned ridx);
     void mark_used_regs(svector<subst> const & sv);
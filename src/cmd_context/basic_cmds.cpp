@@ -18,6 +18,8 @@ Notes:
 #include "util/gparams.h"
 #include "util/env_params.h"
 #include "util/z3_version.h"
+#include "util/statistics.h"
+#include "util/small_object_allocator.h"
 #include "ast/ast_smt_pp.h"
 #include "ast/ast_smt2_pp.h"
 #include "ast/ast_pp_dot.h"
@@ -659,6 +661,7 @@ class get_info_cmd : public cmd {
     symbol   m_all_statistics;
     symbol   m_assertion_stack_levels;
     symbol   m_rlimit;
+    symbol   m_memory;
 public:
     get_info_cmd():
         cmd("get-info"),
@@ -670,7 +673,8 @@ public:
         m_reason_unknown(":reason-unknown"),
         m_all_statistics(":all-statistics"),
         m_assertion_stack_levels(":assertion-stack-levels"),
-        m_rlimit(":rlimit") {
+        m_rlimit(":rlimit"),
+        m_memory(":memory") {
     }
     char const * get_usage() const override { return "<keyword>"; }
     char const * get_descr(cmd_context & ctx) const override { return "get information."; }
@@ -711,6 +715,12 @@ public:
         else if (opt == m_assertion_stack_levels) {
             ctx.regular_stream() << "(:assertion-stack-levels " << ctx.num_scopes() << ")" << std::endl;
         }
+        else if (opt == m_memory) {
+            statistics st;
+            get_memory_statistics(st);
+            small_object_allocator::collect_statistics(st);
+            st.display_smt2(ctx.regular_stream());
+        }
         else {
             ctx.print_unsupported(opt, m_line, m_pos);
         }
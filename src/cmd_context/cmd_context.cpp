@@ -22,6 +22,7 @@ Notes:
 #include "util/scoped_ctrl_c.h"
 #include "util/dec_ref_util.h"
 #include "util/scoped_timer.h"
+#include "util/self_profiler.h"
 #include "ast/func_decl_dependencies.h"
 #include "ast/arith_decl_plugin.h"
 #include "ast/bv_decl_plugin.h"
@@ -36,7 +37,9 @@ Notes:
 #include "ast/rewriter/var_subst.h"
 #include "ast/pp.h"
 #include "ast/ast_smt2_pp.h"
+#include "ast/ast_smt_pp.h"
 #include "ast/ast_ll_pp.h"
+#include "ast/pp_params.hpp"
 #include "ast/decl_collector.h"
 #include "ast/well_sorted.h"
 #include "ast/for_each_expr.h"
@@ -952,8 +955,8 @@ void cmd_context::insert(symbol const & s, object_ref * r) {
 
 void cmd_context::model_add(symbol const & s, unsigned arity, sort *const* domain, expr * t) {
 
-    if (!mc0()) m_mcs.set(m_mcs.size()-1, alloc(generic_model_converter, m(), "cmd_context"));
-    if (m_solver.get() && !m_solver->mc0()) m_solver->set_model_converter(mc0()); 
+    mc0_owned();
+    if (m_solver.get() && !m_solver->mc0()) m_solver->set_model_converter(mc0());
 
     func_decl_ref fn(m().mk_func_decl(s, arity, domain, t->get_sort()), m());
     mc0()->add(fn, t);
@@ -970,11 +973,25 @@ void cmd_context::register_fun(symbol const& s, func_decl* fn) {
 }
 
 void cmd_context::model_del(func_decl* f) {
-    if (!mc0()) m_mcs.set(m_mcs.size() - 1, alloc(generic_model_converter, m(), "cmd_context"));
+    mc0_owned();
     if (m_solver.get() && !m_solver->mc0()) m_solver->set_model_converter(mc0());
     mc0()->hide(f);
 }
 
+/**
+   \brief return the model converter of the current scope, allocating or
+   unsharing it first so that updates do not leak into enclosing scopes.
+*/
+generic_model_converter* cmd_context::mc0_owned() {
+    if (!mc0())
+        m_mcs.set(m_mcs.size() - 1, alloc(generic_model_converter, m(), "cmd_context"));
+    else if (m_mcs.size() > 1 && m_mcs.get(m_mcs.size() - 2) == m_mcs.back()) {
+        ast_translation tr(m(), m());
+        m_mcs.set(m_mcs.size() - 1, m_mcs.back()->copy(tr));
+    }
+    return mc0();
+}
+
 
 recfun::decl::plugin& cmd_context::get_recfun_plugin() {
     recfun::util u(get_ast_manager());
@@ -1509,8 +1526,10 @@ void cmd_context::push() {
     s.m_assertions_lim         = m_assertions.size();
     if (!m_global_decls)
         pm().push();
-    ast_translation tr(m(), m());
-    m_mcs.push_back(m_mcs.back() ? m_mcs.back()->copy(tr) : nullptr);
+    // the model converter is shared with the enclosing scope and copied
+    // lazily on the first model_add/model_del at this level, so deep push
+    // chains without model commands stay O(1).
+    m_mcs.push_back(m_mcs.back());
     unsigned timeout = m_params.m_timeout;
     m().limit().push(m_params.rlimit());
     cancel_eh<reslimit> eh(m().limit());
@@ -2188,6 +2207,7 @@ void cmd_context::display_statistics(bool show_total_time, double total_time) {
     st.update("time", get_seconds());
     get_memory_statistics(st);
     get_rlimit_statistics(m().limit(), st);
+    self_profiler::collect_statistics(st);
     if (m_check_sat_result) {
         m_check_sat_result->collect_statistics(st);
     }
@@ -2288,6 +2308,10 @@ void cmd_context::display(std::ostream & out, sort * s, unsigned indent) const {
 }
 
 void cmd_context::display(std::ostream & out, expr * n, unsigned indent, unsigned num_vars, char const * var_prefix, sbuffer<symbol> & var_names) const {
+    if (pp_params().stream()) {
+        display_streamed(out, n, indent, num_vars, var_prefix, var_names);
+        return;
+    }
     format_ns::format_ref f(format_ns::fm(m()));
     pp(n, num_vars, var_prefix, f, var_names);
     if (indent > 0)
@@ -2295,6 +2319,28 @@ void cmd_context::display(std::ostream & out, expr * n, unsigned indent, unsigne
     ::pp(out, f.get(), m());
 }
 
+/**
+   \brief Print \p n by streaming it directly to \p out with let bindings
+   for shared subterms. Unlike the default printer, no formatting tree is
+   built first, so memory use is proportional to the depth of \p n rather
+   than its size. Used for pp.stream=true to dump very large terms.
+*/
+void cmd_context::display_streamed(std::ostream & out, expr * n, unsigned indent, unsigned num_vars, char const * var_prefix, sbuffer<symbol> & var_names) const {
+    if (var_prefix == nullptr)
+        var_prefix = "x";
+    for (unsigned i = 0; i < num_vars; i++) {
+        std::string name = std::string(var_prefix) + "!" + std::to_string(i);
+        var_names.push_back(symbol(name.c_str()));
+    }
+    // the printer renders variable i as names[num_vars - i - 1]
+    ptr_buffer<char const> names;
+    for (unsigned i = 0; i < num_vars; i++)
+        names.push_back(var_names[num_vars - i - 1].bare_str());
+    ast_smt_pp pp(m());
+    pp.set_logic(m_logic);
+    pp.display_expr_smt2(out, n, indent, num_vars, names.data());
+}
+
 void cmd_context::display(std::ostream & out, expr * n, unsigned indent) const {
     sbuffer<symbol> buf;
     display(out, n, indent, 0, nullptr, buf);
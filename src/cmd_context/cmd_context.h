@@ -245,6 +245,7 @@ protected:
     static std::ostringstream    g_error_stream;
 
     generic_model_converter* mc0() { return m_mcs.back(); }
+    generic_model_converter* mc0_owned();
     sref_vector<generic_model_converter> m_mcs;
     ast_manager *                m_manager;
     bool                         m_own_manager;
@@ -544,6 +545,7 @@ public:
     void pp(expr * n, format_ns::format_ref & r) const override;
     void display(std::ostream & out, sort * s, unsigned indent = 0) const override;
     void display(std::ostream & out, expr * n, unsigned indent, unsigned num_vars, char const * var_prefix, sbuffer<symbol> & var_names) const override;
+    void display_streamed(std::ostream & out, expr * n, unsigned indent, unsigned num_vars, char const * var_prefix, sbuffer<symbol> & var_names) const;
     void display(std::ostream & out, expr * n, unsigned indent = 0) const override;
     void display(std::ostream & out, func_decl * f, unsigned indent = 0) const override;
 
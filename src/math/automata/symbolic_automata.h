@@ -104,6 +104,11 @@ public:
     automaton_t* mk_difference(automaton_t& a, automaton_t& b);
     automaton_t* mk_product(automaton_t& a, automaton_t& b);
 
+    // decide emptiness of the product of a and b without materializing it.
+    // Returns l_true if the product is empty, l_false if it accepts a word,
+    // l_undef if a move constraint could not be decided.
+    lbool is_product_empty(automaton_t& a, automaton_t& b);
+
 private:
     automaton_t* mk_determinstic_param(automaton_t& a, bool flip_acceptance);
     
@@ -483,6 +483,68 @@ typename symbolic_automata<T, M>::automaton_t* symbolic_automata<T, M>::mk_produ
 
 
 
+template<class T, class M>
+lbool symbolic_automata<T, M>::is_product_empty(automaton_t& a, automaton_t& b) {
+    if (a.is_empty() || b.is_empty()) {
+        return l_true;
+    }
+    // lazy on-the-fly exploration of the product: state pairs are
+    // hash-consed and expanded from a worklist; the search exits as soon
+    // as a final pair is reachable. Unlike mk_product, no moves are
+    // materialized and no backward pruning is required.
+    u2_map<unsigned> pair2id;
+    unsigned_pair init_pair(a.init(), b.init());
+    svector<unsigned_pair> todo;
+    todo.push_back(init_pair);
+    pair2id.insert(init_pair, 0);
+    unsigned_vector a_init, b_init;
+    a.get_epsilon_closure(a.init(), a_init);
+    for (unsigned ia : a_init) {
+        if (a.is_final_state(ia)) {
+            b.get_epsilon_closure(b.init(), b_init);
+            for (unsigned ib : b_init) {
+                if (b.is_final_state(ib)) {
+                    return l_false;
+                }
+            }
+            break;
+        }
+    }
+
+    unsigned n = 1;
+    moves_t mvsA, mvsB;
+    while (!todo.empty()) {
+        unsigned_pair curr_pair = todo.back();
+        todo.pop_back();
+        mvsA.reset(); mvsB.reset();
+        a.get_moves_from(curr_pair.first,  mvsA, true);
+        b.get_moves_from(curr_pair.second, mvsB, true);
+        for (unsigned i = 0; i < mvsA.size(); ++i) {
+            for (unsigned j = 0; j < mvsB.size(); ++j) {
+                unsigned_pair tgt_pair(mvsA[i].dst(), mvsB[j].dst());
+                unsigned tgt;
+                if (pair2id.find(tgt_pair, tgt)) {
+                    continue;
+                }
+                ref_t ab(m_ba.mk_and(mvsA[i].t(), mvsB[j].t()), m);
+                lbool is_sat = m_ba.is_sat(ab);
+                if (is_sat == l_false) {
+                    continue;
+                }
+                else if (is_sat == l_undef) {
+                    return l_undef;
+                }
+                if (a.is_final_state(tgt_pair.first) && b.is_final_state(tgt_pair.second)) {
+                    return l_false;
+                }
+                pair2id.insert(tgt_pair, n++);
+                todo.push_back(tgt_pair);
+            }
+        }
+    }
+    return l_true;
+}
+
 template<class T, class M>
 typename symbolic_automata<T, M>::automaton_t* symbolic_automata<T, M>::mk_difference(automaton_t& a, automaton_t& b) {
     return mk_product(a,mk_complement(b));
@@ -43,7 +43,6 @@ namespace dd {
             m_nodes.back().m_index = m_nodes.size()-1;
         }
 
-        m_spare_entry = nullptr;
         m_max_num_bdd_nodes = 1 << 24; // up to 16M nodes
         m_mark_level = 0;
         alloc_free_nodes(1024 + num_vars);
@@ -57,13 +56,6 @@ namespace dd {
     }
 
     bdd_manager::~bdd_manager() {
-        if (m_spare_entry) {
-            m_alloc.deallocate(sizeof(*m_spare_entry), m_spare_entry);
-        }
-        for (auto* e : m_op_cache) {
-            SASSERT(e != m_spare_entry);
-            m_alloc.deallocate(sizeof(*e), e);
-        }
     }
     
     bdd_manager::BDD bdd_manager::apply_const(BDD a, BDD b, bdd_op op) {
@@ -108,20 +100,64 @@ namespace dd {
     bdd bdd_manager::mk_forall(unsigned v, bdd const& b) { return mk_forall(1, &v, b); }
 
 
-    bool bdd_manager::check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c) {
-        if (e1 != e2) {
-            SASSERT(e2->m_result != null_bdd);
-            push_entry(e1);
-            e1 = nullptr;
-            return true;            
+    bool bdd_manager::op_cache::find(BDD a, BDD b, BDD op, BDD& r) {
+        if (++m_lookups == window_size)
+            end_window();
+        entry* es = set_of(a, b, op);
+        for (unsigned i = 0; i < num_ways; ++i) {
+            entry& e = es[i];
+            if (e.m_generation == m_generation && e.m_bdd1 == a && e.m_bdd2 == b && e.m_op == op) {
+                r = e.m_result;
+                if (i > 0)
+                    std::swap(es[0], e); // promote to the most recently used way
+                ++m_hits;
+                return true;
+            }
         }
-        else {
-            e1->m_bdd1 = a;
-            e1->m_bdd2 = b;
-            e1->m_op = c;
-            SASSERT(e1->m_result == null_bdd);
-            return false;        
+        return false;
+    }
+
+    void bdd_manager::op_cache::insert(BDD a, BDD b, BDD op, BDD r) {
+        entry* es = set_of(a, b, op);
+        unsigned way = num_ways;
+        for (unsigned i = 0; i < num_ways && way == num_ways; ++i)
+            if (es[i].m_generation != m_generation || (es[i].m_bdd1 == a && es[i].m_bdd2 == b && es[i].m_op == op))
+                way = i;
+        if (way == num_ways) {
+            // evict the least recently used way; the previous occupant
+            // of way 0 is kept around as the second way
+            std::swap(es[0], es[num_ways - 1]);
+            way = 0;
+            ++m_evictions;
         }
+        es[way] = { a, b, op, r, m_generation };
+    }
+
+    void bdd_manager::op_cache::invalidate() {
+        if (++m_generation == 0) {
+            // the generation counter wrapped around; clear the entries
+            // so stale ones cannot alias the restarted generation
+            for (entry& e : m_entries)
+                e = entry();
+            m_generation = 1;
+        }
+    }
+
+    void bdd_manager::op_cache::resize(unsigned num_sets) {
+        m_num_sets = num_sets;
+        m_entries.reset();
+        m_entries.resize(num_ways * m_num_sets);
+        m_generation = 1;
+    }
+
+    void bdd_manager::op_cache::end_window() {
+        if (m_evictions * 4 >= window_size && m_num_sets < max_sets)
+            resize(m_num_sets * 2);
+        else if (m_hits * 16 <= window_size && m_num_sets > min_sets)
+            resize(m_num_sets / 2);
+        m_lookups = 0;
+        m_hits = 0;
+        m_evictions = 0;
     }
 
     bdd_manager::BDD bdd_manager::apply_rec(BDD a, BDD b, bdd_op op) {
@@ -152,14 +188,12 @@ namespace dd {
         if (is_const(a) && is_const(b)) {
             return m_apply_const[a + 2*b + 4*op];
         }
-        op_entry * e1 = pop_entry(a, b, op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, b, op)) {
-            SASSERT(!m_free_nodes.contains(e2->m_result));
-            return e2->m_result;
+        BDD r;
+        if (m_op_cache.find(a, b, op, r)) {
+            SASSERT(!m_free_nodes.contains(r));
+            return r;
         }
         // SASSERT(well_formed());
-        BDD r;
         if (level(a) == level(b)) {
             push(apply_rec(lo(a), lo(b), op));
             push(apply_rec(hi(a), hi(b), op));
@@ -176,7 +210,7 @@ namespace dd {
             r = make_node(level(b), read(2), read(1));
         }
         pop(2);
-        e1->m_result = r;
+        m_op_cache.insert(a, b, op, r);
         // SASSERT(well_formed());
         SASSERT(!m_free_nodes.contains(r));
         return r;
@@ -194,28 +228,6 @@ namespace dd {
         return m_bdd_stack[m_bdd_stack.size() - index];
     }
 
-    bdd_manager::op_entry* bdd_manager::pop_entry(BDD l, BDD r, BDD op) {
-        op_entry* result = nullptr;
-        if (m_spare_entry) {
-            result = m_spare_entry;
-            m_spare_entry = nullptr;
-            result->m_bdd1 = l;
-            result->m_bdd2 = r;
-            result->m_op = op;
-        }
-        else {
-            void * mem = m_alloc.allocate(sizeof(op_entry));
-            result = new (mem) op_entry(l, r, op);
-        }
-        result->m_result = null_bdd;
-        return result;
-    }
-
-    void bdd_manager::push_entry(op_entry* e) {
-        SASSERT(!m_spare_entry);
-        m_spare_entry = e;
-    }
-
     bdd_manager::BDD bdd_manager::make_node(unsigned lvl, BDD l, BDD h) {
         m_is_new_node = false;
         if (l == h) {
@@ -264,16 +276,12 @@ namespace dd {
     }    
 
     void bdd_manager::try_reorder() {
-        gc();        
-        for (auto* e : m_op_cache) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        m_op_cache.reset();
+        gc();
+        m_op_cache.invalidate();
         init_reorder();
         for (unsigned i = 0; i < m_var2level.size(); ++i) {
             sift_var(i);
         }
-        SASSERT(m_op_cache.empty());
         SASSERT(well_formed());
     }
 
@@ -562,15 +570,14 @@ namespace dd {
     bdd_manager::BDD bdd_manager::mk_not_rec(BDD b) {
         if (is_true(b)) return false_bdd;
         if (is_false(b)) return true_bdd;
-        op_entry* e1 = pop_entry(b, b, bdd_not_op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, b, b, bdd_not_op)) 
-            return e2->m_result;
+        BDD r;
+        if (m_op_cache.find(b, b, bdd_not_op, r))
+            return r;
         push(mk_not_rec(lo(b)));
         push(mk_not_rec(hi(b)));
-        BDD r = make_node(level(b), read(2), read(1));
+        r = make_node(level(b), read(2), read(1));
         pop(2);
-        e1->m_result = r;
+        m_op_cache.insert(b, b, bdd_not_op, r);
         return r;
     }
 
@@ -615,17 +622,16 @@ namespace dd {
 	if (la < lb) 
 	    return mk_cofactor_rec(a, is_false(lo(b)) ? hi(b) : lo(b));
 
-        op_entry* e1 = pop_entry(a, b, bdd_cofactor_op);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, b, bdd_cofactor_op))
-            return e2->m_result;
+        BDD r;
+        if (m_op_cache.find(a, b, bdd_cofactor_op, r))
+            return r;
 
         SASSERT(la > lb);
         push(mk_cofactor_rec(lo(a), b));
         push(mk_cofactor_rec(hi(a), b));
-        BDD r = make_node(la, read(2), read(1));
+        r = make_node(la, read(2), read(1));
         pop(2);
-        e1->m_result = r;
+        m_op_cache.insert(a, b, bdd_cofactor_op, r);
         return r;
     }
     
@@ -655,12 +661,10 @@ namespace dd {
         if (is_false(b)) return apply_rec(mk_not_rec(a), c, bdd_and_op);
         if (is_true(c)) return apply_rec(mk_not_rec(a), b, bdd_or_op);
         SASSERT(!is_const(a) && !is_const(b) && !is_const(c));
-        op_entry * e1 = pop_entry(a, b, c);
-        op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-        if (check_result(e1, e2, a, b, c)) 
-            return e2->m_result;
-        unsigned la = level(a), lb = level(b), lc = level(c);
         BDD r;
+        if (m_op_cache.find(a, b, c, r))
+            return r;
+        unsigned la = level(a), lb = level(b), lc = level(c);
         BDD a1, b1, c1, a2, b2, c2;
         unsigned lvl = la;
         if (la >= lb && la >= lc) {
@@ -687,8 +691,8 @@ namespace dd {
         push(mk_ite_rec(a1, b1, c1));
         push(mk_ite_rec(a2, b2, c2));
         r = make_node(lvl, read(2), read(1));
-        pop(2);          
-        e1->m_result = r;
+        pop(2);
+        m_op_cache.insert(a, b, c, r);
         return r;
     }
 
@@ -725,18 +729,12 @@ namespace dd {
         else {
             BDD a = level2bdd(l);
             bdd_op q_op = op == bdd_and_op ? bdd_and_proj_op : bdd_or_proj_op;
-            op_entry * e1 = pop_entry(a, b, q_op);
-            op_entry const* e2 = m_op_cache.insert_if_not_there(e1);
-            if (check_result(e1, e2, a, b, q_op)) {
-                r = e2->m_result;
-            }
-            else {
-                SASSERT(e1->m_result == null_bdd);
+            if (!m_op_cache.find(a, b, q_op, r)) {
                 push(mk_quant_rec(l, lo(b), op));
                 push(mk_quant_rec(l, hi(b), op));
                 r = make_node(lvl, read(2), read(1));
                 pop(2);
-                e1->m_result = r;
+                m_op_cache.insert(a, b, q_op, r);
             }
         }
         SASSERT(r != UINT_MAX);
@@ -844,22 +842,9 @@ namespace dd {
         std::sort(m_free_nodes.begin(), m_free_nodes.end());
         m_free_nodes.reverse();
 
-        ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
-            if (e->m_result != null_bdd) {
-                to_delete.push_back(e);
-            }
-            else {
-                to_keep.push_back(e);
-            }
-        }
-        m_op_cache.reset();
-        for (op_entry* e : to_delete) {
-            m_alloc.deallocate(sizeof(*e), e);
-        }
-        for (op_entry* e : to_keep) {
-            m_op_cache.insert(e);
-        }
+        // cached results may refer to recycled nodes; in-flight
+        // computations re-insert their results after gc returns
+        m_op_cache.invalidate();
 
         m_node_table.reset();
         // re-populate node cache
@@ -20,7 +20,6 @@ Revision History:
 
 #include "util/vector.h"
 #include "util/map.h"
-#include "util/small_object_allocator.h"
 #include "util/rational.h"
 
 namespace dd {
@@ -86,43 +85,56 @@ namespace dd {
         
         typedef hashtable<bdd_node, hash_node, eq_node> node_table;
 
-        struct op_entry {
-            op_entry(BDD l, BDD r, BDD op):
-                m_bdd1(l),
-                m_bdd2(r),
-                m_op(op),
-                m_result(0)
-            {}
-
-            BDD      m_bdd1;
-            BDD      m_bdd2;
-            BDD      m_op;
-            BDD      m_result;
-            unsigned hash() const { return mk_mix(m_bdd1, m_bdd2, m_op); }
+        /**
+           Bounded 2-way set-associative cache for operation results.
+           Lookups and insertions never allocate: a miss either fills a
+           free way or overwrites the least recently used one. Stale
+           entries left behind by gc or reordering are filtered out by a
+           generation stamp, so the whole cache is invalidated in O(1).
+           The number of sets adapts to the observed behavior per window
+           of lookups: the cache doubles when evictions are frequent and
+           halves when almost every lookup misses anyway.
+        */
+        class op_cache {
+            struct entry {
+                BDD      m_bdd1 = 0;
+                BDD      m_bdd2 = 0;
+                BDD      m_op = 0;
+                BDD      m_result = 0;
+                unsigned m_generation = 0;
+            };
+
+            static const unsigned num_ways = 2;
+            static const unsigned min_sets = 1 << 10;
+            static const unsigned max_sets = 1 << 20;
+            static const unsigned window_size = 1 << 16;
+
+            svector<entry> m_entries;
+            unsigned       m_num_sets = min_sets;
+            unsigned       m_generation = 1;
+            unsigned       m_lookups = 0;
+            unsigned       m_hits = 0;
+            unsigned       m_evictions = 0;
+
+            entry* set_of(BDD a, BDD b, BDD op) { return m_entries.data() + num_ways * (mk_mix(a, b, op) & (m_num_sets - 1)); }
+            void resize(unsigned num_sets);
+            void end_window();
+
+        public:
+            op_cache() { m_entries.resize(num_ways * m_num_sets); }
+            bool find(BDD a, BDD b, BDD op, BDD& r);
+            void insert(BDD a, BDD b, BDD op, BDD r);
+            void invalidate();
         };
 
-        struct hash_entry {
-            unsigned operator()(op_entry* e) const { return e->hash(); }
-        };
-
-        struct eq_entry {
-            bool operator()(op_entry * a, op_entry * b) const { 
-                return a->m_bdd1 == b->m_bdd2 && a->m_bdd2 == b->m_bdd2 && a->m_op == b->m_op;
-            }
-        };
-
-        typedef ptr_hashtable<op_entry, hash_entry, eq_entry> op_table;
-
         svector<bdd_node>          m_nodes;
-        op_table                   m_op_cache;
+        op_cache                   m_op_cache;
         node_table                 m_node_table;
         unsigned_vector            m_apply_const;
         svector<BDD>               m_bdd_stack;
-        op_entry*                  m_spare_entry;
         svector<BDD>               m_var2bdd;
         unsigned_vector            m_var2level, m_level2var;
         unsigned_vector            m_free_nodes;
-        small_object_allocator     m_alloc;
         mutable svector<unsigned>  m_mark;
         mutable unsigned           m_mark_level;
         mutable svector<double>    m_count;
@@ -153,10 +165,6 @@ namespace dd {
         void pop(unsigned num_scopes);
         BDD read(unsigned index);
 
-        op_entry* pop_entry(BDD l, BDD r, BDD op);
-        void push_entry(op_entry* e);
-        bool check_result(op_entry*& e1, op_entry const* e2, BDD a, BDD b, BDD c);
-        
         double count(BDD b, unsigned z);
 
         void alloc_free_nodes(unsigned n);
@@ -52,7 +52,10 @@ namespace dd {
     void pdd_manager::reset(unsigned_vector const& level2var) {
         reset_op_cache();
         m_factor_cache.reset();
-        m_node_table.reset();
+        for (unsigned i = 0; i < num_node_shards; ++i)
+            m_node_tables[i].reset();
+        m_reachable.reset();
+        m_sweep_shard = num_node_shards;
         m_nodes.reset();
         m_free_nodes.reset();
         m_pdd_stack.reset();
@@ -1279,20 +1282,25 @@ namespace dd {
     }
 
     pdd_manager::PDD pdd_manager::insert_node(node const& n) {
-        node_table::entry* e = m_node_table.insert_if_not_there2(n);
+        node_table& table = m_node_tables[n.m_level % num_node_shards];
+        node_table::entry* e = table.insert_if_not_there2(n);
         if (e->get_data().m_index != 0) {
             unsigned result = e->get_data().m_index;
             SASSERT(well_formed(e->get_data()));
             return result;
         }
         e->get_data().m_refcount = 0;
-        bool do_gc = m_free_nodes.empty();
-        if (do_gc && !m_disable_gc) {
-            gc();
-            e = m_node_table.insert_if_not_there2(n);
-            e->get_data().m_refcount = 0;      
-        }
-        if (do_gc) {
+        if (m_free_nodes.empty() && !m_disable_gc) {
+            // resume (or start) a collection cycle, sweeping only as
+            // many shards as needed to serve this allocation.
+            if (!sweep_in_progress())
+                start_sweep();
+            while (sweep_in_progress() && m_free_nodes.empty())
+                sweep_shard();
+            e = table.insert_if_not_there2(n);
+            e->get_data().m_refcount = 0;
+        }
+        if (m_free_nodes.empty()) {
             if (m_nodes.size() > m_max_num_nodes) {
                 throw mem_out();
             }
@@ -1306,10 +1314,15 @@ namespace dd {
         m_free_nodes.pop_back();
         e->get_data().m_index = result;
         m_nodes[result] = e->get_data();
+        if (sweep_in_progress() && result < m_reachable.size()) {
+            // allocate black: the node must survive the shard sweeps
+            // that are still pending in this cycle.
+            m_reachable[result] = true;
+        }
         SASSERT(well_formed(m_nodes[result]));
-        m_is_new_node = true;        
+        m_is_new_node = true;
         SASSERT(!m_free_nodes.contains(result));
-        SASSERT(m_nodes[result].m_index == result); 
+        SASSERT(m_nodes[result].m_index == result);
         return result;
     }
 
@@ -1531,32 +1544,24 @@ namespace dd {
         }
     }
 
-    void pdd_manager::gc() {
+    //
+    // Begin a collection cycle: mark the nodes reachable from live pdds
+    // and schedule all table shards for sweeping. Nodes created while
+    // the cycle is in progress are allocated black (see insert_node),
+    // so the sweep can be spread over subsequent allocations.
+    //
+    void pdd_manager::start_sweep() {
+        SASSERT(!sweep_in_progress());
         m_gc_generation++;
         init_dmark();
-        m_free_nodes.reset();
         SASSERT(well_formed());
         IF_VERBOSE(13, verbose_stream() << "(pdd :gc " << m_nodes.size() << ")\n";);
-        bool_vector reachable(m_nodes.size(), false);
-        compute_reachable(reachable);
-        for (unsigned i = m_nodes.size(); i-- > pdd_no_op; ) {
-            if (!reachable[i]) {
-                if (is_val(i)) {
-                    if (m_freeze_value == val(i)) continue;
-                    m_free_values.push_back(m_mpq_table.find(val(i)).m_value_index);
-                    m_mpq_table.remove(val(i));  
-                }
-                m_nodes[i].set_internal();
-                SASSERT(m_nodes[i].m_refcount == 0);
-                m_free_nodes.push_back(i);       
-            }
-        }
-        // sort free nodes so that adjacent nodes are picked in order of use
-        std::sort(m_free_nodes.begin(), m_free_nodes.end());
-        m_free_nodes.reverse();
+        m_reachable.reset();
+        m_reachable.resize(m_nodes.size(), false);
+        compute_reachable(m_reachable);
 
         ptr_vector<op_entry> to_delete, to_keep;
-        for (auto* e : m_op_cache) {            
+        for (auto* e : m_op_cache) {
             if (e->m_result != null_pdd) {
                 to_delete.push_back(e);
             }
@@ -1574,14 +1579,53 @@ namespace dd {
 
         m_factor_cache.reset();
 
-        m_node_table.reset();
-        // re-populate node cache
+        m_sweep_shard = 0;
+    }
+
+    //
+    // Sweep the next shard of the unique table: recycle the unreachable
+    // nodes whose level is mapped to the shard and re-populate the shard
+    // with the surviving nodes.
+    //
+    void pdd_manager::sweep_shard() {
+        SASSERT(sweep_in_progress());
+        unsigned shard = m_sweep_shard++;
+        node_table& table = m_node_tables[shard];
+        table.reset();
+        unsigned old_sz = m_free_nodes.size();
         for (unsigned i = m_nodes.size(); i-- > 2; ) {
-            if (reachable[i]) {
-                SASSERT(m_nodes[i].m_index == i);
-                m_node_table.insert(m_nodes[i]);
+            node& n = m_nodes[i];
+            if (n.m_level % num_node_shards != shard)
+                continue;
+            if (n.is_internal())
+                continue;
+            if (i < m_reachable.size() && !m_reachable[i]) {
+                if (i < pdd_no_op)
+                    continue;
+                if (is_val(i)) {
+                    if (m_freeze_value == val(i)) continue;
+                    m_free_values.push_back(m_mpq_table.find(val(i)).m_value_index);
+                    m_mpq_table.remove(val(i));
+                }
+                n.set_internal();
+                SASSERT(n.m_refcount == 0);
+                m_free_nodes.push_back(i);
+            }
+            else {
+                SASSERT(n.m_index == i);
+                table.insert(n);
             }
         }
+        // sort free nodes so that adjacent nodes are picked in order of use
+        std::sort(m_free_nodes.begin() + old_sz, m_free_nodes.end());
+        std::reverse(m_free_nodes.begin() + old_sz, m_free_nodes.end());
+    }
+
+    void pdd_manager::gc() {
+        if (!sweep_in_progress())
+            start_sweep();
+        while (sweep_in_progress())
+            sweep_shard();
         SASSERT(well_formed());
     }
 
@@ -1673,7 +1717,13 @@ namespace dd {
                 return false;
             }
         }
-        for (node const& n : m_nodes) {
+        for (unsigned i = 0; i < m_nodes.size(); ++i) {
+            node const& n = m_nodes[i];
+            if (sweep_in_progress() && i < m_reachable.size() && !m_reachable[i]) {
+                // unreachable node whose shard has not been swept yet;
+                // its children may already have been recycled.
+                continue;
+            }
             if (!well_formed(n)) {
                 IF_VERBOSE(0, display(verbose_stream() << n.m_index << " lo " << n.m_lo << " hi " << n.m_hi << "\n"););
                 UNREACHABLE();
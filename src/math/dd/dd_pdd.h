@@ -185,7 +185,8 @@ namespace dd {
         vector<rational>           m_values;
         op_table                   m_op_cache;
         factor_table               m_factor_cache;
-        node_table                 m_node_table;
+        static const unsigned      num_node_shards = 16;
+        node_table                 m_node_tables[num_node_shards]; // unique table sharded by variable level
         mpq_table                  m_mpq_table;
         svector<PDD>               m_pdd_stack;
         op_entry*                  m_spare_entry;
@@ -210,6 +211,13 @@ namespace dd {
         rational                   m_max_value;
         unsigned                   m_gc_generation = 0;  ///< will be incremented on each GC
 
+        // Incremental GC state. A collection cycle marks the reachable
+        // nodes once and then sweeps the unique table one shard at a
+        // time, so the pause taken on a single allocation is bounded by
+        // a shard instead of the whole table.
+        bool_vector                m_reachable;          ///< valid while a sweep cycle is in progress
+        unsigned                   m_sweep_shard = num_node_shards; ///< next shard to sweep; == num_node_shards when no cycle is in progress
+
         void reset_op_cache();
         void init_nodes(unsigned_vector const& l2v);
         void init_vars(unsigned_vector const& l2v);
@@ -287,6 +295,9 @@ namespace dd {
 
         bool is_reachable(PDD p);
         void compute_reachable(bool_vector& reachable);
+        bool sweep_in_progress() const { return m_sweep_shard < num_node_shards; }
+        void start_sweep();
+        void sweep_shard();
         void try_gc();
         void reserve_var(unsigned v);
         bool well_formed();
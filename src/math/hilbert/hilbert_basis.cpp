@@ -23,6 +23,11 @@ Revision History:
 #include "math/hilbert/heap_trie.h"
 #include "util/stopwatch.h"
 
+#ifndef SINGLE_THREAD
+#include <atomic>
+#include <thread>
+#endif
+
 
 typedef int_hashtable<int_hash, default_eq<int> > int_table;
 
@@ -836,14 +841,10 @@ lbool hilbert_basis::saturate_orig(num_vector const& ineq, bool is_eq) {
     m_index->reset(m_current_ineq+1);
     int_table support;
     TRACE("hilbert_basis", display_ineq(tout, ineq, is_eq););
+    compute_weights(ineq);
     iterator it = begin();
     for (; it != end(); ++it) {
         offset_t idx = *it;
-        values v = vec(idx);
-        v.weight() = get_weight(v, ineq);
-        for (unsigned k = 0; k < m_current_ineq; ++k) {
-            v.weight(k) = get_weight(v, m_ineqs[k]);        
-        }
         add_goal(idx);
         if (m_use_support) {
             support.insert(idx.m_offset);
@@ -910,13 +911,10 @@ lbool hilbert_basis::saturate(num_vector const& ineq, bool is_eq) {
     m_sos.reset();
     TRACE("hilbert_basis", display_ineq(tout, ineq, is_eq););
     unsigned init_basis_size = 0;
+    compute_weights(ineq);
     for (unsigned i = 0; i < m_basis.size(); ++i) {
         offset_t idx = m_basis[i];
         values v = vec(idx);
-        v.weight() = get_weight(v, ineq);
-        for (unsigned k = 0; k < m_current_ineq; ++k) {
-            v.weight(k) = get_weight(v, m_ineqs[k]);        
-        }
         m_index->insert(idx, v);
         if (v.weight().is_zero()) {
             m_zero.push_back(idx);
@@ -1183,6 +1181,46 @@ hilbert_basis::numeral hilbert_basis::get_weight(values const & val, num_vector
     return result;
 }
 
+void hilbert_basis::update_weights(offset_t idx, num_vector const& ineq) {
+    values v = vec(idx);
+    v.weight() = get_weight(v, ineq);
+    for (unsigned k = 0; k < m_current_ineq; ++k) {
+        v.weight(k) = get_weight(v, m_ineqs[k]);
+    }
+}
+
+void hilbert_basis::compute_weights(num_vector const& ineq) {
+#ifndef SINGLE_THREAD
+    // weights of distinct basis vectors are written into disjoint slices
+    // of the store, so they are computed in parallel on wide bases.
+    static const unsigned min_parallel_work = 1 << 16;
+    unsigned num_threads = std::min(m_basis.size(), (unsigned) std::thread::hardware_concurrency());
+    unsigned work = m_basis.size() * (m_current_ineq + 1) * get_num_vars();
+    if (num_threads >= 2 && work >= min_parallel_work) {
+        std::atomic<bool> overflow(false);
+        vector<std::thread> threads;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            threads.push_back(std::thread([&, t]() {
+                try {
+                    for (unsigned i = t; i < m_basis.size(); i += num_threads)
+                        update_weights(m_basis[i], ineq);
+                }
+                catch (...) {
+                    overflow = true;
+                }
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        if (overflow)
+            throw checked_int64<check>::overflow_exception();
+        return;
+    }
+#endif
+    for (unsigned i = 0; i < m_basis.size(); ++i)
+        update_weights(m_basis[i], ineq);
+}
+
 void hilbert_basis::display(std::ostream& out) const {
     out << "inequalities:\n";
     for (unsigned i = 0; i < m_ineqs.size(); ++i) {
@@ -1320,7 +1358,24 @@ bool hilbert_basis::is_subsumed(offset_t i, offset_t j) const {
 
 bool hilbert_basis::is_geq(values const& v, values const& w) const {
     unsigned nv = get_num_vars();
-    for (unsigned i = 0; i < nv; ++i) {
+    // the store is contiguous; compare blocks branch-free over the raw
+    // representation so the compiler can vectorize the flag accumulation,
+    // keeping an early exit per block.
+    numeral const* vp = v();
+    numeral const* wp = w();
+    unsigned i = 0;
+    for (; i + 8 <= nv; i += 8) {
+        bool ok = true;
+        for (unsigned j = i; j < i + 8; ++j) {
+            int64_t a = vp[j].get_int64();
+            int64_t b = wp[j].get_int64();
+            ok = ok & (b < 0 ? a <= b : a >= b);
+        }
+        if (!ok) {
+            return false;
+        }
+    }
+    for (; i < nv; ++i) {
         if (!is_abs_geq(v[i], w[i])) {
             return false;
         }
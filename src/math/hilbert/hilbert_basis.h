@@ -132,6 +132,8 @@ class hilbert_basis {
     void add_unit_vector(unsigned i, numeral const& e);
     unsigned get_num_vars() const;
     numeral get_weight(values const & val, num_vector const& ineq) const;
+    void update_weights(offset_t idx, num_vector const& ineq);
+    void compute_weights(num_vector const& ineq);
     bool is_geq(values const& v, values const& w) const;
     bool is_abs_geq(numeral const& v, numeral const& w) const;
     bool is_subsumed(offset_t idx);
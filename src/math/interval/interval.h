@@ -257,6 +257,16 @@ public:
     void add(interval const & a, interval const & b, interval & c);
     void add_jst(interval const & a, interval const & b, interval_deps_combine_rule & c_deps);
 
+    /**
+       \brief Accumulate one directed bound of k*a into the mutable interval t:
+       t.lower += lower(k*a) if is_upper is false, and t.upper += upper(k*a) otherwise.
+       The caller is responsible for setting the rounding mode for the whole batch
+       of accumulations: to minus infinity for lower bounds, and to plus infinity
+       for upper bounds. Thus, a linear form can be evaluated with one rounding
+       mode switch per direction instead of several per term.
+    */
+    void add_mul_bound(bool is_upper, numeral const & k, interval const & a, interval & t);
+
     /**
        \brief c <- a - b
     */
@@ -816,6 +816,35 @@ void interval_manager<C>::add(interval const & a, interval const & b, interval &
     SASSERT(check_invariant(c));
 }
 
+template<typename C>
+void interval_manager<C>::add_mul_bound(bool is_upper, numeral const & k, interval const & a, interval & t) {
+    if (m().is_zero(k))
+        return;
+    // k > 0: the bound of k*a in a given direction comes from the bound of a in the same direction.
+    // k < 0: it comes from the opposite bound of a.
+    bool use_upper       = m().is_pos(k) == is_upper;
+    numeral const & b    = use_upper ? upper(a) : lower(a);
+    ext_numeral_kind b_k = use_upper ? upper_kind(a) : lower_kind(a);
+    bool b_o             = use_upper ? upper_is_open(a) : lower_is_open(a);
+    ext_numeral_kind new_k;
+    if (is_upper) {
+        if (upper_is_inf(t))
+            return;
+        ::mul(m(), b, b_k, k, EN_NUMERAL, m_result_upper, new_k);
+        ::add(m(), upper(t), upper_kind(t), m_result_upper, new_k, upper(t), new_k);
+        set_upper_is_inf(t, new_k == EN_PLUS_INFINITY);
+        set_upper_is_open(t, upper_is_open(t) || b_o);
+    }
+    else {
+        if (lower_is_inf(t))
+            return;
+        ::mul(m(), b, b_k, k, EN_NUMERAL, m_result_lower, new_k);
+        ::add(m(), lower(t), lower_kind(t), m_result_lower, new_k, lower(t), new_k);
+        set_lower_is_inf(t, new_k == EN_MINUS_INFINITY);
+        set_lower_is_open(t, lower_is_open(t) || b_o);
+    }
+}
+
 template<typename C>
 void interval_manager<C>::sub_jst(interval const & a, interval const & b, interval_deps_combine_rule & c_deps) {
     c_deps.m_lower_combine = DEP_IN_LOWER1 | DEP_IN_UPPER2;
@@ -154,11 +154,13 @@ template <typename T, typename X> void dense_matrix<T, X>::apply_from_left_to_X(
 //   alpha and adding it to row i0.
 template <typename T, typename X> void dense_matrix<T, X>::pivot_row_to_row(unsigned i, const T& alpha, unsigned i0,
                                                                             const double & pivot_epsilon) {
+    // Row base pointers instead of per-element index arithmetic: the body
+    // becomes a plain saxpy-with-drop that the compiler can vectorize.
+    T * r0      = m_values.data() + i0 * m_n;
+    T const * r = m_values.data() + i * m_n;
     for (unsigned j = 0; j < m_n; j++) {
-        m_values[i0 * m_n + j] += m_values[i * m_n + j] * alpha;
-        if (fabs(m_values[i0 + m_n + j]) < pivot_epsilon) {
-            m_values[i0 + m_n + j] = numeric_traits<T>::zero();;
-        }
+        T t = r0[j] + r[j] * alpha;
+        r0[j] = fabs(t) < pivot_epsilon ? numeric_traits<T>::zero() : t;
     }
 }
 
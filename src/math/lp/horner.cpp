@@ -67,6 +67,30 @@ bool horner::row_is_interesting(const T& row) const {
     return false;
 }
 
+// Fingerprint of the state the lemmas of a row depend on: its entries, the
+// variables of its monics, and the bounds of the occurring columns. A row
+// whose fingerprint has not changed since an unproductive attempt is skipped
+// by horner_lemmas until its state changes.
+template <typename T>
+std::size_t horner::row_fingerprint(const T& row) const {
+    std::size_t seed = 0;
+    auto hash_var = [&](lpvar j) {
+        hash_combine(seed, j);
+        if (c().has_lower_bound(j))
+            hash_combine(seed, c().get_lower_bound(j));
+        if (c().has_upper_bound(j))
+            hash_combine(seed, c().get_upper_bound(j));
+    };
+    for (const auto& p : row) {
+        hash_combine(seed, p.coeff());
+        hash_var(p.var());
+        if (c().is_monic_var(p.var()))
+            for (lpvar k : c().emons()[p.var()].vars())
+                hash_var(k);
+    }
+    return seed;
+}
+
 bool horner::lemmas_on_expr(cross_nested& cn, nex_sum* e) {
     TRACE("nla_horner", tout << "e = " << *e << "\n";);
     cn.run(e);
@@ -122,9 +146,18 @@ bool horner::horner_lemmas() {
     bool conflict = false;
     for (unsigned i = 0; i < sz && !conflict; i++) {
         m_row_index = rows[(i + r) % sz];
-        if (lemmas_on_row(matrix.m_rows[m_row_index])) {
+        const auto& row = matrix.m_rows[m_row_index];
+        std::size_t fp = row_fingerprint(row);
+        auto it = m_row_fingerprints.find(m_row_index);
+        if (it != m_row_fingerprints.end() && it->second == fp)
+            continue;
+        if (lemmas_on_row(row)) {
             c().lp_settings().stats().m_horner_conflicts++;
             conflict = true;
+            m_row_fingerprints.erase(m_row_index);
+        }
+        else {
+            m_row_fingerprints[m_row_index] = fp;
         }
     }
     return conflict;
@@ -19,6 +19,8 @@
   --*/
 #pragma once
 
+#include <unordered_map>
+
 #include "math/lp/nla_common.h"
 #include "math/lp/nla_intervals.h"
 #include "math/lp/nex.h"
@@ -31,7 +33,9 @@ class core;
 
 class horner : common {
     nex_creator::sum_factory  m_row_sum;
-    unsigned         m_row_index;                      
+    unsigned         m_row_index;
+    // row index -> fingerprint of the last unproductive attempt on the row
+    std::unordered_map<unsigned, std::size_t> m_row_fingerprints;
 public:
     typedef intervals::interval interv;
     horner(core *core);
@@ -39,6 +43,7 @@ public:
     template <typename T> // T has an iterator of (coeff(), var())
     bool lemmas_on_row(const T&);
     template <typename T>  bool row_is_interesting(const T&) const;
+    template <typename T>  std::size_t row_fingerprint(const T&) const;
 
     
     intervals::interval interval_of_sum_with_deps(const nex_sum*);
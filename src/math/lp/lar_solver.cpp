@@ -1,4 +1,5 @@
 #include "math/lp/lar_solver.h"
+#include "util/self_profiler.h"
 #include "smt/params/smt_params_helper.hpp"
 
 /*
@@ -192,6 +193,7 @@ namespace lp {
     void lar_solver::set_status(lp_status s) { m_status = s; }
 
     lp_status lar_solver::find_feasible_solution() {
+        scoped_profile_tag _prof(self_profiler::SUB_ARITH);
         stats().m_make_feasible++;
         if (A_r().column_count() > stats().m_max_cols)
             stats().m_max_cols = A_r().column_count();
@@ -242,6 +244,8 @@ namespace lp {
         m_term_count.push();
         m_constraints.push();
         m_usage_in_terms.push();
+        m_fixed_var_trail_size = m_fixed_var_trail.size();
+        m_fixed_var_trail_size.push();
     }
     
     void lar_solver::clean_popped_elements(unsigned n, u_set& set) {
@@ -263,6 +267,9 @@ namespace lp {
         TRACE("lar_solver", tout << "k = " << k << std::endl;);
         m_crossed_bounds_column.pop(k);
         unsigned n = m_columns_to_ul_pairs.peek_size(k);
+        stats().m_num_of_pops++;
+        if (A_r().column_count() == n)
+            stats().m_bound_only_pops++; // the basis survives these pops intact
         m_var_register.shrink(n);
         if (m_settings.use_tableau()) 
             pop_tableau();
@@ -275,7 +282,8 @@ namespace lp {
         m_columns_to_ul_pairs.pop(k);
 
         m_mpq_lar_core_solver.pop(k);
-        remove_non_fixed_from_fixed_var_table();
+        m_fixed_var_trail_size.pop(k);
+        clean_fixed_var_tables_after_pop();
         clean_popped_elements(n, m_columns_with_changed_bounds);
         clean_popped_elements(n, m_incorrect_columns);
 
@@ -1836,21 +1844,18 @@ namespace lp {
         return ci;
     }
 
-    template <typename T>
-    void lar_solver::remove_non_fixed_from_table(T& table) {
-        vector<mpq> to_remove;
-        for (const auto& p : table) {
-            unsigned j = p.m_value;
-            if (j >= column_count() || !column_is_fixed(j))
-                to_remove.push_back(p.m_key);
+    // Entries present at push time keep pointing at fixed columns after the
+    // matching pop, because pop restores exactly the bounds under which they
+    // were registered. Only entries added since the push are revisited.
+    void lar_solver::clean_fixed_var_tables_after_pop() {
+        for (unsigned i = m_fixed_var_trail.size(); i-- > m_fixed_var_trail_size; ) {
+            auto const& p = m_fixed_var_trail[i];
+            auto& table = p.first ? m_fixed_var_table_int : m_fixed_var_table_real;
+            unsigned j;
+            if (table.find(p.second, j) && (j >= column_count() || !column_is_fixed(j)))
+                table.erase(p.second);
         }
-        for (const auto& p : to_remove)
-            table.erase(p);
-    }
-
-    void lar_solver::remove_non_fixed_from_fixed_var_table() {
-        remove_non_fixed_from_table(m_fixed_var_table_int);
-        remove_non_fixed_from_table(m_fixed_var_table_real);
+        m_fixed_var_trail.shrink(m_fixed_var_trail_size);
     }
 
     void lar_solver::register_in_fixed_var_table(unsigned j, unsigned& equal_to_j) {
@@ -1866,12 +1871,14 @@ namespace lp {
         if (j_is_int) {
             if (!m_fixed_var_table_int.find(key, k)) {
                 m_fixed_var_table_int.insert(key, j);
+                m_fixed_var_trail.push_back(std::make_pair(true, key));
                 return;
             }
         }
         else { // j is not integral column        
             if (!m_fixed_var_table_real.find(key, k)) {
                 m_fixed_var_table_real.insert(key, j);
+                m_fixed_var_trail.push_back(std::make_pair(false, key));
                 return;
             }
         }
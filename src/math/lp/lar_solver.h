@@ -110,6 +110,11 @@ class lar_solver : public column_namer {
     map<mpq, unsigned, obj_hash<mpq>, default_eq<mpq>>  m_fixed_var_table_int;
     // maps values to non-integral fixed vars
     map<mpq, unsigned, obj_hash<mpq>, default_eq<mpq>>  m_fixed_var_table_real;
+    // keys (is_int, value) inserted into the fixed var tables since the last
+    // push; only these entries can become stale on pop, so pop revisits them
+    // instead of scanning the whole tables.
+    vector<std::pair<bool, mpq>>                        m_fixed_var_trail;
+    stacked_value<unsigned>                             m_fixed_var_trail_size;
     // end of fields
 
     ////////////////// methods ////////////////////////////////
@@ -152,7 +157,6 @@ class lar_solver : public column_namer {
     void update_bound_with_ub_no_lb(var_index j, lconstraint_kind kind, const mpq & right_side, constraint_index constr_index);
     void update_bound_with_no_ub_no_lb(var_index j, lconstraint_kind kind, const mpq & right_side, constraint_index constr_index);
     void register_in_fixed_var_table(unsigned, unsigned&);
-    void remove_non_fixed_from_fixed_var_table();
     constraint_index add_var_bound_on_constraint_for_term(var_index j, lconstraint_kind kind, const mpq & right_side);
     inline void set_infeasible_column(unsigned j) {
         set_status(lp_status::INFEASIBLE);
@@ -316,7 +320,7 @@ public:
         return is_int? fixed_var_table_int().find(mpq, j) : fixed_var_table_real().find(mpq, j);
     }
     
-    template <typename T> void remove_non_fixed_from_table(T&);
+    void clean_fixed_var_tables_after_pop();
 
     unsigned external_to_column_index(unsigned) const;
 
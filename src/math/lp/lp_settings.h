@@ -127,11 +127,15 @@ struct statistics {
     unsigned m_grobner_calls;
     unsigned m_grobner_conflicts;
     unsigned m_offset_eqs;
+    unsigned m_num_of_pops;
+    unsigned m_bound_only_pops; // pops that removed no columns and kept the basis
     statistics() { reset(); }
     void reset() { memset(this, 0, sizeof(*this)); }
     void collect_statistics(::statistics& st) const {
         st.update("arith-factorizations", m_num_factorizations);
         st.update("arith-make-feasible", m_make_feasible);
+        st.update("arith-pops", m_num_of_pops);
+        st.update("arith-pops-bound-only", m_bound_only_pops);
         st.update("arith-max-columns", m_max_cols);
         st.update("arith-max-rows", m_max_rows);
         st.update("arith-gcd-calls", m_gcd_calls);
@@ -90,21 +90,19 @@ template <typename T, typename X>    void square_dense_submatrix<T, X>::pivot_ro
     T m = m_v[row_offset + pjd];
     lp_assert(!is_zero(pivot));
     m_v[row_offset + pjd] = -m * pivot; // creating L matrix
-    for (unsigned j = m_index_start; j < m_parent->dimension(); j++) {
-        if (j == pj) {
-            pivot_row_offset++;
-            row_offset++;
-            continue;
-        }
-        auto t = m_v[row_offset] - m_v[pivot_row_offset] * m;
-        if (settings.abs_val_is_smaller_than_drop_tolerance(t)) {
-            m_v[row_offset] = zero_of_type<T>();
-        } else {
-            m_v[row_offset] = t;
+    // Update the row in two branch-free stretches around the pivot column so
+    // the inner loop is a straight elimination step the compiler can
+    // vectorize; at the same time we pivot the L too.
+    auto update_range = [&](unsigned from, unsigned to) {
+        unsigned ro = row_offset + (from - m_index_start);
+        unsigned po = pivot_row_offset + (from - m_index_start);
+        for (unsigned j = from; j < to; j++, ro++, po++) {
+            auto t = m_v[ro] - m_v[po] * m;
+            m_v[ro] = settings.abs_val_is_smaller_than_drop_tolerance(t) ? zero_of_type<T>() : t;
         }
-        row_offset++; pivot_row_offset++;
-        // at the same time we pivot the L too
-    }
+    };
+    update_range(m_index_start, pj);
+    update_range(pj + 1, m_parent->dimension());
 }
 
 template <typename T, typename X>    void square_dense_submatrix<T, X>::divide_row_by_pivot(unsigned i) {
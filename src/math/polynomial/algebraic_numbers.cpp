@@ -16,6 +16,7 @@ Author:
 Notes:
 
 --*/
+#include <cmath>
 #include "util/mpbq.h"
 #include "util/basic_interval.h"
 #include "util/scoped_ptr_vector.h"
@@ -26,6 +27,7 @@ Notes:
 #include "math/polynomial/upolynomial.h"
 #include "math/polynomial/sexpr2upolynomial.h"
 #include "math/polynomial/algebraic_params.hpp"
+#include "util/chashtable.h"
 
 namespace algebraic_numbers {
 
@@ -84,6 +86,37 @@ namespace algebraic_numbers {
         polynomial::var          m_x;
         polynomial::var          m_y;
 
+        /**
+           Cache of Sturm-Tarski sequences used in the expensive case of compare_core.
+           nlsat repeatedly compares roots of the same pair of defining polynomials
+           while refining their isolating intervals, and recomputing the sequence
+           from scratch dominates the cost of sign determination on such traces.
+           Each entry owns copies of both polynomials and the resulting sequence.
+        */
+        struct sturm_tarski_entry {
+            upoly       m_p1;
+            upoly       m_p2;
+            unsigned    m_hash;
+            upolynomial::scoped_upolynomial_sequence * m_seq;
+
+            sturm_tarski_entry(unsigned h):m_hash(h), m_seq(nullptr) {}
+
+            struct hash_proc { unsigned operator()(sturm_tarski_entry const * e) const { return e->m_hash; } };
+
+            struct eq_proc {
+                upoly_manager & m;
+                eq_proc(upoly_manager & _m):m(_m) {}
+                bool operator()(sturm_tarski_entry const * e1, sturm_tarski_entry const * e2) const {
+                    return m.eq(e1->m_p1, e2->m_p1) && m.eq(e1->m_p2, e2->m_p2);
+                }
+            };
+        };
+
+        typedef chashtable<sturm_tarski_entry*, sturm_tarski_entry::hash_proc, sturm_tarski_entry::eq_proc> sturm_tarski_cache;
+
+        sturm_tarski_cache       m_sturm_tarski_cache;
+        static const unsigned    m_sturm_tarski_cache_max = 1024;
+
         // configuration
         int                        m_min_magnitude;
         bool                       m_factor;
@@ -93,6 +126,7 @@ namespace algebraic_numbers {
         // statistics
         unsigned                 m_compare_cheap;
         unsigned                 m_compare_sturm;
+        unsigned                 m_compare_sturm_cached;
         unsigned                 m_compare_refine;
         unsigned                 m_compare_poly_eq;
 
@@ -114,7 +148,8 @@ namespace algebraic_numbers {
             m_isolate_roots(bqm()),
             m_isolate_lowers(bqm()),
             m_isolate_uppers(bqm()),
-            m_add_tmp(upm()) {
+            m_add_tmp(upm()),
+            m_sturm_tarski_cache(sturm_tarski_entry::hash_proc(), sturm_tarski_entry::eq_proc(m_upmanager)) {
             updt_params(p);
             reset_statistics();
             m_x = pm().mk_var();
@@ -122,6 +157,59 @@ namespace algebraic_numbers {
         }
 
         ~imp() {
+            reset_sturm_tarski_cache();
+        }
+
+        void del_sturm_tarski_entry(sturm_tarski_entry * entry) {
+            upm().reset(entry->m_p1);
+            upm().reset(entry->m_p2);
+            dealloc(entry->m_seq);
+            entry->~sturm_tarski_entry();
+            m_allocator.deallocate(sizeof(sturm_tarski_entry), entry);
+        }
+
+        void reset_sturm_tarski_cache() {
+            sturm_tarski_cache::iterator it  = m_sturm_tarski_cache.begin();
+            sturm_tarski_cache::iterator end = m_sturm_tarski_cache.end();
+            for (; it != end; ++it) {
+                del_sturm_tarski_entry(*it);
+            }
+            m_sturm_tarski_cache.reset();
+        }
+
+        static unsigned upoly_hash(unsigned sz, mpz const * p) {
+            unsigned r = 17;
+            for (unsigned i = 0; i < sz; i++)
+                r = combine_hash(r, unsynch_mpz_manager::hash(p[i]));
+            return r;
+        }
+
+        /**
+           \brief Return the Sturm-Tarski sequence for p_a, p_a' * p_b, computing it
+           only if it is not already in m_sturm_tarski_cache. The returned reference
+           is valid until the next call to this method.
+        */
+        upolynomial::upolynomial_sequence const & sturm_tarski_seq(algebraic_cell const * cell_a, algebraic_cell const * cell_b) {
+            if (m_sturm_tarski_cache.size() > m_sturm_tarski_cache_max)
+                reset_sturm_tarski_cache();
+            unsigned h = combine_hash(upoly_hash(cell_a->m_p_sz, cell_a->m_p), upoly_hash(cell_b->m_p_sz, cell_b->m_p));
+            sturm_tarski_entry * entry = new (m_allocator.allocate(sizeof(sturm_tarski_entry))) sturm_tarski_entry(h);
+            upm().set(cell_a->m_p_sz, cell_a->m_p, entry->m_p1);
+            upm().set(cell_b->m_p_sz, cell_b->m_p, entry->m_p2);
+            sturm_tarski_entry * old_entry = m_sturm_tarski_cache.insert_if_not_there(entry);
+            if (entry != old_entry) {
+                del_sturm_tarski_entry(entry);
+                if (old_entry->m_seq != nullptr) {
+                    m_compare_sturm_cached++;
+                    return *(old_entry->m_seq);
+                }
+                // A previous attempt to compute the sequence for this pair was canceled.
+                entry = old_entry;
+            }
+            scoped_ptr<upolynomial::scoped_upolynomial_sequence> seq = alloc(upolynomial::scoped_upolynomial_sequence, upm());
+            upm().sturm_tarski_seq(cell_a->m_p_sz, cell_a->m_p, cell_b->m_p_sz, cell_b->m_p, *seq);
+            entry->m_seq = seq.detach();
+            return *(entry->m_seq);
         }
 
         bool acell_inv(algebraic_cell const& c) {
@@ -137,6 +225,7 @@ namespace algebraic_numbers {
         void reset_statistics() {
             m_compare_cheap   = 0;
             m_compare_sturm   = 0;
+            m_compare_sturm_cached = 0;
             m_compare_refine  = 0;
             m_compare_poly_eq = 0;
         }
@@ -145,6 +234,7 @@ namespace algebraic_numbers {
 #ifndef _EXTERNAL_RELEASE
             st.update("algebraic compare cheap", m_compare_cheap);
             st.update("algebraic compare sturm", m_compare_sturm);
+            st.update("algebraic compare sturm cached", m_compare_sturm_cached);
             st.update("algebraic compare refine", m_compare_refine);
             st.update("algebraic compare poly", m_compare_poly_eq);
 #endif
@@ -1891,8 +1981,7 @@ namespace algebraic_numbers {
 
 
             m_compare_sturm++;
-            upolynomial::scoped_upolynomial_sequence seq(upm());
-            upm().sturm_tarski_seq(cell_a->m_p_sz, cell_a->m_p, cell_b->m_p_sz, cell_b->m_p, seq);
+            upolynomial::upolynomial_sequence const & seq = sturm_tarski_seq(cell_a, cell_b);
             unsigned V1 = upm().sign_variations_at(seq, a_lower);
             unsigned V2 = upm().sign_variations_at(seq, a_upper);            
             int V =  V1 - V2;
@@ -2082,10 +2171,73 @@ namespace algebraic_numbers {
             }
         };
 
+        /**
+           \brief Try to determine the sign of p at x2v using double precision
+           arithmetic with a dynamic bound on the accumulated rounding error.
+           Succeeds only when all variables of p are assigned small rational
+           values, and the magnitude of the computed value exceeds the error
+           bound (i.e., the sign is certain). Return true (and store the sign
+           in r) on success.
+
+           Machine integers convert to double exactly, and small rationals with
+           a single rounding, so each conversion contributes at most one ulp to
+           the error bound. Values that are not small are rejected since
+           mpz_manager::get_double does not provide a relative error guarantee
+           for them.
+        */
+        bool eval_sign_filter(polynomial_ref const & p, polynomial::var2anum const & x2v, ::sign & r) {
+            polynomial::manager & ext_pm = p.m();
+            double const u   = std::numeric_limits<double>::epsilon();
+            double const tiny = std::numeric_limits<double>::min(); // absorbs underflow to subnormals
+            double val = 0.0; // running value of p
+            double err = 0.0; // bound on |exact value - val|
+            unsigned sz = ext_pm.size(p);
+            for (unsigned i = 0; i < sz; i++) {
+                if (!ext_pm.m().is_small(ext_pm.coeff(p, i)))
+                    return false;
+                double m_val = ext_pm.m().get_double(ext_pm.coeff(p, i)); // exact: small mpz fits in the mantissa
+                double m_err = 0.0;
+                polynomial::monomial * mon = ext_pm.get_monomial(p, i);
+                unsigned msz = ext_pm.size(mon);
+                for (unsigned j = 0; j < msz; j++) {
+                    polynomial::var x = ext_pm.get_var(mon, j);
+                    if (!x2v.contains(x))
+                        return false;
+                    anum const & v = x2v(x);
+                    if (!v.is_basic() || !qm().is_small(basic_value(v)))
+                        return false;
+                    double x_val = qm().get_double(basic_value(v));
+                    double x_err = std::fabs(x_val) * u + tiny;
+                    unsigned d   = ext_pm.degree(mon, j);
+                    for (unsigned k = 0; k < d; k++) {
+                        double new_val = m_val * x_val;
+                        m_err = std::fabs(m_val) * x_err + std::fabs(x_val) * m_err + m_err * x_err + std::fabs(new_val) * u + tiny;
+                        m_val = new_val;
+                    }
+                }
+                double new_val = val + m_val;
+                err += m_err + std::fabs(new_val) * u + tiny;
+                val  = new_val;
+            }
+            if (!std::isfinite(val) || !std::isfinite(err))
+                return false;
+            if (std::fabs(val) <= err)
+                return false; // too close to zero, the sign is not certain
+            r = val > 0.0 ? sign_pos : sign_neg;
+            return true;
+        }
+
         polynomial::var_vector m_eval_sign_vars;
         sign eval_sign_at(polynomial_ref const & p, polynomial::var2anum const & x2v) {
             polynomial::manager & ext_pm = p.m();
             TRACE("anum_eval_sign", tout << "evaluating sign of: " << p << "\n";);
+            {
+                ::sign r;
+                if (eval_sign_filter(p, x2v, r)) {
+                    TRACE("anum_eval_sign", tout << "sign determined by floating point filter: " << r << "\n";);
+                    return r;
+                }
+            }
             while (true) {
                 bool restart = false;
                 // Optimistic: maybe x2v contains only rational values
@@ -5692,16 +5692,25 @@ namespace realclosure {
                     return qm().lt(to_mpq(a), to_mpq(b)) ? -1 : 1;
             }
             else {
-                // FUTURE: try to refine interval before switching to sub+sign approach
                 if (bqim().before(interval(a), interval(b)))
                     return -1;
                 else if (bqim().before(interval(b), interval(a)))
                     return 1;
-                else {
-                    value_ref diff(*this);
-                    sub(a, b, diff);
-                    return sign(diff);
+                // Try to separate the cached intervals with budgeted refinement
+                // before switching to the sub+sign approach. Creating a - b
+                // allocates a new rational function value and may trigger the
+                // expensive (Tarski query based) sign determination machinery.
+                for (unsigned prec = 1; prec <= m_max_precision; prec++) {
+                    if (!refine_interval(a, prec) || !refine_interval(b, prec))
+                        break; // interval end-points can't separate values that depend on infinitesimals
+                    if (bqim().before(interval(a), interval(b)))
+                        return -1;
+                    if (bqim().before(interval(b), interval(a)))
+                        return 1;
                 }
+                value_ref diff(*this);
+                sub(a, b, diff);
+                return sign(diff);
             }
         }
 
@@ -82,7 +82,10 @@ struct bit_matrix::report {
 };
 
 void bit_matrix::solve() {
-    basic_solve();
+    if (m_rows.size() >= 32)
+        solve_4r();
+    else
+        basic_solve();
 }
 
 void bit_matrix::basic_solve() {
@@ -98,6 +101,117 @@ void bit_matrix::basic_solve() {
     }
 }
 
+/*
+  Gauss-Jordan elimination with the method of four Russians.
+  Pivot rows are gathered in blocks of up to k; the 2^k combinations of a
+  block are tabulated once following a Gray code (one row XOR per entry),
+  and every remaining row is then reduced with a single table lookup and
+  XOR instead of up to k row operations.
+*/
+void bit_matrix::solve_4r() {
+    report _report(*this);
+    unsigned num_rows = m_rows.size();
+    unsigned chunks = m_num_chunks;
+    unsigned k = 1;
+    while ((1u << k) < num_rows && k < 8)
+        ++k;
+
+    auto row_xor = [chunks](uint64_t* dst, uint64_t const* src) {
+        for (unsigned i = 0; i < chunks; ++i)
+            dst[i] ^= src[i];
+    };
+    auto leading_col = [chunks](uint64_t const* r) {
+        for (unsigned i = 0; i < chunks; ++i) {
+            if (r[i]) {
+                uint64_t w = r[i];
+                unsigned j = 0;
+                while (0 == (w & 1)) {
+                    w >>= 1;
+                    ++j;
+                }
+                return 64*i + j;
+            }
+        }
+        return UINT_MAX;
+    };
+    auto test = [](uint64_t const* r, unsigned c) {
+        return 0 != (r[c >> 6] & (1ull << (c & 63)));
+    };
+
+    svector<uint64_t> table;
+    table.resize((1u << k) * chunks, 0);
+    bool_vector settled(num_rows, false);
+    ptr_vector<uint64_t> pivots;
+    unsigned_vector pivot_cols, pivot_rows;
+
+    while (true) {
+        // gather up to k pivot rows, reducing each candidate against the
+        // pivots already chosen in this block.
+        pivots.reset();
+        pivot_cols.reset();
+        pivot_rows.reset();
+        for (unsigned i = 0; i < num_rows && pivots.size() < k; ++i) {
+            if (settled[i])
+                continue;
+            uint64_t* r = m_rows[i];
+            for (unsigned j = 0; j < pivots.size(); ++j)
+                if (test(r, pivot_cols[j]))
+                    row_xor(r, pivots[j]);
+            unsigned c = leading_col(r);
+            if (c == UINT_MAX) {
+                settled[i] = true;
+                continue;
+            }
+            pivots.push_back(r);
+            pivot_cols.push_back(c);
+            pivot_rows.push_back(i);
+            settled[i] = true;
+        }
+        unsigned p = pivots.size();
+        if (p == 0)
+            return;
+
+        // reduce the pivot rows against each other so that each one is the
+        // only block pivot with a bit in its pivot column.
+        for (unsigned i = p; i-- > 0; )
+            for (unsigned j = i + 1; j < p; ++j)
+                if (test(pivots[i], pivot_cols[j]))
+                    row_xor(pivots[i], pivots[j]);
+
+        // tabulate all 2^p pivot combinations along a Gray code.
+        unsigned_vector codes = gray(p);
+        svector<uint64_t> acc;
+        acc.resize(chunks, 0);
+        for (unsigned b = 0; b < p; ++b)
+            if (codes[0] & (1u << b))
+                row_xor(acc.data(), pivots[b]);
+        memcpy(table.data() + codes[0] * chunks, acc.data(), chunks * sizeof(uint64_t));
+        for (unsigned t = 1; t < codes.size(); ++t) {
+            unsigned diff = codes[t-1] ^ codes[t];
+            SASSERT(diff != 0 && 0 == (diff & (diff - 1)));
+            unsigned b = 0;
+            while (0 == (diff & (1u << b)))
+                ++b;
+            row_xor(acc.data(), pivots[b]);
+            memcpy(table.data() + codes[t] * chunks, acc.data(), chunks * sizeof(uint64_t));
+        }
+
+        // eliminate the block pivot columns from every other row with one
+        // table XOR per row.
+        for (unsigned i = 0; i < num_rows; ++i) {
+            uint64_t* r = m_rows[i];
+            if (pivot_rows.contains(i))
+                continue;
+            unsigned idx = 0;
+            for (unsigned j = 0; j < p; ++j)
+                if (test(r, pivot_cols[j]))
+                    idx |= 1u << j;
+            if (idx != 0)
+                row_xor(r, table.data() + idx * chunks);
+        }
+    }
+}
+
 std::ostream& bit_matrix::display(std::ostream& out) {
     for (row& r : *this) {
         out << r;
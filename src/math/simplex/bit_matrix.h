@@ -16,7 +16,8 @@ Author:
 Notes:
 
     Exposes Gauss-Jordan simplification.
-    Uses extremely basic implementation, can be tuned by 4R method.
+    Larger matrices are reduced with the method of four Russians;
+    small ones use the basic row-by-row elimination.
 
 --*/
 
@@ -103,6 +104,7 @@ public:
 
 private:
     void basic_solve();
+    void solve_4r();
     unsigned_vector gray(unsigned n);
 };
 
@@ -25,6 +25,22 @@ Notes:
 
 namespace simplex {
 
+    // The row addition kernel walks one row sequentially but indexes
+    // m_var_pos and m_columns by variable, which is effectively random.
+    // Touching the structures of the next entry one step ahead hides most of
+    // that latency on rows too large for the cache.
+    static inline void prefetch_addr(void const * p) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(static_cast<char const *>(p));
+#else
+    #if !defined(_M_ARM) && !defined(_M_ARM64)
+        _mm_prefetch(static_cast<char const *>(p), _MM_HINT_T1);
+    #else
+        (void)p;
+    #endif
+#endif
+    }
+
     // -----------------------------------
     //
     // Rows
@@ -324,7 +340,8 @@ namespace simplex {
             return;
         m_stats.m_add_rows++;
         _row & r1 = m_rows[row1.id()];
-        
+        _row & r2 = m_rows[row2.id()];
+
         r1.save_var_pos(m_var_pos, m_var_pos_idx);
 
         // 
@@ -337,6 +354,14 @@ namespace simplex {
         row_iterator end = row_end(row2);                               \
         for (; it != end; ++it) {                                       \
             var_t v = it->m_var;                                        \
+            unsigned nxt = it.m_curr + 1;                               \
+            if (nxt < r2.num_entries()) {                               \
+                var_t nv = r2.m_entries[nxt].m_var;                     \
+                if (nv != dead_id) {                                    \
+                    prefetch_addr(&m_var_pos[nv]);                      \
+                    prefetch_addr(&m_columns[nv]);                      \
+                }                                                       \
+            }                                                           \
             int pos = m_var_pos[v];                                     \
             if (pos == -1) {                                            \
                 /* variable v is not in row1 */                         \
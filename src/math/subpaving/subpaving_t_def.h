@@ -59,6 +59,36 @@ public:
     }
 };
 
+/**
+   \brief Node selector that interleaves depth-first and breadth-first search.
+   It selects the most recently created leaf (as in depth-first search, so the
+   bounds of its ancestors are still hot), and every m_period selections it
+   takes the oldest leaf instead. This mimics, in a single thread, the schedule
+   of a work-stealing exploration where a worker pops boxes from its own end of
+   the deque and idle workers steal the oldest ones.
+*/
+template<typename C>
+class interleaved_node_selector : public context_t<C>::node_selector {
+    typedef typename context_t<C>::node            node;
+    unsigned m_period;
+    unsigned m_counter;
+public:
+    interleaved_node_selector(context_t<C> * ctx, unsigned period):
+        context_t<C>::node_selector(ctx),
+        m_period(period),
+        m_counter(0) {
+    }
+
+    node * operator()(node * front, node * back) override {
+        m_counter++;
+        if (m_counter >= m_period) {
+            m_counter = 0;
+            return back;
+        }
+        return front;
+    }
+};
+
 /**
    Round robing variable selector.
    If only_non_def is true, then variable definitions (aka auxiliary variables) are ignored.
@@ -496,6 +526,12 @@ void context_t<C>::updt_params(params_ref const & p) {
     m_max_depth = p.get_uint("max_depth", 128);
     m_max_nodes = p.get_uint("max_nodes", 8192);
 
+    unsigned interleave = p.get_uint("interleave", 0);
+    if (interleave != 0)
+        m_node_selector = alloc(interleaved_node_selector<C>, this, interleave);
+    else
+        m_node_selector = alloc(breadth_first_node_selector<C>, this);
+
     m_max_memory = megabytes_to_bytes(p.get_uint("max_memory", UINT_MAX));
 
     unsigned prec = p.get_uint("nth_root_precision", 8192);
@@ -509,6 +545,7 @@ template<typename C>
 void context_t<C>::collect_param_descrs(param_descrs & d) {
     d.insert("max_nodes", CPK_UINT, "(default: 8192) maximum number of nodes in the subpaving tree.");
     d.insert("max_depth", CPK_UINT, "(default: 128) maximum depth of the subpaving tree.");
+    d.insert("interleave", CPK_UINT, "(default: 0) if k > 0, process the most recently created leaf, taking the oldest leaf every k-th selection; if 0, always process the oldest leaf (breadth-first).");
     d.insert("epsilon", CPK_UINT, "(default: 20) value k s.t. a new lower (upper) bound for x is propagated only new-lower(x) > lower(k) + 1/k * max(min(upper(x) - lower(x), |lower|), 1) (new-upper(x) < upper(x) - 1/k * max(min(upper(x) - lower(x), |lower|), 1)). If k = 0, then this restriction is ignored.");
     d.insert("max_bound", CPK_UINT, "(default 10) value k s.t. a new upper (lower) bound for x is propagated only if upper(x) > -10^k or lower(x) = -oo (lower(x) < 10^k or upper(x) = oo)");
     d.insert("nth_root_precision", CPK_UINT, "(default 8192) value k s.t. 1/k is the precision for computing the nth root in the subpaving module.");
@@ -1414,35 +1451,54 @@ void context_t<C>::propagate_polynomial(var x, node * n, var y) {
     unsigned sz    = p->size();
     interval & r   = m_i_tmp1; r.set_mutable();
     interval & v   = m_i_tmp2;
-    interval & av  = m_i_tmp3; av.set_mutable();
+    numeral & a    = m_tmp1;
+    // The linear form is accumulated in two directed passes: all lower
+    // bounds with rounding to minus infinity, then all upper bounds with
+    // rounding to plus infinity. Thus, the rounding mode is switched once
+    // per pass instead of once per interval operation.
     if (x == y) {
+        nm().set(a, 0);
+        im().set(r, a);
+        C::round_to_minus_inf(nm());
         for (unsigned i = 0; i < sz; i++) {
-            var z = p->x(i);
-            v.set_constant(n, z);
-            im().mul(p->a(i), v, av);
-            if (i == 0)
-                im().set(r, av);
-            else
-                im().add(r, av, r);
+            v.set_constant(n, p->x(i));
+            im().add_mul_bound(false, p->a(i), v, r);
+        }
+        C::round_to_plus_inf(nm());
+        for (unsigned i = 0; i < sz; i++) {
+            v.set_constant(n, p->x(i));
+            im().add_mul_bound(true, p->a(i), v, r);
         }
         // r contains the deduced bounds for x == y
     }
     else {
         v.set_constant(n, x);
-        numeral & a = m_tmp1;
+        numeral & minus_a = m_tmp2;
         im().set(r, v);
+        C::round_to_minus_inf(nm());
         for (unsigned i = 0; i < sz; i++) {
             var z = p->x(i);
             if (z != y) {
+                nm().set(minus_a, p->a(i));
+                nm().neg(minus_a);
                 v.set_constant(n, z);
-                im().mul(p->a(i), v, av);
-                im().sub(r, av, r);
+                im().add_mul_bound(false, minus_a, v, r);
             }
             else {
                 nm().set(a, p->a(i));
                 TRACE("propagate_polynomial_bug", tout << "a: "; nm().display(tout, a); tout << "\n";);
             }
         }
+        C::round_to_plus_inf(nm());
+        for (unsigned i = 0; i < sz; i++) {
+            var z = p->x(i);
+            if (z != y) {
+                nm().set(minus_a, p->a(i));
+                nm().neg(minus_a);
+                v.set_constant(n, z);
+                im().add_mul_bound(true, minus_a, v, r);
+            }
+        }
         TRACE("propagate_polynomial_bug", tout << "r before mul 1/a: "; im().display(tout, r); tout << "\n";);
         im().div(r, a, r);
         TRACE("propagate_polynomial_bug", tout << "r after mul 1/a:  "; im().display(tout, r); tout << "\n";);
@@ -0,0 +1,349 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    expr_tape.cpp
+
+Abstract:
+
+    Compile a ground expression into a linear tape of typed operations.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020-08-20
+
+Revision History:
+
+--*/
+#include "model/expr_tape.h"
+
+expr_tape::expr_tape(ast_manager & m):
+    m(m),
+    m_arith(m),
+    m_inputs(m) {
+}
+
+unsigned expr_tape::mk_input(func_decl * f) {
+    unsigned idx;
+    if (m_input2idx.find(f, idx))
+        return idx;
+    idx = m_inputs.size();
+    m_inputs.push_back(f);
+    m_input2idx.insert(f, idx);
+    return idx;
+}
+
+/**
+   \brief Emit a chain of binary instructions for an n-ary application.
+*/
+unsigned expr_tape::mk_chain(op_kind op, app * a, obj_map<expr, unsigned> const & slots) {
+    unsigned r = slots.find(a->get_arg(0));
+    for (unsigned i = 1; i < a->get_num_args(); i++) {
+        instr c(op);
+        c.m_arg0 = r;
+        c.m_arg1 = slots.find(a->get_arg(i));
+        r = emit(c);
+    }
+    return r;
+}
+
+bool expr_tape::compile(expr * e) {
+    m_code.reset();
+    m_inputs.reset();
+    m_input2idx.reset();
+    m_regs.reset();
+    m_bregs.reset();
+    obj_map<expr, unsigned> slots;
+    ptr_vector<expr> todo;
+    todo.push_back(e);
+    bool ok = true;
+    while (ok && !todo.empty()) {
+        expr * t = todo.back();
+        if (slots.contains(t)) {
+            todo.pop_back();
+            continue;
+        }
+        if (!is_app(t)) {
+            ok = false;
+            break;
+        }
+        app * a = to_app(t);
+        unsigned num_args = a->get_num_args();
+        bool ready = true;
+        for (unsigned i = 0; i < num_args; i++) {
+            expr * arg = a->get_arg(i);
+            if (!slots.contains(arg)) {
+                todo.push_back(arg);
+                ready = false;
+            }
+        }
+        if (!ready)
+            continue;
+        todo.pop_back();
+        unsigned s = UINT_MAX;
+        rational q;
+        if (m_arith.is_numeral(t, q)) {
+            instr c(OP_TAPE_NUM);
+            c.m_num = q;
+            s = emit(c);
+        }
+        else if (m.is_true(t)) {
+            instr c(OP_TAPE_BNUM);
+            c.m_bool = true;
+            s = emit(c);
+        }
+        else if (m.is_false(t)) {
+            instr c(OP_TAPE_BNUM);
+            s = emit(c);
+        }
+        else if (is_uninterp_const(t)) {
+            if (!m_arith.is_int_real(t)) {
+                ok = false;
+                break;
+            }
+            instr c(OP_TAPE_INPUT);
+            c.m_arg0 = mk_input(a->get_decl());
+            s = emit(c);
+        }
+        else if (a->get_family_id() == m.get_basic_family_id()) {
+            switch (a->get_decl_kind()) {
+            case OP_AND:
+                s = mk_chain(OP_TAPE_AND, a, slots);
+                break;
+            case OP_OR:
+                s = mk_chain(OP_TAPE_OR, a, slots);
+                break;
+            case OP_XOR:
+                s = mk_chain(OP_TAPE_XOR, a, slots);
+                break;
+            case OP_NOT: {
+                instr c(OP_TAPE_NOT);
+                c.m_arg0 = slots.find(a->get_arg(0));
+                s = emit(c);
+                break;
+            }
+            case OP_IMPLIES: {
+                instr c(OP_TAPE_IMPLIES);
+                c.m_arg0 = slots.find(a->get_arg(0));
+                c.m_arg1 = slots.find(a->get_arg(1));
+                s = emit(c);
+                break;
+            }
+            case OP_EQ: {
+                expr * lhs = a->get_arg(0);
+                if (!m.is_bool(lhs) && !m_arith.is_int_real(lhs)) {
+                    ok = false;
+                    break;
+                }
+                instr c(m.is_bool(lhs) ? OP_TAPE_IFF : OP_TAPE_EQ);
+                c.m_arg0 = slots.find(lhs);
+                c.m_arg1 = slots.find(a->get_arg(1));
+                s = emit(c);
+                break;
+            }
+            case OP_ITE: {
+                if (!m.is_bool(t) && !m_arith.is_int_real(t)) {
+                    ok = false;
+                    break;
+                }
+                instr c(m.is_bool(t) ? OP_TAPE_BITE : OP_TAPE_ITE);
+                c.m_arg0 = slots.find(a->get_arg(0));
+                c.m_arg1 = slots.find(a->get_arg(1));
+                c.m_arg2 = slots.find(a->get_arg(2));
+                s = emit(c);
+                break;
+            }
+            default:
+                ok = false;
+                break;
+            }
+        }
+        else if (a->get_family_id() == m_arith.get_family_id()) {
+            switch (a->get_decl_kind()) {
+            case OP_ADD:
+                s = mk_chain(OP_TAPE_ADD, a, slots);
+                break;
+            case OP_MUL:
+                s = mk_chain(OP_TAPE_MUL, a, slots);
+                break;
+            case OP_SUB:
+                if (num_args == 1) {
+                    instr c(OP_TAPE_NEG);
+                    c.m_arg0 = slots.find(a->get_arg(0));
+                    s = emit(c);
+                }
+                else {
+                    s = mk_chain(OP_TAPE_SUB, a, slots);
+                }
+                break;
+            case OP_UMINUS: {
+                instr c(OP_TAPE_NEG);
+                c.m_arg0 = slots.find(a->get_arg(0));
+                s = emit(c);
+                break;
+            }
+            case OP_DIV:
+            case OP_IDIV:
+            case OP_MOD: {
+                op_kind k = a->get_decl_kind() == OP_DIV ? OP_TAPE_DIV : (a->get_decl_kind() == OP_IDIV ? OP_TAPE_IDIV : OP_TAPE_MOD);
+                instr c(k);
+                c.m_arg0 = slots.find(a->get_arg(0));
+                c.m_arg1 = slots.find(a->get_arg(1));
+                s = emit(c);
+                break;
+            }
+            case OP_LE:
+            case OP_LT:
+            case OP_GE:
+            case OP_GT: {
+                bool swap = a->get_decl_kind() == OP_GE || a->get_decl_kind() == OP_GT;
+                bool strict = a->get_decl_kind() == OP_LT || a->get_decl_kind() == OP_GT;
+                instr c(strict ? OP_TAPE_LT : OP_TAPE_LE);
+                c.m_arg0 = slots.find(a->get_arg(swap ? 1 : 0));
+                c.m_arg1 = slots.find(a->get_arg(swap ? 0 : 1));
+                s = emit(c);
+                break;
+            }
+            case OP_TO_REAL: {
+                instr c(OP_TAPE_MOV);
+                c.m_arg0 = slots.find(a->get_arg(0));
+                s = emit(c);
+                break;
+            }
+            case OP_TO_INT: {
+                instr c(OP_TAPE_TO_INT);
+                c.m_arg0 = slots.find(a->get_arg(0));
+                s = emit(c);
+                break;
+            }
+            default:
+                ok = false;
+                break;
+            }
+        }
+        else {
+            ok = false;
+        }
+        if (!ok || s == UINT_MAX) {
+            ok = false;
+            break;
+        }
+        slots.insert(t, s);
+    }
+    if (!ok) {
+        m_code.reset();
+        m_inputs.reset();
+        m_input2idx.reset();
+        return false;
+    }
+    m_root = slots.find(e);
+    m_bool_result = m.is_bool(e);
+    return true;
+}
+
+bool expr_tape::run(rational const * in) {
+    unsigned sz = m_code.size();
+    m_regs.reserve(sz);
+    m_bregs.reserve(sz, false);
+    for (unsigned i = 0; i < sz; i++) {
+        instr const & c = m_code[i];
+        switch (c.m_op) {
+        case OP_TAPE_NUM:
+            m_regs[i] = c.m_num;
+            break;
+        case OP_TAPE_INPUT:
+            m_regs[i] = in[c.m_arg0];
+            break;
+        case OP_TAPE_ADD:
+            m_regs[i] = m_regs[c.m_arg0] + m_regs[c.m_arg1];
+            break;
+        case OP_TAPE_SUB:
+            m_regs[i] = m_regs[c.m_arg0] - m_regs[c.m_arg1];
+            break;
+        case OP_TAPE_MUL:
+            m_regs[i] = m_regs[c.m_arg0] * m_regs[c.m_arg1];
+            break;
+        case OP_TAPE_DIV:
+            if (m_regs[c.m_arg1].is_zero())
+                return false;
+            m_regs[i] = m_regs[c.m_arg0] / m_regs[c.m_arg1];
+            break;
+        case OP_TAPE_IDIV:
+            if (m_regs[c.m_arg1].is_zero())
+                return false;
+            m_regs[i] = div(m_regs[c.m_arg0], m_regs[c.m_arg1]);
+            break;
+        case OP_TAPE_MOD:
+            if (m_regs[c.m_arg1].is_zero())
+                return false;
+            m_regs[i] = mod(m_regs[c.m_arg0], m_regs[c.m_arg1]);
+            break;
+        case OP_TAPE_NEG:
+            m_regs[i] = -m_regs[c.m_arg0];
+            break;
+        case OP_TAPE_TO_INT:
+            m_regs[i] = floor(m_regs[c.m_arg0]);
+            break;
+        case OP_TAPE_MOV:
+            m_regs[i] = m_regs[c.m_arg0];
+            break;
+        case OP_TAPE_LE:
+            m_bregs[i] = m_regs[c.m_arg0] <= m_regs[c.m_arg1];
+            break;
+        case OP_TAPE_LT:
+            m_bregs[i] = m_regs[c.m_arg0] < m_regs[c.m_arg1];
+            break;
+        case OP_TAPE_EQ:
+            m_bregs[i] = m_regs[c.m_arg0] == m_regs[c.m_arg1];
+            break;
+        case OP_TAPE_BNUM:
+            m_bregs[i] = c.m_bool;
+            break;
+        case OP_TAPE_NOT:
+            m_bregs[i] = !m_bregs[c.m_arg0];
+            break;
+        case OP_TAPE_AND:
+            m_bregs[i] = m_bregs[c.m_arg0] && m_bregs[c.m_arg1];
+            break;
+        case OP_TAPE_OR:
+            m_bregs[i] = m_bregs[c.m_arg0] || m_bregs[c.m_arg1];
+            break;
+        case OP_TAPE_XOR:
+            m_bregs[i] = m_bregs[c.m_arg0] != m_bregs[c.m_arg1];
+            break;
+        case OP_TAPE_IMPLIES:
+            m_bregs[i] = !m_bregs[c.m_arg0] || m_bregs[c.m_arg1];
+            break;
+        case OP_TAPE_IFF:
+            m_bregs[i] = m_bregs[c.m_arg0] == m_bregs[c.m_arg1];
+            break;
+        case OP_TAPE_ITE:
+            m_regs[i] = m_bregs[c.m_arg0] ? m_regs[c.m_arg1] : m_regs[c.m_arg2];
+            break;
+        case OP_TAPE_BITE:
+            m_bregs[i] = m_bregs[c.m_arg0] ? m_bregs[c.m_arg1] : m_bregs[c.m_arg2];
+            break;
+        default:
+            UNREACHABLE();
+            break;
+        }
+    }
+    return true;
+}
+
+bool expr_tape::eval(rational const * in, rational & r) {
+    SASSERT(!m_bool_result);
+    if (m_code.empty() || !run(in))
+        return false;
+    r = m_regs[m_root];
+    return true;
+}
+
+bool expr_tape::eval(rational const * in, bool & r) {
+    SASSERT(m_bool_result);
+    if (m_code.empty() || !run(in))
+        return false;
+    r = m_bregs[m_root];
+    return true;
+}
@@ -0,0 +1,110 @@
+/*++
+Copyright (c) 2020 Microsoft Corporation
+
+Module Name:
+
+    expr_tape.h
+
+Abstract:
+
+    Compile a ground expression into a linear tape of typed operations
+    that can be evaluated repeatedly over different assignments to its
+    uninterpreted constants, without walking the AST or consulting a
+    per-node cache on every evaluation.
+
+    The facility is intended for loops that evaluate the same objective
+    on a large number of candidate models. Compilation supports the
+    basic Boolean operators and linear/nonlinear rational arithmetic;
+    compile returns false for expressions outside this fragment, and the
+    caller is expected to fall back to model_evaluator.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2020-08-20
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "ast/ast.h"
+#include "ast/arith_decl_plugin.h"
+#include "util/rational.h"
+#include "util/obj_hashtable.h"
+
+class expr_tape {
+public:
+    enum op_kind {
+        OP_TAPE_NUM,      // load constant
+        OP_TAPE_INPUT,    // load input value
+        OP_TAPE_ADD,
+        OP_TAPE_SUB,
+        OP_TAPE_MUL,
+        OP_TAPE_DIV,
+        OP_TAPE_IDIV,
+        OP_TAPE_MOD,
+        OP_TAPE_NEG,
+        OP_TAPE_TO_INT,   // floor
+        OP_TAPE_MOV,      // copy slot (to_real)
+        OP_TAPE_LE,
+        OP_TAPE_LT,
+        OP_TAPE_EQ,
+        OP_TAPE_BNUM,     // load Boolean constant
+        OP_TAPE_NOT,
+        OP_TAPE_AND,
+        OP_TAPE_OR,
+        OP_TAPE_XOR,
+        OP_TAPE_IMPLIES,
+        OP_TAPE_IFF,
+        OP_TAPE_ITE,      // Boolean guard, arithmetic branches
+        OP_TAPE_BITE      // Boolean guard, Boolean branches
+    };
+private:
+    struct instr {
+        op_kind  m_op;
+        unsigned m_arg0 = 0;
+        unsigned m_arg1 = 0;
+        unsigned m_arg2 = 0;
+        rational m_num;
+        bool     m_bool = false;
+        instr(op_kind op):m_op(op) {}
+    };
+    ast_manager &                m;
+    arith_util                   m_arith;
+    vector<instr>                m_code;
+    func_decl_ref_vector         m_inputs;
+    obj_map<func_decl, unsigned> m_input2idx;
+    bool                         m_bool_result = false;
+    unsigned                     m_root = 0;
+    // evaluation registers, reused across evaluations
+    vector<rational>             m_regs;
+    bool_vector                  m_bregs;
+
+    unsigned emit(instr const & i) { m_code.push_back(i); return m_code.size() - 1; }
+    unsigned mk_input(func_decl * f);
+    unsigned mk_chain(op_kind op, app * a, obj_map<expr, unsigned> const & slots);
+    bool run(rational const * in);
+
+public:
+    expr_tape(ast_manager & m);
+
+    /**
+       \brief Compile e. The uninterpreted arithmetic constants of e become
+       the tape inputs, in first-occurrence order. Return false when e
+       contains operators outside the supported fragment; the tape is left
+       empty in that case.
+    */
+    bool compile(expr * e);
+
+    unsigned num_inputs() const { return m_inputs.size(); }
+    func_decl * input(unsigned i) const { return m_inputs.get(i); }
+    bool is_bool() const { return m_bool_result; }
+
+    /**
+       \brief Evaluate the tape over the given input values (one rational
+       per input, in input order). Return false on evaluation failure
+       (e.g., division by zero).
+    */
+    bool eval(rational const * in, rational & r);
+    bool eval(rational const * in, bool & r);
+};
@@ -76,7 +76,8 @@ func_interp::func_interp(ast_manager & m, unsigned arity):
     m_else(nullptr),
     m_args_are_values(true),
     m_interp(nullptr),
-    m_array_interp(nullptr) {
+    m_array_interp(nullptr),
+    m_index_valid(false) {
 }
 
 func_interp::~func_interp() {
@@ -103,6 +104,7 @@ void func_interp::reset_interp_cache() {
     m().dec_ref(m_array_interp);
     m_interp = nullptr;
     m_array_interp = nullptr;
+    m_index_valid = false;
 }
 
 bool func_interp::is_fi_entry_expr(expr * e, ptr_vector<expr> & args) {
@@ -175,7 +177,56 @@ bool func_interp::is_constant() const {
    If such entry does not exist then return 0, and store set
    args_are_values to true if for all entries e e.args_are_values() is true.
 */
+// number of entries starting from which lookups go through m_index.
+static const unsigned FUNC_INTERP_INDEX_MIN_SIZE = 16;
+
+static unsigned entry_args_hash(unsigned arity, expr * const * args) {
+    unsigned h = 17;
+    for (unsigned i = 0; i < arity; i++)
+        h = combine_hash(h, args[i]->get_id());
+    return h;
+}
+
+void func_interp::build_index() const {
+    m_index.reset();
+    for (unsigned i = 0; i < m_entries.size(); i++) {
+        unsigned h = entry_args_hash(m_arity, m_entries[i]->get_args());
+        if (!m_index.contains(h))
+            m_index.insert(h, i);
+    }
+    m_index_valid = true;
+}
+
+/**
+   \brief Index-based lookup. It is only sound when all arguments are
+   unique values: then are_equal collapses to pointer equality and a miss
+   in the index means no entry matches. Entries with the same hash as an
+   earlier entry are left out of the index; a hash hit that does not match
+   falls back to the caller's linear scan.
+*/
+func_entry * func_interp::find_indexed(expr * const * args) const {
+    for (unsigned i = 0; i < m_arity; i++)
+        if (!m().is_unique_value(args[i]))
+            return nullptr;
+    if (!m_index_valid)
+        build_index();
+    unsigned idx;
+    if (!m_index.find(entry_args_hash(m_arity, args), idx))
+        return nullptr;
+    func_entry * e = m_entries[idx];
+    if (e->eq_args(m(), m_arity, args))
+        return e;
+    return nullptr;
+}
+
 func_entry * func_interp::get_entry(expr * const * args) const {
+    if (m_arity > 0 && m_entries.size() >= FUNC_INTERP_INDEX_MIN_SIZE) {
+        func_entry * e = find_indexed(args);
+        if (e)
+            return e;
+        // a miss is conclusive for unique values without hash collisions,
+        // but scanning keeps the corner cases simple and correct.
+    }
     for (func_entry* curr : m_entries) {
         if (curr->eq_args(m(), m_arity, args))
             return curr;
@@ -216,6 +267,7 @@ void func_interp::insert_new_entry(expr * const * args, expr * r) {
 }
 
 void func_interp::del_entry(unsigned idx) {
+    m_index_valid = false;
     auto* e = m_entries[idx];
     m_entries[idx] = m_entries.back();
     m_entries.pop_back();
@@ -225,6 +277,11 @@ void func_interp::del_entry(unsigned idx) {
 bool func_interp::eval_else(expr * const * args, expr_ref & result) const {
     if (m_else == nullptr)
         return false;
+    if (is_ground(m_else)) {
+        // the substitution below is the identity on ground terms.
+        result = m_else;
+        return true;
+    }
     var_subst s(m(), false);
     SASSERT(!s.std_order()); // (VAR 0) <- args[0], (VAR 1) <- args[1], ...
     result = s(m_else, m_arity, args);
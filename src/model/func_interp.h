@@ -31,6 +31,7 @@ Revision History:
 
 #include "ast/ast.h"
 #include "ast/ast_translation.h"
+#include "util/map.h"
 
 class func_interp;
 
@@ -74,6 +75,16 @@ class func_interp {
 
     expr *                 m_array_interp; // <! interp with lambda abstraction
 
+    // Index from hashes of argument tuples to entry positions. It is built
+    // lazily when the entry list is large and lookups use unique values,
+    // so huge function graphs (e.g., array models) are probed in constant
+    // time instead of scanning every entry.
+    mutable u_map<unsigned> m_index;
+    mutable bool            m_index_valid;
+
+    void build_index() const;
+    func_entry * find_indexed(expr * const * args) const;
+
     void reset_interp_cache();
 
     expr * get_interp_core() const;
@@ -75,17 +75,60 @@ namespace datalog {
             tout<<"init:\n";
             rules.display(tout);
         );
-        scoped_ptr<rule_set> new_rules = alloc(rule_set, rules);      
+        // the source rule set is only copied lazily: cur_rules points at
+        // the original rules until the first plugin produces a new set.
+        rule_set const * cur_rules = &rules;
+        scoped_ptr<rule_set> owned_rules;
         plugin_vector::iterator it = m_plugins.begin();
         plugin_vector::iterator end = m_plugins.end();
-        for(; it!=end && !m_context.canceled(); ++it) {
+        while (it != end && !m_context.canceled()) {
             plugin & p = **it;
+            // fuse maximal runs of adjacent rule-local plugins into a single
+            // pass over the rules.
+            plugin_vector::iterator run_end = it;
+            while (run_end != end && (*run_end)->is_rule_local())
+                ++run_end;
 
-
-            IF_VERBOSE(1, verbose_stream() << "(transform " << typeid(p).name() << "...";);
+            scoped_ptr<rule_set> new_rules1;
             stopwatch sw;
             sw.start();
-            scoped_ptr<rule_set> new_rules1 = p(*new_rules);
+            if (run_end - it >= 2) {
+                IF_VERBOSE(1, {
+                    verbose_stream() << "(transform-fused";
+                    for (plugin_vector::iterator pit = it; pit != run_end; ++pit)
+                        verbose_stream() << " " << typeid(**pit).name();
+                    verbose_stream() << "...";
+                });
+                bool run_modified = false;
+                new_rules1 = alloc(rule_set, m_context);
+                for (rule * r : *cur_rules) {
+                    rule_ref cur(r, m_rule_manager);
+                    bool keep = true;
+                    for (plugin_vector::iterator pit = it; pit != run_end && keep; ++pit) {
+                        rule_ref res(m_rule_manager);
+                        if (!(*pit)->transform_rule(cur.get(), res)) {
+                            keep = false;
+                            run_modified = true;
+                            break;
+                        }
+                        run_modified |= res.get() != cur.get();
+                        m_rule_manager.mk_rule_rewrite_proof(*cur.get(), *res.get());
+                        cur = res;
+                    }
+                    if (keep)
+                        new_rules1->add_rule(cur.get());
+                }
+                if (run_modified)
+                    new_rules1->inherit_predicates(*cur_rules);
+                else
+                    new_rules1 = nullptr;
+                it = run_end;
+            }
+            else {
+                IF_VERBOSE(1, verbose_stream() << "(transform " << typeid(p).name() << "...";);
+                new_rules1 = p(*cur_rules);
+                ++it;
+            }
             sw.stop();
             double sec = sw.get_seconds();
             if (sec < 0.001) sec = 0.0;
@@ -93,7 +136,7 @@ namespace datalog {
                 IF_VERBOSE(1, verbose_stream() << "no-op " << sec << "s)\n";);
                 continue;
             }
-            if (p.can_destratify_negation() && 
+            if (p.can_destratify_negation() &&
                 !new_rules1->is_closed() &&
                 !new_rules1->close()) {
                 warning_msg("a rule transformation skipped "
@@ -103,17 +146,18 @@ namespace datalog {
                 continue;
             }
             modified = true;
-            new_rules = new_rules1.detach();
-            new_rules->ensure_closed();
+            owned_rules = new_rules1.detach();
+            owned_rules->ensure_closed();
+            cur_rules = owned_rules.get();
 
-            IF_VERBOSE(1, verbose_stream() << new_rules->get_num_rules() << " rules " << sec << "s)\n";);
-            TRACE("dl_rule_transf", 
+            IF_VERBOSE(1, verbose_stream() << cur_rules->get_num_rules() << " rules " << sec << "s)\n";);
+            TRACE("dl_rule_transf",
                 tout << typeid(p).name()<<":\n";
-                new_rules->display(tout);
+                cur_rules->display(tout);
             );
         }
         if (modified) {
-            rules.replace_rules(*new_rules);
+            rules.replace_rules(*owned_rules);
         }
         return modified;
     }
@@ -104,6 +104,24 @@ namespace datalog {
         */
         virtual rule_set * operator()(rule_set const & source) = 0;
 
+        /**
+           \brief Return true if the plugin transforms each rule independently
+           of the rest of the rule set. Adjacent rule-local plugins are fused
+           by the transformer into a single pass over the rules, so the
+           intermediate rule sets between them are never materialized.
+
+           Plugins returning true must implement \c transform_rule.
+        */
+        virtual bool is_rule_local() const { return false; }
+
+        /**
+           \brief Per-rule transformation for rule-local plugins
+           (\sa is_rule_local). If the rule should be retained, assign the
+           transformed version to \c res and return true; if the rule is to be
+           deleted, return false.
+        */
+        virtual bool transform_rule(rule * r, rule_ref & res) { res = r; return true; }
+
         /**
            Removes duplicate tails.
         */
@@ -19,6 +19,7 @@ Revision History:
 
 #include "ast/datatype_decl_plugin.h"
 #include "ast/dl_decl_plugin.h"
+#include "ast/ast_translation.h"
 #include "ast/ast_smt_pp.h"
 #include "ast/well_sorted.h"
 #include "ast/rewriter/bool_rewriter.h"
@@ -36,6 +37,10 @@ Revision History:
 #include "muz/transforms/dl_mk_rule_inliner.h"
 #include "muz/base/fp_params.hpp"
 
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <mutex>
+#endif
 
 namespace datalog {
 
@@ -1156,15 +1161,20 @@ namespace datalog {
     // Basic linear BMC based on incrementally unfolding the transition relation.
 
     class bmc::linear {
-        bmc&         b;
-        ast_manager& m;
+        bmc&            b;
+        ast_manager&    m;
+        expr_ref_vector m_fmls; // formulas asserted so far, in order; replayed into parallel workers
 
     public:
-        linear(bmc& b): b(b), m(b.m) {}
+        linear(bmc& b): b(b), m(b.m), m_fmls(b.m) {}
 
         lbool check() {
             setup();
             unsigned max_depth = b.m_ctx.get_params().bmc_linear_unrolling_depth();
+#ifndef SINGLE_THREAD
+            if (b.m_ctx.get_params().bmc_parallel() && std::thread::hardware_concurrency() > 1)
+                return check_parallel(max_depth);
+#endif
             for (unsigned i = 0; i < max_depth; ++i) {
                 IF_VERBOSE(1, verbose_stream() << "level: " << i << "\n";);
                 b.checkpoint();
@@ -1183,16 +1193,106 @@ namespace datalog {
 
     private:
 
+#ifndef SINGLE_THREAD
+        // Check a block of consecutive levels concurrently. Every worker owns
+        // a manager and an incremental solver that is caught up on the
+        // formulas compiled so far, then decides the level query assigned to
+        // it; blocks advance in lockstep and satisfiability of any level in a
+        // block cancels the remaining checks. Formula translation mutates the
+        // main manager and therefore stays on this thread; workers only run
+        // check_sat on their own managers. The reported level is the least
+        // satisfiable one of the block up to cancellation, which yields a
+        // valid (not necessarily shortest) derivation.
+        lbool check_parallel(unsigned max_depth) {
+            unsigned num_threads = std::min(std::thread::hardware_concurrency(), max_depth);
+            scoped_ptr_vector<ast_manager> wms;
+            scoped_ptr_vector<ast_translation> trs;
+            vector<solver_ref> solvers;
+            scoped_limits sl(m.limit());
+            params_ref p;
+            p.set_uint("smt.relevancy", 0u);
+            p.set_bool("smt.mbqi", false);
+            for (unsigned t = 0; t < num_threads; ++t) {
+                ast_manager* wm = alloc(ast_manager, m, true);
+                wms.push_back(wm);
+                trs.push_back(alloc(ast_translation, m, *wm));
+                solvers.push_back(solver_ref(mk_smt_solver(*wm, p, symbol::null)));
+                sl.push_child(&wm->limit());
+            }
+            unsigned_vector consumed(num_threads, 0u);
+            for (unsigned base = 0; base < max_depth; base += num_threads) {
+                unsigned block = std::min(num_threads, max_depth - base);
+                IF_VERBOSE(1, verbose_stream() << "levels: [" << base << ", " << base + block << ")\n";);
+                b.checkpoint();
+                for (unsigned l = base; l < base + block; ++l)
+                    compile(l);
+                vector<expr_ref> queries;
+                for (unsigned t = 0; t < block; ++t) {
+                    ast_translation& tr = *trs[t];
+                    for (unsigned& i = consumed[t]; i < m_fmls.size(); ++i)
+                        solvers[t]->assert_expr(tr(m_fmls.get(i)));
+                    expr_ref q = mk_level_predicate(b.m_query_pred, base + t);
+                    queries.push_back(expr_ref(tr(q.get()), *wms[t]));
+                }
+                svector<lbool> results(block, l_undef);
+                std::mutex mux;
+                auto worker = [&](unsigned t) {
+                    try {
+                        expr* q = queries[t].get();
+                        lbool r = solvers[t]->check_sat(1, &q);
+                        std::lock_guard<std::mutex> lock(mux);
+                        results[t] = r;
+                        if (r == l_true)
+                            for (unsigned j = 0; j < block; ++j)
+                                if (j != t)
+                                    wms[j]->limit().cancel();
+                    }
+                    catch (z3_exception&) {
+                        // recorded as l_undef; the block evaluation decides.
+                    }
+                    catch (...) {
+                    }
+                };
+                vector<std::thread> threads;
+                for (unsigned t = 0; t < block; ++t)
+                    threads.push_back(std::thread([&, t]() { worker(t); }));
+                for (auto& th : threads)
+                    th.join();
+                bool undef = false;
+                for (unsigned t = 0; t < block; ++t) {
+                    if (results[t] == l_true) {
+                        model_ref md;
+                        solvers[t]->get_model(md);
+                        if (md) {
+                            ast_translation back(*wms[t], m);
+                            md = md->translate(back);
+                        }
+                        get_model(base + t, md);
+                        return l_true;
+                    }
+                    undef |= results[t] == l_undef;
+                }
+                if (undef)
+                    return l_undef;
+            }
+            return l_undef;
+        }
+#endif
+
         void get_model(unsigned level) {
-            if (!m.inc()) {
+            model_ref md;
+            b.m_solver->get_model(md);
+            get_model(level, md);
+        }
+
+        void get_model(unsigned level, model_ref const& md) {
+            if (!m.inc() || !md) {
                 return;
             }
             rule_manager& rm = b.m_ctx.get_rule_manager();
             expr_ref level_query = mk_level_predicate(b.m_query_pred, level);
-            model_ref md;
             proof_ref pr(m);
             rule_unifier unifier(b.m_ctx);
-            b.m_solver->get_model(md);
             func_decl* pred = b.m_query_pred;
             SASSERT(m.is_true(md->get_const_interp(to_app(level_query)->get_decl())));
 
@@ -1375,6 +1475,11 @@ namespace datalog {
             }
         }
 
+        void assert_fml(expr* e) {
+            b.assert_expr(e);
+            m_fmls.push_back(e);
+        }
+
         void compile(unsigned level) {
             rule_set::decl2rules::iterator it  = b.m_rules.begin_grouped_rules();
             rule_set::decl2rules::iterator end = b.m_rules.end_grouped_rules();
@@ -1396,7 +1501,7 @@ namespace datalog {
                     rules.push_back(rule_i);
                     if (level == 0 && r.get_uninterpreted_tail_size() > 0) {
                         tmp = m.mk_not(rule_i);
-                        b.assert_expr(tmp);
+                        assert_fml(tmp);
                         continue;
                     }
 
@@ -1423,11 +1528,11 @@ namespace datalog {
                     }
                     bool_rewriter(m).mk_and(conjs.size(), conjs.data(), rule_body);
                     rule_body = m.mk_implies(rule_i, rule_body);
-                    b.assert_expr(rule_body);
+                    assert_fml(rule_body);
                 }
                 bool_rewriter(m).mk_or(rules.size(), rules.data(), tmp);
                 tmp = m.mk_implies(level_pred, tmp);
-                b.assert_expr(tmp);
+                assert_fml(tmp);
             }
         }
     };
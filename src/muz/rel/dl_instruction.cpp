@@ -645,9 +645,20 @@ namespace datalog {
             if (!ctx.reg(m_src)) {
                 return true;
             }
-            log_verbose(ctx);            
+            log_verbose(ctx);
             ++ctx.m_stats.m_union;
             relation_base & r_src = *ctx.reg(m_src);
+            if (!ctx.reg(m_tgt) && !m_widen &&
+                (m_delta == execution_context::void_register || !ctx.reg(m_delta))) {
+                // the target is empty: the union is a plain copy of the source
+                // and the delta, when maintained, is the source itself. A
+                // clone avoids the fact-by-fact union during the first, big
+                // iterations of the saturation loop.
+                ctx.set_reg(m_tgt, r_src.clone());
+                if (m_delta != execution_context::void_register)
+                    ctx.set_reg(m_delta, r_src.clone());
+                return true;
+            }
             if (!ctx.reg(m_tgt)) {
                 relation_base * new_tgt = r_src.get_plugin().mk_empty(r_src);
                 ctx.set_reg(m_tgt, new_tgt);
@@ -125,6 +125,9 @@ namespace datalog {
         rule_set &      m_rs_aux_copy; //reference to a rule_set that will allow to ask for stratum levels
 
         cost_map          m_costs;
+        typedef obj_map<func_decl, cost> pred_size_map;
+        mutable pred_size_map        m_pred_sizes;    // cardinality estimates, memoized
+        mutable obj_hashtable<func_decl> m_size_in_progress; // cycle cut-off for recursive predicates
         ptr_vector<app>   m_interpreted;
         rule_pred_map     m_rules_content;
         rule_ref_vector   m_introduced_rules;
@@ -600,38 +603,125 @@ namespace datalog {
             return static_cast<cost>(m_context.get_sort_size_estimate(s));            
         }
 
-        unsigned get_stratum(func_decl * pred) const {
-            return m_rs_aux_copy.get_predicate_strat(pred);
+        cost get_domain_bound(func_decl * pred) const {
+            cost res = 1;
+            unsigned n = pred->get_arity();
+            for (unsigned i = 0; i < n; i++) {
+                res *= get_domain_size(pred->get_domain(i));
+            }
+            return res;
         }
 
-        cost estimate_size(app * t) const {
+        /**
+           \brief Estimated number of rows of the relation of \c pred.
+
+           Uses the concrete size of the relation when it holds facts
+           (or is known to be saturated); otherwise propagates the
+           estimates of the body predicates through the rules defining
+           \c pred, cutting recursive predicates off at the product of
+           their domain sizes. Results are memoized, so the stats are
+           computed once per compilation.
+        */
+        cost get_pred_size(func_decl * pred) const {
+            cost res;
+            if (m_pred_sizes.find(pred, res)) {
+                return res;
+            }
+            if (m_size_in_progress.contains(pred)) {
+                return get_domain_bound(pred);
+            }
+            m_size_in_progress.insert(pred);
+            res = compute_pred_size(pred);
+            m_size_in_progress.remove(pred);
+            m_pred_sizes.insert(pred, res);
+            return res;
+        }
+
+        cost compute_pred_size(func_decl * pred) const {
             rel_context_base* rel = m_context.get_rel_context();
-            if (!rel) {
-                return cost(1);
-            }
-            relation_manager& rm = rel->get_rmanager();
-            func_decl * pred = t->get_decl();
-            if ( (m_context.saturation_was_run() && rm.try_get_relation(pred)) || rm.is_saturated(pred)) {
-                SASSERT(rm.try_get_relation(pred)); //if it is saturated, it should exist
-                unsigned rel_size_int = rel->get_relation(pred).get_size_estimate_rows();
-                if (rel_size_int != 0) {
-                    cost curr_size = static_cast<cost>(rel_size_int);
-                    for (expr* arg : *t) {
-                        if (!is_var(arg)) {
-                            curr_size /= get_domain_size(arg);
-                        }
+            cost res = 0;
+            bool has_facts = false;
+            if (rel) {
+                relation_manager& rm = rel->get_rmanager();
+                if ((m_context.saturation_was_run() && rm.try_get_relation(pred))
+                    || rm.is_saturated(pred)) {
+                    unsigned rel_size_int = rel->get_relation(pred).get_size_estimate_rows();
+                    if (rel_size_int != 0) {
+                        return static_cast<cost>(rel_size_int);
                     }
-                    return curr_size;
                 }
+                // before saturation a non-empty relation holds the input facts of \c pred
+                else if (rm.try_get_relation(pred) && !rel->get_relation(pred).empty()) {
+                    res = static_cast<cost>(rel->get_relation(pred).get_size_estimate_rows());
+                    has_facts = true;
+                }
+            }
+            cost bound = get_domain_bound(pred);
+            if (!m_rs_aux_copy.contains(pred)) {
+                return has_facts ? res : bound;
             }
+            // add the estimated join sizes of the defining rules, capped
+            // by the product of the head domains
+            for (rule * r : m_rs_aux_copy.get_predicate_rules(pred)) {
+                res += estimate_rule_size(r);
+                if (res >= bound) {
+                    return bound;
+                }
+            }
+            return res > 1 ? res : cost(1);
+        }
+
+        cost estimate_rule_size(rule * r) const {
             cost res = 1;
-            for (expr* arg : *t) {
-                if (is_var(arg))
-                    res *= get_domain_size(arg);
+            var_idx_set seen;
+            unsigned pt_len = r->get_positive_tail_size();
+            for (unsigned i = 0; i < pt_len; i++) {
+                app * t = r->get_tail(i);
+                res *= estimate_size(t);
+                // every repeated occurrence of a variable acts as a join filter
+                for (expr * arg : *t) {
+                    if (!is_var(arg)) {
+                        continue;
+                    }
+                    unsigned idx = to_var(arg)->get_idx();
+                    if (seen.contains(idx)) {
+                        res /= get_domain_size(arg);
+                    }
+                    else {
+                        seen.insert(idx);
+                    }
+                }
             }
             return res;
         }
 
+        unsigned get_stratum(func_decl * pred) const {
+            return m_rs_aux_copy.get_predicate_strat(pred);
+        }
+
+        cost estimate_size(app * t) const {
+            if (!m_context.get_rel_context()) {
+                return cost(1);
+            }
+            cost curr_size = get_pred_size(t->get_decl());
+            // selectivity of constant arguments and repeated variables
+            var_idx_set seen;
+            for (expr* arg : *t) {
+                if (!is_var(arg)) {
+                    curr_size /= get_domain_size(arg);
+                    continue;
+                }
+                unsigned idx = to_var(arg)->get_idx();
+                if (seen.contains(idx)) {
+                    curr_size /= get_domain_size(arg);
+                }
+                else {
+                    seen.insert(idx);
+                }
+            }
+            return curr_size > 1 ? curr_size : cost(1);
+        }
+
         cost compute_cost(app * t1, app * t2, const var_idx_set & non_local_vars) const {
             cost inters_size = 1;
             variable_intersection vi(m_context.get_manager());
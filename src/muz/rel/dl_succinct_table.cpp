@@ -0,0 +1,356 @@
+/*++
+Copyright (c) 2006 Microsoft Corporation
+
+Module Name:
+
+    dl_succinct_table.cpp
+
+Abstract:
+
+    Compressed table representation for large finite relations.
+
+Author:
+
+Revision History:
+
+--*/
+
+#include <algorithm>
+
+#include "muz/base/dl_util.h"
+#include "muz/rel/dl_succinct_table.h"
+
+namespace datalog {
+
+    // -----------------------------------
+    //
+    // succinct_table_plugin
+    //
+    // -----------------------------------
+
+    bool succinct_table_plugin::can_handle_signature(const table_signature & sig) {
+        if (sig.functional_columns() != 0) {
+            return false;
+        }
+        // tuple codes must fit into 64 bits
+        uint64_t prod = 1;
+        for (table_sort s : sig) {
+            if (s == 0 || prod > UINT64_MAX / s) {
+                return false;
+            }
+            prod *= s;
+        }
+        return true;
+    }
+
+    table_base * succinct_table_plugin::mk_empty(const table_signature & s) {
+        SASSERT(can_handle_signature(s));
+        return alloc(succinct_table, *this, s);
+    }
+
+    // -----------------------------------
+    //
+    // succinct_table
+    //
+    // -----------------------------------
+
+    succinct_table::succinct_table(succinct_table_plugin & plugin, const table_signature & sig)
+        : table_base(plugin, sig) {
+        SASSERT(plugin.can_handle_signature(sig));
+        m_num_cols = sig.size();
+        uint64_t prod = 1;
+        for (unsigned i = 0; i < m_num_cols; ++i) {
+            m_radix.push_back(prod);
+            prod *= sig[i];
+        }
+        m_universe = prod;
+    }
+
+    uint64_t succinct_table::fact2code(const table_element * f) const {
+        uint64_t code = 0;
+        for (unsigned i = 0; i < m_num_cols; ++i) {
+            SASSERT(f[i] < get_signature()[i]);
+            code += f[i] * m_radix[i];
+        }
+        return code;
+    }
+
+    void succinct_table::code2fact(uint64_t code, table_fact & f) const {
+        SASSERT(m_num_cols == f.size());
+        for (unsigned i = 0; i < m_num_cols; ++i) {
+            f[i] = (code / m_radix[i]) % get_signature()[i];
+        }
+    }
+
+    /**
+       \brief Low bits of the \c i -th encoded code.
+    */
+    uint64_t succinct_table::low(uint64_t i) const {
+        if (m_low_bits == 0) {
+            return 0;
+        }
+        uint64_t pos = i * m_low_bits;
+        unsigned w = static_cast<unsigned>(pos / 64);
+        unsigned o = static_cast<unsigned>(pos % 64);
+        uint64_t r = m_low[w] >> o;
+        if (o + m_low_bits > 64) {
+            r |= m_low[w + 1] << (64 - o);
+        }
+        return r & ((1ull << m_low_bits) - 1);
+    }
+
+    /**
+       \brief Position of the \c k -th (zero-based) 0-bit of m_high.
+
+       Binary search over the per-word 1-bit counts, then a scan of the
+       single word that contains the answer.
+    */
+    uint64_t succinct_table::select0(uint64_t k) const {
+        unsigned lo = 0, hi = m_high.size();
+        while (hi - lo > 1) {
+            unsigned mid = lo + (hi - lo) / 2;
+            if (64ull * mid - m_high_ones[mid] <= k) {
+                lo = mid;
+            }
+            else {
+                hi = mid;
+            }
+        }
+        uint64_t zeros = 64ull * lo - m_high_ones[lo];
+        uint64_t word = m_high[lo];
+        for (unsigned j = 0; j < 64; ++j) {
+            if (((word >> j) & 1) == 0) {
+                if (zeros == k) {
+                    return 64ull * lo + j;
+                }
+                ++zeros;
+            }
+        }
+        UNREACHABLE();
+        return 0;
+    }
+
+    bool succinct_table::encoded_contains(uint64_t code) const {
+        if (m_size == 0) {
+            return false;
+        }
+        uint64_t b = code >> m_low_bits;
+        uint64_t begin = b == 0 ? 0 : select0(b - 1) - (b - 1);
+        uint64_t end = select0(b) - b;
+        if (m_low_bits == 0) {
+            return begin < end;
+        }
+        uint64_t lo_val = code & ((1ull << m_low_bits) - 1);
+        for (uint64_t i = begin; i < end; ++i) {
+            if (low(i) == lo_val) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+       \brief Rebuild the encoding from a sorted duplicate-free sequence
+       of tuple codes.
+    */
+    void succinct_table::encode(svector<uint64_t> const & codes) {
+        m_size = codes.size();
+        m_low_bits = 0;
+        m_low.reset();
+        m_high.reset();
+        m_high_ones.reset();
+        if (m_size == 0) {
+            return;
+        }
+        while (m_low_bits < 63 && (m_universe >> m_low_bits) > m_size) {
+            ++m_low_bits;
+        }
+        uint64_t buckets = (m_universe >> m_low_bits) + 1;
+        uint64_t high_len = m_size + buckets;
+        m_high.resize(static_cast<unsigned>((high_len + 63) / 64), 0);
+        if (m_low_bits > 0) {
+            m_low.resize(static_cast<unsigned>((m_size * m_low_bits + 63) / 64), 0);
+        }
+        uint64_t mask = (1ull << m_low_bits) - 1;
+        for (unsigned i = 0; i < codes.size(); ++i) {
+            uint64_t c = codes[i];
+            // element i of bucket b is the (b + i)-th bit of the stream
+            uint64_t pos = (c >> m_low_bits) + i;
+            m_high[static_cast<unsigned>(pos / 64)] |= 1ull << (pos % 64);
+            if (m_low_bits > 0) {
+                pos = static_cast<uint64_t>(i) * m_low_bits;
+                unsigned w = static_cast<unsigned>(pos / 64);
+                unsigned o = static_cast<unsigned>(pos % 64);
+                uint64_t val = c & mask;
+                m_low[w] |= val << o;
+                if (o + m_low_bits > 64) {
+                    m_low[w + 1] |= val >> (64 - o);
+                }
+            }
+        }
+        uint64_t ones = 0;
+        for (uint64_t w : m_high) {
+            m_high_ones.push_back(ones);
+            ones += get_num_1bits(w);
+        }
+        m_high_ones.push_back(ones);
+    }
+
+    void succinct_table::decode(svector<uint64_t> & codes) const {
+        uint64_t bucket = 0;
+        uint64_t index = 0;
+        for (uint64_t pos = 0; index < m_size; ++pos) {
+            if ((m_high[static_cast<unsigned>(pos / 64)] >> (pos % 64)) & 1) {
+                codes.push_back((bucket << m_low_bits) | low(index));
+                ++index;
+            }
+            else {
+                ++bucket;
+            }
+        }
+    }
+
+    void succinct_table::flush() const {
+        if (m_added.empty() && m_removed.empty()) {
+            return;
+        }
+        const_cast<succinct_table *>(this)->compress();
+    }
+
+    void succinct_table::compress() {
+        svector<uint64_t> codes;
+        decode(codes);
+        if (!m_removed.empty()) {
+            unsigned j = 0;
+            for (uint64_t c : codes) {
+                if (!m_removed.contains(c)) {
+                    codes[j++] = c;
+                }
+            }
+            codes.shrink(j);
+        }
+        for (uint64_t c : m_added) {
+            codes.push_back(c);
+        }
+        std::sort(codes.begin(), codes.end());
+        auto it = std::unique(codes.begin(), codes.end());
+        codes.shrink(static_cast<unsigned>(it - codes.begin()));
+        encode(codes);
+        m_added.reset();
+        m_removed.reset();
+    }
+
+    void succinct_table::add_fact(const table_fact & f) {
+        uint64_t c = fact2code(f.data());
+        m_removed.remove(c);
+        m_added.insert(c);
+    }
+
+    void succinct_table::remove_fact(const table_element * fact) {
+        uint64_t c = fact2code(fact);
+        m_added.remove(c);
+        m_removed.insert(c);
+    }
+
+    bool succinct_table::contains_fact(const table_fact & f) const {
+        uint64_t c = fact2code(f.data());
+        if (m_added.contains(c)) {
+            return true;
+        }
+        if (m_removed.contains(c)) {
+            return false;
+        }
+        return encoded_contains(c);
+    }
+
+    bool succinct_table::empty() const {
+        if (!m_added.empty()) {
+            return false;
+        }
+        if (!m_removed.empty()) {
+            flush();
+        }
+        return m_size == 0;
+    }
+
+    unsigned succinct_table::get_size_estimate_rows() const {
+        flush();
+        return static_cast<unsigned>(m_size);
+    }
+
+    unsigned succinct_table::get_size_estimate_bytes() const {
+        unsigned words = m_low.size() + m_high.size() + m_high_ones.size();
+        return words * 8 + (m_added.size() + m_removed.size()) * 16;
+    }
+
+    class succinct_table::ef_iterator : public iterator_core {
+
+        succinct_table const & m_t;
+        uint64_t               m_index;   // element index
+        uint64_t               m_pos;     // position in the high bit stream
+        uint64_t               m_bucket;
+
+        class our_row : public caching_row_interface {
+            const ef_iterator & m_parent;
+        public:
+            our_row(const ef_iterator & p) : caching_row_interface(p.m_t), m_parent(p) {}
+            void get_fact(table_fact & result) const override {
+                if (result.size() < size()) {
+                    result.resize(size(), 0);
+                }
+                m_parent.m_t.code2fact(m_parent.curr_code(), result);
+            }
+        };
+        our_row m_row_obj;
+
+        bool high_bit(uint64_t pos) const {
+            return (m_t.m_high[static_cast<unsigned>(pos / 64)] >> (pos % 64)) & 1;
+        }
+
+        void skip_zeros() {
+            while (m_index < m_t.m_size && !high_bit(m_pos)) {
+                ++m_pos;
+                ++m_bucket;
+            }
+        }
+
+    public:
+        ef_iterator(const succinct_table & t, bool end) :
+            m_t(t), m_index(end ? t.m_size : 0), m_pos(0), m_bucket(0), m_row_obj(*this) {
+            if (!end) {
+                skip_zeros();
+            }
+        }
+
+        uint64_t curr_code() const {
+            return (m_bucket << m_t.m_low_bits) | m_t.low(m_index);
+        }
+
+        bool is_finished() const override {
+            return m_index == m_t.m_size;
+        }
+
+        row_interface & operator*() override {
+            SASSERT(!is_finished());
+            return m_row_obj;
+        }
+        void operator++() override {
+            SASSERT(!is_finished());
+            ++m_index;
+            ++m_pos;
+            skip_zeros();
+            m_row_obj.reset();
+        }
+    };
+
+    table_base::iterator succinct_table::begin() const {
+        flush();
+        return mk_iterator(alloc(ef_iterator, *this, false));
+    }
+
+    table_base::iterator succinct_table::end() const {
+        flush();
+        return mk_iterator(alloc(ef_iterator, *this, true));
+    }
+
+};
@@ -0,0 +1,100 @@
+/*++
+Copyright (c) 2006 Microsoft Corporation
+
+Module Name:
+
+    dl_succinct_table.h
+
+Abstract:
+
+    Compressed table representation for large finite relations.
+
+Author:
+
+Revision History:
+
+--*/
+#pragma once
+
+#include "util/hashtable.h"
+#include "util/vector.h"
+#include "muz/rel/dl_base.h"
+
+namespace datalog {
+
+    class succinct_table;
+
+    class succinct_table_plugin : public table_plugin {
+    public:
+        typedef succinct_table table;
+
+        succinct_table_plugin(relation_manager & manager)
+            : table_plugin(symbol("succinct"), manager) {}
+
+        bool can_handle_signature(const table_signature & s) override;
+
+        table_base * mk_empty(const table_signature & s) override;
+    };
+
+    /**
+       \brief Table storing the Elias-Fano encoding of the sorted
+       sequence of tuple codes.
+
+       A fact is mapped to a mixed-radix code below the product of the
+       column domains. The codes are kept sorted; the low bits of each
+       code are packed densely and the high bits are stored in unary,
+       which takes roughly log2(universe/size) + 2 bits per tuple
+       regardless of the domain sizes. Single-fact updates are buffered
+       in side hashtables and merged into the encoding by the next bulk
+       read, so saturation-style phases of bulk insertion followed by
+       bulk scans pay the re-encoding cost only once per phase.
+    */
+    class succinct_table : public table_base {
+        friend class succinct_table_plugin;
+
+        class ef_iterator;
+        typedef hashtable<uint64_t, uint64_hash, default_eq<uint64_t> > code_set;
+
+        unsigned          m_num_cols;
+        svector<uint64_t> m_radix;      // multiplier of each column in the tuple code
+        uint64_t          m_universe;   // product of the column domains
+        // Elias-Fano encoding of the sorted tuple codes
+        unsigned          m_low_bits = 0;  // bits per element in m_low
+        uint64_t          m_size = 0;      // number of encoded tuples
+        svector<uint64_t> m_low;           // packed low halves
+        svector<uint64_t> m_high;          // unary encoded bucket loads
+        svector<uint64_t> m_high_ones;     // 1-bits in m_high before each word
+        // pending updates, disjoint, merged into the encoding by the next bulk read
+        code_set          m_added;
+        code_set          m_removed;
+
+        succinct_table(succinct_table_plugin & plugin, const table_signature & sig);
+
+        uint64_t fact2code(const table_element * f) const;
+        void     code2fact(uint64_t code, table_fact & f) const;
+
+        uint64_t low(uint64_t i) const;
+        uint64_t select0(uint64_t k) const;
+        bool     encoded_contains(uint64_t code) const;
+        void     encode(svector<uint64_t> const & codes);
+        void     decode(svector<uint64_t> & codes) const;
+        void     flush() const;
+        void     compress();
+
+    public:
+        succinct_table_plugin & get_plugin() const
+        { return static_cast<succinct_table_plugin &>(table_base::get_plugin()); }
+
+        void add_fact(const table_fact & f) override;
+        void remove_fact(const table_element * fact) override;
+        bool contains_fact(const table_fact & f) const override;
+        bool empty() const override;
+        iterator begin() const override;
+        iterator end() const override;
+
+        unsigned get_size_estimate_rows() const override;
+        unsigned get_size_estimate_bytes() const override;
+        bool knows_exact_size() const override { return true; }
+    };
+
+};
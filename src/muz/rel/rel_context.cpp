@@ -36,6 +36,7 @@ Revision History:
 #include "muz/rel/check_relation.h"
 #include "muz/rel/dl_lazy_table.h"
 #include "muz/rel/dl_sparse_table.h"
+#include "muz/rel/dl_succinct_table.h"
 #include "muz/rel/dl_table.h"
 #include "muz/rel/dl_table_relation.h"
 #include "muz/rel/aig_exporter.h"
@@ -107,6 +108,7 @@ namespace datalog {
         rm.register_plugin(alloc(sparse_table_plugin, rm));
         rm.register_plugin(alloc(hashtable_table_plugin, rm));
         rm.register_plugin(alloc(bitvector_table_plugin, rm));
+        rm.register_plugin(alloc(succinct_table_plugin, rm));
         rm.register_plugin(lazy_table_plugin::mk_sparse(rm));
 
         // register plugins for builtin relations
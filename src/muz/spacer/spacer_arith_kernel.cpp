@@ -44,14 +44,20 @@ bool spacer_arith_kernel::compute_kernel() {
 
 namespace {
 class simplex_arith_kernel_plugin : public spacer_arith_kernel::plugin {
+    using qmatrix = simplex::sparse_matrix<simplex::mpq_ext>;
+
+    // kept across calls so that numeral and matrix storage is reused
+    unsynch_mpq_manager m;
+    qmatrix qmat;
+    qmatrix kern;
+
   public:
-    simplex_arith_kernel_plugin() {}
+    simplex_arith_kernel_plugin() : qmat(m), kern(m) {}
 
     bool compute_kernel(const spacer_matrix &in, spacer_matrix &out,
                         vector<unsigned> &basics) override {
-        using qmatrix = simplex::sparse_matrix<simplex::mpq_ext>;
-        unsynch_mpq_manager m;
-        qmatrix qmat(m);
+        qmat.reset();
+        kern.reset();
 
         // extra column for column of 1
         qmat.ensure_var(in.num_cols());
@@ -66,7 +72,6 @@ class simplex_arith_kernel_plugin : public spacer_arith_kernel::plugin {
         }
         TRACE("gg", qmat.display(tout););
 
-        qmatrix kern(m);
         simplex::sparse_matrix_ops::kernel_ffe<simplex::mpq_ext>(qmat, kern,
                                                                  basics);
 
@@ -95,7 +100,10 @@ class simplex_arith_kernel_plugin : public spacer_arith_kernel::plugin {
 
     void collect_statistics(statistics &st) const override {}
     void reset_statistics() override {}
-    void reset() override {}
+    void reset() override {
+        qmat.reset();
+        kern.reset();
+    }
 };
 
 } // namespace
@@ -74,7 +74,8 @@ class spacer_arith_kernel {
     const vector<unsigned> &get_basic_vars() const { return m_basic_vars; }
 
     void reset() {
-        m_kernel = spacer_matrix(0, 0);
+        m_kernel.reset(0);
+        m_basic_vars.reset();
         if (m_plugin) m_plugin->reset();
     }
 
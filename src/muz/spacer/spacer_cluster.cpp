@@ -212,7 +212,60 @@ bool lemma_cluster::add_lemma(const lemma_ref &lemma, bool subsume) {
 }
 
 lemma_cluster_finder::lemma_cluster_finder(ast_manager &_m)
-    : m(_m), m_arith(m), m_bv(m) {}
+    : m(_m), m_arith(m), m_bv(m), m_pinned(m) {}
+
+/// Compute a structural fingerprint of \p e
+///
+/// The fingerprint is a hash of the term structure in which interpreted
+/// constants are collapsed to their sort. Two cubes that anti-unify with a
+/// numeric substitution agree on every node except interpreted constants,
+/// hence they have equal fingerprints. The converse does not hold, so
+/// candidates retrieved by fingerprint are still checked by are_neighbours.
+/// Fingerprints of subterms are cached across calls.
+unsigned lemma_cluster_finder::fingerprint(const expr_ref &e) {
+    unsigned fp;
+    if (m_fingerprints.find(e, fp)) return fp;
+
+    ptr_vector<expr> todo;
+    todo.push_back(e);
+    while (!todo.empty()) {
+        expr *t = todo.back();
+        if (m_fingerprints.contains(t)) {
+            todo.pop_back();
+            continue;
+        }
+        if (is_var(t)) {
+            fp = combine_hash(to_var(t)->get_idx(), t->get_sort()->get_id());
+        }
+        else if (!is_app(t)) {
+            // quantifiers do not occur in normalized cubes
+            fp = t->hash();
+        }
+        else if (m_arith.is_numeral(t) || m_bv.is_numeral(t)) {
+            fp = t->get_sort()->get_id();
+        }
+        else {
+            app *a = to_app(t);
+            bool visited = true;
+            unsigned h;
+            fp = a->get_decl()->get_id();
+            for (expr *arg : *a) {
+                if (m_fingerprints.find(arg, h)) {
+                    fp = combine_hash(fp, h);
+                }
+                else {
+                    todo.push_back(arg);
+                    visited = false;
+                }
+            }
+            if (!visited) continue;
+        }
+        todo.pop_back();
+        m_fingerprints.insert(t, fp);
+        m_pinned.push_back(t);
+    }
+    return m_fingerprints[e];
+}
 
 /// Check whether \p cube and \p lcube differ only in interpreted constants
 bool lemma_cluster_finder::are_neighbours(const expr_ref &cube1,
@@ -339,10 +392,15 @@ void lemma_cluster_finder::cluster(lemma_ref &lemma) {
     expr_ref_vector lma_cubes(m);
     lemma_ref_vector neighbours;
 
+    unsigned lcube_fp = fingerprint(lcube);
+
     for (auto *l : all_lemmas) {
         cube.reset();
         cube = mk_and(l->get_cube());
         normalize_order(cube, cube);
+        // neighbours have equal fingerprints, so anti-unification is only
+        // attempted on lemmas in the same fingerprint bucket
+        if (fingerprint(cube) != lcube_fp) continue;
         // make sure that l is not in any other clusters
         if (are_neighbours(lcube, cube) && cube != lcube &&
             !pt.clstr_contains(l)) {
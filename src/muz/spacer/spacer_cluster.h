@@ -21,6 +21,7 @@ Author:
 #include <ast/ast_util.h>
 #include <ast/substitution/substitution.h>
 #include <muz/spacer/spacer_sem_matcher.h>
+#include <util/obj_hashtable.h>
 #include <util/ref_vector.h>
 #include <util/statistics.h>
 #include <util/stopwatch.h>
@@ -151,10 +152,19 @@ class lemma_cluster_finder {
     ast_manager &m;
     arith_util m_arith;
     bv_util m_bv;
+    /// Cached structural fingerprints of normalized cubes
+    obj_map<expr, unsigned> m_fingerprints;
+    expr_ref_vector m_pinned;
 
     /// Check whether \p cube and \p lcube differ only in interpreted constants
     bool are_neighbours(const expr_ref &cube, const expr_ref &lcube);
 
+    /// Structural fingerprint of \p e with interpreted constants abstracted
+    ///
+    /// Cubes that are neighbours have equal fingerprints, so fingerprints
+    /// are used to filter candidates before anti-unification
+    unsigned fingerprint(const expr_ref &e);
+
     /// N-ary antiunify
     ///
     /// Returns whether there is a substitution with only interpreted consts
@@ -22,6 +22,7 @@ Notes:
 
 // clang-format off
 
+#include <fstream>
 #include <sstream>
 #include <iomanip>
 
@@ -45,6 +46,7 @@ Notes:
 #include "smt/smt_value_sort.h"
 #include "smt/smt_solver.h"
 #include "muz/base/dl_util.h"
+#include "parsers/smt2/marshal.h"
 #include "muz/spacer/spacer_prop_solver.h"
 #include "muz/spacer/spacer_context.h"
 #include "muz/spacer/spacer_generalizers.h"
@@ -2300,7 +2302,8 @@ context::context(fp_params const& params, ast_manager& m) :
     m_expanded_lvl(0),
     m_global_gen(nullptr),
     m_expand_bnd_gen(nullptr),
-    m_trace_stream(nullptr) {
+    m_trace_stream(nullptr),
+    m_lemmas_imported(false) {
 
     params_ref p;
     p.set_uint("arith.solver", params.spacer_arith_solver());
@@ -2753,6 +2756,7 @@ void context::simplify_formulas() {
 lbool context::solve(unsigned from_lvl)
 {
     m_last_result = l_undef;
+    import_lemmas();
     try {
         if (m_use_gpdr) {
             SASSERT(from_lvl == 0);
@@ -2796,6 +2800,8 @@ lbool context::solve(unsigned from_lvl)
         st.display_smt2 (verbose_stream ());
     }
 
+    export_lemmas();
+
     return m_last_result;
 }
 
@@ -4291,6 +4297,124 @@ void context::add_constraint (expr *c, unsigned level)
     }
 }
 
+/// \brief Serialize the frame lemmas of all predicate transformers
+/// into a single conjunction.
+///
+/// Each lemma becomes an implication over its predicate applied to the
+/// n-variables of the signature, the same shape new_lemma_eh uses for
+/// lemma sharing, so that add_constraint can re-import it. Lemmas at a
+/// finite level are guarded with (spacer-lemma-level k) to preserve the
+/// level.
+expr_ref context::get_lemma_dump()
+{
+    // marker used to record the level of a serialized lemma
+    arith_util a(m);
+    sort *int_sort = a.mk_int();
+    func_decl_ref marker(m);
+    marker = m.mk_func_decl(symbol("spacer-lemma-level"), 1, &int_sort,
+                            m.mk_bool_sort());
+
+    expr_ref_vector lemmas(m);
+    lemma_ref_vector pt_lemmas;
+    for (auto &kv : m_rels) {
+        pred_transformer &r = *kv.m_value;
+
+        expr_ref_vector args(m);
+        for (unsigned i = 0; i < r.sig_size(); ++i)
+        { args.push_back(m.mk_const(m_pm.o2n(r.sig(i), 0))); }
+        expr_ref pred(m.mk_app(r.head(), r.sig_size(), args.data()), m);
+
+        pt_lemmas.reset();
+        r.get_all_lemmas(pt_lemmas);
+        for (lemma *l : pt_lemmas) {
+            expr_ref imp(m.mk_implies(pred, l->get_expr()), m);
+            if (!is_infty_level(l->level())) {
+                imp = m.mk_implies(m.mk_app(marker, a.mk_int(rational(l->level()))),
+                                   imp);
+            }
+            lemmas.push_back(imp);
+        }
+    }
+    return mk_and(lemmas);
+}
+
+/// \brief Add the lemmas of a dump produced by get_lemma_dump as
+/// candidate lemmas of the corresponding predicate transformers.
+/// Return the number of processed lemmas.
+unsigned context::load_lemmas(expr *conj)
+{
+    if (!conj) { return 0; }
+
+    arith_util a(m);
+    symbol marker("spacer-lemma-level");
+    expr_ref_vector lemmas(m);
+    flatten_and(conj, lemmas);
+    for (expr *e : lemmas) {
+        unsigned lvl = infty_level();
+        expr *guard = nullptr, *body = nullptr;
+        rational n;
+        if (m.is_implies(e, guard, body) && is_app(guard) &&
+            to_app(guard)->get_decl()->get_name() == marker &&
+            to_app(guard)->get_num_args() == 1 &&
+            a.is_numeral(to_app(guard)->get_arg(0), n) && n.is_unsigned()) {
+            lvl = n.get_unsigned();
+            e = body;
+        }
+        add_constraint(e, lvl);
+    }
+    return lemmas.size();
+}
+
+/// \brief Write the frame lemmas of all predicate transformers to the
+/// file given by the spacer.lemma_export_file option.
+void context::export_lemmas()
+{
+    if (!m_params.spacer_lemma_export_file().is_non_empty_string()) { return; }
+    std::ofstream out(m_params.spacer_lemma_export_file().bare_str());
+    if (!out) {
+        IF_VERBOSE(1, verbose_stream() << "could not open lemma export file: "
+                   << m_params.spacer_lemma_export_file() << "\n";);
+        return;
+    }
+
+    expr_ref conj = get_lemma_dump();
+    marshal(out, conj, m);
+    out.close();
+}
+
+/// \brief Load lemmas previously written by export_lemmas from the
+/// file given by the spacer.lemma_import_file option and add them as
+/// candidate lemmas of the corresponding predicate transformers.
+///
+/// The predicates are matched by name and signature through the
+/// ast_manager, so the import is only sound when the CHC system is
+/// unchanged. Lemmas of unknown predicates are ignored.
+void context::import_lemmas()
+{
+    if (m_lemmas_imported) { return; }
+    if (!m_params.spacer_lemma_import_file().is_non_empty_string()) { return; }
+    m_lemmas_imported = true;
+
+    std::ifstream in(m_params.spacer_lemma_import_file().bare_str());
+    if (!in) {
+        IF_VERBOSE(1, verbose_stream() << "could not open lemma import file: "
+                   << m_params.spacer_lemma_import_file() << "\n";);
+        return;
+    }
+
+    expr_ref conj = unmarshal(in, m);
+    if (!conj) {
+        IF_VERBOSE(1, verbose_stream() << "failed to parse lemma import file: "
+                   << m_params.spacer_lemma_import_file() << "\n";);
+        return;
+    }
+
+    unsigned count = load_lemmas(conj);
+    IF_VERBOSE(1, verbose_stream() << "(spacer.import-lemmas :count "
+               << count << " :imported "
+               << m_stats.m_num_lemmas_imported << ")\n";);
+}
+
 void context::new_lemma_eh(pred_transformer &pt, lemma *lem) {
     bool handle=false;
     for (unsigned i = 0; i < m_callbacks.size(); i++) {
@@ -1194,6 +1194,7 @@ class context {
     unsigned             m_blast_term_ite_inflation;
     scoped_ptr_vector<spacer_callback> m_callbacks;
     std::fstream*        m_trace_stream;
+    bool                 m_lemmas_imported;
     // clang-format on
     // clang-format off
 
@@ -1341,6 +1342,11 @@ class context {
     expr_ref get_constraints(unsigned lvl);
     void add_constraint(expr *c, unsigned lvl);
 
+    expr_ref get_lemma_dump();
+    unsigned load_lemmas(expr *conj);
+    void export_lemmas();
+    void import_lemmas();
+
     void new_lemma_eh(pred_transformer &pt, lemma *lem);
     void new_pob_eh(pob *p);
 
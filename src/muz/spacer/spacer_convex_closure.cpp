@@ -76,6 +76,8 @@ void convex_closure::reset(unsigned n_cols) {
     m_dead_cols.reset();
     m_dead_cols.reserve(m_dim, false);
     m_alphas.reset();
+    m_implicit_cc.reset();
+    m_explicit_cc.reset();
     m_bv_sz = 0;
     m_enable_implicit = true;
 }
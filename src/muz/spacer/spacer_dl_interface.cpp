@@ -35,9 +35,141 @@ Revision History:
 #include "ast/scoped_proof.h"
 #include "muz/transforms/dl_transforms.h"
 #include "muz/spacer/spacer_callback.h"
+#include "ast/ast_translation.h"
+#include "parsers/smt2/marshal.h"
+
+#ifndef SINGLE_THREAD
+#include <thread>
+#include <sstream>
+#endif
 
 using namespace spacer;
 
+#ifndef SINGLE_THREAD
+namespace {
+
+class null_register_engine : public datalog::register_engine_base {
+public:
+    datalog::engine_base *mk_engine(datalog::DL_ENGINE) override { return nullptr; }
+    void set_context(datalog::context *) override {}
+};
+
+/// a self-contained copy of a query, solved in its own manager so that
+/// several copies can run concurrently
+struct pquery_worker {
+    ast_manager           wm;
+    params_ref            wp;
+    smt_params            wsp;
+    null_register_engine  wre;
+    datalog::context      wdctx;
+    datalog::rule_set     wrules;
+    spacer::context       wsctx;
+    func_decl_ref         wquery;
+    lbool                 result = l_undef;
+
+    pquery_worker(ast_manager &m, params_ref const &p) :
+        wm(m.proof_mode()), wp(p), wdctx(wm, wre, wsp, wp),
+        wrules(wdctx), wsctx(wdctx.get_params(), wm), wquery(wm) {}
+};
+
+/// parameters of the main context, re-seeded for worker \p i
+params_ref mk_worker_params(fp_params const &fp, unsigned i) {
+    params_ref p = fp.p;
+    p.set_uint("spacer.random_seed", fp.spacer_random_seed() + i + 1);
+    p.set_uint("spacer.order_children", i % 3);
+    p.set_bool("spacer.parallel", false);
+    // workers must not touch the lemma files of the main context
+    p.set_sym("spacer.lemma_export_file", symbol::null);
+    p.set_sym("spacer.lemma_import_file", symbol::null);
+    return p;
+}
+
+}
+
+/// \brief Solve the current query with a portfolio of differently
+/// seeded copies of the engine.
+///
+/// Each worker owns a private manager with a translated copy of the
+/// rules, so the workers share no state and need no locking. The first
+/// definitive worker cancels its siblings and its frame lemmas are
+/// merged into the main context, which then re-runs the query so that
+/// models, proofs and counterexamples are produced natively.
+lbool dl_interface::parallel_query(func_decl *query_pred, unsigned min_lvl)
+{
+    ast_manager &m = m_ctx.get_manager();
+    datalog::rule_manager &rm = m_ctx.get_rule_manager();
+    unsigned hw = std::thread::hardware_concurrency();
+    unsigned num_workers = std::min(4u, std::max(2u, hw));
+
+    scoped_ptr_vector<pquery_worker> workers;
+    try {
+        // ast_translation updates reference counts of the source
+        // manager, so the workers are populated before any thread runs
+        expr_ref fml(m);
+        for (unsigned i = 0; i < num_workers; ++i) {
+            pquery_worker *w =
+                alloc(pquery_worker, m, mk_worker_params(m_ctx.get_params(), i));
+            workers.push_back(w);
+            ast_translation tr(m, w->wm);
+            for (auto *r : m_spacer_rules.get_rules()) {
+                rm.to_formula(*r, fml);
+                expr_ref wfml(tr(fml.get()), w->wm);
+                w->wdctx.get_rule_manager().mk_rule(wfml, nullptr, w->wrules,
+                                                    r->name());
+            }
+            w->wrules.close();
+            w->wquery = tr(query_pred);
+        }
+    }
+    catch (z3_exception &ex) {
+        IF_VERBOSE(1, verbose_stream() << "spacer.parallel disabled: "
+                   << ex.msg() << "\n";);
+        return m_context->solve(min_lvl);
+    }
+
+    // propagate cancellation from the main manager into the workers
+    scoped_limits sl(m.limit());
+    for (auto *w : workers) { sl.push_child(&w->wm.limit()); }
+
+    std::vector<std::thread> threads;
+    for (auto *w : workers) {
+        threads.emplace_back([w, min_lvl, &workers]() {
+                try {
+                    w->wsctx.set_query(w->wquery);
+                    w->wsctx.update_rules(w->wrules);
+                    w->result = w->wsctx.solve(min_lvl);
+                }
+                catch (...) { w->result = l_undef; }
+                if (w->result != l_undef) {
+                    for (pquery_worker *o : workers)
+                        if (o != w) { o->wm.limit().cancel(); }
+                }
+            });
+    }
+    for (auto &t : threads) { t.join(); }
+
+    pquery_worker *winner = nullptr;
+    for (auto *w : workers)
+        if (w->result != l_undef) { winner = w; break; }
+
+    if (winner) {
+        // frame lemmas are over-approximations of the same rules, so
+        // they are sound to import whatever the result was; the
+        // marshal/unmarshal round trip bridges the two managers
+        try {
+            std::ostringstream buf;
+            expr_ref dump = winner->wsctx.get_lemma_dump();
+            marshal(buf, dump, winner->wm);
+            m_context->load_lemmas(unmarshal(buf.str(), m));
+        }
+        catch (z3_exception &) { /* ignore, merge is best effort */ }
+        IF_VERBOSE(1, verbose_stream() << "(spacer.parallel :result "
+                   << winner->result << ")\n";);
+    }
+    return m_context->solve(min_lvl);
+}
+#endif
+
 dl_interface::dl_interface(datalog::context& ctx) :
     engine_base(ctx.get_manager(), "spacer"),
     m_ctx(ctx),
@@ -164,6 +296,12 @@ lbool dl_interface::query(expr * query)
         return l_false;
     }
 
+#ifndef SINGLE_THREAD
+    if (m_ctx.get_params().spacer_parallel() &&
+        std::thread::hardware_concurrency() > 1) {
+        return parallel_query(query_pred, m_ctx.get_params().spacer_min_level());
+    }
+#endif
     return m_context->solve(m_ctx.get_params().spacer_min_level());
 
 }
@@ -257,6 +395,12 @@ lbool dl_interface::query_from_lvl(expr * query, unsigned lvl)
         return l_false;
     }
 
+#ifndef SINGLE_THREAD
+    if (m_ctx.get_params().spacer_parallel() &&
+        std::thread::hardware_concurrency() > 1) {
+        return parallel_query(query_pred, lvl);
+    }
+#endif
     return m_context->solve(lvl);
 
 }
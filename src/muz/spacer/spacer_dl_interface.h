@@ -42,6 +42,10 @@ class dl_interface : public datalog::engine_base {
 
     void check_reset();
 
+#ifndef SINGLE_THREAD
+    lbool parallel_query(func_decl *query_pred, unsigned min_lvl);
+#endif
+
 public:
     dl_interface(datalog::context& ctx);
     ~dl_interface() override;
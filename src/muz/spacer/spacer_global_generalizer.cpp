@@ -130,7 +130,7 @@ bool all_same_sz(ast_manager &m, const substitution &sub, unsigned sz) {
 namespace spacer {
 lemma_global_generalizer::subsumer::subsumer(ast_manager &a_m, bool ground_pob)
     : m(a_m), m_arith(m), m_bv(m), m_tags(m), m_used_tags(0), m_col_names(m),
-      m_ground_pob(ground_pob) {
+      m_cvx_closure(m), m_ground_pob(ground_pob) {
     scoped_ptr<solver_factory> factory(
         mk_smt_strategic_solver_factory(symbol::null));
     m_solver = (*factory)(m, params_ref::get_empty(), false, true, false,
@@ -360,7 +360,7 @@ bool lemma_global_generalizer::subsumer::subsume(const lemma_cluster &lc,
                                                  app_ref_vector &bindings) {
     if (!is_handled(lc)) return false;
 
-    convex_closure cvx_closure(m);
+    convex_closure &cvx_closure = m_cvx_closure;
 
     reset();
     setup_cvx_closure(cvx_closure, lc);
@@ -783,7 +783,7 @@ void lemma_global_generalizer::subsumer::collect_statistics(
     st.update("SPACER num no over approximate", m_st.m_num_no_ovr_approx);
     st.update("SPACER num sync cvx cls", m_st.m_num_syn_cls);
     st.update("SPACER num mbp failed", m_st.m_num_mbp_failed);
-    // m_cvx_closure.collect_statistics(st);
+    m_cvx_closure.collect_statistics(st);
 }
 
 void lemma_global_generalizer::collect_statistics(statistics &st) const {
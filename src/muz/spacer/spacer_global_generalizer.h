@@ -59,6 +59,10 @@ class lemma_global_generalizer : public lemma_generalizer {
         app_ref_vector m_col_names;
         vector<rational> m_col_lcm;
 
+        // convex closure computation, kept across subsume calls so that
+        // internal matrices are reused
+        convex_closure m_cvx_closure;
+
         // create pob without free vars
         bool m_ground_pob;
 
@@ -30,26 +30,32 @@ void spacer_matrix::get_col(unsigned i, vector<rational> &row) const {
     SASSERT(i < m_num_cols);
     row.reset();
     row.reserve(m_num_rows);
-    unsigned j = 0;
-    for (auto &v : m_matrix) { row[j++] = (v.get(i)); }
+    for (unsigned j = 0; j < m_num_rows; ++j) { row[j] = m_matrix[j].get(i); }
     SASSERT(row.size() == m_num_rows);
 }
 
 void spacer_matrix::add_row(const vector<rational> &row) {
     SASSERT(row.size() == m_num_cols);
-    m_matrix.push_back(row);
-    m_num_rows = m_matrix.size();
+    if (m_num_rows < m_matrix.size()) {
+        // reuse a row retained by reset()
+        auto &dst = m_matrix[m_num_rows];
+        dst.reset();
+        dst.append(row);
+    } else {
+        m_matrix.push_back(row);
+    }
+    ++m_num_rows;
 }
 
 unsigned spacer_matrix::perform_gaussian_elimination() {
     unsigned i = 0;
     unsigned j = 0;
-    while (i < m_matrix.size() && j < m_matrix[0].size()) {
+    while (i < m_num_rows && j < m_num_cols) {
         // find maximal element in column with row index bigger or equal i
         rational max = m_matrix[i][j];
         unsigned max_index = i;
 
-        for (unsigned k = i + 1; k < m_matrix.size(); ++k) {
+        for (unsigned k = i + 1; k < m_num_rows; ++k) {
             if (max < m_matrix[k][j]) {
                 max = m_matrix[k][j];
                 max_index = k;
@@ -74,7 +80,7 @@ unsigned spacer_matrix::perform_gaussian_elimination() {
             }
 
             // subtract row from all other rows
-            for (unsigned k = 1; k < m_matrix.size(); ++k) {
+            for (unsigned k = 1; k < m_num_rows; ++k) {
                 if (k != i) {
                     rational factor = m_matrix[k][j];
                     for (unsigned l = 0; l < m_matrix[k].size(); ++l) {
@@ -89,15 +95,15 @@ unsigned spacer_matrix::perform_gaussian_elimination() {
         }
     }
 
-    if (get_verbosity_level() >= 1) { SASSERT(m_matrix.size() > 0); }
+    if (get_verbosity_level() >= 1) { SASSERT(m_num_rows > 0); }
 
     return i; // i points to the row after the last row which is non-zero
 }
 
 std::ostream &spacer_matrix::display(std::ostream &out) const {
     out << "Matrix\n";
-    for (const auto &row : m_matrix) {
-        for (const auto &element : row) { out << element << ", "; }
+    for (unsigned i = 0; i < m_num_rows; ++i) {
+        for (const auto &element : m_matrix[i]) { out << element << ", "; }
         out << "\n";
     }
     out << "\n";
@@ -26,6 +26,8 @@ class spacer_matrix {
   private:
     unsigned m_num_rows;
     unsigned m_num_cols;
+    // row storage; rows beyond m_num_rows are retained across reset() and
+    // reused by add_row()
     vector<vector<rational>> m_matrix;
 
     bool is_lin_reltd(unsigned i, unsigned j, rational &coeff1,
@@ -53,7 +55,6 @@ class spacer_matrix {
     void reset(unsigned n_cols) {
         m_num_rows = 0;
         m_num_cols = n_cols;
-        m_matrix.reset();
     }
 
     std::ostream &display(std::ostream &out) const;
@@ -34,6 +34,20 @@ sym_mux::~sym_mux() {
     for (auto &entry : m_entries) {
         dealloc(entry.m_value);
     }
+    for (auto *cache : m_shift_caches) {
+        dealloc(cache);
+    }
+}
+
+sym_mux::shift_cache &sym_mux::get_shift_cache(unsigned src_idx,
+                                               unsigned tgt_idx) const {
+    // only a handful of index pairs occur in practice
+    for (auto *cache : m_shift_caches) {
+        if (cache->m_src_idx == src_idx && cache->m_tgt_idx == tgt_idx)
+            return *cache;
+    }
+    m_shift_caches.push_back(alloc(shift_cache, m, src_idx, tgt_idx));
+    return *m_shift_caches.back();
 }
 
 func_decl_ref sym_mux::mk_variant(func_decl *fdecl, unsigned i) const {
@@ -124,49 +138,101 @@ bool sym_mux::is_homogenous_formula(expr * e, unsigned idx) const {
     return fck.all_have_idx();
 }
 
-namespace {
-struct conv_rewriter_cfg : public default_rewriter_cfg {
-private:
-    ast_manager & m;
-    const sym_mux & m_parent;
-    unsigned m_from_idx;
-    unsigned m_to_idx;
-    bool m_homogenous;
-    expr_ref_vector m_pinned;
-public:
-    conv_rewriter_cfg(const sym_mux & parent, unsigned from_idx,
-                      unsigned to_idx, bool homogenous)
-        : m(parent.get_manager()),
-          m_parent(parent),
-          m_from_idx(from_idx),
-          m_to_idx(to_idx),
-          m_homogenous(homogenous), m_pinned(m) {(void) m_homogenous;}
-
-    bool get_subst(expr * s, expr * & t, proof * & t_pr)
-    {
-        if (!is_app(s)) 
-            return false; 
-        app * a = to_app(s);
-        func_decl * sym = a->get_decl();
-        if (!m_parent.has_index(sym, m_from_idx)) {
-            CTRACE("spacer", m_homogenous && m_parent.is_muxed(sym), tout << "not found " << mk_pp(a, m) << "\n");
-            SASSERT(!m_homogenous || !m_parent.is_muxed(sym));
-            return false;
-        }
-        func_decl * tgt = m_parent.shift_decl(sym, m_from_idx, m_to_idx);
-        t = m.mk_app(tgt, a->get_args());
-        m_pinned.push_back(t);
-        return true;
-    }
-};
-}
-
+// One-pass bulk rename: all muxed symbols are shifted in a single DAG walk
+// whose cache persists across calls, so re-shifting shared sub-terms and
+// previously shifted formulas costs a lookup.
 void sym_mux::shift_expr(expr * f, unsigned src_idx, unsigned tgt_idx,
                          expr_ref & res, bool homogenous) const {
-    if (src_idx == tgt_idx) {res = f;}
-    else {
-        conv_rewriter_cfg r_cfg(*this, src_idx, tgt_idx, homogenous);
-        rewriter_tpl<conv_rewriter_cfg> rwr(m, false, r_cfg);
-        rwr(f, res);
+    (void) homogenous;
+    if (src_idx == tgt_idx) {res = f; return;}
+    shift_cache &cache = get_shift_cache(src_idx, tgt_idx);
+    ptr_vector<expr> todo, args;
+    todo.push_back(f);
+    while (!todo.empty()) {
+        expr * a = todo.back(), * b;
+        if (cache.m_cache.contains(a)) {
+            todo.pop_back();
+        }
+        else if (is_var(a)) {
+            cache.m_cache.insert(a, a);
+            todo.pop_back();
+        }
+        else if (is_app(a)) {
+            app * c = to_app(a);
+            args.reset();
+            bool has_all_args = true, arg_differs = false;
+            for (expr * arg : *c) {
+                expr * narg = nullptr;
+                if (cache.m_cache.find(arg, narg)) {
+                    if (has_all_args) {
+                        args.push_back(narg);
+                        arg_differs |= narg != arg;
+                    }
+                }
+                else {
+                    todo.push_back(arg);
+                    has_all_args = false;
+                }
+            }
+            if (!has_all_args) continue;
+            func_decl * sym = c->get_decl();
+            if (has_index(sym, src_idx)) {
+                b = m.mk_app(shift_decl(sym, src_idx, tgt_idx),
+                             args.size(), args.data());
+                cache.m_pinned.push_back(b);
+            }
+            else {
+                CTRACE("spacer", homogenous && is_muxed(sym),
+                       tout << "not found " << mk_pp(c, m) << "\n");
+                SASSERT(!homogenous || !is_muxed(sym));
+                if (arg_differs) {
+                    b = m.mk_app(sym, args.size(), args.data());
+                    cache.m_pinned.push_back(b);
+                }
+                else {
+                    b = a;
+                }
+            }
+            cache.m_cache.insert(a, b);
+            todo.pop_back();
+        }
+        else {
+            SASSERT(is_quantifier(a));
+            quantifier * q = to_quantifier(a);
+            bool has_all = true;
+            expr * new_body = nullptr;
+            if (!cache.m_cache.find(q->get_expr(), new_body)) {
+                todo.push_back(q->get_expr());
+                has_all = false;
+            }
+            ptr_vector<expr> pats, nopats;
+            for (unsigned i = 0, np = q->get_num_patterns(); i < np; ++i) {
+                expr * p = nullptr;
+                if (has_all && cache.m_cache.find(q->get_pattern(i), p)) {
+                    pats.push_back(p);
+                }
+                else {
+                    todo.push_back(q->get_pattern(i));
+                    has_all = false;
+                }
+            }
+            for (unsigned i = 0, np = q->get_num_no_patterns(); i < np; ++i) {
+                expr * p = nullptr;
+                if (has_all && cache.m_cache.find(q->get_no_pattern(i), p)) {
+                    nopats.push_back(p);
+                }
+                else {
+                    todo.push_back(q->get_no_pattern(i));
+                    has_all = false;
+                }
+            }
+            if (!has_all) continue;
+            b = m.update_quantifier(q, pats.size(), pats.data(),
+                                    nopats.size(), nopats.data(), new_body);
+            cache.m_pinned.push_back(b);
+            cache.m_cache.insert(a, b);
+            todo.pop_back();
+        }
     }
+    res = cache.m_cache.find(f);
 }
@@ -40,12 +40,27 @@ private:
     typedef obj_map<func_decl, sym_mux_entry*> decl2entry_map;
     typedef obj_map<func_decl, std::pair<sym_mux_entry*, unsigned> > mux2entry_map;
 
+    // cache of shift_expr results for one (src_idx, tgt_idx) pair. Symbol
+    // shifting is deterministic, so entries stay valid for the lifetime of
+    // the multiplexer and repeated shifts of shared sub-terms are free.
+    class shift_cache {
+    public:
+        unsigned m_src_idx;
+        unsigned m_tgt_idx;
+        obj_map<expr, expr*> m_cache;
+        expr_ref_vector m_pinned;
+        shift_cache(ast_manager &m, unsigned src_idx, unsigned tgt_idx)
+            : m_src_idx(src_idx), m_tgt_idx(tgt_idx), m_pinned(m) {}
+    };
+
     ast_manager &m;
     mutable decl2entry_map m_entries;
     mutable mux2entry_map m_muxes;
+    mutable ptr_vector<shift_cache> m_shift_caches;
 
     func_decl_ref mk_variant(func_decl *fdecl, unsigned i) const;
     void ensure_capacity(sym_mux_entry &entry, unsigned sz) const;
+    shift_cache &get_shift_cache(unsigned src_idx, unsigned tgt_idx) const;
 
 public:
     sym_mux(ast_manager & m);
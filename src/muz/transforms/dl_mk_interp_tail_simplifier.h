@@ -97,7 +97,9 @@ namespace datalog {
         This method is kind of useful, so it's public to allow other rules to use it,
         e.g. on their intermediate results.
         */
-        bool transform_rule(rule * r, rule_ref& res);
+        bool transform_rule(rule * r, rule_ref& res) override;
+
+        bool is_rule_local() const override { return true; }
 
         rule_set * operator()(rule_set const & source) override;
     };
@@ -20,6 +20,7 @@ Revision History:
 --*/
 #include "util/z3_exception.h"
 #include "util/chashtable.h"
+#include "util/scoped_ptr_vector.h"
 #include "util/id_gen.h"
 #include "util/map.h"
 #include "util/dependency.h"
@@ -33,6 +34,9 @@ Revision History:
 #include "nlsat/nlsat_evaluator.h"
 #include "nlsat/nlsat_explain.h"
 #include "nlsat/nlsat_params.hpp"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 #define NLSAT_EXTRA_VERBOSE
 
@@ -125,6 +129,8 @@ namespace nlsat {
         var_vector             m_inv_perm;
         // m_perm:     internal -> external
         // m_inv_perm: external -> internal
+        bool                   m_reordered = false;     // the active variable order differs from the external one
+        unsigned_vector        m_var_conflict_act;      // var -> number of conflicts resolved while the variable was being processed
         struct perm_display_var_proc : public display_var_proc {
             var_vector &             m_perm;
             display_var_proc         m_default_display_var;
@@ -201,12 +207,14 @@ namespace nlsat {
         unsigned               m_lazy;  // how lazy the solver is: 0 - satisfy all learned clauses, 1 - process only unit and empty learned clauses, 2 - use only conflict clauses for resolving conflicts
         bool                   m_simplify_cores;
         bool                   m_reorder;
+        bool                   m_dyn_reorder;
         bool                   m_randomize;
         bool                   m_random_order;
         unsigned               m_random_seed;
         bool                   m_inline_vars;
         bool                   m_log_lemmas;
         bool                   m_check_lemmas;
+        bool                   m_parallel;
         unsigned               m_max_conflicts;
         unsigned               m_lemma_count;
 
@@ -265,6 +273,7 @@ namespace nlsat {
             m_simplify_cores = p.simplify_conflicts();
             bool min_cores   = p.minimize_conflicts();
             m_reorder        = p.reorder();
+            m_dyn_reorder    = p.reorder_dynamic();
             m_randomize      = p.randomize();
             m_max_conflicts  = p.max_conflicts();
             m_random_order   = p.shuffle_vars();
@@ -272,6 +281,7 @@ namespace nlsat {
             m_inline_vars    = p.inline_vars();
             m_log_lemmas     = p.log_lemmas();
             m_check_lemmas   = p.check_lemmas();
+            m_parallel       = p.parallel();
             m_ism.set_seed(m_random_seed);
             m_explain.set_simplify_cores(m_simplify_cores);
             m_explain.set_minimize_cores(min_cores);
@@ -818,6 +828,7 @@ namespace nlsat {
             checker.m_check_lemmas = false;
             checker.m_log_lemmas = false;
             checker.m_inline_vars = false;
+            checker.m_parallel = false;
 
             // need to translate Boolean variables and literals
             scoped_bool_vars tr(checker);
@@ -1568,7 +1579,21 @@ namespace nlsat {
                 }
                 if (bounds.empty()) break;
 
-                init_search();                
+                init_search();
+                // restart boundary of the branch-and-bound loop: the trail is
+                // empty, so the variable order can be refined from the
+                // conflicts seen in the previous round. reorder() migrates the
+                // learned clauses and restore_order() undoes the accumulated
+                // permutation at the end of check().
+                if (m_reordered && m_dyn_reorder && can_reorder()) {
+                    // reorder() renames every variable, so the bounds
+                    // recorded under the old numbering are remapped through
+                    // the applied permutation.
+                    var_vector perm;
+                    dynamic_reorder(perm);
+                    for (auto & b : bounds)
+                        b.first = perm[b.first];
+                }
                 for (auto const& b : bounds) {
                     var x = b.first;
                     rational lo = b.second;
@@ -1594,12 +1619,163 @@ namespace nlsat {
             return r;
         }
 
+#ifndef SINGLE_THREAD
+        /**
+           \brief Split the problem into the sign cubes x < 0, x = 0, x > 0 of the
+           most constrained variable x, and solve the cubes on worker threads.
+           Each worker is built on top of its own ctx (managers are not thread safe),
+           so the input clauses are converted into the worker's polynomial manager.
+
+           Return l_false when every cube is unsat. Otherwise return l_undef and let
+           the sequential search run; when one of the workers proved its cube
+           satisfiable, the corresponding unit cube is asserted first, so the
+           sequential search is confined to a cube that is known to contain a model.
+           Algebraic values cannot be moved between anum_managers, hence the model
+           itself is not copied back.
+        */
+        lbool check_parallel() {
+            if (m_is_int.empty())
+                return l_undef;
+            for (clause * c : m_clauses)
+                if (c->assumptions())
+                    return l_undef; // cores are not tracked across workers
+            // Split on the variable that is the maximal variable of the largest number of atoms.
+            // It is the variable whose cell decomposition decides most of the constraints.
+            unsigned_vector occs(m_is_int.size(), 0u);
+            for (clause * c : m_clauses) {
+                for (literal l : *c) {
+                    atom * a = m_atoms[l.var()];
+                    if (a != nullptr && a->max_var() != null_var)
+                        occs[a->max_var()]++;
+                }
+            }
+            var x = 0;
+            for (var y = 1; y < occs.size(); y++)
+                if (occs[y] > occs[x])
+                    x = y;
+            if (occs[x] == 0)
+                return l_undef; // no arithmetic atoms
+
+            static const unsigned num_cubes = 3;
+            atom::kind cube_kind[num_cubes] = { atom::LT, atom::EQ, atom::GT };
+            scoped_ptr_vector<reslimit> limits;
+            scoped_ptr_vector<solver>   workers;
+            scoped_limits sl(m_rlimit);
+            params_ref wp = m_ctx.m_params;
+            wp.set_bool("parallel", false);
+            for (unsigned i = 0; i < num_cubes; i++) {
+                limits.push_back(alloc(reslimit));
+                wp.set_uint("seed", m_random_seed + i);
+                workers.push_back(alloc(solver, *limits[i], wp, false));
+                sl.push_child(limits[i]);
+            }
+
+            for (unsigned i = 0; i < num_cubes; i++) {
+                imp & w = *(workers[i]->m_imp);
+                w.m_parallel = false;
+                for (var y = 0; y < m_is_int.size(); ++y)
+                    w.register_var(y, m_is_int[y]);
+                scoped_bool_vars tr(w);
+                bool_var bv = 0;
+                tr.push_back(bv);
+                for (bool_var b = 1; b < m_atoms.size(); ++b) {
+                    atom * a = m_atoms[b];
+                    if (a == nullptr) {
+                        bv = w.mk_bool_var();
+                    }
+                    else if (a->is_ineq_atom()) {
+                        ineq_atom & ia = *to_ineq_atom(a);
+                        unsigned sz = ia.size();
+                        polynomial_ref_vector ps(w.m_pm);
+                        bool_vector is_even;
+                        for (unsigned j = 0; j < sz; ++j) {
+                            ps.push_back(convert(m_pm, ia.p(j), w.m_pm));
+                            is_even.push_back(ia.is_even(j));
+                        }
+                        bv = w.mk_ineq_atom(ia.get_kind(), sz, ps.data(), is_even.data());
+                    }
+                    else {
+                        root_atom & r = *to_root_atom(a);
+                        polynomial_ref q(convert(m_pm, r.p(), w.m_pm), w.m_pm);
+                        bv = w.mk_root_atom(r.get_kind(), r.x(), r.i(), q);
+                    }
+                    tr.push_back(bv);
+                }
+                for (clause * c : m_clauses) {
+                    literal_vector lits;
+                    for (literal lit : *c)
+                        lits.push_back(literal(tr[lit.var()], lit.sign()));
+                    w.mk_clause(lits.size(), lits.data(), nullptr);
+                }
+                // assert the cube
+                polynomial_ref px(w.m_pm.mk_polynomial(x), w.m_pm);
+                poly * p = px.get();
+                bool is_even = false;
+                literal cube = w.mk_ineq_literal(cube_kind[i], 1, &p, &is_even);
+                w.mk_clause(1, &cube, nullptr);
+            }
+
+            svector<lbool> rs(num_cubes, l_undef);
+            std::thread ths[num_cubes];
+            for (unsigned i = 0; i < num_cubes; i++) {
+                ths[i] = std::thread([&, i]() {
+                    lbool r = l_undef;
+                    try {
+                        r = workers[i]->m_imp->check();
+                    }
+                    catch (z3_exception &) {
+                        r = l_undef;
+                    }
+                    rs[i] = r;
+                    if (r == l_true) {
+                        // the cubes are disjoint: the siblings became irrelevant
+                        for (unsigned j = 0; j < num_cubes; j++)
+                            if (j != i)
+                                limits[j]->cancel();
+                    }
+                });
+            }
+            for (auto & t : ths)
+                t.join();
+
+            unsigned sat_cube = num_cubes;
+            bool all_unsat = true;
+            for (unsigned i = 0; i < num_cubes; i++) {
+                if (rs[i] == l_true)
+                    sat_cube = i;
+                if (rs[i] != l_false)
+                    all_unsat = false;
+            }
+            if (all_unsat) {
+                IF_VERBOSE(2, verbose_stream() << "(nlsat.parallel :status unsat)\n";);
+                return l_false;
+            }
+            if (sat_cube < num_cubes) {
+                IF_VERBOSE(2, verbose_stream() << "(nlsat.parallel :sat-cube " << sat_cube << ")\n";);
+                polynomial_ref px(m_pm.mk_polynomial(x), m_pm);
+                poly * p = px.get();
+                bool is_even = false;
+                literal cube = mk_ineq_literal(cube_kind[sat_cube], 1, &p, &is_even);
+                mk_clause(1, &cube, nullptr);
+            }
+            return l_undef;
+        }
+#endif
+
         lbool check() {
             TRACE("nlsat_smt2", display_smt2(tout););
             TRACE("nlsat_fd", tout << "is_full_dimensional: " << is_full_dimensional() << "\n";);
+#ifndef SINGLE_THREAD
+            if (m_parallel && !m_incremental && std::thread::hardware_concurrency() > 1) {
+                lbool r = check_parallel();
+                if (r != l_undef)
+                    return r;
+            }
+#endif
             init_search();
             m_explain.set_full_dimensional(is_full_dimensional());
-            bool reordered = false;
+            m_reordered = false;
+            m_var_conflict_act.reset();
 
             if (!m_incremental && m_inline_vars) {
                 if (!simplify()) 
@@ -1611,16 +1787,16 @@ namespace nlsat {
             }
             else if (m_random_order) {
                 shuffle_vars();
-                reordered = true;
+                m_reordered = true;
             }
             else if (m_reorder) {
                 heuristic_reorder();
-                reordered = true;
+                m_reordered = true;
             }
             sort_watched_clauses();
             lbool r = search_check();
             CTRACE("nlsat_model", r == l_true, tout << "model before restore order\n"; display_assignment(tout););
-            if (reordered) {
+            if (m_reordered) {
                 restore_order();
             }
             CTRACE("nlsat_model", r == l_true, tout << "model\n"; display_assignment(tout););
@@ -1978,6 +2154,10 @@ namespace nlsat {
             TRACE("nlsat_proof", tout << "STARTING RESOLUTION\n";);
             TRACE("nlsat_proof_sk", tout << "STARTING RESOLUTION\n";);
             m_conflicts++;
+            if (m_xk != null_var) {
+                m_var_conflict_act.reserve(m_xk + 1);
+                m_var_conflict_act[m_xk]++;
+            }
             TRACE("nlsat", tout << "resolve, conflicting clause:\n"; display(tout, *conflict_clause) << "\n";
                   tout << "xk: "; if (m_xk != null_var) m_display_var(tout, m_xk); else tout << "<null>"; tout << "\n";
                   tout << "scope_lvl: " << scope_lvl() << "\n";
@@ -2349,6 +2529,48 @@ namespace nlsat {
             SASSERT(check_invariant());
         }
 
+        struct dyn_reorder_lt {
+            var_info_collector const & m_info;
+            unsigned_vector const &    m_conflict_act;
+            dyn_reorder_lt(var_info_collector const & info, unsigned_vector const & act):
+                m_info(info), m_conflict_act(act) {}
+            bool operator()(var x, var y) const {
+                // variables involved in more conflicts first
+                unsigned cx = m_conflict_act.get(x, 0);
+                unsigned cy = m_conflict_act.get(y, 0);
+                if (cx != cy)
+                    return cx > cy;
+                return reorder_lt(m_info)(x, y);
+            }
+        };
+
+        // Refine the variable order using the conflict activity accumulated
+        // during search. The static heuristic breaks ties, and the collector
+        // includes the learned clauses, so the order adapts to the part of the
+        // search space where the solver is actually struggling.
+        // perm is set to the applied permutation (old var -> new var), so the
+        // caller can remap variables recorded before the reorder.
+        void dynamic_reorder(var_vector & perm) {
+            unsigned num = num_vars();
+            var_info_collector collector(m_pm, m_atoms, num);
+            collector.collect(m_clauses);
+            collector.collect(m_learned);
+            var_vector new_order;
+            for (var x = 0; x < num; x++) {
+                new_order.push_back(x);
+            }
+            std::sort(new_order.begin(), new_order.end(), dyn_reorder_lt(collector, m_var_conflict_act));
+            TRACE("nlsat_reorder",
+                  tout << "dynamic order: "; for (unsigned i = 0; i < num; i++) tout << new_order[i] << " "; tout << "\n";);
+            perm.reset();
+            perm.resize(num, 0);
+            for (var x = 0; x < num; x++) {
+                perm[new_order[x]] = x;
+            }
+            reorder(perm.size(), perm.data());
+            SASSERT(check_invariant());
+        }
+
         void shuffle_vars() {
             var_vector p;
             unsigned num = num_vars();
@@ -2411,8 +2633,11 @@ namespace nlsat {
             }
             bool_vector is_int;
             is_int.swap(m_is_int);
+            unsigned_vector conflict_act;
+            conflict_act.swap(m_var_conflict_act);
             for (var x = 0; x < sz; x++) {
                 m_is_int.setx(p[x], is_int[x], false);
+                m_var_conflict_act.setx(p[x], conflict_act.get(x, 0), 0);
                 SASSERT(m_infeasible[x] == 0);
             }
             m_inv_perm.swap(new_inv_perm);
@@ -396,20 +396,29 @@ namespace opt {
         }
     }
 
-    void context::set_model(model_ref& m) { 
+    // The fixed (user-level) version of a model is shared between
+    // dump-models, the on-model callback and objective verification,
+    // so each bound improvement copies the model at most once.
+    model_ref context::fixed_model(model* mdl) {
+        if (m_fixed_model_src.get() != mdl) {
+            model_ref md = mdl->copy();
+            fix_model(md);
+            m_fixed_model_src = mdl;
+            m_fixed_model = md;
+        }
+        return m_fixed_model;
+    }
+
+    void context::set_model(model_ref& m) {
         m_model = m;
         opt_params optp(m_params);
         if (optp.dump_models() && m) {
-            model_ref md = m->copy();
-            fix_model(md);
+            fixed_model(m.get());
         }
         if (m_on_model_eh && m) {
-            model_ref md = m->copy();
-            if (!m_model_fixed.contains(md.get()))
-                fix_model(md);
+            model_ref md = fixed_model(m.get());
             flet<bool> _calling(m_calling_on_model, true);
             m_on_model_eh(m_on_model_ctx, md);
-            m_model_fixed.pop_back();
         }
     }
 
@@ -566,6 +575,28 @@ namespace opt {
         return result;
     }
 
+    bool context::get_objective_value(unsigned i, model_ref& mdl, rational& value) {
+        objective const& obj = m_objectives[i];
+        switch (obj.m_type) {
+        case O_MINIMIZE:
+        case O_MAXIMIZE: {
+            expr_ref val = (*mdl)(obj.m_term);
+            if (!is_numeral(val, value))
+                return false;
+            if (obj.m_type == O_MINIMIZE)
+                value.neg();
+            return true;
+        }
+        case O_MAXSMT:
+            value = rational::zero();
+            for (unsigned j = 0; j < obj.m_terms.size(); ++j)
+                if (mdl->is_true(obj.m_terms[j]))
+                    value += obj.m_weights[j];
+            return true;
+        }
+        return false;
+    }
+
     expr_ref context::mk_cmp(bool is_ge, model_ref& mdl, objective const& obj) {
         rational k(0);
         expr_ref val(m), result(m);
@@ -1187,8 +1218,7 @@ namespace opt {
         }
         rational v = m_objectives[index].m_adjust_value(_v);
         expr_ref val(m);
-        model_ref mdl = md->copy();
-        fix_model(mdl);
+        model_ref mdl = fixed_model(md);
         val = (*mdl)(term);
         unsigned bvsz;
         if (!m_arith.is_numeral(val, r) && !m_bv.is_numeral(val, r, bvsz)) {
@@ -1537,6 +1567,8 @@ namespace opt {
         m_box_models.reset();
         m_model.reset();
         m_model_fixed.reset();
+        m_fixed_model.reset();
+        m_fixed_model_src.reset();
         m_core.reset();
     }
 
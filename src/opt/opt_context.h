@@ -187,6 +187,8 @@ namespace opt {
         model_converter_ref          m_model_converter;
         generic_model_converter_ref  m_fm;
         sref_vector<model>           m_model_fixed;
+        model_ref                    m_fixed_model;       // fixed copy of m_fixed_model_src
+        model_ref                    m_fixed_model_src;   // model the fixed copy was derived from
         unsigned                     m_model_counter;
         obj_map<func_decl, unsigned> m_objective_fns;
         obj_map<func_decl, expr*>    m_objective_orig;
@@ -255,6 +257,7 @@ namespace opt {
         expr_ref mk_gt(unsigned i, model_ref& model) override;
         expr_ref mk_ge(unsigned i, model_ref& model) override;
         expr_ref mk_le(unsigned i, model_ref& model) override;
+        bool get_objective_value(unsigned i, model_ref& model, rational& value) override;
 
         generic_model_converter& fm() override { return *m_fm; }
         smt::context& smt_context() override { return m_opt_solver->get_context(); }
@@ -294,6 +297,7 @@ namespace opt {
         lbool execute_box();
         lbool execute_pareto();
         lbool adjust_unknown(lbool r);
+        model_ref fixed_model(model* mdl);
         bool scoped_lex();
         bool contains_quantifiers() const;
         expr_ref to_expr(inf_eps const& n);
@@ -25,9 +25,65 @@ Notes:
 
 namespace opt {
 
+    // ---------------------
+    // Pareto front index
+
+    void pareto_front::insert(vector<rational> const& pt) {
+        node n;
+        n.m_point = pt;
+        n.m_max = pt;
+        unsigned idx = m_nodes.size();
+        m_nodes.push_back(n);
+        if (idx == 0)
+            return;
+        unsigned k = pt.size();
+        unsigned cur = 0, depth = 0;
+        while (true) {
+            node& c = m_nodes[cur];
+            for (unsigned i = 0; i < k; ++i)
+                if (c.m_max[i] < pt[i])
+                    c.m_max[i] = pt[i];
+            unsigned dim = depth % k;
+            unsigned& child = pt[dim] < c.m_point[dim] ? c.m_left : c.m_right;
+            if (child == UINT_MAX) {
+                child = idx;
+                return;
+            }
+            cur = child;
+            ++depth;
+        }
+    }
+
+    bool pareto_front::dominated(vector<rational> const& pt) const {
+        if (m_nodes.empty())
+            return false;
+        unsigned k = pt.size();
+        unsigned_vector todo;
+        todo.push_back(0);
+        while (!todo.empty()) {
+            node const& n = m_nodes[todo.back()];
+            todo.pop_back();
+            bool possible = true;
+            for (unsigned i = 0; possible && i < k; ++i)
+                possible = pt[i] <= n.m_max[i];
+            if (!possible)
+                continue;
+            bool dom = true;
+            for (unsigned i = 0; dom && i < k; ++i)
+                dom = pt[i] <= n.m_point[i];
+            if (dom)
+                return true;
+            if (n.m_left != UINT_MAX)
+                todo.push_back(n.m_left);
+            if (n.m_right != UINT_MAX)
+                todo.push_back(n.m_right);
+        }
+        return false;
+    }
+
     // ---------------------
     // GIA pareto algorithm
-   
+
     lbool gia_pareto::operator()() {
         expr_ref fml(m);
         lbool is_sat = m_solver->check_sat(0, nullptr);
@@ -35,19 +91,32 @@ namespace opt {
             {
                 m_solver->get_model(m_model);
                 solver::scoped_push _s(*m_solver.get());
+                // scope holding only the newest dominance constraint. A
+                // model dominating the current one dominates all of its
+                // predecessors, so the older constraints are redundant
+                // and popped instead of accumulating per improvement step.
+                struct dominance_scope {
+                    solver& s;
+                    bool    m_pushed = false;
+                    dominance_scope(solver& s): s(s) {}
+                    void renew() { if (m_pushed) s.pop(1); s.push(); m_pushed = true; }
+                    ~dominance_scope() { if (m_pushed) s.pop(1); }
+                };
+                dominance_scope _d(*m_solver.get());
                 while (is_sat == l_true) {
                     if (!m.inc()) {
                         return l_undef;
                     }
                     if (!m_model)
                         return l_undef;
-                    m_solver->get_labels(m_labels);                    
+                    m_solver->get_labels(m_labels);
                     m_model->set_model_completion(true);
                     IF_VERBOSE(1,
                                model_ref mdl(m_model);
-                               cb.fix_model(mdl); 
+                               cb.fix_model(mdl);
                                model_smt2_pp(verbose_stream() << "new model:\n", m, *mdl, 0););
                     // TBD: we can also use local search to tune solution coordinate-wise.
+                    _d.renew();
                     mk_dominates();
                     is_sat = m_solver->check_sat(0, nullptr);
                     if (is_sat == l_true) m_solver->get_model(m_model);
@@ -58,6 +127,7 @@ namespace opt {
             }
             SASSERT(is_sat == l_false);
             is_sat = l_true;
+            record_point();
             mk_not_dominated_by();
         }
         return is_sat;
@@ -88,7 +158,23 @@ namespace opt {
         fml = m.mk_not(mk_and(le));
         IF_VERBOSE(10, verbose_stream() << "not dominated by: " << fml << "\n";);
         TRACE("opt", tout << fml << "\n";);
-        m_solver->assert_expr(fml);        
+        m_solver->assert_expr(fml);
+    }
+
+    void pareto_base::record_point() {
+        unsigned sz = cb.num_objectives();
+        vector<rational> pt;
+        rational v;
+        for (unsigned i = 0; i < sz; ++i) {
+            if (!cb.get_objective_value(i, m_model, v))
+                return;
+            pt.push_back(v);
+        }
+        // the blocking constraints exclude the region weakly dominated by
+        // recorded points, so a new point is never dominated.
+        SASSERT(!m_front.dominated(pt));
+        m_front.insert(pt);
+        IF_VERBOSE(2, verbose_stream() << "(opt.pareto :points " << m_front.size() << ")\n";);
     }
 
     // ---------------------------------
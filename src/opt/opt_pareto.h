@@ -19,11 +19,12 @@ Notes:
 --*/
 #pragma once
 
+#include "util/rational.h"
 #include "solver/solver.h"
 #include "model/model.h"
 
 namespace opt {
-   
+
     class pareto_callback {
     public:
         virtual ~pareto_callback() = default;
@@ -32,6 +33,31 @@ namespace opt {
         virtual expr_ref mk_ge(unsigned i, model_ref& model) = 0;
         virtual expr_ref mk_le(unsigned i, model_ref& model) = 0;
         virtual void fix_model(model_ref& m) = 0;
+        // numeric value of objective i under the model, normalized so that
+        // larger is better. Optional; clients that cannot produce values
+        // return false and forego the Pareto front index.
+        virtual bool get_objective_value(unsigned i, model_ref& model, rational& value) { return false; }
+    };
+
+    /**
+       Index over the objective value vectors of the Pareto points found
+       so far. Points are kept in a k-d tree; every subtree maintains the
+       component-wise maximum of its points so that dominance queries can
+       prune subtrees that cannot contain a dominating point. Insertion is
+       incremental as the front is enumerated.
+    */
+    class pareto_front {
+        struct node {
+            vector<rational> m_point;
+            vector<rational> m_max;  // component-wise maximum over the subtree
+            unsigned         m_left = UINT_MAX, m_right = UINT_MAX;
+        };
+        vector<node> m_nodes;
+    public:
+        unsigned size() const { return m_nodes.size(); }
+        void reset() { m_nodes.reset(); }
+        void insert(vector<rational> const& pt);
+        bool dominated(vector<rational> const& pt) const;
     };
     class pareto_base {
     protected:
@@ -41,6 +67,7 @@ namespace opt {
         params_ref       m_params;
         model_ref        m_model;
         svector<symbol>  m_labels;
+        pareto_front     m_front;
     public:
         pareto_base(
             ast_manager & m, 
@@ -73,11 +100,15 @@ namespace opt {
             labels = m_labels;
         }
 
+        pareto_front const& front() const { return m_front; }
+
     protected:
 
         void mk_dominates();
 
-        void mk_not_dominated_by();            
+        void mk_not_dominated_by();
+
+        void record_point();
     };
     class gia_pareto : public pareto_base {
     public:
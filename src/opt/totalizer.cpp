@@ -75,7 +75,19 @@ namespace opt {
                 m_clauses.push_back(mk_or(clause));
             }
             def = mk_not(m, mk_and(ors));
-            m_defs.push_back(std::make_pair(c, def));            
+            m_defs.push_back(std::make_pair(c, def));
+        }
+
+        // ordering clauses: output i + 1 implies output i. They are entailed
+        // by the definitions, but handing them to the solver directly
+        // strengthens unit propagation when the bound is extended across
+        // iterations.
+        for (unsigned i = n->m_linked; i + 1 < k && lits.get(i + 1); ++i) {
+            expr* hi = lits.get(i + 1);
+            expr* lo = lits.get(i);
+            if (!m.is_false(hi))
+                m_clauses.push_back(m.mk_or(mk_not(m, hi), lo));
+            n->m_linked = i + 1;
         }
     }
 
@@ -24,6 +24,7 @@ namespace opt {
         struct node {
             node* m_left = nullptr;
             node* m_right = nullptr;
+            unsigned m_linked = 0;     // number of adjacent output pairs with an ordering clause
             expr_ref_vector m_literals;
             node(expr_ref_vector& l): m_literals(l) {}
             ~node() {
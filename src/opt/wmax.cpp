@@ -17,6 +17,7 @@ Notes:
 
 --*/
 #include "opt/wmax.h"
+#include "opt/opt_params.hpp"
 #include "util/uint_set.h"
 #include "ast/ast_pp.h"
 #include "model/model_smt2_pp.h"
@@ -55,7 +56,11 @@ namespace opt {
             reset();
             if (init())
                 return l_undef;
-            
+
+            opt_params p(m_params);
+            if (p.wmax_stratified() && !m_soft.empty())
+                return stratified(wth());
+
             lbool is_sat = l_true;
             
             expr_ref_vector asms(m);
@@ -111,6 +116,97 @@ namespace opt {
             return is_sat;
         }
 
+        // Solve strata of equal weight in decreasing order of weight.
+        // Each stratum is solved to optimality over the soft constraints
+        // asserted so far. The optimum of a stratum is a lower bound for the
+        // full problem and its model yields an upper bound over all soft
+        // constraints, so later strata start with tightened bounds.
+        // Upper-bound blocks are scoped to their stratum: they force an
+        // improvement over the soft constraints asserted so far and are
+        // invalidated once further soft constraints are added.
+        lbool stratified(smt::theory_wmaxsat& th) {
+            unsigned_vector order;
+            for (unsigned i = 0; i < m_soft.size(); ++i)
+                order.push_back(i);
+            std::sort(order.begin(), order.end(),
+                      [&](unsigned i, unsigned j) { return m_soft[i].weight > m_soft[j].weight; });
+            lbool is_sat = l_true;
+            unsigned next = 0;
+            while (m.inc() && next < order.size() && m_lower < m_upper) {
+                rational w = m_soft[order[next]].weight;
+                while (next < order.size() && m_soft[order[next]].weight == w)
+                    ++next;
+                is_sat = solve_stratum(th, order, next);
+                if (is_sat != l_true)
+                    break;
+            }
+            if (m_model)
+                update_assignment();
+            if (m.inc() && is_sat == l_undef && m_lower == m_upper)
+                is_sat = l_true;
+            TRACE("opt", tout << "min cost: " << m_upper << "\n";);
+            return is_sat;
+        }
+
+        // Solve the first prefix soft constraints in order to optimality.
+        // Returns l_true if the stratum was closed.
+        lbool solve_stratum(smt::theory_wmaxsat& th, unsigned_vector const& order, unsigned prefix) {
+            s().push();
+            reset();
+            for (unsigned i = 0; i < prefix; ++i)
+                assert_weighted(th, m_soft[order[i]].s, m_soft[order[i]].weight);
+            // a model whose cost over the asserted subset reaches m_upper
+            // cannot improve the incumbent.
+            th.init_min_cost(m_upper);
+            trace_bounds("wmax");
+            lbool is_sat = l_true;
+            rational stratum_cost(-1);
+            while (m.inc()) {
+                is_sat = s().check_sat(0, nullptr);
+                if (!m.inc())
+                    is_sat = l_undef;
+                if (is_sat != l_true)
+                    break;
+                if (th.is_optimal()) {
+                    stratum_cost = th.get_cost();
+                    model_ref mdl;
+                    s().get_model(mdl);
+                    update_upper(mdl);
+                }
+                expr_ref fml = th.mk_block();
+                s().assert_expr(fml);
+            }
+            s().pop(1);
+            if (is_sat == l_false) {
+                if (stratum_cost.is_neg())
+                    // no model within the bound exists; the incumbent is optimal.
+                    m_lower = m_upper;
+                else
+                    // the best model of the stratum is its optimum and
+                    // bounds the cost of the full problem from below.
+                    m_lower = std::max(m_lower, stratum_cost);
+                is_sat = l_true;
+            }
+            trace_bounds("wmax");
+            return is_sat;
+        }
+
+        // cost of the model over all soft constraints, including those
+        // not asserted yet.
+        void update_upper(model_ref& mdl) {
+            if (!mdl)
+                return;
+            mdl->set_model_completion(true);
+            rational cost(0);
+            for (soft& s : m_soft)
+                if (!mdl->is_true(s.s))
+                    cost += s.weight;
+            if (cost < m_upper) {
+                m_upper = cost;
+                m_model = mdl;
+            }
+        }
+
         bool is_true(expr* e) {
             return m_model->is_true(e);
         }
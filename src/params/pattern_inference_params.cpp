@@ -25,6 +25,8 @@ void pattern_inference_params::updt_params(params_ref const & _p) {
     m_pi_block_loop_patterns     = p.block_loop_patterns();
     m_pi_arith                   = static_cast<arith_pattern_inference_kind>(p.arith());
     m_pi_use_database            = p.use_database();
+    m_pi_database_file           = p.database_file();
+    m_pi_dump_inferred           = p.dump_inferred();
     m_pi_arith_weight            = p.arith_weight();
     m_pi_non_nested_arith_weight = p.non_nested_arith_weight();
     m_pi_pull_quantifiers        = p.pull_quantifiers();
@@ -38,6 +40,8 @@ void pattern_inference_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_pi_block_loop_patterns);
     DISPLAY_PARAM(m_pi_arith);
     DISPLAY_PARAM(m_pi_use_database);
+    DISPLAY_PARAM(m_pi_database_file);
+    DISPLAY_PARAM(m_pi_dump_inferred);
     DISPLAY_PARAM(m_pi_arith_weight);
     DISPLAY_PARAM(m_pi_non_nested_arith_weight);
     DISPLAY_PARAM(m_pi_pull_quantifiers);
@@ -19,6 +19,7 @@ Revision History:
 #pragma once
 
 #include "util/params.h"
+#include "util/symbol.h"
 
 enum arith_pattern_inference_kind {
     AP_NO,           // do not infer patterns with arithmetic terms
@@ -31,6 +32,8 @@ struct pattern_inference_params {
     bool                          m_pi_block_loop_patterns; 
     arith_pattern_inference_kind  m_pi_arith;
     bool                          m_pi_use_database;
+    symbol                        m_pi_database_file;
+    symbol                        m_pi_dump_inferred;
     unsigned                      m_pi_arith_weight;
     unsigned                      m_pi_non_nested_arith_weight;
     bool                          m_pi_pull_quantifiers;
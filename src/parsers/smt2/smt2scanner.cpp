@@ -36,7 +36,7 @@ namespace smt2 {
             m_bpos++;
         }
         else {
-            m_stream->read(m_buffer, SCANNER_BUFFER_SIZE);
+            m_stream->read(m_buffer.data(), SCANNER_BUFFER_SIZE);
             m_bend = static_cast<unsigned>(m_stream->gcount());
             m_bpos = 0;
             if (m_bpos == m_bend) {
@@ -279,6 +279,7 @@ namespace smt2 {
         m_line(1),
         m_pos(0),
         m_bv_size(UINT_MAX),
+        m_buffer(SCANNER_BUFFER_SIZE),
         m_bpos(0),
         m_bend(0),
         m_stream(&stream),
@@ -44,8 +44,10 @@ namespace smt2 {
         unsigned           m_bv_size;
         // end of data
         signed char        m_normalized[256];
-#define SCANNER_BUFFER_SIZE 1024
-        char               m_buffer[SCANNER_BUFFER_SIZE];
+// Large block reads keep istream overhead negligible on big benchmark
+// files; the buffer lives on the heap so the scanner stays cheap to embed.
+#define SCANNER_BUFFER_SIZE (64 * 1024)
+        svector<char>      m_buffer;
         unsigned           m_bpos;
         unsigned           m_bend;
         svector<char>      m_string;
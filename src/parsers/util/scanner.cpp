@@ -370,8 +370,10 @@ scanner::scanner(std::istream& stream, std::ostream& err, bool smt2, bool bv_tok
     m_state(ID_TOKEN),
     m_stream(stream),
     m_err(err),
-    m_bpos(1 << 10),
-    m_bend(1 << 10),
+    // non-interactive input is consumed in 64KB blocks; large scripts are
+    // dominated by parsing and solving, not stream refills
+    m_bpos(1 << 16),
+    m_bend(1 << 16),
     m_last_char(0),
     m_smt2(smt2),
     m_bv_token(bv_token) {
@@ -20,6 +20,7 @@ Revision History:
 
 #include "ast/rewriter/expr_safe_replace.h"
 #include "ast/ast_pp.h"
+#include "util/obj_pair_hashtable.h"
 #include "ast/ast_util.h"
 #include "ast/occurs.h"
 #include "ast/rewriter/th_rewriter.h"
@@ -44,6 +45,17 @@ class mbproj::impl {
     th_rewriter                     m_rw;
     ptr_vector<mbp::project_plugin> m_plugins;
 
+    // Cache of candidate substitution terms collected by project_var.
+    // The collected terms depend only on the variable and the formula, not
+    // on the model, so they can be reused across projections with different
+    // models. The per-model part (selecting a term with matching value)
+    // stays in project_var.
+    obj_pair_map<app, expr, expr_ref_vector*> m_index_term_cache;
+
+    // scratch substitution reused across projections so that its internal
+    // tables are not reallocated on every call
+    expr_safe_replace m_subst;
+
     // parameters
     bool m_reduce_all_selects;
     bool m_dont_sub;
@@ -59,6 +71,15 @@ class mbproj::impl {
         return m_plugins.get(fid, nullptr);
     }
 
+    void reset_index_term_cache() {
+        for (auto& kv : m_index_term_cache) {
+            m.dec_ref(kv.get_key1());
+            m.dec_ref(kv.get_key2());
+            dealloc(kv.get_value());
+        }
+        m_index_term_cache.reset();
+    }
+
     bool solve(model& model, app_ref_vector& vars, expr_ref_vector& lits) {
         expr_mark is_var, is_rem;
         if (vars.empty()) {
@@ -74,7 +95,8 @@ class mbproj::impl {
             if (m.is_eq(e, l, r) && reduce_eq(is_var, l, r, v, t)) {
                 reduced = true;
                 mbp::project_plugin::erase(lits, i);
-                expr_safe_replace sub(m);
+                expr_safe_replace& sub = m_subst;
+                sub.reset();
                 sub.insert(v, t);
                 is_rem.mark(v);
                 for (unsigned j = 0; j < lits.size(); ++j) {
@@ -119,7 +141,8 @@ class mbproj::impl {
     }
 
     void project_bools(model& mdl, app_ref_vector& vars, expr_ref_vector& fmls) {
-        expr_safe_replace sub(m);
+        expr_safe_replace& sub = m_subst;
+        sub.reset();
         expr_ref val(m);
         model_evaluator eval(mdl, m_params);
         eval.set_model_completion(true);
@@ -147,7 +170,8 @@ class mbproj::impl {
 
 
     void subst_vars(model_evaluator& eval, app_ref_vector const& vars, expr_ref& fml) {
-        expr_safe_replace sub(m);
+        expr_safe_replace& sub = m_subst;
+        sub.reset();
         for (app* v : vars) 
             sub.insert(v, eval(v));        
         sub(fml);
@@ -185,13 +209,22 @@ class mbproj::impl {
         expr_ref val = eval(var);
 
         TRACE("mbqi_project_verbose", tout << "MBQI: var: " << mk_pp(var, m) << "\n" << "fml: " << fml << "\n";);
-        expr_ref_vector terms(m);
-        index_term_finder finder(m, var, terms);
-        for_each_expr(finder, fml);
+        static const unsigned index_term_cache_limit = 4096;
+        expr_ref_vector* terms = nullptr;
+        if (!m_index_term_cache.find(var, fml, terms)) {
+            if (m_index_term_cache.size() >= index_term_cache_limit)
+                reset_index_term_cache();
+            terms = alloc(expr_ref_vector, m);
+            index_term_finder finder(m, var, *terms);
+            for_each_expr(finder, fml);
+            m.inc_ref(var);
+            m.inc_ref(fml.get());
+            m_index_term_cache.insert(var, fml, terms);
+        }
 
-        TRACE("mbqi_project_verbose", tout << "terms:\n" << terms;);
+        TRACE("mbqi_project_verbose", tout << "terms:\n" << *terms;);
 
-        for (expr* term : terms) {
+        for (expr* term : *terms) {
             expr_ref tval = eval(term);
 
             TRACE("mbqi_project_verbose", tout << "term: " << mk_pp(term, m) << " tval: " << tval << " val: " << val << "\n";);
@@ -201,7 +234,8 @@ class mbproj::impl {
             if (tval == val && !occurs(var, term)) {
                 TRACE("mbqi_project",
                     tout << "MBQI: replacing " << mk_pp(var, m) << " with " << mk_pp(term, m) << "\n";);
-                expr_safe_replace sub(m);
+                expr_safe_replace& sub = m_subst;
+                sub.reset();
                 sub.insert(var, term);
                 sub(fml);
                 return true;
@@ -238,7 +272,7 @@ public:
         proj.extract_literals(model, vars, fmls);
     }
 
-    impl(ast_manager& m, params_ref const& p) :m(m), m_params(p), m_rw(m) {
+    impl(ast_manager& m, params_ref const& p) :m(m), m_params(p), m_rw(m), m_subst(m) {
         add_plugin(alloc(mbp::arith_project_plugin, m));
         add_plugin(alloc(mbp::datatype_project_plugin, m));
         add_plugin(alloc(mbp::array_project_plugin, m));
@@ -246,6 +280,7 @@ public:
     }
 
     ~impl() {
+        reset_index_term_cache();
         std::for_each(m_plugins.begin(), m_plugins.end(), delete_proc<mbp::project_plugin>());
     }
 
@@ -305,7 +340,8 @@ public:
             if (!progress && !new_vars.empty() && !fmls.empty() && force_elim && m.limit().inc()) {
                 var = new_vars.back();
                 new_vars.pop_back();
-                expr_safe_replace sub(m);
+                expr_safe_replace& sub = m_subst;
+                sub.reset();
                 val = model(var);
                 sub.insert(var, val);
                 unsigned j = 0;
@@ -544,7 +544,14 @@ namespace qe {
         solver const& s() const { return *m_solver; }
 
         void init() {
-            m_solver = mk_smt_solver(m, m_params, symbol::null);
+            // keep the solver warm across games: roll back to the base
+            // scope instead of rebuilding it, so internalized terms and
+            // preprocessing state survive into the next game.
+            if (m_solver)
+                m_solver->pop(m_solver->get_scope_level());
+            else
+                m_solver = mk_smt_solver(m, m_params, symbol::null);
+            m_solver->push();
         }
         void collect_statistics(statistics & st) const {
             if (m_solver) 
@@ -610,6 +617,17 @@ namespace qe {
         expr_ref                   m_gt;
         opt::inf_eps               m_value_save;
 
+        // winning-move cache: maps a hoisted game formula to the negated
+        // projected cores derived while playing it, so that a re-issued
+        // game warm-starts from the strategies found in earlier rounds.
+        struct strategy_cache {
+            svector<std::pair<bool, expr*>> m_moves; // (target is m_ex, move)
+            obj_hashtable<expr>             m_seen;
+        };
+        obj_map<expr, strategy_cache*>      m_strategies;
+        expr_ref_vector                     m_strategy_trail;
+        expr*                               m_current_game = nullptr;
+
         
         /**
            \brief check alternating satisfiability.
@@ -718,8 +736,9 @@ namespace qe {
             m_vars.reset();
             m_model = nullptr;
             m_free_vars.reset();
-            m_fa.clear();
-            m_ex.clear();                    
+            m_current_game = nullptr;
+            // the kernels are not cleared here: init() rolls them back to
+            // their base scope, preserving the solvers across games.
         }
 
         void reset() override {
@@ -950,6 +969,11 @@ namespace qe {
                 add_assumption(fml);
             }
             else {
+                // cache the winning move for replay when the same game is
+                // issued again. Moves still mentioning auxiliary variables
+                // introduced by projection are not cacheable.
+                if (m_current_game && m_avars.empty() && m_mode != qsat_maximize)
+                    record_strategy(is_exists(m_level), fml);
                 fml = m_pred_abs.mk_abstract(fml);
                 get_kernel(m_level).assert_expr(fml);
             }
@@ -957,6 +981,36 @@ namespace qe {
             return true;
         }
         
+        void record_strategy(bool to_ex, expr* fml) {
+            strategy_cache* cache = nullptr;
+            if (!m_strategies.find(m_current_game, cache)) {
+                cache = alloc(strategy_cache);
+                m_strategies.insert(m_current_game, cache);
+            }
+            if (cache->m_seen.contains(fml))
+                return;
+            cache->m_seen.insert(fml);
+            cache->m_moves.push_back(std::make_pair(to_ex, fml));
+            m_strategy_trail.push_back(fml);
+        }
+
+        void replay_strategies() {
+            strategy_cache* cache = nullptr;
+            if (!m_current_game || !m_strategies.find(m_current_game, cache))
+                return;
+            IF_VERBOSE(3, verbose_stream() << "(replay-qsat-strategies " << cache->m_moves.size() << ")\n";);
+            for (auto const& [to_ex, move] : cache->m_moves) {
+                expr_ref fml(move, m);
+                expr_ref_vector defs(m);
+                max_level level;
+                m_pred_abs.abstract_atoms(fml, level, defs);
+                m_ex.assert_expr(mk_and(defs));
+                m_fa.assert_expr(mk_and(defs));
+                fml = m_pred_abs.mk_abstract(fml);
+                (to_ex ? m_ex : m_fa).assert_expr(fml);
+            }
+        }
+
         void get_vars(unsigned level) {
             m_avars.reset();
             for (unsigned i = level; i < m_vars.size(); ++i) {
@@ -1234,12 +1288,16 @@ namespace qe {
             m_objective(nullptr),
             m_value(nullptr),
             m_was_sat(false),
-            m_gt(m)
+            m_gt(m),
+            m_strategy_trail(m)
         {
         }
-        
+
         ~qsat() override {
             clear();
+            for (auto const& kv : m_strategies)
+                dealloc(kv.m_value);
+            m_strategies.reset();
         }
 
         char const* name() const override { return "qsat"; }
@@ -1285,12 +1343,15 @@ namespace qe {
             if (!is_ground(fml)) {
                 throw tactic_exception("formula is not hoistable");
             }
+            m_current_game = fml;
+            m_strategy_trail.push_back(fml);
             m_pred_abs.abstract_atoms(fml, defs);
             fml = m_pred_abs.mk_abstract(fml);
             m_ex.assert_expr(mk_and(defs));
             m_fa.assert_expr(mk_and(defs));
             m_ex.assert_expr(fml);
             m_fa.assert_expr(m.mk_not(fml));
+            replay_strategies();
             TRACE("qe", tout << "ex: " << fml << "\n";);
             lbool is_sat = check_sat();
             switch (is_sat) {
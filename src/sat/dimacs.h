@@ -29,26 +29,45 @@ namespace dimacs {
     struct lex_error {};
 
     class stream_buffer {
+        // Characters are served from a chunk read in one call instead of
+        // issuing one istream::get per character; on large CNF files the
+        // per-character stream overhead dominates parsing otherwise.
+        static const unsigned chunk_size = 64 * 1024;
         std::istream & m_stream;
         int            m_val;
         unsigned       m_line;
+        unsigned       m_pos = 0;
+        unsigned       m_size = 0;
+        svector<char>  m_chunk;
+
+        int next() {
+            if (m_pos == m_size) {
+                m_stream.read(m_chunk.data(), chunk_size);
+                m_size = static_cast<unsigned>(m_stream.gcount());
+                m_pos = 0;
+                if (m_size == 0)
+                    return EOF;
+            }
+            return static_cast<unsigned char>(m_chunk[m_pos++]);
+        }
     public:
-        
+
     stream_buffer(std::istream & s):
         m_stream(s),
-            m_line(0) {
-            m_val = m_stream.get();
+            m_line(0),
+            m_chunk(chunk_size) {
+            m_val = next();
         }
-        
-        int  operator *() const { 
+
+        int  operator *() const {
             return m_val;
         }
-        
-        void operator ++() { 
-            m_val = m_stream.get();
+
+        void operator ++() {
+            m_val = next();
             if (m_val == '\n') ++m_line;
         }
-        
+
         unsigned line() const { return m_line; }
     };
 
@@ -0,0 +1,227 @@
+/*++
+Copyright (c) 2023 Microsoft Corporation
+
+Module Name:
+
+    sat_approx_mc.cpp
+
+Abstract:
+
+    Approximate model counting over the sat core.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2023-02-07
+
+--*/
+#include "sat/sat_approx_mc.h"
+#include "sat/sat_solver.h"
+#include "sat/sat_params.hpp"
+#include "util/statistics.h"
+#include <cmath>
+#include <algorithm>
+
+namespace sat {
+
+    approx_mc::approx_mc(solver& s):
+        s(s),
+        m_prev_size(0),
+        m_num_checks(0) {
+        updt_params();
+    }
+
+    void approx_mc::updt_params() {
+        sat_params p(s.params());
+        m_epsilon      = p.approx_mc_epsilon();
+        m_delta       = p.approx_mc_delta();
+        m_max_xor_size = p.approx_mc_max_xor_size();
+        if (m_epsilon <= 0.0)
+            m_epsilon = 0.8;
+        if (m_delta <= 0.0 || m_delta >= 1.0)
+            m_delta = 0.2;
+        if (m_max_xor_size < 3)
+            m_max_xor_size = 3;
+        if (m_max_xor_size > 16)
+            m_max_xor_size = 16;
+    }
+
+    /**
+       \brief Add the parity constraint (+ vars) = rhs as clauses.
+       The constraint is chunked into pieces of at most m_max_xor_size
+       literals chained through auxiliary variables, and each chunk of
+       k literals is encoded by the 2^(k-1) clauses excluding the
+       assignments of the wrong parity.
+    */
+    void approx_mc::add_xor(bool_var_vector const& vars, bool rhs) {
+        literal_vector lits;
+        for (bool_var v : vars)
+            lits.push_back(literal(v, false));
+        if (lits.empty()) {
+            if (rhs)
+                s.mk_clause(0, nullptr, status::asserted());
+            return;
+        }
+        while (lits.size() > m_max_xor_size) {
+            // replace the last chunk by a fresh variable z with
+            // z = (+ chunk), consuming one slot for the chaining literal.
+            unsigned k = m_max_xor_size - 1;
+            literal_vector chunk;
+            for (unsigned i = 0; i < k; ++i) {
+                chunk.push_back(lits.back());
+                lits.pop_back();
+            }
+            literal z = literal(s.mk_var(), false);
+            chunk.push_back(~z);
+            // (+ chunk ~z) = 0
+            unsigned n = chunk.size();
+            for (unsigned m = 0; m < (1u << n); ++m) {
+                unsigned parity = 0;
+                for (unsigned i = 0; i < n; ++i)
+                    parity ^= (m >> i) & 1;
+                if (parity == 0)
+                    continue;
+                literal_vector cls;
+                for (unsigned i = 0; i < n; ++i)
+                    cls.push_back(((m >> i) & 1) ? ~chunk[i] : chunk[i]);
+                s.mk_clause(cls.size(), cls.data(), status::asserted());
+            }
+            lits.push_back(z);
+        }
+        unsigned n = lits.size();
+        for (unsigned m = 0; m < (1u << n); ++m) {
+            unsigned parity = 0;
+            for (unsigned i = 0; i < n; ++i)
+                parity ^= (m >> i) & 1;
+            if (parity == (rhs ? 1u : 0u))
+                continue;
+            literal_vector cls;
+            for (unsigned i = 0; i < n; ++i)
+                cls.push_back(((m >> i) & 1) ? ~lits[i] : lits[i]);
+            s.mk_clause(cls.size(), cls.data(), status::asserted());
+        }
+    }
+
+    /**
+       \brief Inject n random parity constraints over the sampling set.
+       Each variable is included with probability 1/2 and the right-hand
+       side is a random bit.
+    */
+    void approx_mc::add_random_xors(unsigned n) {
+        for (unsigned i = 0; i < n; ++i) {
+            bool_var_vector vars;
+            for (bool_var v : m_vars)
+                if (s.rand()(2) == 1)
+                    vars.push_back(v);
+            add_xor(vars, s.rand()(2) == 1);
+        }
+    }
+
+    /**
+       \brief Count the models of the current cell up to m_thresh by
+       enumeration with blocking clauses over the sampling set.
+    */
+    lbool approx_mc::count_cell(unsigned& count) {
+        count = 0;
+        while (true) {
+            if (!s.rlimit().inc())
+                return l_undef;
+            lbool r = s.check();
+            ++m_num_checks;
+            if (r == l_undef)
+                return l_undef;
+            if (r == l_false)
+                return l_true;
+            ++count;
+            if (count >= m_thresh)
+                return l_true;
+            model const& mdl = s.get_model();
+            literal_vector block;
+            for (bool_var v : m_vars)
+                block.push_back(literal(v, value_at(v, mdl) == l_true));
+            s.mk_clause(block.size(), block.data(), status::asserted());
+        }
+    }
+
+    /**
+       \brief One counting round: search for a hash size where the cell
+       is small enough, starting from the size of the previous round.
+    */
+    lbool approx_mc::count_round(rational& result) {
+        unsigned sz = m_prev_size;
+        unsigned max_sz = m_vars.size();
+        while (true) {
+            if (!s.rlimit().inc())
+                return l_undef;
+            s.user_push();
+            add_random_xors(sz);
+            unsigned count = 0;
+            lbool r = count_cell(count);
+            s.user_pop(1);
+            if (r == l_undef)
+                return l_undef;
+            if (count >= m_thresh) {
+                // cell too large, leapfrog to more constraints
+                if (sz == max_sz)
+                    return l_false;
+                sz = std::min(max_sz, sz == 0 ? 1 : 2 * sz);
+            }
+            else if (count == 0 && sz > 0) {
+                // overshot, back off one constraint at a time
+                --sz;
+            }
+            else {
+                m_prev_size = sz;
+                result = rational(count) * rational::power_of_two(sz);
+                return l_true;
+            }
+        }
+    }
+
+    lbool approx_mc::operator()(bool_var_vector const& vars) {
+        m_vars.reset();
+        if (vars.empty()) {
+            for (bool_var v = 0; v < s.num_vars(); ++v)
+                m_vars.push_back(v);
+        }
+        else
+            m_vars.append(vars);
+        m_estimate = rational::zero();
+        m_prev_size = 0;
+
+        m_thresh = 1 + static_cast<unsigned>(std::ceil(9.84 * (1.0 + m_epsilon / (1.0 + m_epsilon)) * (1.0 + 1.0 / m_epsilon) * (1.0 + 1.0 / m_epsilon)));
+        unsigned t = static_cast<unsigned>(std::ceil(17.0 * std::log2(3.0 / m_delta)));
+        if (t % 2 == 0)
+            ++t;
+
+        vector<rational> estimates;
+        for (unsigned i = 0; i < t; ++i) {
+            rational result;
+            lbool r = count_round(result);
+            if (r == l_undef)
+                return l_undef;
+            if (r == l_false) {
+                // every hash size saturated; the count exceeds 2^|vars|/thresh,
+                // report the trivial upper bound for this round.
+                result = rational::power_of_two(m_vars.size());
+            }
+            estimates.push_back(result);
+            IF_VERBOSE(2, verbose_stream() << "(sat.approx-mc :round " << i << " :estimate " << result << ")\n";);
+        }
+        std::sort(estimates.begin(), estimates.end());
+        m_estimate = estimates[estimates.size() / 2];
+        if (m_estimate.is_zero()) {
+            // the median can only be zero if most cells were empty at size 0,
+            // i.e., the formula is unsat.
+            return l_false;
+        }
+        IF_VERBOSE(1, verbose_stream() << "(sat.approx-mc :estimate " << m_estimate
+                   << " :interval [" << m_estimate.get_double() / (1.0 + m_epsilon)
+                   << ", " << m_estimate.get_double() * (1.0 + m_epsilon)
+                   << "] :confidence " << (1.0 - m_delta) << ")\n";);
+        return l_true;
+    }
+
+    void approx_mc::collect_statistics(statistics& st) const {
+        st.update("sat approx-mc checks", m_num_checks);
+    }
+};
@@ -0,0 +1,65 @@
+/*++
+Copyright (c) 2023 Microsoft Corporation
+
+Module Name:
+
+    sat_approx_mc.h
+
+Abstract:
+
+    Approximate model counting over the sat core.
+
+    Estimates the number of models projected onto a set of sampling
+    variables by injecting random parity (XOR) constraints and counting
+    the solutions of the resulting cells, following the ApproxMC scheme
+    of Chakraborty, Meel & Vardi. The hash size search leapfrogs from
+    the size found in the previous round.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2023-02-07
+
+--*/
+#pragma once
+
+#include "util/rational.h"
+#include "sat/sat_types.h"
+
+namespace sat {
+
+    class solver;
+
+    class approx_mc {
+        solver&         s;
+        double          m_epsilon;      // tolerance: result is within factor (1 + epsilon) with confidence 1 - delta
+        double          m_delta;        // confidence parameter
+        unsigned        m_max_xor_size; // maximum number of variables per injected parity constraint
+        bool_var_vector m_vars;         // sampling set
+        unsigned        m_thresh;       // cell size threshold (pivot)
+        unsigned        m_prev_size;    // hash size of the previous successful round, for leapfrogging
+        rational        m_estimate;
+        unsigned        m_num_checks;
+
+        void add_xor(bool_var_vector const& vars, bool rhs);
+        void add_random_xors(unsigned n);
+        lbool count_cell(unsigned& count);
+        lbool count_round(rational& result);
+        void updt_params();
+
+    public:
+        approx_mc(solver& s);
+
+        /**
+           \brief Estimate the number of models of s projected onto vars.
+           An empty vars counts over all variables of s.
+           Returns l_undef when the solver gives up or the resource limit is hit.
+        */
+        lbool operator()(bool_var_vector const& vars);
+
+        rational const& get_estimate() const { return m_estimate; }
+        double epsilon() const { return m_epsilon; }
+        double delta() const { return m_delta; }
+
+        void collect_statistics(statistics& st) const;
+    };
+};
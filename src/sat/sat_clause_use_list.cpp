@@ -42,6 +42,7 @@ namespace sat {
                 return;
             if (!m_clauses[m_i]->was_removed()) {
                 m_clauses[m_j] = m_clauses[m_i];
+                m_sigs[m_j] = m_sigs[m_i];
                 return;
             }
             m_i++;
@@ -52,6 +53,7 @@ namespace sat {
         while (m_i < m_size)
             next();
         m_clauses.shrink(m_j);
+        m_sigs.shrink(m_j);
     }
 
 };
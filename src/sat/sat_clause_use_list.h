@@ -19,18 +19,42 @@ Revision History:
 #pragma once
 
 #include "sat/sat_types.h"
+#include "sat/sat_clause.h"
 #include "util/trace.h"
 
 namespace sat {
 
+    /**
+       \brief 64-bit literal-precise signature of a clause.
+
+       Unlike clause::approx(), which hashes variables, the signature
+       hashes literals, so it distinguishes polarities. It is captured
+       when a clause is inserted into a use list; strengthening only
+       removes literals, so a stale signature over-approximates the
+       clause and remains sound as a subsumption pre-filter.
+    */
+    typedef approx_set_tpl<literal, literal2unsigned, unsigned long long> clause_sig;
+
     /**
        \brief Clause use list with delayed deletion.
+
+       The signatures of the clauses are stored in a parallel array, so
+       subsumption candidates can be discarded by a dense scan without
+       dereferencing the clauses.
     */
     class clause_use_list {
-        clause_vector   m_clauses;
-        unsigned        m_size;
-        unsigned        m_num_redundant;
+        clause_vector                m_clauses;
+        svector<unsigned long long>  m_sigs;
+        unsigned                     m_size;
+        unsigned                     m_num_redundant;
     public:
+        static unsigned long long mk_sig(clause const & c) {
+            clause_sig s;
+            for (literal l : c)
+                s.insert(l);
+            return s.get();
+        }
+
         clause_use_list() {
             STRACE("clause_use_list_bug", tout << "[cul_created] " << this << "\n";);
             m_size = 0; 
@@ -54,18 +78,23 @@ namespace sat {
         void insert(clause & c) { 
             STRACE("clause_use_list_bug", tout << "[cul_insert] " << this << " " << &c << "\n";);
             SASSERT(!m_clauses.contains(&c)); 
-            SASSERT(!c.was_removed()); 
-            m_clauses.push_back(&c); 
-            m_size++; 
+            SASSERT(!c.was_removed());
+            m_clauses.push_back(&c);
+            m_sigs.push_back(mk_sig(c));
+            m_size++;
             if (c.is_learned()) ++m_num_redundant;
         }
 
-        void erase_not_removed(clause & c) { 
+        void erase_not_removed(clause & c) {
             STRACE("clause_use_list_bug", tout << "[cul_erase_not_removed] " << this << " " << &c << "\n";);
-            SASSERT(m_clauses.contains(&c)); 
-            SASSERT(!c.was_removed()); 
-            m_clauses.erase(&c); 
-            m_size--; 
+            SASSERT(m_clauses.contains(&c));
+            SASSERT(!c.was_removed());
+            unsigned i = 0;
+            while (m_clauses[i] != &c)
+                ++i;
+            m_clauses.erase(m_clauses.begin() + i);
+            m_sigs.erase(m_sigs.begin() + i);
+            m_size--;
             if (c.is_learned()) --m_num_redundant;
         }
 
@@ -89,40 +118,46 @@ namespace sat {
             SASSERT(check_invariant());
         }
         
-        void reset() { 
-            m_clauses.finalize(); 
-            m_size = 0; 
+        void reset() {
+            m_clauses.finalize();
+            m_sigs.finalize();
+            m_size = 0;
             m_num_redundant = 0;
         }
-        
+
         bool check_invariant() const;
 
         // iterate & compress
-        class iterator {            
-            clause_vector & m_clauses;
-            unsigned        m_size;
-            unsigned        m_i;
-            unsigned        m_j;
+        class iterator {
+            clause_vector &               m_clauses;
+            svector<unsigned long long> & m_sigs;
+            unsigned              m_size;
+            unsigned              m_i;
+            unsigned              m_j;
             void consume();
 
         public:
-            iterator(clause_vector & v):m_clauses(v), m_size(v.size()), m_i(0) {
+            iterator(clause_vector & v, svector<unsigned long long> & sigs):m_clauses(v), m_sigs(sigs), m_size(v.size()), m_i(0) {
                 m_j = 0;
-                consume(); 
+                consume();
             }
             ~iterator();
             bool at_end() const { return m_i == m_size; }
             clause & curr() const { SASSERT(!at_end()); return *(m_clauses[m_i]); }
-            void next() { 
-                SASSERT(!at_end()); 
-                SASSERT(!m_clauses[m_i]->was_removed()); 
-                m_i++; 
-                m_j++; 
-                consume(); 
+            unsigned long long curr_sig() const { SASSERT(!at_end()); return m_sigs[m_i]; }
+            void next() {
+                SASSERT(!at_end());
+                SASSERT(!m_clauses[m_i]->was_removed());
+                m_i++;
+                m_j++;
+                consume();
             }
         };
-        
-        iterator mk_iterator() const { return iterator(const_cast<clause_use_list*>(this)->m_clauses); }
+
+        iterator mk_iterator() const {
+            clause_use_list * _this = const_cast<clause_use_list*>(this);
+            return iterator(_this->m_clauses, _this->m_sigs);
+        }
 
         std::ostream& display(std::ostream& out) const {
             iterator it = mk_iterator();
@@ -79,7 +79,10 @@ namespace sat {
         m_restart_initial = p.restart_initial();
         m_restart_factor  = p.restart_factor();
         m_restart_max     = p.restart_max();
+        m_restart_banded  = p.restart_banded();
+        m_restart_banded_base = p.restart_banded_base();
         m_propagate_prefetch = p.propagate_prefetch();
+        m_propagate_bin_first = p.propagate_bin_first();
         m_inprocess_max   = p.inprocess_max();
         m_inprocess_out   = p.inprocess_out();
 
@@ -94,6 +97,8 @@ namespace sat {
         
         m_max_conflicts   = p.max_conflicts();
         m_num_threads     = p.threads();
+        m_share_import_max_size = p.share_import_max_size();
+        m_share_import_max_glue = p.share_import_max_glue();
         m_ddfw_search     = p.ddfw_search();
         m_ddfw_threads    = p.ddfw_threads();
         m_prob_search     = p.prob_search();
@@ -185,6 +190,7 @@ namespace sat {
         m_gc_k            = std::min(255u, p.gc_k());
         m_gc_burst        = p.gc_burst();
         m_gc_defrag       = p.gc_defrag();
+        m_gc_defrag_period = p.gc_defrag_period();
 
         m_force_cleanup   = p.force_cleanup();
 
@@ -192,8 +198,18 @@ namespace sat {
         m_backtrack_init_conflicts = p.backtrack_conflicts();
 
         m_minimize_lemmas = p.minimize_lemmas();
+        s = p.minimize_lemmas_alg();
+        if (s == symbol("deep"))
+            m_minimize_lemmas_alg = LM_DEEP;
+        else if (s == symbol("binary"))
+            m_minimize_lemmas_alg = LM_BINARY;
+        else if (s == symbol("both"))
+            m_minimize_lemmas_alg = LM_BOTH;
+        else
+            throw sat_param_exception("invalid lemma minimization algorithm. Use deep (default), binary, both");
         m_core_minimize   = p.core_minimize();
         m_core_minimize_partial   = p.core_minimize_partial();
+        m_core_minimize_threads   = p.core_minimize_threads();
         m_drat_check_unsat  = p.drat_check_unsat();
         m_drat_check_sat  = p.drat_check_sat();
         m_drat_file       = p.drat_file();
@@ -221,6 +237,7 @@ namespace sat {
         else 
             throw sat_param_exception("invalid branching heuristic: accepted heuristics are 'vsids' or 'chb'");
 
+        m_branching_autotune = p.branching_autotune();
         m_anti_exploration = p.branching_anti_exploration();
         m_step_size_init = 0.40;
         m_step_size_dec  = 0.000001;
@@ -52,6 +52,12 @@ namespace sat {
         BH_CHB
     };
 
+    enum lemma_minimization {
+        LM_DEEP,
+        LM_BINARY,
+        LM_BOTH
+    };
+
     enum pb_resolve {
         PB_CARDINALITY,
         PB_ROUNDING
@@ -94,12 +100,15 @@ namespace sat {
         double             m_reorder_itau;
         unsigned           m_reorder_activity_scale;
         bool               m_propagate_prefetch;
+        bool               m_propagate_bin_first;
         restart_strategy   m_restart;
         bool               m_restart_fast;
         unsigned           m_restart_initial;
         double             m_restart_factor; // for geometric case
         double             m_restart_margin; // for ema
         unsigned           m_restart_max;
+        bool               m_restart_banded;
+        unsigned           m_restart_banded_base;
         unsigned           m_activity_scale;
         double             m_fast_glue_avg;
         double             m_slow_glue_avg;
@@ -111,6 +120,8 @@ namespace sat {
         bool               m_enable_pre_simplify;
         unsigned           m_max_conflicts;
         unsigned           m_num_threads;
+        unsigned           m_share_import_max_size;
+        unsigned           m_share_import_max_glue;
         bool               m_ddfw_search;
         unsigned           m_ddfw_threads;
         bool               m_prob_search;
@@ -161,6 +172,7 @@ namespace sat {
         unsigned           m_gc_k;
         bool               m_gc_burst;
         bool               m_gc_defrag;
+        unsigned           m_gc_defrag_period;
 
         bool               m_force_cleanup;
 
@@ -169,9 +181,11 @@ namespace sat {
         unsigned           m_backtrack_init_conflicts;
 
         bool               m_minimize_lemmas;
+        lemma_minimization m_minimize_lemmas_alg;
         bool               m_dyn_sub_res;
         bool               m_core_minimize;
         bool               m_core_minimize_partial;
+        unsigned           m_core_minimize_threads;
 
         // drat proofs
         bool               m_drat;
@@ -191,6 +205,7 @@ namespace sat {
         
         // branching heuristic settings.
         branching_heuristic m_branching_heuristic;
+        bool               m_branching_autotune;
         bool               m_anti_exploration;
         double             m_step_size_init;
         double             m_step_size_dec;
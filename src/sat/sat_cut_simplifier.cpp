@@ -246,19 +246,61 @@ namespace sat {
 
         if (s.m_config.m_cut_npn3) {
             npn3_finder nf(s);
-            // TBD: stubs for npn3
-            // question: perhaps just use a LUT interface?
-            // nf.set_on_mux
-            // nf.set_on_maj
-            // nf.set_on_orand
-            // nf.set_on_and
-            // nf.set_on_xor
-            // nf.set_on_andxor
-            // nf.set_on_xorand
-            // nf.set_on_gamble
-            // nf.set_on_onehot
-            // nf.set_on_dot
-            // nf(clauses);
+            // Each callback provides a head literal h and argument literals a, b, c
+            // such that h is equivalent to the class function applied to a, b, c.
+            // The tables below are truth tables over the argument literals
+            // (bit index w has bit i set iff argument i is true). Signs of the
+            // arguments and of the head are folded into the table so the node
+            // can be added over the underlying variables through the LUT interface.
+            auto add_npn3 = [&,this](uint64_t t, literal head, literal a, literal b, literal c) {
+                literal lits[3] = { a, b, c };
+                bool_var vars[3] = { a.var(), b.var(), c.var() };
+                uint64_t tv = 0;
+                for (unsigned w = 0; w < 8; ++w) {
+                    unsigned u = w;
+                    for (unsigned i = 0; i < 3; ++i)
+                        if (lits[i].sign())
+                            u ^= 1u << i;
+                    tv |= ((t >> u) & 1u) << w;
+                }
+                if (head.sign())
+                    tv = ~tv & 0xFF;
+                m_aig_cuts.add_node(head.var(), tv, 3, vars);
+                m_stats.m_xluts++;
+            };
+            nf.set_on_mux(on_ite);
+            nf.set_on_and([&,this](literal head, literal a, literal b, literal c) {
+                literal args[3] = { a, b, c };
+                m_aig_cuts.add_node(head, and_op, 3, args);
+                m_stats.m_xands++;
+            });
+            nf.set_on_xor([&,this](literal head, literal a, literal b, literal c) {
+                literal args[3] = { a, b, c };
+                m_aig_cuts.add_node(head, xor_op, 3, args);
+                m_stats.m_xxors++;
+            });
+            nf.set_on_maj([&](literal head, literal a, literal b, literal c) {
+                add_npn3(0xE8, head, a, b, c);     // at least two of a, b, c
+            });
+            nf.set_on_orand([&](literal head, literal a, literal b, literal c) {
+                add_npn3(0xA8, head, a, b, c);     // a & (b | c)
+            });
+            nf.set_on_andxor([&](literal head, literal a, literal b, literal c) {
+                add_npn3(0x95, head, a, b, c);     // !(a ^ (b & c))
+            });
+            nf.set_on_xorand([&](literal head, literal a, literal b, literal c) {
+                add_npn3(0x28, head, a, b, c);     // a & (b ^ c)
+            });
+            nf.set_on_gamble([&](literal head, literal a, literal b, literal c) {
+                add_npn3(0x81, head, a, b, c);     // all or none of a, b, c
+            });
+            nf.set_on_onehot([&](literal head, literal a, literal b, literal c) {
+                add_npn3(0x16, head, a, b, c);     // exactly one of a, b, c
+            });
+            nf.set_on_dot([&](literal head, literal a, literal b, literal c) {
+                add_npn3(0x52, head, a, b, c);     // (!a & c) | (a & !b & !c)
+            });
+            nf(clauses);
         }
 
         if (s.m_config.m_cut_lut) {
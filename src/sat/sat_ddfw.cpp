@@ -398,11 +398,32 @@ namespace sat {
             }
             m_par->to_solver(*this);
         }
+        exchange_assignment();
         ++m_parsync_count;
         m_parsync_next *= 3;
         m_parsync_next /= 2;
     }
 
+    void ddfw::exchange_assignment() {
+        m_shared_values.reserve(num_vars());
+        for (unsigned v = 0; v < num_vars(); ++v) {
+            m_shared_values[v] = to_lbool(value(v));
+        }
+        if (!m_par->share_ls_assignment(m_unsat.size(), m_min_sz, m_shared_values)) {
+            return;
+        }
+        // crossover: another walker found a strictly better assignment.
+        for (unsigned v = 0; v < num_vars(); ++v) {
+            if (v < m_shared_values.size() && m_shared_values[v] != l_undef) {
+                value(v) = l_true == m_shared_values[v];
+            }
+        }
+        init_clause_data();
+        if (m_unsat.size() <= m_min_sz) {
+            save_best_values();
+        }
+    }
+
     void ddfw::save_best_values() {
         if (m_unsat.empty()) {
             m_model.reserve(num_vars());
@@ -82,6 +82,7 @@ namespace sat {
         svector<double>      m_probs;       // var -> probability of flipping
         svector<double>      m_scores;      // reward -> score
         model                m_model;       // var -> best assignment
+        model                m_shared_values; // scratch for cross-walker assignment exchange
         
         vector<unsigned_vector> m_use_list;
         unsigned_vector  m_flat_use_list;
@@ -180,6 +181,7 @@ namespace sat {
         // parallel integration
         bool should_parallel_sync();
         void do_parallel_sync();
+        void exchange_assignment();
 
         void log();
 
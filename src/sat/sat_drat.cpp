@@ -31,9 +31,17 @@ namespace sat {
     {
         if (s.get_config().m_drat && s.get_config().m_drat_file.is_non_empty_string()) {
             auto mode = s.get_config().m_drat_binary ? (std::ios_base::binary | std::ios_base::out | std::ios_base::trunc) : std::ios_base::out;
-            m_out = alloc(std::ofstream, s.get_config().m_drat_file.str(), mode);
-            if (s.get_config().m_drat_binary) 
-                std::swap(m_out, m_bout);            
+            std::ofstream* out = alloc(std::ofstream);
+            // Use a large stream buffer so proof logging flushes to the OS in
+            // big chunks; with the default buffer the per-clause writes of a
+            // long run dominate in write system calls. The buffer has to be
+            // installed before the file is opened to take effect portably.
+            m_out_buffer.resize(1 << 20);
+            out->rdbuf()->pubsetbuf(m_out_buffer.data(), m_out_buffer.size());
+            out->open(s.get_config().m_drat_file.str(), mode);
+            m_out = out;
+            if (s.get_config().m_drat_binary)
+                std::swap(m_out, m_bout);
         }
     }
 
@@ -122,7 +130,7 @@ namespace sat {
     void drat::dump_activity() {
         (*m_out) << "c activity ";
         for (unsigned v = 0; v < s.num_vars(); ++v) 
-            (*m_out) << s.m_activity[v] << " ";
+            (*m_out) << s.activity(v) << " ";
         (*m_out) << "\n";
     }
 
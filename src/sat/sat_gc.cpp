@@ -18,6 +18,7 @@ Revision History:
 --*/
 
 
+#include "util/phase_trace.h"
 #include "sat/sat_solver.h"
 
 namespace sat {
@@ -29,13 +30,18 @@ namespace sat {
     // -----------------------
 
     bool solver::should_gc() const {
-        return 
-            m_conflicts_since_gc > m_gc_threshold &&
-            (m_config.m_gc_strategy != GC_DYN_PSM || at_base_lvl());
+        if (m_conflicts_since_gc <= m_gc_threshold &&
+            // under memory pressure collect before the conflict threshold is
+            // reached; require some conflicts so that consecutive collections
+            // have new activity to go by.
+            (m_conflicts_since_gc <= m_config.m_gc_increment || !memory::above_high_watermark()))
+            return false;
+        return m_config.m_gc_strategy != GC_DYN_PSM || at_base_lvl();
     }
 
     void solver::do_gc() {
         if (!should_gc()) return;
+        scoped_phase_trace _pt("sat.gc");
         TRACE("sat", tout << m_conflicts_since_gc << " " << m_gc_threshold << "\n";);
         unsigned gc = m_stats.m_gc_clause;
         m_conflicts_since_gc = 0;
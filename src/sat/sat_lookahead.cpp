@@ -2106,40 +2106,44 @@ namespace sat {
 
     double lookahead::psat_heur() {
         double h = 0.0;
+        double const inv_base  = 1.0 / m_config.m_cube_psat_clause_base;
+        double const inv_base2 = inv_base * inv_base;
+        // m_psat_inv_pow[k] caches inv_base^k; rebuilt if the configured base changed.
+        if (m_psat_inv_pow.size() >= 2 && m_psat_inv_pow[1] != inv_base)
+            m_psat_inv_pow.reset();
         for (bool_var x : m_freevars) {
             literal l(x, false);
             for (literal lit : m_binary[l.index()]) {
-                h += l.index() > lit.index() ? 1.0 / m_config.m_cube_psat_clause_base : 0.0;
+                h += l.index() > lit.index() ? inv_base : 0.0;
             }
             for (literal lit : m_binary[(~l).index()]) {
-                h += l.index() > lit.index() ? 1.0 / m_config.m_cube_psat_clause_base : 0.0;
+                h += l.index() > lit.index() ? inv_base : 0.0;
             }
             for (binary b : m_ternary[l.index()]) {
-                h += l.index() > b.m_u.index() && l.index() > b.m_v.index() ?
-                     1.0 / pow(m_config.m_cube_psat_clause_base, 2) :
-                     0.0;
+                h += l.index() > b.m_u.index() && l.index() > b.m_v.index() ? inv_base2 : 0.0;
             }
             for (binary b : m_ternary[(~l).index()]) {
-                h += l.index() > b.m_u.index() && l.index() > b.m_v.index() ?
-                     1.0 / pow(m_config.m_cube_psat_clause_base, 2) :
-                     0.0;
+                h += l.index() > b.m_u.index() && l.index() > b.m_v.index() ? inv_base2 : 0.0;
             }
         }
         for (nary * n : m_nary_clauses) {
-            h += 1.0 / pow(m_config.m_cube_psat_clause_base, static_cast<double>(n->size() - 1));
+            unsigned sz = n->size();
+            while (m_psat_inv_pow.size() < sz)
+                m_psat_inv_pow.push_back(m_psat_inv_pow.empty() ? 1.0 : m_psat_inv_pow.back() * inv_base);
+            h += m_psat_inv_pow[sz - 1];
         }
         h /= pow(m_freevars.size(), m_config.m_cube_psat_var_exp);
         IF_VERBOSE(10, verbose_stream() << "(sat-cube-psat :val " << h << ")\n";);
         return h;
     }
 
-    bool lookahead::should_cutoff(unsigned depth) {
-        return depth > 0 && 
+    bool lookahead::should_cutoff(unsigned depth, double psat) {
+        return depth > 0 &&
             ((m_config.m_cube_cutoff == depth_cutoff && depth == m_config.m_cube_depth) ||
              (m_config.m_cube_cutoff == freevars_cutoff && m_freevars.size() <= m_init_freevars * m_config.m_cube_freevars) ||
-             (m_config.m_cube_cutoff == psat_cutoff && psat_heur() >= m_config.m_cube_psat_trigger) ||
+             (m_config.m_cube_cutoff == psat_cutoff && psat >= m_config.m_cube_psat_trigger) ||
              (m_config.m_cube_cutoff == adaptive_freevars_cutoff && m_freevars.size() < m_cube_state.m_freevars_threshold) ||
-             (m_config.m_cube_cutoff == adaptive_psat_cutoff && psat_heur() >= m_cube_state.m_psat_threshold));
+             (m_config.m_cube_cutoff == adaptive_psat_cutoff && psat >= m_cube_state.m_psat_threshold));
     }
 
     lbool lookahead::cube(bool_var_vector& vars, literal_vector& lits, unsigned backtrack_level) {
@@ -2189,7 +2193,12 @@ namespace sat {
             }
             backtrack_level = UINT_MAX;
             depth = m_cube_state.m_cube.size();
-            if (should_cutoff(depth)) {
+            // the psat heuristic walks the whole formula; compute it at most
+            // once per cube node and share it between the cutoff test and the
+            // threshold bookkeeping below.
+            bool use_psat = m_config.m_cube_cutoff == psat_cutoff || m_config.m_cube_cutoff == adaptive_psat_cutoff;
+            double cur_psat = use_psat ? psat_heur() : dbl_max;
+            if (should_cutoff(depth, cur_psat)) {
                 double dec = (1.0 - pow(m_config.m_cube_fraction, static_cast<double>(depth)));
                 m_cube_state.m_freevars_threshold *= dec;
                 m_cube_state.m_psat_threshold *= 2.0 - dec;
@@ -2202,7 +2211,7 @@ namespace sat {
                 return l_undef;
             }
             int prev_nfreevars = m_freevars.size();
-            double prev_psat = m_config.m_cube_cutoff == adaptive_psat_cutoff ? psat_heur() : dbl_max;  // MN. only compute PSAT if enabled
+            double prev_psat = m_config.m_cube_cutoff == adaptive_psat_cutoff ? cur_psat : dbl_max;  // MN. only compute PSAT if enabled
             literal lit = choose();
             if (inconsistent()) {
                 TRACE("sat", tout << "inconsistent: " << m_cube_state.m_cube << "\n";);
@@ -248,8 +248,9 @@ namespace sat {
         unsigned               m_init_freevars;
         lookahead_mode         m_search_mode;   // mode of search
         stats                  m_stats;
-        model                  m_model; 
+        model                  m_model;
         cube_state             m_cube_state;
+        svector<double>        m_psat_inv_pow;  // cached inverse powers of the psat clause base
         unsigned               m_max_ops;       // cap number of operations used to compute lookahead reward.
         //scoped_ptr<extension>  m_ext;
  
@@ -564,7 +565,7 @@ namespace sat {
 
         double psat_heur();
 
-        bool should_cutoff(unsigned depth);
+        bool should_cutoff(unsigned depth, double psat);
 
     public:
         lookahead(solver& s) : 
@@ -20,6 +20,9 @@ Notes:
 
 #include "sat/sat_solver.h"
 #include "sat/sat_mus.h"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace sat {
 
@@ -61,7 +64,7 @@ namespace sat {
         TRACE("sat", tout << "old core: " << s.get_core() << "\n";);
         literal_vector& core = get_core();
         literal_vector& mus = m_mus;
-        if (!minimize_partial && core.size() > 64) {
+        if (!minimize_partial && core.size() > 64 && !parallel_enabled()) {
             return mus2();
         }
         while (!core.empty()) {
@@ -82,6 +85,9 @@ namespace sat {
                 break;
             }
 
+            if (!minimize_partial && core.size() > 2 && parallel_enabled() && parallel_shrink(core, mus))
+                continue;
+
             literal lit = core.back();
             core.pop_back();
             lbool is_sat;
@@ -135,6 +141,115 @@ namespace sat {
     }
     
 
+    bool mus::parallel_enabled() const {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        return s.m_config.m_core_minimize_threads > 1 && !s.m_config.m_drat &&
+               std::thread::hardware_concurrency() > 1;
+#endif
+    }
+
+    // Shrink the core with a batch of deletion probes, each running on its
+    // own copy of the solver. A satisfiable probe proves its literal is a
+    // transition literal; transition literals stay critical under any further
+    // shrinking of the working set, so all satisfiable probes of a batch can
+    // be committed together. Among the unsatisfiable probes the smallest
+    // returned core is kept -- it necessarily contains every literal that was
+    // proved critical. Returns false when no batch was run.
+    bool mus::parallel_shrink(literal_vector& core, literal_vector& mus) {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        unsigned num_threads = std::min(s.m_config.m_core_minimize_threads, std::thread::hardware_concurrency());
+        num_threads = std::min(num_threads, core.size());
+        if (num_threads <= 1)
+            return false;
+
+        literal_vector probes;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            probes.push_back(core.back());
+            core.pop_back();
+        }
+
+        vector<reslimit>       limits(num_threads);
+        scoped_limits          scoped_rl(s.rlimit());
+        ptr_vector<solver>     solvers;
+        svector<lbool>         results(num_threads, l_undef);
+        vector<literal_vector> cores(num_threads);
+        vector<model>          models(num_threads);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            solvers.push_back(alloc(solver, s.m_params, limits[i]));
+            solvers[i]->copy(s, false);
+            scoped_rl.push_child(&limits[i]);
+        }
+
+        auto worker = [&](unsigned i) {
+            solver& ws = *solvers[i];
+            literal_vector assumptions(mus);
+            assumptions.append(core);
+            for (unsigned j = 0; j < probes.size(); ++j)
+                assumptions.push_back(i == j ? ~probes[j] : probes[j]);
+            try {
+                results[i] = ws.check(assumptions.size(), assumptions.data());
+                if (results[i] == l_false)
+                    cores[i].append(ws.get_core());
+                else if (results[i] == l_true)
+                    models[i].append(ws.get_model());
+            }
+            catch (z3_exception&) {
+                results[i] = l_undef;
+            }
+        };
+
+        {
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < num_threads; ++i)
+                threads.emplace_back([&worker, i]() { worker(i); });
+            for (auto& th : threads)
+                th.join();
+        }
+        for (solver* ps : solvers)
+            dealloc(ps);
+
+        unsigned best = UINT_MAX;
+        bool progress = false;
+        for (unsigned i = 0; i < num_threads; ++i) {
+            switch (results[i]) {
+            case l_true:
+                progress = true;
+                mus.push_back(probes[i]);
+                if (m_model.empty())
+                    m_model.append(models[i]);
+                break;
+            case l_false:
+                // a core containing the negated probe does not shrink the
+                // working set (unit reduction case); skip it.
+                if (!cores[i].contains(~probes[i]) &&
+                    (best == UINT_MAX || cores[i].size() < cores[best].size()))
+                    best = i;
+                break;
+            default:
+                // inconclusive probe: the literal goes back into the core.
+                core.push_back(probes[i]);
+                break;
+            }
+        }
+        if (best != UINT_MAX) {
+            progress = true;
+            core.reset();
+            for (literal lit : cores[best])
+                if (!mus.contains(lit))
+                    core.push_back(lit);
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat.mus :parallel-probes " << num_threads
+                   << " :core " << core.size() << " :mus " << mus.size() << ")\n";);
+        // every probe was inconclusive; let the sequential step handle
+        // cancellation and restart bounds.
+        return progress;
+#endif
+    }
+
     // bisection search.
     lbool mus::mus2() {
         literal_set core(get_core());
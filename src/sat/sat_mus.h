@@ -37,6 +37,8 @@ namespace sat {
     private:
         lbool mus1();
         lbool mus2();
+        bool parallel_enabled() const;
+        bool parallel_shrink(literal_vector& core, literal_vector& mus);
         lbool qx(literal_set& assignment, literal_set& support, bool has_support);
         void reset();
         void set_core();
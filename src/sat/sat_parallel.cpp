@@ -90,7 +90,7 @@ namespace sat {
         return false;
     }
 
-    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_scoped_rlimit(s.rlimit()) {}
+    parallel::parallel(solver& s): m_num_clauses(0), m_consumer_ready(false), m_ls_best_unsat(UINT_MAX), m_scoped_rlimit(s.rlimit()) {}
 
     parallel::~parallel() {
         for (unsigned i = 0; i < m_solvers.size(); ++i) {            
@@ -147,13 +147,27 @@ namespace sat {
         if (s.get_config().m_num_threads == 1 || s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": share " <<  l1 << " " << l2 << "\n";);
+        unsigned owner = s.m_par_id;
+        if (owner < m_outboxes.size()) {
+            unsigned_vector& out = m_outboxes[owner];
+            out.push_back(3);
+            out.push_back(2); // glue of a learned binary clause
+            out.push_back(l1.index());
+            out.push_back(l2.index());
+            if (out.size() >= m_outbox_limit) {
+                lock_guard lock(m_mux);
+                _flush_outbox(owner);
+            }
+            return;
+        }
         {
             lock_guard lock(m_mux);
-            m_pool.begin_add_vector(s.m_par_id, 2);
+            m_pool.begin_add_vector(owner, 3);
+            m_pool.add_vector_elem(2);
             m_pool.add_vector_elem(l1.index());
-            m_pool.add_vector_elem(l2.index());            
+            m_pool.add_vector_elem(l2.index());
             m_pool.end_add_vector();
-        }        
+        }
     }
 
     void parallel::share_clause(solver& s, clause const& c) {        
@@ -162,39 +176,75 @@ namespace sat {
         unsigned n = c.size();
         unsigned owner = s.m_par_id;
         IF_VERBOSE(3, verbose_stream() << owner << ": share " <<  c << "\n";);
+        if (owner < m_outboxes.size()) {
+            unsigned_vector& out = m_outboxes[owner];
+            out.push_back(n + 1);
+            out.push_back(c.glue());
+            for (unsigned i = 0; i < n; ++i)
+                out.push_back(c[i].index());
+            if (out.size() >= m_outbox_limit) {
+                lock_guard lock(m_mux);
+                _flush_outbox(owner);
+            }
+            return;
+        }
         lock_guard lock(m_mux);
-        m_pool.begin_add_vector(owner, n);                
+        m_pool.begin_add_vector(owner, n + 1);
+        m_pool.add_vector_elem(c.glue());
         for (unsigned i = 0; i < n; ++i) {
             m_pool.add_vector_elem(c[i].index());
         }
-        m_pool.end_add_vector();        
+        m_pool.end_add_vector();
     }
 
     void parallel::get_clauses(solver& s) {
         if (s.m_par_syncing_clauses) return;
         flet<bool> _disable_sync_clause(s.m_par_syncing_clauses, true);
         lock_guard lock(m_mux);
+        if (s.m_par_id < m_outboxes.size())
+            _flush_outbox(s.m_par_id);
         _get_clauses(s);        
     }
 
+    // \pre m_mux is held.
+    void parallel::_flush_outbox(unsigned owner) {
+        unsigned_vector& out = m_outboxes[owner];
+        unsigned i = 0;
+        while (i < out.size()) {
+            unsigned n = out[i++];
+            m_pool.begin_add_vector(owner, n);
+            for (unsigned j = 0; j < n; ++j) 
+                m_pool.add_vector_elem(out[i++]);
+            m_pool.end_add_vector();
+        }
+        out.reset();
+    }
+
     void parallel::_get_clauses(solver& s) {
         unsigned n;
         unsigned const* ptr;
         unsigned owner = s.m_par_id;
+        config const& cfg = s.get_config();
         while (m_pool.get_vector(owner, n, ptr)) {
+            SASSERT(n >= 3);
+            unsigned glue = ptr[0];
+            if (n - 1 > cfg.m_share_import_max_size || glue > cfg.m_share_import_max_glue) {
+                // lemma does not match this consumer's subscription; skip it
+                // without copying the literals.
+                continue;
+            }
             m_lits.reset();
             bool usable_clause = true;
-            for (unsigned i = 0; usable_clause && i < n; ++i) {
-                literal lit(to_literal(ptr[i]));                
+            for (unsigned i = 1; usable_clause && i < n; ++i) {
+                literal lit(to_literal(ptr[i]));
                 m_lits.push_back(lit);
                 usable_clause = lit.var() <= s.m_par_num_vars && !s.was_eliminated(lit.var());
             }
             IF_VERBOSE(3, verbose_stream() << s.m_par_id << ": retrieve " << m_lits << "\n";);
-            SASSERT(n >= 2);
             if (usable_clause) {
                 s.mk_clause_core(m_lits.size(), m_lits.data(), sat::status::redundant());
             }
-        }        
+        }
     }
 
     bool parallel::enable_add(clause const& c) const {
@@ -215,6 +265,12 @@ namespace sat {
 
 
     bool parallel::_to_solver(solver& s) {
+        // seed the phase from the best assignment found by local search.
+        for (bool_var v = 0; v < m_ls_best_values.size(); ++v) {
+            if (m_ls_best_values[v] != l_undef) {
+                s.set_phase(literal(v, m_ls_best_values[v] == l_false));
+            }
+        }
         if (m_priorities.empty()) {
             return false;
         }
@@ -258,7 +314,23 @@ namespace sat {
 
     void parallel::to_solver(i_local_search& s) {
         lock_guard lock(m_mux);
-        _to_solver(s);               
+        _to_solver(s);
+    }
+
+    bool parallel::share_ls_assignment(unsigned unsat_size, unsigned best_size, model& values) {
+        lock_guard lock(m_mux);
+        if (unsat_size < m_ls_best_unsat) {
+            m_ls_best_unsat = unsat_size;
+            m_ls_best_values.reset();
+            m_ls_best_values.append(values);
+            return false;
+        }
+        if (m_ls_best_unsat < best_size) {
+            values.reset();
+            values.append(m_ls_best_values);
+            return true;
+        }
+        return false;
     }
 
     bool parallel::copy_solver(solver& s) {
@@ -30,6 +30,10 @@ namespace sat {
     class parallel {
 
         // shared pool of learned clauses.
+        // Each pooled vector starts with a provenance tag (the glue of the
+        // clause at the time it was shared) followed by the literal indices.
+        // Consumers use the tag to skip lemmas that do not match their
+        // configured import filter without copying the literals.
         class vector_pool {
             unsigned_vector m_vectors;
             unsigned        m_size{ 0 };
@@ -50,6 +54,7 @@ namespace sat {
 
         bool enable_add(clause const& c) const;
         void _get_clauses(solver& s);
+        void _flush_outbox(unsigned owner);
         void _from_solver(solver& s);
         bool _to_solver(solver& s);
         bool _from_solver(i_local_search& s);
@@ -60,6 +65,12 @@ namespace sat {
         index_set      m_unit_set;
         literal_vector m_lits;
         vector_pool    m_pool;
+        // Per-owner staging buffers for shared clauses. Each worker appends
+        // to its own outbox without taking m_mux and the buffer is drained
+        // into the pool in one critical section, so the mutex is acquired
+        // once per batch instead of once per shared clause.
+        vector<unsigned_vector> m_outboxes;
+        static const unsigned m_outbox_limit = 2048;
         mutex          m_mux;
 
         // for exchange with local search:
@@ -67,6 +78,11 @@ namespace sat {
         scoped_ptr<solver> m_solver_copy;
         bool               m_consumer_ready;
         svector<double>    m_priorities;
+        // best assignment found by any local search walker. Walkers publish
+        // improvements here and adopt the entry when it beats their own best
+        // (cross-walker crossover); it is also used to seed the CDCL phase.
+        unsigned           m_ls_best_unsat;
+        model              m_ls_best_values;
 
         scoped_limits      m_scoped_rlimit;
         vector<reslimit>   m_limits;
@@ -83,7 +99,11 @@ namespace sat {
         void push_child(reslimit& rl);
 
         // reserve space
-        void reserve(unsigned num_owners, unsigned sz) { m_pool.reserve(num_owners, sz); }
+        void reserve(unsigned num_owners, unsigned sz) {
+            m_pool.reserve(num_owners, sz);
+            m_outboxes.reset();
+            m_outboxes.resize(num_owners);
+        }
 
         solver& get_solver(unsigned i) { return *m_solvers[i]; }
 
@@ -106,6 +126,11 @@ namespace sat {
         
         bool from_solver(i_local_search& s);
         void to_solver(i_local_search& s);
+
+        // Publish a walker's current assignment when it improves on the shared
+        // best. Overwrites values with the shared best and returns true when
+        // that one is strictly better than best_size.
+        bool share_ls_assignment(unsigned unsat_size, unsigned best_size, model& values);
         
         bool copy_solver(solver& s);
     };
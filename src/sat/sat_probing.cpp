@@ -21,6 +21,9 @@ Revision History:
 #include "sat/sat_solver.h"
 #include "sat/sat_elim_eqs.h"
 #include "sat/sat_simplifier_params.hpp"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 namespace sat {
     probing::probing(solver & _s, params_ref const & p):
@@ -189,6 +192,96 @@ namespace sat {
         }
     }
 
+    // Probe literals on worker threads, each owning a copy of the solver,
+    // and apply the failed literals found as units in one batch. Workers
+    // probe disjoint variable sets, so no synchronization is needed beyond
+    // the final join. Returns false if the parallel mode is unavailable;
+    // the caller then falls back to sequential probing.
+    bool probing::parallel_probe() {
+#ifdef SINGLE_THREAD
+        return false;
+#else
+        unsigned num_threads = std::min(m_probing_threads, std::thread::hardware_concurrency());
+        if (num_threads <= 1 || s.m_config.m_drat)
+            return false;
+        svector<bool_var> candidates;
+        for (bool_var v = 0; v < s.num_vars(); ++v)
+            if (s.value(v) == l_undef && !s.was_eliminated(v))
+                candidates.push_back(v);
+        if (candidates.empty())
+            return true;
+        num_threads = std::min(num_threads, candidates.size());
+
+        vector<reslimit>       limits(num_threads);
+        scoped_limits          scoped_rl(s.rlimit());
+        ptr_vector<solver>     solvers;
+        vector<literal_vector> units(num_threads);
+        unsigned_vector        probes(num_threads, 0u);
+        for (unsigned i = 0; i < num_threads; ++i) {
+            solvers.push_back(alloc(solver, s.m_params, limits[i]));
+            solvers[i]->copy(s, false);
+            scoped_rl.push_child(&limits[i]);
+        }
+        unsigned budget = 1 + m_probing_limit / num_threads;
+
+        auto worker = [&](unsigned i) {
+            solver& ws = *solvers[i];
+            for (unsigned j = i; j < candidates.size() && probes[i] < budget && ws.rlimit().inc(); j += num_threads) {
+                bool_var v = candidates[j];
+                for (unsigned sign = 0; sign < 2 && ws.value(v) == l_undef; ++sign) {
+                    literal l(v, sign != 0);
+                    ws.push();
+                    ws.assign_scoped(l);
+                    ws.propagate(false);
+                    bool failed = ws.inconsistent();
+                    ws.pop(1);
+                    probes[i]++;
+                    if (!failed)
+                        continue;
+                    units[i].push_back(~l);
+                    ws.assign_unit(~l);
+                    ws.propagate(false);
+                    if (ws.inconsistent()) {
+                        // both phases fail: the formula is unsat; export the
+                        // contradiction and stop this worker.
+                        units[i].push_back(l);
+                        return;
+                    }
+                }
+            }
+        };
+
+        {
+            std::vector<std::thread> threads;
+            for (unsigned i = 0; i < num_threads; ++i)
+                threads.emplace_back([&worker, i]() { worker(i); });
+            for (auto& th : threads)
+                th.join();
+        }
+        for (solver* ps : solvers)
+            dealloc(ps);
+
+        for (unsigned i = 0; i < num_threads; ++i) {
+            m_counter -= probes[i];
+            for (literal lit : units[i]) {
+                switch (s.value(lit)) {
+                case l_undef:
+                    s.assign_unit(lit);
+                    m_num_assigned++;
+                    break;
+                case l_false:
+                    s.set_conflict();
+                    return true;
+                default:
+                    break;
+                }
+            }
+        }
+        s.propagate(false);
+        return true;
+#endif
+    }
+
     void probing::process(bool_var v) {
         int old_counter = m_counter;
         unsigned old_num_assigned = m_num_assigned;
@@ -242,6 +335,12 @@ namespace sat {
         bool r    = true;
         m_counter = 0;
         m_equivs.reset();
+        if (m_probing_threads > 1 && parallel_probe()) {
+            m_counter = -m_counter;
+            CASSERT("probing", s.check_invariant());
+            finalize();
+            return true;
+        }
         m_big.init(s, true);
         int limit = -static_cast<int>(m_probing_limit);
         unsigned i;
@@ -303,6 +402,7 @@ namespace sat {
         m_probing_cache       = p.probing_cache();
         m_probing_binary      = p.probing_binary();
         m_probing_cache_limit = p.probing_cache_limit();
+        m_probing_threads     = p.probing_threads();
     }
 
     void probing::collect_param_descrs(param_descrs & d) {
@@ -40,6 +40,7 @@ namespace sat {
         bool               m_probing_cache;       // cache implicit binary clauses
         bool               m_probing_binary;      // try l1 and l2 for binary clauses l1 \/ l2
         unsigned long long m_probing_cache_limit; // memory limit for enabling caching.
+        unsigned           m_probing_threads;     // number of threads for failed literal detection
 
         // stats
         unsigned           m_num_assigned;        
@@ -58,6 +59,7 @@ namespace sat {
         bool try_lit(literal l, bool updt_cache);
         void process(bool_var v);
         void process_core(bool_var v);
+        bool parallel_probe();
 
         // learn equivalences from probing.
         svector<std::pair<literal, literal>> m_equivs;
@@ -35,8 +35,12 @@ namespace sat {
         m_core_literals.insert(literal_vector());
         m_propagated.resize(num_vars(), false);
         for (unsigned i = m_trail.size(); i-- > 0; ) {
-            auto const& [id, cl, clp, is_add, is_initial] = m_trail[i];
-            if (!is_add) {
+            step const& st = m_trail[i];
+            unsigned id    = st.m_id;
+            clause*  clp   = st.m_clause;
+            m_step_clause.init(st.m_length, m_trail_lits.data() + st.m_offset);
+            literal_vector const& cl = m_step_clause;
+            if (!st.m_is_add) {
                 revive(cl, clp);
                 continue;
             }
@@ -48,7 +52,7 @@ namespace sat {
             if (!in_core(cl, clp))
                 continue;
             result.push_back(id);
-            if (is_initial)
+            if (st.m_is_initial)
                 continue;
             conflict_analysis_core(cl, clp);            
         }
@@ -323,7 +327,7 @@ namespace sat {
             return;
         IF_VERBOSE(3, verbose_stream() << (is_initial?"assume ":"rup ") << m_clause << "\n");
         auto* cl = s.mk_clause(m_clause, status::redundant());
-        m_trail.push_back({ id, m_clause, cl, true, is_initial });
+        push_step(id, cl, true, is_initial);
         s.propagate(false);
         save(m_clause, cl);
     }
@@ -346,7 +350,19 @@ namespace sat {
     void proof_trim::del() {
         std::sort(m_clause.begin(), m_clause.end());
         clause* cp = del(m_clause);
-        m_trail.push_back({ 0, m_clause, cp, false, true });
+        push_step(0, cp, false, true);
+    }
+
+    void proof_trim::push_step(unsigned id, clause* cp, bool is_add, bool is_initial) {
+        step st;
+        st.m_id         = id;
+        st.m_offset     = m_trail_lits.size();
+        st.m_length     = m_clause.size();
+        st.m_clause     = cp;
+        st.m_is_add     = is_add;
+        st.m_is_initial = is_initial;
+        m_trail_lits.append(m_clause);
+        m_trail.push_back(st);
     }
     
     void proof_trim::infer(unsigned id) {
@@ -33,8 +33,22 @@ namespace sat {
         literal_vector m_clause;
         uint_set       m_in_clause;
         uint_set       m_in_coi;
-        vector<std::tuple<unsigned, literal_vector, clause*, bool, bool>> m_trail;
-        
+
+        // the recorded proof steps share one literal arena instead of
+        // keeping a heap-allocated vector per step; 100M-step proofs
+        // otherwise spend more memory on vector headers than literals.
+        struct step {
+            unsigned m_id;
+            unsigned m_offset;
+            unsigned m_length;
+            clause*  m_clause;
+            bool     m_is_add;
+            bool     m_is_initial;
+        };
+        svector<step>  m_trail;
+        literal_vector m_trail_lits;
+        literal_vector m_step_clause;
+
         
         struct hash {
             unsigned operator()(literal_vector const& v) const {
@@ -70,6 +84,7 @@ namespace sat {
 
         uint_set m_units;
         bool unit_or_binary_occurs();
+        void push_step(unsigned id, clause* cp, bool is_add, bool is_initial);
         
     public:
 
@@ -430,7 +430,17 @@ namespace sat {
     void simplifier::collect_subsumed1_core(clause const & c1, clause_vector & out, literal_vector & out_lits,
                                             literal target) {
         clause_use_list const & cs = m_use_list.get(target);
+        unsigned long long sig1 = clause_use_list::mk_sig(c1);
         for (auto it = cs.mk_iterator(); !it.at_end(); it.next()) {
+            // literals of c1 whose signature bit is missing from c2.
+            // subsumption allows none, self-subsumption at most one
+            // (the flipped literal), so the residue must be zero or a
+            // single bit. The signatures are literal-precise and stored
+            // contiguously, so candidates are discarded without
+            // dereferencing c2.
+            unsigned long long residue = sig1 & ~it.curr_sig();
+            if ((residue & (residue - 1)) != 0)
+                continue;
             clause & c2 = it.curr();
             CTRACE("sat_simplifier", c2.was_removed(), tout << "clause has been removed:\n" << c2 << "\n";);
             SASSERT(!c2.was_removed());
@@ -539,8 +549,14 @@ namespace sat {
     */
     void simplifier::collect_subsumed0_core(clause const & c1, clause_vector & out, literal target) {
         clause_use_list const & cs = m_use_list.get(target);
+        unsigned long long sig1 = clause_use_list::mk_sig(c1);
         clause_use_list::iterator it = cs.mk_iterator();
         for (; !it.at_end(); it.next()) {
+            // every literal of c1 must appear in c2; the contiguous
+            // literal-precise signatures discard most candidates without
+            // dereferencing c2.
+            if ((sig1 & ~it.curr_sig()) != 0)
+                continue;
             clause & c2 = it.curr();
             SASSERT(!c2.was_removed());
             if (&c2 != &c1 &&
@@ -26,6 +26,8 @@ Revision History:
 #include "util/trace.h"
 #include "util/max_cliques.h"
 #include "util/gparams.h"
+#include "util/phase_trace.h"
+#include "util/self_profiler.h"
 #include "sat/sat_solver.h"
 #include "sat/sat_integrity_checker.h"
 #include "sat/sat_lookahead.h"
@@ -40,6 +42,20 @@ Revision History:
 
 namespace sat {
 
+    static inline void prefetch_data(void const * p) {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(static_cast<char const *>(p));
+#else
+    #if !defined(_M_ARM) && !defined(_M_ARM64)
+        _mm_prefetch(static_cast<char const *>(p), _MM_HINT_T1);
+    #else
+        (void)p;
+    #endif
+#endif
+    }
+
+    // Lookahead distance for prefetching clause bodies during watch-list scans.
+    static constexpr unsigned watch_prefetch_distance = 4;
 
     solver::solver(params_ref const & p, reslimit& l):
         solver_core(l),
@@ -59,8 +75,9 @@ namespace sat {
         m_searching(false),
         m_conflict(justification(0)),
         m_num_frozen(0),
+        m_num_rescales(0),
         m_activity_inc(128),
-        m_case_split_queue(m_activity),
+        m_case_split_queue(m_activity, m_activity_scale, m_num_rescales),
         m_qhead(0),
         m_scope_lvl(0),
         m_search_lvl(0),
@@ -129,6 +146,8 @@ namespace sat {
         m_external.reset();
         m_var_scope.reset();
         m_activity.reset();
+        m_activity_scale.reset();
+        m_num_rescales = 0;
         m_mark.reset();
         m_lit_mark.reset();
         m_best_phase.reset();
@@ -165,7 +184,8 @@ namespace sat {
             m_prev_phase[v] = src.m_prev_phase[v];
 
             // inherit activity:
-            m_activity[v] = src.m_activity[v];
+            m_activity[v] = src.activity(v);
+            m_activity_scale[v] = m_num_rescales;
             m_case_split_queue.activity_changed_eh(v, false);
         }
 
@@ -207,11 +227,21 @@ namespace sat {
 
         {
             literal_vector buffer;
-            // copy clauses
+            // Copy clauses. Clauses of a consistent source solver are
+            // duplicate-free and non-tautological, so they are cloned
+            // directly instead of being re-sorted and re-simplified by
+            // mk_clause_core.
             for (clause* c : src.m_clauses) {
                 buffer.reset();
                 for (literal l : *c) buffer.push_back(l);
-                mk_clause_core(buffer);
+                if (buffer.size() <= 2) {
+                    mk_clause_core(buffer);
+                    continue;
+                }
+                ++m_stats.m_non_learned_generation;
+                if (!m_searching)
+                    m_mc.add_clause(buffer.size(), buffer.data());
+                mk_nary_clause(buffer.size(), buffer.data(), sat::status::asserted());
             }
 
             // copy high quality lemmas
@@ -220,7 +250,9 @@ namespace sat {
                 if (c->glue() <= 2 || (c->size() <= 40 && c->glue() <= 8) || copy_learned) {
                     buffer.reset();
                     for (literal l : *c) buffer.push_back(l);
-                    clause* c1 = mk_clause_core(buffer.size(), buffer.data(), sat::status::redundant());
+                    clause* c1 = buffer.size() <= 2 ?
+                        mk_clause_core(buffer.size(), buffer.data(), sat::status::redundant()) :
+                        mk_nary_clause(buffer.size(), buffer.data(), sat::status::redundant());
                     if (c1) {
                         ++num_learned;
                         c1->set_glue(c->glue());
@@ -262,6 +294,7 @@ namespace sat {
         m_var_scope[v] = scope_lvl();
         m_touched[v] = 0;
         m_activity[v] = 0;
+        m_activity_scale[v] = m_num_rescales;
         m_mark[v] = false;
         m_lit_mark[2*v] = false;
         m_lit_mark[2*v+1] = false;
@@ -302,7 +335,8 @@ namespace sat {
         m_external.push_back(ext);
         m_var_scope.push_back(scope_lvl());
         m_touched.push_back(0);
-        m_activity.push_back(0); 
+        m_activity.push_back(0);
+        m_activity_scale.push_back(m_num_rescales);
         m_mark.push_back(false);
         m_lit_mark.push_back(false);
         m_lit_mark.push_back(false);
@@ -650,17 +684,19 @@ namespace sat {
         solver& s;
         cmp_activity(solver& s):s(s) {}
         bool operator()(bool_var v1, bool_var v2) const {
-            return s.m_activity[v1] > s.m_activity[v2];
+            return s.activity(v1) > s.activity(v2);
         }
     };
 
     bool solver::should_defrag() {
+        if (m_config.m_gc_defrag_period == 0)
+            return false;
         if (m_defrag_threshold > 0) --m_defrag_threshold;
         return m_defrag_threshold == 0 && m_config.m_gc_defrag;
     }
 
     void solver::defrag_clauses() {
-        m_defrag_threshold = 2;
+        m_defrag_threshold = m_config.m_gc_defrag_period == 0 ? 2 : m_config.m_gc_defrag_period - 1;
         if (memory_pressure()) return;
         pop(scope_lvl());
         IF_VERBOSE(2, verbose_stream() << "(sat-defrag)\n");
@@ -913,7 +949,7 @@ namespace sat {
             uint64_t age = m_stats.m_conflict - m_canceled[v];
             if (age > 0) {
                 double decay = pow(0.95, static_cast<double>(age));
-                set_activity(v, static_cast<unsigned>(m_activity[v] * decay));
+                set_activity(v, static_cast<unsigned>(activity(v) * decay));
                 // NB. MapleSAT does not update canceled.
                 m_canceled[v] = m_stats.m_conflict;
             }
@@ -982,6 +1018,7 @@ namespace sat {
     }
 
     bool solver::propagate(bool update) {
+        scoped_profile_tag _prof(self_profiler::SUB_SAT_PROPAGATE);
         unsigned qhead = m_qhead;
         bool r = propagate_core(update);
         if (m_config.m_branching_heuristic == BH_CHB) {
@@ -1029,7 +1066,41 @@ namespace sat {
                     *it2 = *it;                 \
                 wlist.set_end(it2);             \
             }
+        if (m_config.m_propagate_bin_first) {
+            // Propagate every binary implication of l before inspecting any
+            // clause body. Binary entries are never removed by the scan below,
+            // so this pass leaves the watch list untouched and the main loop
+            // revisits them as satisfied (or skips out on the conflict here).
+            // Assigning the cheap implications first lets them participate in
+            // the blocked-literal tests of the clause entries.
+            for (watch_list::iterator bit = it; bit != end; ++bit) {
+                if (!bit->is_binary_clause())
+                    continue;
+                l1 = bit->get_literal();
+                switch (value(l1)) {
+                case l_false:
+                    set_conflict(justification(curr_level, not_l), ~l1);
+                    return false;
+                case l_undef:
+                    m_stats.m_bin_propagate++;
+                    assign_core(l1, justification(curr_level, not_l));
+                    break;
+                case l_true:
+                    break; // skip
+                }
+            }
+        }
+        bool const prefetch = m_config.m_propagate_prefetch;
         for (; it != end; ++it) {
+            // The scan touches clause bodies scattered across the clause
+            // allocator; fetching the body a few entries ahead hides most of
+            // the miss latency. The watched entries themselves are sequential
+            // and covered by hardware prefetch.
+            if (prefetch && it + watch_prefetch_distance < end) {
+                watched const & w = *(it + watch_prefetch_distance);
+                if (w.is_clause())
+                    prefetch_data(&get_clause(w.get_clause_offset()));
+            }
             switch (it->get_kind()) {
             case watched::BINARY:
                 l1 = it->get_literal();
@@ -1594,7 +1665,7 @@ namespace sat {
                 next = m_case_split_queue.min_var();
                 auto age = m_stats.m_conflict - m_canceled[next];
                 while (age > 0) {
-                    set_activity(next, static_cast<unsigned>(m_activity[next] * pow(0.95, static_cast<double>(age))));
+                    set_activity(next, static_cast<unsigned>(activity(next) * pow(0.95, static_cast<double>(age))));
                     m_canceled[next] = m_stats.m_conflict;
                     next = m_case_split_queue.min_var();
                     age = m_stats.m_conflict - m_canceled[next];                    
@@ -1864,8 +1935,9 @@ namespace sat {
     }
 
     void solver::set_activity(bool_var v, unsigned new_act) {
-        unsigned old_act = m_activity[v];
-        m_activity[v] = new_act; 
+        unsigned old_act = activity(v);
+        m_activity[v] = new_act;
+        m_activity_scale[v] = m_num_rescales;
         if (!was_eliminated(v) && value(v) == l_undef && new_act != old_act) {
             m_case_split_queue.activity_changed_eh(v, new_act > old_act);
         }
@@ -1891,6 +1963,16 @@ namespace sat {
         m_force_conflict_analysis = false;
         m_restart_threshold       = m_config.m_restart_initial;
         m_luby_idx                = 1;
+        m_band_stable             = false;
+        m_band_next               = m_conflicts_since_init + m_config.m_restart_banded_base;
+        m_band_len[0]             = m_config.m_restart_banded_base;
+        m_band_len[1]             = m_config.m_restart_banded_base;
+        m_band_glue[0]            = 0.0;
+        m_band_glue[1]            = 0.0;
+        m_band_phase_valid[0]     = false;
+        m_band_phase_valid[1]     = false;
+        if (m_config.m_restart_banded)
+            m_config.m_restart    = RS_LUBY; // the first band is a fast band
         m_gc_threshold            = m_config.m_gc_initial;
         m_defrag_threshold        = 2;
         m_restarts                = 0;
@@ -2251,7 +2333,8 @@ namespace sat {
         IF_VERBOSE(1, verbose_stream() << str);            
     }
 
-    void solver::do_restart(bool to_base) {        
+    void solver::do_restart(bool to_base) {
+        phase_trace::instant("sat.restart");
         m_stats.m_restart++;
         m_restarts++;
         if (m_conflicts_since_init >= m_restart_next_out && get_verbosity_level() >= 1) {
@@ -2267,7 +2350,92 @@ namespace sat {
         IF_VERBOSE(30, display_status(verbose_stream()););
         TRACE("sat", tout << "restart " << restart_level(to_base) << "\n";);
         pop_reinit(restart_level(to_base));
-        set_next_restart();        
+        set_next_restart();
+        if (m_config.m_restart_banded)
+            update_restart_band();
+        if (m_config.m_branching_autotune)
+            autotune();
+    }
+
+    // Alternate fast luby restart bands with long stable bands. Saved phases
+    // are snapshotted when a band ends and restored when a band of the same
+    // kind resumes, so the deep assignments accumulated during a stable band
+    // are not clobbered by the shallow probing of a fast band and vice versa.
+    // Band lengths grow geometrically; in addition the band kind whose glue
+    // record is better receives twice the budget of the other kind, biasing
+    // the allocation towards the regime the instance responds to.
+    void solver::update_restart_band() {
+        if (m_conflicts_since_init < m_band_next)
+            return;
+        unsigned cur = m_band_stable ? 1 : 0;
+        unsigned nxt = 1 - cur;
+        double glue = m_fast_glue_avg;
+        m_band_glue[cur] = m_band_glue[cur] == 0.0 ? glue : 0.5 * (m_band_glue[cur] + glue);
+        m_band_phase[cur].reset();
+        m_band_phase[cur].append(m_phase);
+        m_band_phase_valid[cur] = true;
+        if (m_band_phase_valid[nxt]) {
+            unsigned sz = std::min(m_band_phase[nxt].size(), m_phase.size());
+            for (unsigned i = 0; i < sz; ++i)
+                m_phase[i] = m_band_phase[nxt][i];
+        }
+        m_band_len[cur] = std::min(2 * m_band_len[cur], 16 * m_config.m_restart_banded_base);
+        unsigned len = m_band_len[nxt];
+        if (m_band_glue[nxt] != 0.0 && m_band_glue[cur] != 0.0 && m_band_glue[nxt] < m_band_glue[cur])
+            len *= 2;
+        m_band_next = m_conflicts_since_init + len;
+        m_band_stable = !m_band_stable;
+        if (m_band_stable) {
+            // a stable band runs without intermediate restarts.
+            m_config.m_restart = RS_STATIC;
+            m_restart_threshold = len;
+        }
+        else {
+            m_config.m_restart = RS_LUBY;
+            m_luby_idx = 1;
+            m_restart_threshold = m_config.m_restart_initial * get_luby(m_luby_idx);
+        }
+        IF_VERBOSE(2, verbose_stream() << "(sat.restart-band :kind " << (m_band_stable ? "stable" : "fast")
+                   << " :length " << len << ")\n");
+    }
+
+    // Adapt restart strategy and branching heuristic to the measured search
+    // regime instead of committing to one fixed configuration per solver.
+    // The controller runs at restart boundaries. Conflict-dense windows with
+    // degrading glue behave unsat-like: they profit from frequent ema
+    // restarts and vsids. Propagation-dense windows with stable glue behave
+    // sat-like: they profit from luby restarts that let the solver go deep,
+    // and from the chb reward scheme. Switching is safe mid-flight because
+    // chb time-stamps and vsids activities are maintained for every variable
+    // regardless of the active heuristic.
+    void solver::autotune() {
+        if (m_restarts < m_tune_restarts + 16)
+            return;
+        unsigned conflicts = m_stats.m_conflict - m_tune_conflicts;
+        unsigned propagations = m_stats.m_propagate - m_tune_propagations;
+        m_tune_restarts = m_restarts;
+        m_tune_conflicts = m_stats.m_conflict;
+        m_tune_propagations = m_stats.m_propagate;
+        if (conflicts < 1000)
+            return;
+        bool conflict_dense = static_cast<uint64_t>(conflicts) * 100 > propagations;
+        bool glue_degrading = m_fast_glue_avg > m_config.m_restart_margin * m_slow_glue_avg;
+        bool unsat_like = conflict_dense || glue_degrading;
+        restart_strategy target = unsat_like ? RS_EMA : RS_LUBY;
+        // banded restarts own the restart strategy; only branching is tuned then.
+        if (!m_config.m_restart_banded && m_config.m_restart != target) {
+            IF_VERBOSE(2, verbose_stream() << "(sat.autotune :restart " << (unsat_like ? "ema" : "luby") << ")\n");
+            m_config.m_restart = target;
+            m_luby_idx = 1;
+            m_restart_threshold = m_config.m_restart_initial;
+        }
+        branching_heuristic bh = unsat_like ? BH_VSIDS : BH_CHB;
+        if (m_config.m_branching_heuristic != bh) {
+            IF_VERBOSE(2, verbose_stream() << "(sat.autotune :branching " << (unsat_like ? "vsids" : "chb") << ")\n");
+            m_config.m_branching_heuristic = bh;
+            if (bh == BH_CHB)
+                m_step_size = m_config.m_step_size_init;
+        }
     }
 
     unsigned solver::restart_level(bool to_base) {
@@ -2520,8 +2688,15 @@ namespace sat {
         }
         
         if (m_config.m_minimize_lemmas) {
-            minimize_lemma();
+            // Binary shrinking resolves lemma literals against the binary
+            // implications of the asserting literal; it is much cheaper than
+            // the recursive antecedent walk and can replace or complement it
+            // on long-clause-heavy instances.
+            if (m_config.m_minimize_lemmas_alg != LM_BINARY)
+                minimize_lemma();
             reset_lemma_var_marks();
+            if (m_config.m_minimize_lemmas_alg != LM_DEEP)
+                minimize_lemma_binres();
             if (m_config.m_dyn_sub_res)
                 dyn_sub_res();
             TRACE("sat_lemma", tout << "new lemma (after minimization) size: " << m_lemma.size() << "\n" << m_lemma << "\n";);
@@ -3176,23 +3351,23 @@ namespace sat {
         for (unsigned i = 1; i < sz; ++i) {
             mark_lit(m_lemma[i]);            
         }
-        watch_list const& wlist = get_wlist(m_lemma[0]);
+        // binary clauses (l0 ∨ l) are recorded in the watch list of ~l0;
+        // resolving the lemma with such a clause removes the lemma literal ~l.
+        watch_list const& wlist = get_wlist(~m_lemma[0]);
         for (watched const& w : wlist) {
-            if (w.is_binary_clause() && is_marked_lit(w.get_literal())) {
+            if (w.is_binary_clause() && is_marked_lit(~w.get_literal())) {
                 unmark_lit(~w.get_literal());
                 num_reduced++;
             }
         }
-        if (num_reduced > 0) {
-            unsigned j = 1;
-            for (unsigned i = 1; i < sz; ++i) {
-                if (is_marked_lit(m_lemma[i])) {
-                    m_lemma[j++] = m_lemma[i];
-                    unmark_lit(m_lemma[i]);
-                }
+        unsigned j = 1;
+        for (unsigned i = 1; i < sz; ++i) {
+            if (is_marked_lit(m_lemma[i])) {
+                m_lemma[j++] = m_lemma[i];
+                unmark_lit(m_lemma[i]);
             }
-            m_lemma.shrink(j);
         }
+        m_lemma.shrink(j);
 
         return num_reduced > 0;
     }
@@ -3507,6 +3682,7 @@ namespace sat {
         m_var_scope.shrink(v);
         m_touched.shrink(v);
         m_activity.shrink(v);
+        m_activity_scale.shrink(v);
         m_mark.shrink(v);
         m_lit_mark.shrink(2*v);
         m_phase.shrink(v);
@@ -3715,9 +3891,9 @@ namespace sat {
 
     void solver::rescale_activity() {
         SASSERT(m_config.m_branching_heuristic == BH_VSIDS);
-        for (unsigned& act : m_activity) {
-            act >>= 14;
-        }
+        // constant time: bump the scale generation instead of shifting
+        // every entry; entries are normalized by activity() on access.
+        ++m_num_rescales;
         m_activity_inc >>= 14;
     }
 
@@ -3729,8 +3905,8 @@ namespace sat {
             auto d = m_stats.m_conflict - m_last_conflict[v] + 1;
             if (d == 0) d = 1;
             auto reward = multiplier / d;            
-            auto activity = m_activity[v];
-            set_activity(v, static_cast<unsigned>(m_step_size * reward + ((1.0 - m_step_size) * activity)));
+            auto act = activity(v);
+            set_activity(v, static_cast<unsigned>(m_step_size * reward + ((1.0 - m_step_size) * act)));
         }
     }
 
@@ -3740,7 +3916,7 @@ namespace sat {
         if (m_case_split_queue.empty())
             return;
         bool_var next = m_case_split_queue.min_var();
-        auto next_act = m_activity[next];
+        auto next_act = activity(next);
         set_activity(b, next_act + 1);
     }
 
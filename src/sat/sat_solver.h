@@ -140,6 +140,8 @@ namespace sat {
         literal_vector          m_replay_assign;
         // branch variable selection:
         svector<unsigned>       m_activity;
+        svector<unsigned>       m_activity_scale; // scale generation of each entry of m_activity
+        unsigned                m_num_rescales;   // global activity scale generation
         unsigned                m_activity_inc;
         svector<uint64_t>       m_last_conflict;
         svector<uint64_t>       m_last_propagation;
@@ -536,6 +538,19 @@ namespace sat {
         unsigned m_simplifications = 0;
         unsigned m_restart_threshold = 0;
         unsigned m_luby_idx = 0;
+        // autotuner state: counter values at the last policy evaluation.
+        unsigned m_tune_propagations = 0;
+        unsigned m_tune_conflicts = 0;
+        unsigned m_tune_restarts = 0;
+        // banded restart state: fast (luby) and stable (long) bands alternate,
+        // each band kind keeps its own saved-phase snapshot and glue record.
+        // Index 0 is the fast band, index 1 the stable band.
+        bool        m_band_stable = false;
+        unsigned    m_band_next = 0;
+        unsigned    m_band_len[2] = { 0, 0 };
+        double      m_band_glue[2] = { 0.0, 0.0 };
+        bool_vector m_band_phase[2];
+        bool        m_band_phase_valid[2] = { false, false };
         unsigned m_conflicts_since_gc = 0;
         unsigned m_gc_threshold = 0;
         unsigned m_defrag_threshold = 0;
@@ -580,6 +595,8 @@ namespace sat {
         bool should_cancel();
         bool should_restart() const;
         void set_next_restart();
+        void autotune();
+        void update_restart_band();
         void update_activity(bool_var v, double p);
         bool reached_max_conflicts();
         void sort_watch_lits();
@@ -791,8 +808,25 @@ namespace sat {
         //
         // -----------------------
     public:
+        /**
+           \brief Activity of v normalized to the current scale generation.
+           Activities are rescaled in O(1) by bumping m_num_rescales; entries
+           pay for the missed rescales when they are read.
+        */
+        unsigned activity(bool_var v) const {
+            unsigned d = m_num_rescales - m_activity_scale[v];
+            if (d == 0)
+                return m_activity[v];
+            unsigned s = d * 14;
+            return s >= 32 ? 0 : m_activity[v] >> s;
+        }
+
         void inc_activity(bool_var v) {
             unsigned & act = m_activity[v];
+            if (m_activity_scale[v] != m_num_rescales) {
+                act = activity(v);
+                m_activity_scale[v] = m_num_rescales;
+            }
             act += m_activity_inc;
             m_case_split_queue.activity_increased_eh(v);
             if (act > (1 << 24))
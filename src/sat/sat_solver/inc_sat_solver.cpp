@@ -366,6 +366,8 @@ public:
         m_params.set_sym("pb.solver", p1.pb_solver());
         m_solver.updt_params(m_params);
         m_solver.set_incremental(is_incremental() && !override_incremental());
+        m_preprocess = nullptr; // rebuilt lazily with the new parameters
+
         if (p1.euf() && !get_euf()) 
             ensure_euf();        
     }
@@ -614,41 +616,42 @@ public:
     }
 
     void init_preprocess() {
-        if (m_preprocess) {
-            m_preprocess->reset();
-        }
         if (!m_bb_rewriter) {
             m_bb_rewriter = alloc(bit_blaster_rewriter, m, m_params);
         }
-        params_ref simp1_p = m_params;
-        simp1_p.set_bool("som", true);
-        simp1_p.set_bool("pull_cheap_ite", true);
-        simp1_p.set_bool("push_ite_bv", false);
-        simp1_p.set_bool("local_ctx", true);
-        simp1_p.set_uint("local_ctx_limit", 10000000);
-        simp1_p.set_bool("flat", true); // required by som
-        simp1_p.set_bool("hoist_mul", false); // required by som
-        simp1_p.set_bool("elim_and", true);
-        simp1_p.set_bool("blast_distinct", true);
-
-        params_ref simp2_p = m_params;
-        simp2_p.set_bool("flat", false);
-
-        sat_params sp(m_params);
-        if (sp.euf()) 
-            m_preprocess =
-                and_then(mk_simplify_tactic(m),
-                         mk_propagate_values_tactic(m));
-        else 
-            m_preprocess =
-                and_then(mk_simplify_tactic(m),
-                         mk_propagate_values_tactic(m),
-                         mk_card2bv_tactic(m, m_params),                  // updates model converter
-                         using_params(mk_simplify_tactic(m), simp1_p),
-                         mk_max_bv_sharing_tactic(m),
-                         mk_bit_blaster_tactic(m, m_bb_rewriter.get()),
-                         using_params(mk_simplify_tactic(m), simp2_p)
-                         );
+        // the pipeline is built once and reused across check-sat calls;
+        // updt_params invalidates it so parameter changes take effect.
+        if (!m_preprocess) {
+            params_ref simp1_p = m_params;
+            simp1_p.set_bool("som", true);
+            simp1_p.set_bool("pull_cheap_ite", true);
+            simp1_p.set_bool("push_ite_bv", false);
+            simp1_p.set_bool("local_ctx", true);
+            simp1_p.set_uint("local_ctx_limit", 10000000);
+            simp1_p.set_bool("flat", true); // required by som
+            simp1_p.set_bool("hoist_mul", false); // required by som
+            simp1_p.set_bool("elim_and", true);
+            simp1_p.set_bool("blast_distinct", true);
+
+            params_ref simp2_p = m_params;
+            simp2_p.set_bool("flat", false);
+
+            sat_params sp(m_params);
+            if (sp.euf())
+                m_preprocess =
+                    and_then(mk_simplify_tactic(m),
+                             mk_propagate_values_tactic(m));
+            else
+                m_preprocess =
+                    and_then(mk_simplify_tactic(m),
+                             mk_propagate_values_tactic(m),
+                             mk_card2bv_tactic(m, m_params),                  // updates model converter
+                             using_params(mk_simplify_tactic(m), simp1_p),
+                             mk_max_bv_sharing_tactic(m),
+                             mk_bit_blaster_tactic(m, m_bb_rewriter.get()),
+                             using_params(mk_simplify_tactic(m), simp2_p)
+                             );
+        }
         while (m_bb_rewriter->get_num_scopes() < m_num_scopes) {
             m_bb_rewriter->push();
         }
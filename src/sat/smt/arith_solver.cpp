@@ -239,12 +239,13 @@ namespace arith {
 
         lp_bounds const& bounds = m_bounds[v];
         bool first = true;
+        m_implied_lits.reset();
         for (unsigned i = 0; i < bounds.size(); ++i) {
             api_bound* b = bounds[i];
-            if (s().value(b->get_lit()) != l_undef) 
+            if (s().value(b->get_lit()) != l_undef)
                 continue;
             literal lit = is_bound_implied(be.kind(), be.m_bound, *b);
-            if (lit == sat::null_literal) 
+            if (lit == sat::null_literal)
                 continue;
             TRACE("arith", tout << "lp bound " << lit << " bound: " << *b << " first: " << first << "\n";);
 
@@ -260,13 +261,35 @@ namespace arith {
             TRACE("arith", for (auto lit : m_core) tout << lit << ": " << s().value(lit) << "\n";);
             DEBUG_CODE(for (auto lit : m_core) { VERIFY(s().value(lit) == l_true); });
             ++m_stats.m_bound_propagations1;
-            assign(lit, m_core, m_eqs, explain(hint_type::bound_h, lit));
+            m_implied_lits.push_back(lit);
         }
 
+        if (!m_implied_lits.empty())
+            assign_bounds(m_implied_lits, m_core, m_eqs);
+
         if (should_refine_bounds() && first)
             refine_bound(v, be);
     }
 
+    /**
+       Assign all bound literals implied by the same explanation.
+       The literals share their antecedents, so a single justification is
+       allocated for the whole batch instead of one per literal. Proof
+       hints record the implied literal, hence the batch falls back to
+       per-literal justifications when proofs are on.
+    */
+    void solver::assign_bounds(literal_vector const& lits, literal_vector const& core, svector<enode_pair> const& eqs) {
+        if (lits.size() == 1 || ctx.use_drat() ||
+            (core.size() < small_lemma_size() && eqs.empty())) {
+            for (literal lit : lits)
+                assign(lit, core, eqs, explain(hint_type::bound_h, lit));
+            return;
+        }
+        auto* jst = euf::th_explain::propagate(*this, core, eqs, lits[0], nullptr);
+        for (literal lit : lits)
+            ctx.propagate(lit, jst->to_index());
+    }
+
     literal solver::is_bound_implied(lp::lconstraint_kind k, rational const& value, api_bound const& b) const {
         if ((k == lp::LE || k == lp::LT) && b.get_bound_kind() == lp_api::upper_t && value <= b.get_value()) {
             TRACE("arith", tout << "v <= value <= b.get_value() => v <= b.get_value() \n";);
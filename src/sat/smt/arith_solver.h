@@ -259,6 +259,7 @@ namespace arith {
         lp::explanation     m_explanation;
         vector<nla::lemma>  m_nla_lemma_vector;
         literal_vector      m_core, m_core2;
+        literal_vector      m_implied_lits;  // bounds implied by one explanation
         svector<enode_pair> m_eqs;
         vector<parameter>   m_params;
         nla::lemma          m_lemma;
@@ -469,6 +470,7 @@ namespace arith {
         void set_conflict_or_lemma(literal_vector const& core, bool is_conflict);
         void set_evidence(lp::constraint_index idx);
         void assign(literal lit, literal_vector const& core, svector<enode_pair> const& eqs, euf::th_proof_hint const* pma);
+        void assign_bounds(literal_vector const& lits, literal_vector const& core, svector<enode_pair> const& eqs);
 
         void false_case_of_check_nla(const nla::lemma& l);        
         void dbg_finalize_model(model& mdl);
@@ -38,7 +38,7 @@ namespace pb {
     }
 
     bool card::is_watching(literal l) const {
-        unsigned sz = std::min(k() + 1, size());
+        unsigned sz = counter_mode() ? size() : std::min(k() + 1, size());
         for (unsigned i = 0; i < sz; ++i) {
             if ((*this)[i] == l) return true;
         }
@@ -107,9 +107,10 @@ namespace pb {
     void card::clear_watch(solver_interface& s) {
         if (is_clear()) return;
         reset_watch();
-        unsigned sz = std::min(k() + 1, size());
-        for (unsigned i = 0; i < sz; ++i) 
-            unwatch_literal(s, (*this)[i]);        
+        unsigned sz = counter_mode() ? size() : std::min(k() + 1, size());
+        for (unsigned i = 0; i < sz; ++i)
+            unwatch_literal(s, (*this)[i]);
+        unset_counter_mode();
     }
 
     bool card::init_watch(solver_interface& s) {
@@ -137,7 +138,9 @@ namespace pb {
         for (unsigned i = 0; i < sz; ++i) {
             if (s.value(c[i]) != l_false) {
                 if (j != i) {
-                    if (c.is_watched() && j <= bound && i > bound) {
+                    // in counter mode every literal is watched; swapping does
+                    // not change the watch set.
+                    if (c.is_watched() && !c.counter_mode() && j <= bound && i > bound) {
                         c.unwatch_literal(s, c[j]);
                         c.watch_literal(s, c[i]);
                     }
@@ -182,10 +185,26 @@ namespace pb {
             return false;
         }
         else {
-            if (c.is_watched()) return true;
+            if (c.is_watched()) {
+                // positional watches maintain their own invariants; the false
+                // counter has to be refreshed for the current assignment.
+                if (c.counter_mode())
+                    c.set_counter_mode(sz - j);
+                return true;
+            }
             clear_watch(s);
-            for (unsigned i = 0; i <= bound; ++i) {
-                c.watch_literal(s, c[i]);
+            if (2 * (bound + 1) >= sz) {
+                // at-most-k style constraints (bound close to the size) would
+                // watch almost every literal anyway; watch all of them and
+                // propagate by counting false literals, O(1) per assignment.
+                for (unsigned i = 0; i < sz; ++i)
+                    c.watch_literal(s, c[i]);
+                c.set_counter_mode(sz - j);
+            }
+            else {
+                for (unsigned i = 0; i <= bound; ++i) {
+                    c.watch_literal(s, c[i]);
+                }
             }
             c.set_watch();
             return true;
@@ -216,12 +235,19 @@ namespace pb {
         }
     }
 
-    bool card::validate_unit_propagation(solver_interface const& s, literal alit) const { 
+    bool card::validate_unit_propagation(solver_interface const& s, literal alit) const {
         (void) alit;
-        if (lit() != sat::null_literal && s.value(lit()) != l_true) 
+        if (lit() != sat::null_literal && s.value(lit()) != l_true)
             return false;
-        for (unsigned i = k(); i < size(); ++i) 
-            if (s.value((*this)[i]) != l_false) 
+        if (counter_mode()) {
+            unsigned num_false = 0;
+            for (literal l : *this)
+                if (s.value(l) == l_false)
+                    ++num_false;
+            return num_false >= size() - k();
+        }
+        for (unsigned i = k(); i < size(); ++i)
+            if (s.value((*this)[i]) != l_false)
                 return false;
         return true;
     }
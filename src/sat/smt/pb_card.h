@@ -24,6 +24,8 @@ Author:
 namespace pb {
 
     class card : public constraint {
+        unsigned       m_num_false = 0; // counter mode: number of false literals
+        bool           m_counter = false; // propagate by counting instead of positional watches
         literal        m_lits[0];
     public:
         static size_t get_obj_size(unsigned num_lits) { return sat::constraint_base::obj_size(sizeof(card) + num_lits * sizeof(literal)); }
@@ -39,6 +41,12 @@ namespace pb {
         literal get_lit(unsigned i) const override { return m_lits[i]; }
         void set_lit(unsigned i, literal l) override { m_lits[i] = l; }
         unsigned get_coeff(unsigned i) const override { return 1; }
+        bool counter_mode() const { return m_counter; }
+        unsigned num_false() const { return m_num_false; }
+        void inc_false() { ++m_num_false; }
+        void dec_false() { SASSERT(m_num_false > 0); --m_num_false; }
+        void set_counter_mode(unsigned num_false) { m_counter = true; m_num_false = num_false; }
+        void unset_counter_mode() { m_counter = false; }
         double get_reward(solver_interface const& s, sat::literal_occs_fun& occs) const override;
         std::ostream& display(std::ostream& out) const override;
         std::ostream& display(std::ostream& out, solver_interface const& s, bool values) const override;
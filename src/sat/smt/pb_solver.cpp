@@ -1274,11 +1274,23 @@ namespace pb {
         SASSERT(c.k() <= c.size());       
         SASSERT(lit == sat::null_literal || value(lit) != l_undef);
         SASSERT(0 < offset);
-        for (unsigned i = c.k(); i < c.size(); ++i) {
-            process_antecedent(c[i], offset);
+        if (c.counter_mode()) {
+            // counter mode does not maintain the false literals in positions
+            // k() .. size(); split by value instead.
+            for (literal l2 : c) {
+                if (value(l2) == l_false)
+                    process_antecedent(l2, offset);
+                else
+                    inc_coeff(l2, offset);
+            }
         }
-        for (unsigned i = 0; i < c.k(); ++i) {
-            inc_coeff(c[i], offset);                        
+        else {
+            for (unsigned i = c.k(); i < c.size(); ++i) {
+                process_antecedent(c[i], offset);
+            }
+            for (unsigned i = 0; i < c.k(); ++i) {
+                inc_coeff(c[i], offset);
+            }
         }
         if (lit != sat::null_literal) {
             uint64_t offset1 = static_cast<uint64_t>(offset) * c.k();
@@ -1646,6 +1658,20 @@ namespace pb {
 
 
     void solver::get_antecedents(literal l, card const& c, literal_vector& r) {
+        if (c.counter_mode()) {
+            // in counter mode the false literals are not kept in positions
+            // k() .. size(); collect them by value. After the constraint
+            // propagated, no remaining literal is undefined, so the false
+            // literals are exactly the ones that triggered the propagation.
+            if (l != ~c.lit() && c.lit() != sat::null_literal) {
+                VERIFY(value(c.lit()) != l_false);
+                r.push_back(value(c.lit()) == l_true ? c.lit() : ~c.lit());
+            }
+            for (literal lit2 : c)
+                if (value(lit2) == l_false)
+                    r.push_back(~lit2);
+            return;
+        }
         if (l == ~c.lit()) {
             for (unsigned i = c.k() - 1; i < c.size(); ++i) {
                 VERIFY(value(c[i]) == l_false);
@@ -1703,9 +1729,28 @@ namespace pb {
         c.nullify_tracking_literal(*this);
         clear_watch(c);
         c.set_removed();
+        if (c.tag() == pb::tag_t::card_t && c.to_card().counter_mode())
+            purge_counter_trail(c.to_card());
         m_constraint_removed = true;
     }
 
+    // Drop the undo entries of c from m_counter_trail: c may be deallocated
+    // while the search is above base level (gc runs at search level), so its
+    // entries must not be dereferenced by a later pop. The scope limits are
+    // compacted alongside the trail.
+    void solver::purge_counter_trail(card& c) {
+        unsigned j = 0, lim_idx = 0;
+        for (unsigned i = 0; i < m_counter_trail.size(); ++i) {
+            while (lim_idx < m_counter_trail_lim.size() && m_counter_trail_lim[lim_idx] == i)
+                m_counter_trail_lim[lim_idx++] = j;
+            if (m_counter_trail[i] != &c)
+                m_counter_trail[j++] = m_counter_trail[i];
+        }
+        while (lim_idx < m_counter_trail_lim.size())
+            m_counter_trail_lim[lim_idx++] = j;
+        m_counter_trail.shrink(j);
+    }
+
     // --------------------------------
     // validation
 
@@ -1907,6 +1952,8 @@ namespace pb {
             if (m >= num_vars) {
                 clear_watch(*c);
                 c->nullify_tracking_literal(*this);
+                if (c->tag() == pb::tag_t::card_t && c->to_card().counter_mode())
+                    purge_counter_trail(c->to_card());
                 c->deallocate(m_allocator);
             }
             else 
@@ -1916,8 +1963,48 @@ namespace pb {
     }
 
 
+    // Counter-based propagation: every literal of c is watched and c keeps
+    // the number of false literals. Assignments cost O(1); the counter is
+    // restored from m_counter_trail on backtracking. Once the number of
+    // false literals reaches size - k the remaining literals are forced.
+    lbool solver::add_assign_counter(card& c, literal alit) {
+        unsigned sz = c.size();
+        unsigned slack = sz - c.k();
+        SASSERT(value(alit) == l_false);
+        c.inc_false();
+        m_counter_trail.push_back(&c);
+        if (c.num_false() < slack)
+            return l_true;
+        if (c.num_false() > slack) {
+            if (c.lit() != sat::null_literal && value(c.lit()) == l_undef) {
+                assign(c, ~c.lit());
+                return inconsistent() ? l_false : l_true;
+            }
+            set_conflict(c, alit);
+            return l_false;
+        }
+        if (c.lit() != sat::null_literal && value(c.lit()) == l_undef)
+            return l_true;
+        for (unsigned i = 0; i < sz; ++i) {
+            literal lit2 = c[i];
+            if (value(lit2) == l_undef)
+                assign(c, lit2);
+            if (inconsistent())
+                return l_false;
+        }
+        if (c.learned() && c.glue() > 2) {
+            unsigned glue;
+            if (s().num_diff_false_levels_below(c.size(), c.begin(), c.glue()-1, glue)) {
+                c.set_glue(glue);
+            }
+        }
+        return l_true;
+    }
+
     lbool solver::add_assign(card& c, literal alit) {
-        // literal is assigned to false.        
+        if (c.counter_mode())
+            return add_assign_counter(c, alit);
+        // literal is assigned to false.
         unsigned sz = c.size();
         unsigned bound = c.k();
         TRACE("pb", tout << "assign: " << c.lit() << ": " << ~alit << "@" << lvl(~alit) << " " << c << "\n";);
@@ -2003,14 +2090,22 @@ namespace pb {
     sat::check_result solver::check() { return sat::check_result::CR_DONE; }
 
     void solver::push() {
+        if (m_counter_trail_lim.empty())
+            m_counter_trail.reset(); // base-level increments are never undone
+        m_counter_trail_lim.push_back(m_counter_trail.size());
         m_constraint_to_reinit_lim.push_back(m_constraint_to_reinit.size());
     }
 
-    void solver::pop(unsigned n) {        
+    void solver::pop(unsigned n) {
         TRACE("sat_verbose", tout << "pop:" << n << "\n";);
         unsigned new_lim = m_constraint_to_reinit_lim.size() - n;
         m_constraint_to_reinit_last_sz = m_constraint_to_reinit_lim[new_lim];
         m_constraint_to_reinit_lim.shrink(new_lim);
+        unsigned lim = m_counter_trail_lim[new_lim];
+        for (unsigned i = m_counter_trail.size(); i-- > lim; )
+            m_counter_trail[i]->dec_false();
+        m_counter_trail.shrink(lim);
+        m_counter_trail_lim.shrink(new_lim);
         m_num_propagations_since_pop = 0;
     }
 
@@ -90,6 +90,10 @@ namespace pb {
         ptr_vector<constraint> m_constraint_to_reinit;
         unsigned_vector        m_constraint_to_reinit_lim;
         unsigned               m_constraint_to_reinit_last_sz{ 0 };
+        // undo trail for counter-based cardinality constraints: every false
+        // counter increment is recorded and reverted on backtracking.
+        ptr_vector<card>       m_counter_trail;
+        unsigned_vector        m_counter_trail_lim;
         unsigned               m_constraint_id{ 0 };
 
         // conflict resolution
@@ -216,6 +220,8 @@ namespace pb {
 
         // cardinality
         lbool add_assign(card& c, literal lit);
+        lbool add_assign_counter(card& c, literal alit);
+        void purge_counter_trail(card& c);
         void reset_coeffs();
         void reset_marked_literals();
         void get_antecedents(literal l, card const& c, literal_vector & r);
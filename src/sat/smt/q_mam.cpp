@@ -3083,7 +3083,24 @@ namespace q {
 
         enode *                     m_root = nullptr;  // temp field
         enode *                     m_other = nullptr; // temp field
-        bool                        m_check_missing_instances = false;        
+        bool                        m_check_missing_instances = false;
+
+        // Bindings found while interpreting code trees. During the match
+        // phase bindings are collected here instead of being sent to the
+        // instantiation queue, so that code-tree interpretation runs
+        // read-only against the current egraph. The batch is merged into
+        // the queue once the phase is over.
+        struct deferred_binding {
+            quantifier * m_qa;
+            app *        m_pat;
+            unsigned     m_offset; // start in m_deferred_nodes
+            unsigned     m_max_generation;
+            unsigned     m_min_top_generation;
+            unsigned     m_max_top_generation;
+        };
+        svector<deferred_binding>   m_deferred_bindings;
+        ptr_vector<enode>           m_deferred_nodes;
+        bool                        m_defer_bindings = false;
 
         enode_vector * mk_tmp_vector() {
             enode_vector * r = m_pool.mk();
@@ -3710,21 +3727,25 @@ namespace q {
                 }
             }
 
-            for (func_decl * lbl : m_tmp_trees_to_delete) {
-                unsigned    lbl_id   = lbl->get_small_id();
-                code_tree * tmp_tree = m_tmp_trees[lbl_id];
-                SASSERT(tmp_tree != 0);
-                SASSERT(!m_egraph.enodes_of(lbl).empty());
-                m_interpreter.init(tmp_tree);
-                auto& nodes = m_egraph.enodes_of(lbl);
-                for (unsigned i = 0; i < nodes.size(); ++i) {
-                    enode* app = nodes[i];
-                    if (ctx.is_relevant(app))
-                        m_interpreter.execute_core(tmp_tree, app);
+            {
+                flet<bool> defer(m_defer_bindings, true);
+                for (func_decl * lbl : m_tmp_trees_to_delete) {
+                    unsigned    lbl_id   = lbl->get_small_id();
+                    code_tree * tmp_tree = m_tmp_trees[lbl_id];
+                    SASSERT(tmp_tree != 0);
+                    SASSERT(!m_egraph.enodes_of(lbl).empty());
+                    m_interpreter.init(tmp_tree);
+                    auto& nodes = m_egraph.enodes_of(lbl);
+                    for (unsigned i = 0; i < nodes.size(); ++i) {
+                        enode* app = nodes[i];
+                        if (ctx.is_relevant(app))
+                            m_interpreter.execute_core(tmp_tree, app);
+                    }
+                    m_tmp_trees[lbl_id] = nullptr;
+                    dealloc(tmp_tree);
                 }
-                m_tmp_trees[lbl_id] = nullptr;
-                dealloc(tmp_tree);
             }
+            flush_deferred_bindings();
         }
 
     public:
@@ -3783,11 +3804,29 @@ namespace q {
         }
 
         void propagate_to_match() {
-            if (m_to_match_head >= m_to_match.size()) 
+            if (m_to_match_head >= m_to_match.size())
                 return;
             ctx.push(value_trail<unsigned>(m_to_match_head));
-            for (; m_to_match_head < m_to_match.size(); ++m_to_match_head) 
-                m_interpreter.execute(m_to_match[m_to_match_head]);
+            {
+                flet<bool> defer(m_defer_bindings, true);
+                for (; m_to_match_head < m_to_match.size(); ++m_to_match_head)
+                    m_interpreter.execute(m_to_match[m_to_match_head]);
+            }
+            flush_deferred_bindings();
+        }
+
+        /// Merge the batch of bindings found during the match phase into
+        /// the instantiation queue.
+        void flush_deferred_bindings() {
+            SASSERT(!m_defer_bindings);
+            for (auto const & db : m_deferred_bindings)
+                m_ematch.on_binding(db.m_qa, db.m_pat,
+                                    m_deferred_nodes.data() + db.m_offset,
+                                    db.m_max_generation,
+                                    db.m_min_top_generation,
+                                    db.m_max_top_generation);
+            m_deferred_bindings.reset();
+            m_deferred_nodes.reset();
         }
 
         void propagate() override {
@@ -3820,6 +3859,14 @@ namespace q {
             TRACE("trigger_bug", tout << "found match " << mk_pp(qa, m) << "\n";);
             unsigned min_gen = 0, max_gen = 0;
             m_interpreter.get_min_max_top_generation(min_gen, max_gen);
+            if (m_defer_bindings) {
+                deferred_binding db = { qa, pat, m_deferred_nodes.size(),
+                                        max_generation, min_gen, max_gen };
+                m_deferred_bindings.push_back(db);
+                for (unsigned i = 0; i < num_bindings; i++)
+                    m_deferred_nodes.push_back(bindings[i]);
+                return;
+            }
             m_ematch.on_binding(qa, pat, bindings, max_generation, min_gen, max_gen);
         }
 
@@ -3,12 +3,12 @@ Copyright (c) 2014 Microsoft Corporation
 
 Module Name:
 
-    xor_solver.h
+    xor_solver.cpp
 
 Abstract:
 
     XOR solver.
-    Interface outline.
+    Native parity constraints with watched-variable propagation.
 
 --*/
 
@@ -20,12 +20,95 @@ Abstract:
 namespace xr {
 
     solver::solver(euf::solver& ctx):
-        th_solver(ctx.get_manager(), symbol("xor-solver"), ctx.get_manager().get_family_id("xor-solver"))
+        th_solver(ctx.get_manager(), symbol("xor-solver"), ctx.get_manager().get_family_id("xor-solver")),
+        m_allocator("xor-solver")
     {}
 
+    solver::~solver() {
+        for (constraint* c : m_constraints) {
+            void* mem = sat::constraint_base::from_index(c->cindex());
+            m_allocator.deallocate(constraint::get_obj_size(c->size()), mem);
+        }
+    }
+
     euf::th_solver* solver::clone(euf::solver& ctx) {
-        // and relevant copy internal state
-        return alloc(solver, ctx);
+        solver* result = alloc(solver, ctx);
+        sat::literal_vector lits;
+        for (constraint* c : m_constraints) {
+            lits.reset();
+            lits.append(c->size(), c->begin());
+            result->add_xor(lits);
+        }
+        return result;
+    }
+
+    void solver::add_xor(sat::literal_vector const& lits) {
+        DEBUG_CODE(
+            for (unsigned i = 0; i < lits.size(); ++i)
+                for (unsigned j = i + 1; j < lits.size(); ++j)
+                    SASSERT(lits[i].var() != lits[j].var()););
+        void* mem = m_allocator.allocate(constraint::get_obj_size(lits.size()));
+        sat::constraint_base::initialize(mem, this);
+        constraint* c = new (sat::constraint_base::ptr2mem(mem)) constraint(lits);
+        m_constraints.push_back(c);
+        for (sat::literal l : lits)
+            m_shared.setx(l.var(), true, false);
+        // a cloned solver defers watch installation to init_search.
+        if (m_solver && m_num_watched == m_constraints.size() - 1) {
+            init_watch(*c);
+            ++m_num_watched;
+        }
+    }
+
+    void solver::watch(constraint& c, unsigned pos) {
+        sat::literal l = c[pos];
+        sat::watched w(c.cindex());
+        s().get_wlist(l).push_back(w);
+        s().get_wlist(~l).push_back(w);
+    }
+
+    void solver::assign(constraint& c, sat::literal lit) {
+        switch (s().value(lit)) {
+        case l_true:
+            break;
+        case l_false:
+            s().set_conflict(sat::justification::mk_ext_justification(s().scope_lvl(), c.cindex()), ~lit);
+            break;
+        default:
+            s().assign(lit, sat::justification::mk_ext_justification(s().scope_lvl(), c.cindex()));
+            break;
+        }
+    }
+
+    void solver::init_watch(constraint& c) {
+        if (c.size() == 0) {
+            s().set_conflict();
+            return;
+        }
+        if (c.size() == 1) {
+            assign(c, c[0]);
+            return;
+        }
+        // move two unassigned literals (if any) to the watch positions.
+        unsigned num_undef = 0;
+        for (unsigned i = 0; i < c.size() && num_undef < 2; ++i)
+            if (s().value(c[i]) == l_undef)
+                c.swap(num_undef++, i);
+        watch(c, 0);
+        watch(c, 1);
+        if (num_undef >= 2)
+            return;
+        // unit or fully assigned: the parity of positions 1..n-1 forces position 0.
+        bool v = false;
+        for (unsigned i = 1; i < c.size(); ++i)
+            v ^= s().value(c[i]) == l_true;
+        assign(c, v ? ~c[0] : c[0]);
+    }
+
+    void solver::init_search() {
+        for (unsigned i = m_num_watched; i < m_constraints.size(); ++i)
+            init_watch(*m_constraints[i]);
+        m_num_watched = m_constraints.size();
     }
 
     void solver::asserted(sat::literal l) {
@@ -35,19 +118,72 @@ namespace xr {
     bool solver::unit_propagate() {
         return false;
     }
-    
+
+    bool solver::propagated(sat::literal l, sat::ext_constraint_idx idx) {
+        constraint& c = constraint::from_index(idx);
+        unsigned w = c[0].var() == l.var() ? 0 : 1;
+        SASSERT(c[w].var() == l.var());
+        // replace the fired watch by an unassigned variable when one exists.
+        for (unsigned i = 2; i < c.size(); ++i) {
+            if (s().value(c[i]) == l_undef) {
+                c.swap(w, i);
+                watch(c, w);
+                // remove the entry for the other phase of the replaced variable.
+                s().get_wlist(~l).erase(sat::watched(idx));
+                return false;
+            }
+        }
+        // all literals outside the other watch are assigned: force its value.
+        unsigned other = 1 - w;
+        bool v = false;
+        for (unsigned i = 0; i < c.size(); ++i)
+            if (i != other)
+                v ^= s().value(c[i]) == l_true;
+        assign(c, v ? ~c[other] : c[other]);
+        return true;
+    }
+
     void solver::get_antecedents(sat::literal l, sat::ext_justification_idx idx,
                                  sat::literal_vector & r, bool probing) {
-        
+        constraint& c = constraint::from_index(idx);
+        for (unsigned i = 0; i < c.size(); ++i) {
+            sat::literal li = c[i];
+            if (li.var() == l.var())
+                continue;
+            SASSERT(s().value(li) != l_undef);
+            r.push_back(s().value(li) == l_true ? li : ~li);
+        }
+    }
+
+    bool solver::is_external(sat::bool_var v) {
+        return v < m_shared.size() && m_shared[v];
     }
-    
+
+    void solver::init_use_list(sat::ext_use_list& ul) {
+        for (constraint* cp : m_constraints) {
+            for (sat::literal l : *cp) {
+                ul.insert(l, cp->cindex());
+                ul.insert(~l, cp->cindex());
+            }
+        }
+    }
+
     sat::check_result solver::check() {
+        DEBUG_CODE(
+            for (constraint* cp : m_constraints) {
+                bool v = false;
+                for (sat::literal l : *cp)
+                    v ^= s().value(l) == l_true;
+                SASSERT(v);
+            });
         return sat::check_result::CR_DONE;
     }
-    
+
     void solver::push() {
+        // the watch invariant is stable under backtracking:
+        // watched variables are unassigned before the remaining ones.
     }
-    
+
     void solver::pop(unsigned n) {
     }
 
@@ -56,24 +192,36 @@ namespace xr {
     // simplify: recompile clauses to xor constraints
     // literals that get added to xor constraints are tagged with the theory.
     void solver::pre_simplify() {
-        
+
     }
 
     void solver::simplify() {
-        
+
+    }
+
+    std::ostream& solver::display(std::ostream& out, constraint const& c) const {
+        bool first = true;
+        for (sat::literal l : c) {
+            if (!first)
+                out << " ^ ";
+            first = false;
+            out << l;
+        }
+        return out;
     }
 
     std::ostream& solver::display(std::ostream& out) const {
+        for (constraint* cp : m_constraints)
+            display(out, *cp) << "\n";
         return out;
     }
-    
+
     std::ostream& solver::display_justification(std::ostream& out, sat::ext_justification_idx idx) const  {
-        return out;
+        return display(out << "xor ", constraint::from_index(idx));
     }
-    
+
     std::ostream& solver::display_constraint(std::ostream& out, sat::ext_constraint_idx idx) const {
-        return out;
+        return display(out, constraint::from_index(idx));
     }
-    
-}
 
+}
@@ -8,29 +8,81 @@ Module Name:
 Abstract:
 
     XOR solver.
-    Interface outline.
+    Native parity constraints with watched-variable propagation.
 
 --*/
 
 #pragma once
 
+#include "util/small_object_allocator.h"
 #include "sat/smt/euf_solver.h"
 
 namespace xr {
     class solver : public euf::th_solver {
+
+        /**
+           A constraint asserts that the xor of its literals is true.
+           The literals at positions 0 and 1 are watched; both phases of
+           their variables are registered in the watch lists, since any
+           assignment to a watched variable may complete the parity.
+           An n-ary xor therefore costs two watch entries instead of the
+           2^(n-1) clauses of a CNF encoding.
+           The variables of a constraint are pairwise distinct.
+        */
+        class constraint {
+            unsigned     m_size;
+            sat::literal m_lits[0];
+        public:
+            static size_t get_obj_size(unsigned num_lits) { return sat::constraint_base::obj_size(sizeof(constraint) + num_lits * sizeof(sat::literal)); }
+            constraint(sat::literal_vector const& lits):
+                m_size(lits.size()) {
+                unsigned i = 0;
+                for (sat::literal l : lits)
+                    m_lits[i++] = l;
+            }
+            unsigned size() const { return m_size; }
+            sat::literal operator[](unsigned i) const { return m_lits[i]; }
+            sat::literal const* begin() const { return m_lits; }
+            sat::literal const* end() const { return m_lits + m_size; }
+            void swap(unsigned i, unsigned j) { std::swap(m_lits[i], m_lits[j]); }
+            size_t cindex() const { return sat::constraint_base::mem2base(this); }
+            static constraint& from_index(size_t idx) { return *reinterpret_cast<constraint*>(sat::constraint_base::idx2mem(idx)); }
+        };
+
+        small_object_allocator m_allocator;
+        ptr_vector<constraint> m_constraints;
+        unsigned               m_num_watched = 0; // prefix of m_constraints whose watches are installed
+        bool_vector            m_shared;          // variables occurring in some constraint
+
+        void watch(constraint& c, unsigned pos);
+        void init_watch(constraint& c);
+        void assign(constraint& c, sat::literal lit);
+        std::ostream& display(std::ostream& out, constraint const& c) const;
+
     public:
         solver(euf::solver& ctx);
-        
+        ~solver() override;
+
         th_solver* clone(euf::solver& ctx) override;
 
         sat::literal internalize(expr* e, bool sign, bool root)  override { UNREACHABLE(); return sat::null_literal; }
 
         void internalize(expr* e) override { UNREACHABLE(); }
 
+        /**
+           \brief Add the constraint xor(lits) = true. The variables of
+           lits must be pairwise distinct. Watches are installed when the
+           search is initialized.
+        */
+        void add_xor(sat::literal_vector const& lits);
 
         void asserted(sat::literal l) override;
         bool unit_propagate() override;
+        bool propagated(sat::literal l, sat::ext_constraint_idx idx) override;
         void get_antecedents(sat::literal l, sat::ext_justification_idx idx, sat::literal_vector & r, bool probing) override;
+        bool is_external(sat::bool_var v) override;
+        void init_use_list(sat::ext_use_list& ul) override;
+        void init_search() override;
 
         void pre_simplify() override;
         void simplify() override;
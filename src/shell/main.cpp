@@ -49,6 +49,7 @@ typedef enum { IN_UNSPECIFIED, IN_SMTLIB_2, IN_DATALOG, IN_DIMACS, IN_WCNF, IN_O
 static char const * g_input_file          = nullptr;
 static char const * g_drat_input_file     = nullptr;
 static bool         g_standard_input      = false;
+static bool         g_serve_queries       = false;
 static input_kind   g_input_kind          = IN_UNSPECIFIED;
 bool                g_display_statistics  = false;
 bool                g_display_model       = false;
@@ -86,6 +87,7 @@ void display_usage() {
     std::cout << "  -lp         use parser for a modest subset of CPLEX LP input format.\n";
     std::cout << "  -log        use parser for Z3 log input format.\n";
     std::cout << "  -in         read formula from standard input.\n";
+    std::cout << "  -serve      preload the input file once and serve query files named on standard input, one per line, forking a copy-on-write worker process per query (SMT 2 input only, POSIX only).\n";
     std::cout << "  -model      display model for satisfiable SMT.\n";
     std::cout << "\nMiscellaneous:\n";
     std::cout << "  -h, -?      prints this message.\n";
@@ -190,6 +192,9 @@ static void parse_cmd_line_args(std::string& input_file, int argc, char ** argv)
             else if (strcmp(opt_name, "dl") == 0) {
                 g_input_kind = IN_DATALOG;
             }
+            else if (strcmp(opt_name, "serve") == 0) {
+                g_serve_queries = true;
+            }
             else if (strcmp(opt_name, "in") == 0) {
                 g_standard_input = true;
             }
@@ -386,7 +391,7 @@ int STD_CALL main(int argc, char ** argv) {
         switch (g_input_kind) {
         case IN_SMTLIB_2:
             memory::exit_when_out_of_memory(true, "(error \"out of memory\")");
-            return_value = read_smtlib2_commands(g_input_file);
+            return_value = g_serve_queries ? serve_smtlib2_queries(g_input_file) : read_smtlib2_commands(g_input_file);
             break;
         case IN_DIMACS:
             return_value = read_dimacs(g_input_file);
@@ -32,6 +32,11 @@ Revision History:
 #include "cmd_context/extra_cmds/subpaving_cmds.h"
 #include "smt/smt2_extra_cmds.h"
 #include "smt/smt_solver.h"
+#ifndef _WINDOWS
+#include<unistd.h>
+#include<sys/types.h>
+#include<sys/wait.h>
+#endif
 
 static mutex *display_stats_mux = new mutex;
 
@@ -191,3 +196,80 @@ unsigned read_smtlib2_commands(char const * file_name) {
     return result ? 0 : 1;
 }
 
+/**
+   Load base_file once and then serve queries read from standard input,
+   one file name per line. Each query runs in a forked child process: the
+   preloaded context is shared with the parent through the kernel's
+   copy-on-write pages, so per-query startup cost is a fork instead of
+   re-parsing the base.
+*/
+unsigned serve_smtlib2_queries(char const * base_file) {
+#ifdef _WINDOWS
+    std::cerr << "(error \"serving queries relies on fork and is only supported on POSIX platforms\")" << std::endl;
+    return 1;
+#else
+    g_start_time = clock();
+    register_on_timeout_proc(on_timeout);
+    signal(SIGINT, on_ctrl_c);
+    cmd_context ctx;
+
+    ctx.set_solver_factory(mk_smt_strategic_solver_factory());
+    install_dl_cmds(ctx);
+    install_dbg_cmds(ctx);
+    install_polynomial_cmds(ctx);
+    install_subpaving_cmds(ctx);
+    install_opt_cmds(ctx);
+    install_smt2_extra_cmds(ctx);
+    install_proof_cmds(ctx);
+
+    g_cmd_context = &ctx;
+    signal(SIGINT, on_ctrl_c);
+
+    if (base_file) {
+        std::ifstream in(base_file);
+        if (in.bad() || in.fail()) {
+            std::cerr << "(error \"failed to open file '" << base_file << "'\")" << std::endl;
+            exit(ERR_OPEN_FILE);
+        }
+        if (!parse_smt2_commands(ctx, in)) {
+            g_cmd_context = nullptr;
+            return 1;
+        }
+    }
+
+    unsigned result = 0;
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        if (line.empty())
+            continue;
+        std::cout.flush();
+        std::cerr.flush();
+        pid_t pid = fork();
+        if (pid == -1) {
+            std::cerr << "(error \"failed to fork worker process\")" << std::endl;
+            result = 1;
+            break;
+        }
+        if (pid == 0) {
+            std::ifstream in(line);
+            if (in.bad() || in.fail()) {
+                std::cerr << "(error \"failed to open file '" << line << "'\")" << std::endl;
+                std::cerr.flush();
+                _Exit(ERR_OPEN_FILE);
+            }
+            bool ok = parse_smt2_commands(ctx, in);
+            display_statistics();
+            display_model();
+            std::cout.flush();
+            std::cerr.flush();
+            _Exit(ok ? 0 : 1);
+        }
+        int status = 0;
+        if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            result = 1;
+    }
+    g_cmd_context = nullptr;
+    return result;
+#endif
+}
+
@@ -21,6 +21,7 @@ Revision History:
 #include "util/pool.h"
 #include "util/trail.h"
 #include "util/stopwatch.h"
+#include "util/self_profiler.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include "ast/ast_smt2_pp.h"
@@ -2007,14 +2008,20 @@ namespace {
         }
 
         bool execute(code_tree * t) {
+            scoped_profile_tag _prof(self_profiler::SUB_EMATCH);
             TRACE("trigger_bug", tout << "execute for code tree:\n"; t->display(tout););
             init(t);
+            // Poll resource limits once per batch of candidates: on large
+            // candidate lists the per-candidate poll is measurable next to
+            // the shallow-failing matches that dominate these lists.
+            unsigned count = 0;
+#define CHECK_LIMITS ((count++ & 0xF) == 0 && m_context.resource_limits_exceeded())
 #define CLEANUP  for (enode* app : t->get_candidates()) if (app->is_marked()) app->unset_mark();
             if (t->filter_candidates()) {
                 for (enode* app : t->get_candidates()) {
                     TRACE("trigger_bug", tout << "candidate\n" << mk_ismt2_pp(app->get_expr(), m) << "\n";);
                     if (!app->is_marked() && app->is_cgr()) {
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app)) {
+                        if (CHECK_LIMITS || !execute_core(t, app)) {
                             CLEANUP;
                             return false;
                         }
@@ -2022,7 +2029,7 @@ namespace {
                     }
                 }
                 CLEANUP;
-                
+
             }
             else {
                 for (enode* app : t->get_candidates()) {
@@ -2030,11 +2037,12 @@ namespace {
                     if (app->is_cgr()) {
                         TRACE("trigger_bug", tout << "is_cgr\n";);
                         // scoped_suspend_rlimit susp(m.limit(), false);
-                        if (m_context.resource_limits_exceeded() || !execute_core(t, app))
+                        if (CHECK_LIMITS || !execute_core(t, app))
                             return false;
                     }
                 }
             }
+#undef CHECK_LIMITS
             return true;
         }
 
@@ -2902,6 +2910,14 @@ namespace {
            - mp: is used a pattern for qa.
 
            - first_idx: index to be used as head of the multi-pattern mp
+
+           The per-label code trees are the compiled-pattern cache: a second
+           pattern with the same head label extends the existing tree and
+           shares its instruction prefix. The trees cannot be persisted
+           across backtracking points or solver instances, because the
+           instruction sequences live in the trail region, are spliced via
+           trail-managed next-pointers, and embed enode pointers that are
+           only meaningful in the current context.
         */
         void add_pattern(quantifier * qa, app * mp, unsigned first_idx) {
             (void)m;
@@ -27,6 +27,7 @@ void preprocessor_params::updt_local_params(params_ref const & _p) {
     m_pull_nested_quantifiers = p.pull_nested_quantifiers();
     m_refine_inj_axiom        = p.refine_inj_axioms();
     m_propagate_values        = p.propagate_values();
+    m_coi_ordering            = p.coi_ordering();
     m_elim_unconstrained      = p.elim_unconstrained();
     m_solve_eqs               = p.solve_eqs();
     m_ng_lift_ite             = static_cast<lift_ite_kind>(p.q_lift_ite());
@@ -50,6 +51,7 @@ void preprocessor_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_eliminate_term_ite);
     DISPLAY_PARAM(m_macro_finder);
     DISPLAY_PARAM(m_propagate_values);
+    DISPLAY_PARAM(m_coi_ordering);
     DISPLAY_PARAM(m_solve_eqs);
     DISPLAY_PARAM(m_elim_unconstrained);
     DISPLAY_PARAM(m_refine_inj_axiom);
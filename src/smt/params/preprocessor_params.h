@@ -36,6 +36,7 @@ struct preprocessor_params : public pattern_inference_params,
     bool            m_eliminate_term_ite = false;
     bool            m_macro_finder = false;
     bool            m_propagate_values = true;
+    bool            m_coi_ordering = false;
     bool            m_elim_unconstrained = true;
     bool            m_solve_eqs = true;
     bool            m_refine_inj_axiom = true;
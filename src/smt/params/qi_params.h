@@ -51,6 +51,7 @@ struct qi_params {
     bool               m_mbqi_trace = false;
     unsigned           m_mbqi_force_template = 10;
     const char *       m_mbqi_id = nullptr;
+    bool               m_mbqi_model_diff = true;
 
     qi_params(params_ref const & p = params_ref()):
         /*
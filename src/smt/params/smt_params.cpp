@@ -26,6 +26,7 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_auto_config = p.auto_config() && gparams::get_value("auto_config") == "true"; // auto-config is not scoped by smt in gparams.
     m_random_seed = p.random_seed();
     m_relevancy_lvl = p.relevancy();
+    m_relevancy_lazy = p.relevancy_lazy();
     m_ematching   = p.ematching();
     m_induction   = p.induction();
     m_clause_proof = p.clause_proof();
@@ -48,6 +49,8 @@ void smt_params::updt_local_params(params_ref const & _p) {
     m_threads       = p.threads();
     m_threads_max_conflicts  = p.threads_max_conflicts();
     m_threads_cube_frequency = p.threads_cube_frequency();
+    m_threads_affinity = p.threads_affinity();
+    m_threads_deterministic = p.threads_deterministic();
     m_core_validate = p.core_validate();
     m_logic = _p.get_sym("logic", m_logic);
     m_string_solver = p.string_solver();
@@ -106,6 +109,7 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_binary_clause_opt);
     DISPLAY_PARAM(m_relevancy_lvl);
     DISPLAY_PARAM(m_relevancy_lemma);
+    DISPLAY_PARAM(m_relevancy_lazy);
     DISPLAY_PARAM(m_random_seed);
     DISPLAY_PARAM(m_random_var_freq);
     DISPLAY_PARAM(m_inv_decay);
@@ -120,6 +124,8 @@ void smt_params::display(std::ostream & out) const {
     DISPLAY_PARAM(m_threads);
     DISPLAY_PARAM(m_threads_max_conflicts);
     DISPLAY_PARAM(m_threads_cube_frequency);
+    DISPLAY_PARAM(m_threads_affinity);
+    DISPLAY_PARAM(m_threads_deterministic);
     DISPLAY_PARAM(m_simplify_clauses);
     DISPLAY_PARAM(m_tick);
     DISPLAY_PARAM(m_display_features);
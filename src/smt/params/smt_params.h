@@ -91,6 +91,7 @@ struct smt_params : public preprocessor_params,
     bool             m_binary_clause_opt = true;
     unsigned         m_relevancy_lvl = 2;
     bool             m_relevancy_lemma = false;
+    bool             m_relevancy_lazy = false;
     unsigned         m_random_seed = 0;
     double           m_random_var_freq = 0.01;
     double           m_inv_decay = 1.052;
@@ -106,6 +107,8 @@ struct smt_params : public preprocessor_params,
     unsigned         m_threads = 1;
     unsigned         m_threads_max_conflicts = UINT_MAX;
     unsigned         m_threads_cube_frequency = 2;
+    bool             m_threads_affinity = false;
+    bool             m_threads_deterministic = false;
     bool             m_simplify_clauses = true;
     unsigned         m_tick = 1000;
     bool             m_display_features = false;
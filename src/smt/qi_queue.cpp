@@ -256,10 +256,6 @@ namespace smt {
 #endif
    
         TRACE("qi_queue", tout << "simplified instance:\n" << s_instance << "\n";);
-        stat->inc_num_instances();
-        if (stat->get_num_instances() % m_params.m_qi_profile_freq == 0) {
-            m_qm.display_stats(verbose_stream(), q);
-        }
         expr_ref lemma(m);
         if (m.is_or(s_instance)) {
             ptr_vector<expr> args;
@@ -276,7 +272,25 @@ namespace smt {
         else {
             lemma = m.mk_or(m.mk_not(q), s_instance);
         }
+        if (m_asserted_instances.contains(lemma)) {
+            // a different binding collapsed to the same lemma after simplification;
+            // it is already asserted on this branch.
+            TRACE("qi_queue", tout << "duplicate instance:\n" << mk_pp(lemma, m) << "\n";);
+            STRACE("instance", tout << "Instance already asserted (duplicate)\n";);
+            m_stats.m_num_duplicate_instances++;
+            if (m.has_trace_stream()) {
+                display_instance_profile(f, q, num_bindings, bindings, 0, generation);
+                m.trace_stream() << "[end-of-instance]\n";
+            }
+            return;
+        }
+        stat->inc_num_instances();
+        if (stat->get_num_instances() % m_params.m_qi_profile_freq == 0) {
+            m_qm.display_stats(verbose_stream(), q);
+        }
         m_instances.push_back(lemma);
+        m_asserted_instances.insert(lemma);
+        m_asserted_instance_trail.push_back(lemma);
         proof_ref pr1(m);
         unsigned proof_id = 0;
         if (m.proofs_enabled()) {
@@ -361,9 +375,10 @@ namespace smt {
         m_scopes.push_back(scope());
         SASSERT(m_context.inconsistent() || m_new_entries.empty());
         scope & s = m_scopes.back();
-        s.m_delayed_entries_lim    = m_delayed_entries.size();
-        s.m_instances_lim          = m_instances.size();
-        s.m_instantiated_trail_lim = m_instantiated_trail.size();
+        s.m_delayed_entries_lim      = m_delayed_entries.size();
+        s.m_instances_lim            = m_instances.size();
+        s.m_asserted_instances_lim   = m_asserted_instance_trail.size();
+        s.m_instantiated_trail_lim   = m_instantiated_trail.size();
     }
 
     void qi_queue::pop_scope(unsigned num_scopes) {
@@ -375,6 +390,10 @@ namespace smt {
             m_delayed_entries[m_instantiated_trail[i]].m_instantiated = false;
         m_instantiated_trail.shrink(old_sz);
         m_delayed_entries.shrink(s.m_delayed_entries_lim);
+        // unmark asserted instances before m_instances releases the references
+        for (unsigned i = s.m_asserted_instances_lim; i < m_asserted_instance_trail.size(); i++)
+            m_asserted_instances.remove(m_asserted_instance_trail[i]);
+        m_asserted_instance_trail.shrink(s.m_asserted_instances_lim);
         m_instances.shrink(s.m_instances_lim);
         m_new_entries.reset();
         m_scopes.shrink(new_lvl);
@@ -384,6 +403,8 @@ namespace smt {
     void qi_queue::reset() {
         m_new_entries.reset();
         m_delayed_entries.reset();
+        m_asserted_instances.reset();
+        m_asserted_instance_trail.reset();
         m_instances.reset();
         m_scopes.reset();
     }
@@ -499,6 +520,7 @@ namespace smt {
     void qi_queue::collect_statistics(::statistics & st) const {
         st.update("quant instantiations", m_stats.m_num_instances);
         st.update("lazy quant instantiations", m_stats.m_num_lazy_instances);
+        st.update("duplicate quant instantiations", m_stats.m_num_duplicate_instances);
         st.update("missed quant instantiations", m_delayed_entries.size());
         float min, max;
         get_min_max_costs(min, max);
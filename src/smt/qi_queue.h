@@ -33,7 +33,7 @@ namespace smt {
     class context;
 
     struct qi_queue_stats {
-        unsigned m_num_instances, m_num_lazy_instances;
+        unsigned m_num_instances, m_num_lazy_instances, m_num_duplicate_instances;
         void reset() { memset(this, 0, sizeof(qi_queue_stats)); }
         qi_queue_stats() { reset(); }
     };
@@ -62,10 +62,15 @@ namespace smt {
         svector<entry>                m_new_entries;
         svector<entry>                m_delayed_entries;
         expr_ref_vector               m_instances;
+        // lemmas asserted on the current branch; different bindings may
+        // collapse to the same lemma after simplification.
+        obj_hashtable<expr>           m_asserted_instances;
+        ptr_vector<expr>              m_asserted_instance_trail;
         unsigned_vector               m_instantiated_trail;
         struct scope {
             unsigned   m_delayed_entries_lim;
             unsigned   m_instances_lim;
+            unsigned   m_asserted_instances_lim;
             unsigned   m_instantiated_trail_lim;
         };
         svector<scope>                m_scopes;
@@ -518,16 +518,31 @@ bool theory_seq::branch_ternary_variable() {
 }
 
 
+// the memo is keyed by the equation sides directly; probing allocates no terms.
+void theory_seq::mk_align_key(expr_ref_vector const& ls, expr_ref_vector const& rs) {
+    m_align_key.reset();
+    for (expr* e : ls)
+        m_align_key.push_back(e);
+    m_align_key.push_back(nullptr);
+    for (expr* e : rs)
+        m_align_key.push_back(e);
+}
+
+void theory_seq::save_align_result(align_cache& table, bool result) {
+    for (expr* e : m_align_key)
+        if (e)
+            m_overlap_trail.push_back(e);
+    table.insert(m_align_key, result);
+}
+
 // exists x, y, rs' != empty s.t.  (ls = x ++ rs ++ y) || (ls = rs' ++ y && rs = x ++ rs')
 bool theory_seq::can_align_from_lhs(expr_ref_vector const& ls, expr_ref_vector const& rs) {
     SASSERT(!ls.empty() && !rs.empty());
-    expr_ref l = mk_concat(ls);
-    expr_ref r = mk_concat(rs);
-    expr_ref pair(m.mk_eq(l,r), m);
+    mk_align_key(ls, rs);
     bool result;
-    if (!m_overlap_lhs.find(pair, result)) {
+    if (!m_overlap_lhs.find(m_align_key, result)) {
         result = m_eq.can_align_from_lhs_aux(ls, rs);
-        m_overlap_lhs.insert(pair, result);
+        save_align_result(m_overlap_lhs, result);
     }
     return result;
 }
@@ -535,13 +550,11 @@ bool theory_seq::can_align_from_lhs(expr_ref_vector const& ls, expr_ref_vector c
 // exists x, y, rs' != empty s.t.  (ls = x ++ rs ++ y) || (ls = x ++ rs' && rs = rs' ++ y)
 bool theory_seq::can_align_from_rhs(expr_ref_vector const& ls, expr_ref_vector const& rs) {
     SASSERT(!ls.empty() && !rs.empty());
-    expr_ref l = mk_concat(ls);
-    expr_ref r = mk_concat(rs);
-    expr_ref pair(m.mk_eq(l, r), m);
+    mk_align_key(ls, rs);
     bool result;
-    if (!m_overlap_rhs.find(pair, result)) {
+    if (!m_overlap_rhs.find(m_align_key, result)) {
         result = m_eq.can_align_from_rhs_aux(ls, rs);
-        m_overlap_rhs.insert(pair, result);
+        save_align_result(m_overlap_rhs, result);
     }
     return result;
 }
@@ -30,7 +30,8 @@ namespace smt {
         ctx(th.get_context()),
         m(th.get_manager()),
         m_state_to_expr(m),
-        m_state_graph(state_graph::state_pp(this, pp_state)) { }
+        m_state_graph(state_graph::state_pp(this, pp_state)),
+        m_deriv_trail(m) { }
 
     seq_util& seq_regex::u() { return th.m_util; }
     class seq_util::rex& seq_regex::re() { return th.m_util.re; }
@@ -437,9 +438,18 @@ namespace smt {
 
         // Uses canonical variable (:var 0) for the derivative element
         // Substitute (:var 0) with the actual element
+        expr* cached = nullptr;
+        if (m_deriv_memo.find(ele, r, cached)) {
+            STRACE("seq_regex", tout << "derivative result (memo): " << mk_pp(cached, m) << std::endl;);
+            return expr_ref(cached, m);
+        }
         expr_ref der = seq_rw().mk_derivative(r);
         var_subst subst(m);
         der = subst(der, ele);
+        m_deriv_trail.push_back(ele);
+        m_deriv_trail.push_back(r);
+        m_deriv_trail.push_back(der);
+        m_deriv_memo.insert(ele, r, der);
 
         STRACE("seq_regex", tout << "derivative result: " << mk_pp(der, m) << std::endl;);
         STRACE("seq_regex_brief", tout << "d(" << state_str(r) << ")="
@@ -17,6 +17,7 @@ Author:
 #pragma once
 
 #include "util/scoped_vector.h"
+#include "util/obj_pair_hashtable.h"
 #include "util/state_graph.h"
 #include "ast/seq_decl_plugin.h"
 #include "ast/rewriter/seq_rewriter.h"
@@ -117,6 +118,12 @@ namespace smt {
         /* map from uninterpreted regex constants to assigned regex expressions by EQ */
         // expr_map                       m_const_to_expr;
         unsigned                       m_max_state_graph_size { 10000 };
+        /*
+            memo of instantiated derivatives, keyed by (element, regex);
+            survives backtracking and check-sat calls
+        */
+        obj_pair_map<expr, expr, expr*> m_deriv_memo;
+        expr_ref_vector                m_deriv_trail;
         // Convert between expressions and states (IDs)
         unsigned get_state_id(expr* e);
         expr* get_expr_from_id(unsigned id);
@@ -32,19 +32,19 @@ namespace {
     typedef map<bool_var, double, int_hash, default_eq<bool_var> > theory_var_priority_map;
 
     struct bool_var_act_lt {
-        svector<double> const & m_activity;
-        bool_var_act_lt(svector<double> const & a):m_activity(a) {}
+        context const & m_context;
+        bool_var_act_lt(context const & c):m_context(c) {}
         bool operator()(bool_var v1, bool_var v2) const {
-            return m_activity[v1] > m_activity[v2];
+            return m_context.get_activity(v1) > m_context.get_activity(v2);
         }
     };
 
     typedef heap<bool_var_act_lt> bool_var_act_queue;
 
     struct theory_aware_act_lt {
-        svector<double> const & m_activity;
+        context const & m_context;
         theory_var_priority_map const & m_theory_var_priority;
-        theory_aware_act_lt(svector<double> const & act, theory_var_priority_map const & a):m_activity(act),m_theory_var_priority(a) {}
+        theory_aware_act_lt(context const & c, theory_var_priority_map const & a):m_context(c),m_theory_var_priority(a) {}
         bool operator()(bool_var v1, bool_var v2) const {
             double p_v1, p_v2;
             if (!m_theory_var_priority.find(v1, p_v1)) {
@@ -54,8 +54,8 @@ namespace {
                 p_v2 = 0.0;
             }
             // add clause activity
-            p_v1 += m_activity[v1];
-            p_v2 += m_activity[v2];
+            p_v1 += m_context.get_activity(v1);
+            p_v2 += m_context.get_activity(v2);
             return p_v1 > p_v2;
         }
     };
@@ -74,7 +74,7 @@ namespace {
         act_case_split_queue(context & ctx, smt_params & p):
             m_context(ctx),
             m_params(p),
-            m_queue(1024, bool_var_act_lt(ctx.get_activity_vector())) {
+            m_queue(1024, bool_var_act_lt(ctx)) {
         }
             
         void activity_increased_eh(bool_var v) override {
@@ -161,7 +161,7 @@ namespace {
     public:
         dact_case_split_queue(context & ctx, smt_params & p):
             act_case_split_queue(ctx, p),
-            m_delayed_queue(1024, bool_var_act_lt(ctx.get_activity_vector())) {
+            m_delayed_queue(1024, bool_var_act_lt(ctx)) {
         }
 
         void activity_increased_eh(bool_var v) override {
@@ -521,7 +521,7 @@ namespace {
             m_params(p),
             m_head(0),
             m_bs_num_bool_vars(UINT_MAX),
-            m_delayed_queue(1024, bool_var_act_lt(ctx.get_activity_vector())) {
+            m_delayed_queue(1024, bool_var_act_lt(ctx)) {
         }
 
         void activity_increased_eh(bool_var v) override {}
@@ -1141,7 +1141,7 @@ namespace {
             m_context(ctx),
             m_params(p),
             m_theory_var_priority(),
-            m_queue(1024, theory_aware_act_lt(ctx.get_activity_vector(), m_theory_var_priority)) {
+            m_queue(1024, theory_aware_act_lt(ctx, m_theory_var_priority)) {
         }
 
         void activity_increased_eh(bool_var v) override {
@@ -23,7 +23,7 @@ Revision History:
 namespace smt {
 
     // one table per func_decl implementation
-    unsigned cg_table::cg_hash::operator()(enode * n) const {
+    unsigned cg_table::cg_hash::hash(enode * n) {
         SASSERT(n->get_decl()->is_flat_associative() || n->get_num_args() >= 3);
         unsigned a, b, c;
         a = b = 0x9e3779b9;
@@ -64,7 +64,8 @@ namespace smt {
     }
 
     cg_table::cg_table(ast_manager & m):
-        m_manager(m) {
+        m_manager(m),
+        m_use_cached_hash(false) {
     }
 
     cg_table::~cg_table() {
@@ -76,28 +77,28 @@ namespace smt {
         SASSERT(d->get_arity() >= 1);
         switch (d->get_arity()) {
         case 1:
-            r = TAG(void*, alloc(unary_table), UNARY);
+            r = TAG(void*, alloc(unary_table, cg_unary_hash(m_use_cached_hash)), UNARY);
             SASSERT(GET_TAG(r) == UNARY);
             return r;
         case 2:
             if (d->is_flat_associative()) {
                 // applications of declarations that are flat-assoc (e.g., +) may have many arguments.
-                r = TAG(void*, alloc(table), NARY);
+                r = TAG(void*, alloc(table, cg_hash(m_use_cached_hash)), NARY);
                 SASSERT(GET_TAG(r) == NARY);
                 return r;
             }
             else if (d->is_commutative()) {
-                r = TAG(void*, alloc(comm_table, cg_comm_hash(), cg_comm_eq(m_commutativity)), BINARY_COMM);
+                r = TAG(void*, alloc(comm_table, cg_comm_hash(m_use_cached_hash), cg_comm_eq(m_commutativity)), BINARY_COMM);
                 SASSERT(GET_TAG(r) == BINARY_COMM);
                 return r;
             }
             else {
-                r = TAG(void*, alloc(binary_table), BINARY);
+                r = TAG(void*, alloc(binary_table, cg_binary_hash(m_use_cached_hash)), BINARY);
                 SASSERT(GET_TAG(r) == BINARY);
                 return r;
             }
-        default: 
-            r = TAG(void*, alloc(table), NARY);
+        default:
+            r = TAG(void*, alloc(table, cg_hash(m_use_cached_hash)), NARY);
             SASSERT(GET_TAG(r) == NARY);
             return r;
         }
@@ -171,7 +172,7 @@ namespace smt {
         binary_table* tb = UNTAG(binary_table*, t);
         out << "b ";
         for (enode* n : *tb) {
-            out << n->get_owner_id() << " " << cg_binary_hash()(n) << " ";
+            out << n->get_owner_id() << " " << cg_binary_hash::hash(n) << " ";
         }
         out << "\n";
     }
@@ -217,7 +218,7 @@ namespace smt {
             return enode_bool_pair(n_prime, false);
         case BINARY:
             n_prime = UNTAG(binary_table*, t)->insert_if_not_there(n);
-            TRACE("cg_table", tout << "insert: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
+            TRACE("cg_table", tout << "insert: " << n->get_owner_id() << " " << cg_binary_hash::hash(n) << " inserted: " << (n == n_prime) << " " << n_prime->get_owner_id() << "\n";
                   display_binary(tout, t); tout << "contains_ptr: " << contains_ptr(n) << "\n";); 
             return enode_bool_pair(n_prime, false);
         case BINARY_COMM:
@@ -232,13 +233,17 @@ namespace smt {
 
     void cg_table::erase(enode * n) {
         SASSERT(n->get_num_args() > 0);
-        void * t = get_table(n); 
+        void * t = get_table(n);
+        // n is in the table, so the hash cached at its last insertion is
+        // still valid and the argument walk can be skipped.
+        flet<bool> _use_cached(m_use_cached_hash, true);
+        SASSERT(cg_hash_of(n) == n->get_cg_hash());
         switch (static_cast<table_kind>(GET_TAG(t))) {
         case UNARY:
             UNTAG(unary_table*, t)->erase(n);
             break;
         case BINARY:
-            TRACE("cg_table", tout << "erase: " << n->get_owner_id() << " " << cg_binary_hash()(n) << " contains: " << contains_ptr(n) << "\n";);
+            TRACE("cg_table", tout << "erase: " << n->get_owner_id() << " " << cg_binary_hash::hash(n) << " contains: " << contains_ptr(n) << "\n";);
             UNTAG(binary_table*, t)->erase(n);
             break;
         case BINARY_COMM:
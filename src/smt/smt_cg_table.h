@@ -32,11 +32,31 @@ namespace smt {
        \brief Congruence table.
     */
     class cg_table {
+        /*
+          The hash functors cache the congruence hash in the enode. The cached
+          value stays valid while a node is in the table: the context removes a
+          parent from the table before changing the root of any of its
+          arguments and reinserts it afterwards, so every hash computed for a
+          node that is in the table coincides with the hash stored at its last
+          insertion. The m_use_cached flag refers to cg_table::m_use_cached_hash
+          (same pattern as cg_comm_eq::m_commutativity); it is set around erase
+          calls, where the argument is known to be in the table, to skip the
+          argument walk and root dereferences.
+        */
         struct cg_unary_hash {
-            unsigned operator()(enode * n) const {
+            bool & m_use_cached;
+            cg_unary_hash(bool & c):m_use_cached(c) {}
+            static unsigned hash(enode * n) {
                 SASSERT(n->get_num_args() == 1);
                 return n->get_arg(0)->get_root()->hash();
             }
+            unsigned operator()(enode * n) const {
+                if (m_use_cached)
+                    return n->get_cg_hash();
+                unsigned h = hash(n);
+                n->set_cg_hash(h);
+                return h;
+            }
         };
 
         struct cg_unary_eq {
@@ -51,10 +71,19 @@ namespace smt {
         typedef chashtable<enode *, cg_unary_hash, cg_unary_eq> unary_table;
         
         struct cg_binary_hash {
-            unsigned operator()(enode * n) const {
+            bool & m_use_cached;
+            cg_binary_hash(bool & c):m_use_cached(c) {}
+            static unsigned hash(enode * n) {
                 SASSERT(n->get_num_args() == 2);
                 return combine_hash(n->get_arg(0)->get_root()->hash(), n->get_arg(1)->get_root()->hash());
             }
+            unsigned operator()(enode * n) const {
+                if (m_use_cached)
+                    return n->get_cg_hash();
+                unsigned h = hash(n);
+                n->set_cg_hash(h);
+                return h;
+            }
         };
 
         struct cg_binary_eq {
@@ -71,7 +100,9 @@ namespace smt {
         typedef chashtable<enode*, cg_binary_hash, cg_binary_eq> binary_table;
         
         struct cg_comm_hash {
-            unsigned operator()(enode * n) const {
+            bool & m_use_cached;
+            cg_comm_hash(bool & c):m_use_cached(c) {}
+            static unsigned hash(enode * n) {
                 SASSERT(n->get_num_args() == 2);
                 unsigned h1 = n->get_arg(0)->get_root()->hash();
                 unsigned h2 = n->get_arg(1)->get_root()->hash();
@@ -79,6 +110,13 @@ namespace smt {
                     std::swap(h1, h2);
                 return hash_u((h1 << 16) | (h2 & 0xFFFF));
             }
+            unsigned operator()(enode * n) const {
+                if (m_use_cached)
+                    return n->get_cg_hash();
+                unsigned h = hash(n);
+                n->set_cg_hash(h);
+                return h;
+            }
         };
         
         struct cg_comm_eq {
@@ -106,7 +144,16 @@ namespace smt {
         typedef chashtable<enode*, cg_comm_hash, cg_comm_eq> comm_table;
 
         struct cg_hash {
-            unsigned operator()(enode * n) const;
+            bool & m_use_cached;
+            cg_hash(bool & c):m_use_cached(c) {}
+            static unsigned hash(enode * n);
+            unsigned operator()(enode * n) const {
+                if (m_use_cached)
+                    return n->get_cg_hash();
+                unsigned h = hash(n);
+                n->set_cg_hash(h);
+                return h;
+            }
         };
 
         struct cg_eq {
@@ -117,6 +164,7 @@ namespace smt {
 
         ast_manager &                 m_manager;
         bool                          m_commutativity; //!< true if the last found congruence used commutativity
+        bool                          m_use_cached_hash; //!< true while the hash functors may read the hash cached in the enode
         ptr_vector<void>              m_tables;
         obj_map<func_decl, unsigned>  m_func_decl2id;
 
@@ -138,6 +186,21 @@ namespace smt {
             return m_tables[tid];
         }
 
+        //!< Recompute the congruence hash of n (debugging aid for the cached hash).
+        unsigned cg_hash_of(enode * n) {
+            void * t = get_table(n);
+            switch (static_cast<table_kind>(GET_TAG(t))) {
+            case UNARY:
+                return cg_unary_hash::hash(n);
+            case BINARY:
+                return cg_binary_hash::hash(n);
+            case BINARY_COMM:
+                return cg_comm_hash::hash(n);
+            default:
+                return cg_hash::hash(n);
+            }
+        }
+
     public:
         cg_table(ast_manager & m);
         ~cg_table();
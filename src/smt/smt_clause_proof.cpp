@@ -14,6 +14,7 @@ Revision History:
 --*/
 #include "smt/smt_clause_proof.h"
 #include "smt/smt_context.h"
+#include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
 #include <iostream>
@@ -21,7 +22,7 @@ Revision History:
 namespace smt {
     
     clause_proof::clause_proof(context& ctx):
-        ctx(ctx), m(ctx.get_manager()), m_lits(m), m_pp(m),
+        ctx(ctx), m(ctx.get_manager()), m_lits(m), m_lit_pool(m), m_pp(m),
         m_assumption(m), m_rup(m), m_del(m), m_smt(m) {
         
         auto proof_log = ctx.get_fparams().m_proof_log;
@@ -155,7 +156,7 @@ namespace smt {
         for (literal l : ante)
             m_lits.push_back(ctx.literal2expr(~l));
         m_lits.push_back(ctx.literal2expr(lit));
-        proof_ref pr(m.mk_app(symbol("smt"), 0, nullptr, m.mk_proof_sort()), m);
+        auto pr = justification2proof(status::th_lemma, nullptr);
         update(clause_proof::status::th_lemma, m_lits, pr);
     }
 
@@ -187,8 +188,10 @@ namespace smt {
 
     void clause_proof::update(status st, expr_ref_vector& v, proof* p) {
         TRACE("clause_proof", tout << m_trail.size() << " " << st << " " << v << "\n";);
-        if (ctx.get_fparams().m_clause_proof)
-            m_trail.push_back(info(st, v, p));
+        if (ctx.get_fparams().m_clause_proof) {
+            m_trail.push_back(info(st, m_lit_pool.size(), v.size(), p, m));
+            m_lit_pool.append(v);
+        }
         if (m_on_clause_eh) 
             m_on_clause_eh(m_on_clause_ctx, p, v.size(), v.data());        
         if (m_has_log) {
@@ -235,7 +238,7 @@ namespace smt {
             return proof_ref(m);
         proof_ref_vector ps(m);
         for (auto& info : m_trail) {
-            expr_ref fact = mk_or(info.m_clause);
+            expr_ref fact(mk_or(m, info.m_num_lits, m_lit_pool.data() + info.m_lit_offset), m);
             proof* pr = info.m_proof;
             expr* args[2] = { pr, fact };
             unsigned num_args = 2, offset = 0;
@@ -47,16 +47,23 @@ namespace smt {
         };
     private:
 
+        // Trail entries are fixed-size records; clause literals live in a shared
+        // pool referenced by offset/length. With millions of clause events the
+        // per-entry vector headers and allocations would otherwise dominate the
+        // trail footprint.
         struct info {
             status          m_status;
-            expr_ref_vector m_clause;     
+            unsigned        m_lit_offset;
+            unsigned        m_num_lits;
             proof_ref       m_proof;
-            info(status st, expr_ref_vector& v, proof* p): m_status(st), m_clause(v), m_proof(p, m_clause.m()) {}
+            info(status st, unsigned offset, unsigned num_lits, proof* p, ast_manager& m):
+                m_status(st), m_lit_offset(offset), m_num_lits(num_lits), m_proof(p, m) {}
         };
         context&        ctx;
         ast_manager&    m;
         expr_ref_vector m_lits;
         vector<info>    m_trail;
+        expr_ref_vector m_lit_pool; // shared literal storage for m_trail
         bool            m_enabled = false;
         bool            m_has_log = false;
         user_propagator::on_clause_eh_t m_on_clause_eh;
@@ -228,7 +228,13 @@ namespace smt {
         m_todo_js.shrink(old_js_qhead);
         m_todo_js_qhead = old_js_qhead;
         m_todo_eqs.reset();
-        m_already_processed_eqs.reset();
+        // invalidate the eq marks by bumping the epoch; the table is only
+        // rebuilt once it accumulates too many stale entries or the epoch wraps.
+        ++m_eq_mark_epoch;
+        if (m_eq_mark_epoch == 0 || m_already_processed_eqs.size() > (1u << 14)) {
+            m_already_processed_eqs.reset();
+            m_eq_mark_epoch = 1;
+        }
     }
 
     /**
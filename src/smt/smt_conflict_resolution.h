@@ -28,7 +28,6 @@ Revision History:
 #include "util/obj_pair_hashtable.h"
 #include "util/map.h"
 #include "smt/watch_list.h"
-#include "util/obj_pair_set.h"
 
 typedef approx_set_tpl<unsigned, u2u, unsigned> level_approx_set;
 
@@ -42,7 +41,7 @@ namespace smt {
     */
     class conflict_resolution {
     protected:
-        typedef obj_pair_set<enode, enode> enode_pair_set;
+        typedef obj_pair_map<enode, enode, unsigned> enode_pair_epoch_map;
 
         ast_manager &                  m;
         smt_params const &             m_params;
@@ -60,7 +59,11 @@ namespace smt {
         justification_vector           m_todo_js;
         unsigned                       m_todo_js_qhead;
         svector<enode_pair>            m_todo_eqs;
-        enode_pair_set                 m_already_processed_eqs;
+        // eqs marked during the current conflict carry the current epoch;
+        // entries of past conflicts become stale by bumping the epoch, so
+        // the table is not torn down after every conflict.
+        enode_pair_epoch_map           m_already_processed_eqs;
+        unsigned                       m_eq_mark_epoch = 1;
         
         literal_vector *               m_antecedents;
 
@@ -124,11 +127,12 @@ namespace smt {
                 if (n1->get_owner_id() > n2->get_owner_id())
                     std::swap(n1, n2);
                 enode_pair p(n1, n2);
-                if (m_already_processed_eqs.insert_if_not_there(p)) {
-                    TRACE("conflict_detail_verbose", tout << "marking eq #" << p.first->get_owner_id() << " = #" << 
+                unsigned & epoch = m_already_processed_eqs.insert_if_not_there(n1, n2, 0);
+                if (epoch != m_eq_mark_epoch) {
+                    epoch = m_eq_mark_epoch;
+                    TRACE("conflict_detail_verbose", tout << "marking eq #" << p.first->get_owner_id() << " = #" <<
                           p.second->get_owner_id() << "\n";);
                     m_todo_eqs.push_back(p);
-                    SASSERT(m_already_processed_eqs.contains(p));
                 }
             }
         }
@@ -46,8 +46,7 @@ namespace smt {
     // - e is an equality between a variable and value that is to be fixed.
     // - e is a data-type recognizer of a variable that is to be fixed.
     // 
-    void context::extract_fixed_consequences(literal lit, index_set const& assumptions, expr_ref_vector& conseq) {
-        datatype_util dt(m);
+    void context::extract_fixed_consequences(datatype_util& dt, literal lit, index_set const& assumptions, expr_ref_vector& conseq) {
         expr* e1, *e2, *arg;
         expr_ref fml(m);        
         if (lit == true_literal) return;
@@ -139,10 +138,11 @@ namespace smt {
     void context::extract_fixed_consequences(unsigned& start, index_set const& assumptions, expr_ref_vector& conseq) {
         pop_to_search_lvl();
         SASSERT(!inconsistent());
+        datatype_util dt(m);
         literal_vector const& lits = assigned_literals();
         unsigned sz = lits.size();
-        for (unsigned i = start; i < sz; ++i) {            
-            extract_fixed_consequences(lits[i], assumptions, conseq);
+        for (unsigned i = start; i < sz; ++i) {
+            extract_fixed_consequences(dt, lits[i], assumptions, conseq);
         }
         start = sz;
         SASSERT(!inconsistent());
@@ -431,6 +431,16 @@ namespace smt {
             }
             extract_fixed_consequences(num_units, _assumptions, conseq);
             num_fixed_eqs += extract_fixed_eqs(conseq);
+            //
+            // Grow the batches geometrically. A candidate that is really fixed costs a
+            // single conflict during batch assembly no matter how large the batch is,
+            // and one satisfying assignment prunes non-fixed candidates across the
+            // whole batch, so larger batches keep the number of bounded_search passes
+            // logarithmic in the number of candidates instead of linear.
+            //
+            if (num_vars == chunk_size && chunk_size < m_var2val.size()) {
+                chunk_size *= 2;
+            }
             IF_VERBOSE(1, display_consequence_progress(verbose_stream(), num_iterations, m_var2val.size(), conseq.size(),
                                                        unfixed.size(), num_fixed_eqs););
             TRACE("context", display_consequence_progress(tout, num_iterations, m_var2val.size(), conseq.size(),
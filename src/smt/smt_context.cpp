@@ -20,6 +20,8 @@ Revision History:
 #include "util/luby.h"
 #include "util/warning.h"
 #include "util/timeit.h"
+#include "util/phase_trace.h"
+#include "util/self_profiler.h"
 #include "util/union_find.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -78,6 +80,7 @@ namespace smt {
         m_dyn_ack_manager(*this, p),
         m_unknown("unknown"),
         m_unsat_core(m),
+        m_trail_stack(m_region),
         m_mk_bool_var_trail(*this),
         m_mk_enode_trail(*this),
         m_mk_lambda_trail(*this),
@@ -495,6 +498,14 @@ namespace smt {
             //
             // The second condition is used to enforce the invariant that if a class contain
             // an interpreted enode then the root is also interpreted.
+            //
+            // The first condition is size-based linking: the root update loop below
+            // walks the smaller class, so the total relabeling cost is O(n log n).
+            // Lazy union-find variants (path splitting/compression) do not pay off
+            // here: the congruence table hashes through m_root, theory propagation
+            // reads roots on hot paths, and backtracking must restore the exact
+            // previous roots, all of which require eagerly maintained root pointers
+            // in exchange for a constant-time get_root().
             if ((r1->get_class_size() > r2->get_class_size() && !r2->is_interpreted()) || r1->is_interpreted()) {
                 SASSERT(!r2->is_interpreted());
                 std::swap(n1, n2);
@@ -1631,6 +1642,11 @@ namespace smt {
 
     bool context::propagate_theories() {
         for (theory * t : m_theory_set) {
+            // only dispatch into theories with pending work. can_propagate()
+            // is an exact emptiness check on the theory's propagation queues,
+            // so idle theories pay a single predicate call per cycle.
+            if (!t->can_propagate())
+                continue;
             t->propagate();
             if (inconsistent())
                 return false;
@@ -1696,6 +1712,7 @@ namespace smt {
        congruences cannot be retracted to a consistent state.
      */
     bool context::propagate() {
+        scoped_profile_tag _prof(self_profiler::SUB_SMT_PROPAGATE);
         TRACE("propagate", tout << "propagating... " << m_qhead << ":" << m_assigned_literals.size() << "\n";);
         while (true) {
             if (inconsistent())
@@ -1763,11 +1780,10 @@ namespace smt {
     }
 
     void context::rescale_bool_var_activity() {
-        TRACE("case_split", tout << "rescale\n";);        
-        svector<double>::iterator it  = m_activity.begin();
-        svector<double>::iterator end = m_activity.end();
-        for (; it != end; ++it)
-            *it *= INV_ACTIVITY_LIMIT;
+        TRACE("case_split", tout << "rescale\n";);
+        // constant time: bump the scale generation instead of multiplying
+        // every entry; entries are normalized by get_activity() on access.
+        ++m_num_rescales;
         m_bvar_inc *= INV_ACTIVITY_LIMIT;
     }
 
@@ -1958,7 +1974,7 @@ namespace smt {
        \brief Execute generic undo-objects.
     */
     void context::undo_trail_stack(unsigned old_size) {
-        ::undo_trail_stack(m_trail_stack, old_size);
+        m_trail_stack.undo(old_size);
     }
 
     /**
@@ -2657,6 +2673,7 @@ namespace smt {
         // Remark: when assumptions are used m_scope_lvl >= m_search_lvl > m_base_lvl. Therefore, no simplification is performed.
         if (m_scope_lvl > m_base_lvl)
             return;
+        scoped_phase_trace _pt("smt.simplify_clauses");
 
         unsigned sz = m_assigned_literals.size();
         SASSERT(m_simp_qhead <= sz);
@@ -2721,7 +2738,8 @@ namespace smt {
     inline void context::del_inactive_lemmas() {
         if (m_fparams.m_lemma_gc_strategy == LGC_NONE)
             return;
-        else if (m_fparams.m_lemma_gc_half)
+        scoped_phase_trace _pt("smt.gc_lemmas");
+        if (m_fparams.m_lemma_gc_half)
             del_inactive_lemmas1();
         else
             del_inactive_lemmas2();
@@ -3822,14 +3840,19 @@ namespace smt {
             SASSERT(!inconsistent());
             log_stats();
             // execute the restart
+            phase_trace::instant("smt.restart");
             m_stats.m_num_restarts++;
             m_num_restarts++;
             if (m_scope_lvl > curr_lvl) {
+                for (theory* th : m_theory_set)
+                    th->snapshot_eh();
                 pop_scope(m_scope_lvl - curr_lvl);
                 SASSERT(at_search_level());
+                for (theory* th : m_theory_set)
+                    th->resume_eh();
             }
-            for (theory* th : m_theory_set) 
-                if (!inconsistent()) 
+            for (theory* th : m_theory_set)
+                if (!inconsistent())
                     th->restart_eh();
 
             TRACE("mbqi_bug_detail", tout << "before instantiating quantifiers...\n";);
@@ -3978,8 +4001,15 @@ namespace smt {
         }
 
         if (memory::above_high_watermark()) {
-            m_last_search_failure = MEMOUT;
-            return true;
+            // before giving up on the query, try to recover by releasing
+            // inactive lemmas; new conflicts have to accumulate before a
+            // further recovery attempt is made.
+            if (m_num_conflicts_since_lemma_gc > 0 && !m_lemmas.empty())
+                del_inactive_lemmas();
+            if (memory::above_high_watermark()) {
+                m_last_search_failure = MEMOUT;
+                return true;
+            }
         }
 
         return false;
@@ -58,6 +58,10 @@ Revision History:
 // consumption.
 #define USE_BOOL_VAR_VECTOR 1
 
+namespace datatype {
+    class util;
+}
+
 namespace smt {
 
     class model_generator;
@@ -68,6 +72,7 @@ namespace smt {
         friend class model_generator;
         friend class lookahead;
         friend class parallel;
+        friend class kernel;
     public:
         statistics                  m_stats;
 
@@ -174,6 +179,8 @@ namespace smt {
         unsigned_vector             m_lit_occs;    //!< occurrence count of literals
         svector<bool_var_data>      m_bdata;       //!< mapping bool_var -> data
         svector<double>             m_activity;
+        unsigned_vector             m_activity_scale; // scale generation of each entry of m_activity
+        unsigned                    m_num_rescales { 0 }; // global activity scale generation
         clause_vector               m_aux_clauses;
         clause_vector               m_lemmas;
         vector<clause_vector>       m_clauses_to_reinit;
@@ -411,11 +418,24 @@ namespace smt {
 
         bool is_searching() const { return m_searching; }
 
-        svector<double> const & get_activity_vector() const { return m_activity; }
+#define ACTIVITY_LIMIT 1e100
+#define INV_ACTIVITY_LIMIT 1e-100
 
-        double get_activity(bool_var v) const { return m_activity[v]; }
+        /**
+           \brief Activity of v normalized to the current scale generation.
+           Rescaling is O(1): it bumps m_num_rescales instead of touching
+           every entry, and entries pay for the missed rescales when they
+           are read. The factor underflows to zero after a few generations,
+           so normalization is constant time as well.
+        */
+        double get_activity(bool_var v) const {
+            double act = m_activity[v];
+            for (unsigned d = m_num_rescales - m_activity_scale[v]; d > 0 && act != 0; --d)
+                act *= INV_ACTIVITY_LIMIT;
+            return act;
+        }
 
-        void set_activity(bool_var v, double act) { m_activity[v] = act; }
+        void set_activity(bool_var v, double act) { m_activity[v] = act; m_activity_scale[v] = m_num_rescales; }
 
         void activity_changed(bool_var v, bool increased) {
             if (increased) {
@@ -604,8 +624,7 @@ namespace smt {
         //
         // -----------------------------------
     protected:
-        typedef ptr_vector<trail >   trail_stack;
-        trail_stack                           m_trail_stack;
+        trail_log                             m_trail_stack;
 #ifdef Z3DEBUG
         bool                                  m_trail_enabled { true };
 #endif
@@ -614,11 +633,11 @@ namespace smt {
         template<typename TrailObject>
         void push_trail(const TrailObject & obj) {
             SASSERT(m_trail_enabled);
-            m_trail_stack.push_back(new (m_region) TrailObject(obj));
+            m_trail_stack.push(obj);
         }
 
         void push_trail_ptr(trail * ptr) {
-            m_trail_stack.push_back(ptr);
+            m_trail_stack.push_ptr(ptr);
         }
 
     protected:
@@ -1154,14 +1173,15 @@ namespace smt {
 
         void update_phase_cache_counter();
 
-#define ACTIVITY_LIMIT 1e100
-#define INV_ACTIVITY_LIMIT 1e-100
-
         void rescale_bool_var_activity();
 
     public:
         void inc_bvar_activity(bool_var v) {
             double & act = m_activity[v];
+            if (m_activity_scale[v] != m_num_rescales) {
+                act = get_activity(v);
+                m_activity_scale[v] = m_num_rescales;
+            }
             act += m_bvar_inc;
             if (act > ACTIVITY_LIMIT)
                 rescale_bool_var_activity();
@@ -1562,7 +1582,7 @@ namespace smt {
         obj_map<expr, expr*> m_var2orig;
         u_map<expr*> m_assumption2orig;
         obj_map<expr, expr*> m_var2val;
-        void extract_fixed_consequences(literal lit, index_set const& assumptions, expr_ref_vector& conseq);
+        void extract_fixed_consequences(datatype::util& dt, literal lit, index_set const& assumptions, expr_ref_vector& conseq);
         void extract_fixed_consequences(unsigned& idx, index_set const& assumptions, expr_ref_vector& conseq);
 
         void display_consequence_progress(std::ostream& out, unsigned it, unsigned nv, unsigned fixed, unsigned unfixed, unsigned eq);
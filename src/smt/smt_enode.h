@@ -67,6 +67,7 @@ namespace smt {
         unsigned            m_generation; //!< Tracks how many quantifier instantiation rounds were needed to generate this enode.
 
         unsigned            m_func_decl_id; //!< Id generated by the congruence table for fast indexing.
+        unsigned            m_cg_hash;      //!< Congruence hash cached by the congruence table at insertion time.
 
         unsigned            m_mark:1;        //!< Multi-purpose auxiliary mark. 
         unsigned            m_mark2:1;       //!< Multi-purpose auxiliary mark. 
@@ -156,6 +157,14 @@ namespace smt {
             m_func_decl_id = id;
         }
 
+        unsigned get_cg_hash() const {
+            return m_cg_hash;
+        }
+
+        void set_cg_hash(unsigned h) {
+            m_cg_hash = h;
+        }
+
         void mark_as_interpreted() {
             SASSERT(!m_interpreted);
             SASSERT(m_class_size == 1);
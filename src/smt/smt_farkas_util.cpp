@@ -75,15 +75,13 @@ namespace smt {
         return a.mk_lt(e1, e2);
     }
 
-    void farkas_util::mul(rational const& c, expr* e, expr_ref& res) {
-        expr_ref tmp(m);
+    void farkas_util::mul(rational const& c, expr* e, expr_ref_vector& sum) {
         if (c.is_one()) {
-            tmp = e;
+            sum.push_back(e);
         }
         else {
-            tmp = mk_mul(a.mk_numeral(c, c.is_int() && a.is_int(e)), e);
+            sum.push_back(mk_mul(a.mk_numeral(c, c.is_int() && a.is_int(e)), e));
         }
-        res = mk_add(res, tmp);
     }
 
     bool farkas_util::is_int_sort(app* c) {
@@ -228,32 +226,49 @@ namespace smt {
     }
     expr_ref farkas_util::extract_consequence(unsigned lo, unsigned hi) {
         bool is_int = is_int_sort();
-        app_ref zero(a.mk_numeral(rational::zero(), is_int), m);
         expr_ref res(m);
-        res = zero;
+        expr_ref_vector sum(m);
         bool is_strict = false;
         bool is_eq     = true;
         expr* x, *y;
         for (unsigned i = lo; i < hi; ++i) {
             app* c = m_ineqs[i].get();
             if (m.is_eq(c, x, y)) {
-                mul(m_coeffs[i],  x, res);
-                mul(-m_coeffs[i], y, res);
+                mul(m_coeffs[i],  x, sum);
+                mul(-m_coeffs[i], y, sum);
             }
             if (a.is_lt(c, x, y) || a.is_gt(c, y, x)) {
-                mul(m_coeffs[i],  x, res);
-                mul(-m_coeffs[i], y, res);
+                mul(m_coeffs[i],  x, sum);
+                mul(-m_coeffs[i], y, sum);
                 is_strict = true;
                 is_eq = false;
             }
             if (a.is_le(c, x, y) || a.is_ge(c, y, x)) {
-                mul(m_coeffs[i],  x, res);
-                mul(-m_coeffs[i], y, res);
+                mul(m_coeffs[i],  x, sum);
+                mul(-m_coeffs[i], y, sum);
                 is_eq = false;
             }
         }
-        
-        zero = a.mk_numeral(rational::zero(), a.is_int(res));
+
+        // combine the scaled terms in a single n-ary sum instead of a chain
+        // of binary additions; coerce to real if sorts are mixed.
+        bool has_real = false;
+        for (expr* e : sum)
+            has_real |= a.is_real(e);
+        if (has_real) {
+            for (unsigned i = 0; i < sum.size(); ++i) {
+                if (a.is_int(sum.get(i)))
+                    sum.set(i, a.mk_to_real(sum.get(i)));
+            }
+        }
+        if (sum.empty())
+            res = a.mk_numeral(rational::zero(), is_int);
+        else if (sum.size() == 1)
+            res = sum.get(0);
+        else
+            res = a.mk_add(sum.size(), sum.data());
+
+        app_ref zero(a.mk_numeral(rational::zero(), a.is_int(res)), m);
         if (is_eq) {
             res = m.mk_eq(res, zero);
         }
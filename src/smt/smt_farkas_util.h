@@ -43,7 +43,7 @@ namespace smt {
         app* mk_ge(expr* e1, expr* e2);
         app* mk_gt(expr* e1, expr* e2);
         app* mk_lt(expr* e1, expr* e2);
-        void mul(rational const& c, expr* e, expr_ref& res);
+        void mul(rational const& c, expr* e, expr_ref_vector& sum);
         bool is_int_sort(app* c);
         bool is_int_sort();
         void normalize_coeffs();
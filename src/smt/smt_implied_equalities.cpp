@@ -42,8 +42,10 @@ namespace {
         stopwatch                          m_stats_timer;
         unsigned                           m_stats_calls;
         stopwatch                          m_stats_val_eq_timer;
+        vector<model_ref>                  m_models;
         static stopwatch                   s_timer;
         static stopwatch                   s_stats_val_eq_timer;
+        static const unsigned              m_max_models = 8;
                 
         struct term_id {
             expr_ref term;
@@ -63,14 +65,42 @@ namespace {
             }
         }
         
+        /**
+           \brief Check whether a sampled model distinguishes \c s and \c t.
+
+           Every sampled model satisfies the asserted formulas, so a model
+           that evaluates s = t to false witnesses that the equality is not
+           implied and the solver call for the pair can be skipped.
+        */
+        bool is_distinguished(expr* s, expr* t) {
+            expr_ref eq(m.mk_eq(s, t), m), vl(m);
+            for (model_ref& mdl : m_models) {
+                vl = (*mdl)(eq);
+                if (m.is_false(vl))
+                    return true;
+            }
+            return false;
+        }
+
+        void sample_model() {
+            if (m_models.size() >= m_max_models)
+                return;
+            model_ref mdl;
+            m_solver.get_model(mdl);
+            if (mdl)
+                m_models.push_back(mdl);
+        }
+
         /**
            \brief Basic implied equalities method.
            It performs a simple N^2 loop over all pairs of terms.
+           Candidate pairs that a sampled model refutes are skipped
+           without a solver call.
 
-           n1, .., n_k, 
+           n1, .., n_k,
            t1, .., t_l
         */
-        
+
         void get_implied_equalities_filter_basic(uint_set const& non_values, term_ids& terms) {
             m_stats_timer.start();
             uint_set root_indices;
@@ -93,11 +123,14 @@ namespace {
                     if (found_root_value && !non_values.contains(j)) continue;
                     expr* s = terms[j].term;
                     SASSERT(t->get_sort() == s->get_sort());
+                    if (is_distinguished(s, t)) {
+                        TRACE("get_implied_equalities", tout << mk_pp(t, m) << " = " << mk_pp(s, m) << " refuted by sampled model\n";);
+                        continue;
+                    }
                     ++m_stats_calls;
                     m_solver.push();
                     m_solver.assert_expr(m.mk_not(m.mk_eq(s, t)));
                     bool is_eq = l_false == m_solver.check_sat(0,nullptr);
-                    m_solver.pop(1);
                     TRACE("get_implied_equalities", tout << mk_pp(t, m) << " = " << mk_pp(s, m) << " " << (is_eq?"eq":"unrelated") << "\n";);
                     if (is_eq) {
                         m_uf.merge(terms[i].id, terms[j].id);
@@ -105,6 +138,10 @@ namespace {
                             found_root_value = true;
                         }
                     }
+                    else {
+                        sample_model();
+                    }
+                    m_solver.pop(1);
                 }
             }            
             m_stats_timer.stop();
@@ -213,6 +250,8 @@ namespace {
 
                 for (unsigned j = 0; !found && j < vec.size(); ++j) {
                     expr* s = terms[vec[j]].term;
+                    if (is_distinguished(s, t))
+                        continue;
                     m_solver.push();
                     m_solver.assert_expr(m.mk_not(m.mk_eq(t, s)));
                     lbool is_sat = m_solver.check_sat(0,nullptr);
@@ -341,7 +380,8 @@ namespace {
                 model_ref model;
                 m_solver.get_model(model);
                 SASSERT(model.get());
-                  
+                m_models.push_back(model);
+
                 partition_terms(num_terms, terms, termids);
                 sort2term_ids::iterator it = termids.begin(), end = termids.end();
                 for (; it != end; ++it) {
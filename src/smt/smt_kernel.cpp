@@ -24,14 +24,134 @@ Revision History:
 
 namespace smt {
 
+    namespace {
+        // Cross-query cache of base-level unit consequences, enabled by
+        // smt.unit_cache. An entry records the assertion set of a query at
+        // the point the kernel was reset together with the literals the query
+        // proved at base level. Units are consequences of the premise set and
+        // remain consequences of any superset, so an entry may be replayed
+        // into a later query as soon as every recorded premise is asserted
+        // again. The cache outlives kernel::reset; see kernel::reset below.
+        struct unit_cache_entry {
+            expr_ref_vector m_premises;
+            expr_ref_vector m_units;
+            unsigned        m_replayed_gen = UINT_MAX;
+            unit_cache_entry(ast_manager& m): m_premises(m), m_units(m) {}
+        };
+
+        struct unit_cache {
+            static const unsigned max_entries = 4;
+            static const unsigned max_units   = 1024;
+            ptr_vector<unit_cache_entry> m_entries; // most recent last
+            unsigned                     m_generation = 0;
+            ~unit_cache() {
+                for (unit_cache_entry* e : m_entries)
+                    dealloc(e);
+            }
+        };
+    }
+
     struct kernel::imp {
         smt::context m_kernel;
         params_ref   m_params;
-        
+        unit_cache * m_unit_cache = nullptr;
+        // user scopes created by push() that have not been materialized in
+        // the context yet. A pending scope is by construction empty: any
+        // operation that lands state in it materializes it first. Popping a
+        // pending scope just decrements the counter.
+        unsigned     m_pending_scopes = 0;
+
         imp(ast_manager & m, smt_params & fp, params_ref const & p):
             m_kernel(m, fp, p),
             m_params(p) {
         }
+
+        ~imp() {
+            dealloc(m_unit_cache);
+        }
+
+        void flush_pending_scopes() {
+            for (; m_pending_scopes > 0; --m_pending_scopes)
+                m_kernel.push();
+        }
+
+        bool unit_cache_enabled() const {
+            return smt_params_helper(m_params).unit_cache();
+        }
+
+        void harvest_units(unit_cache& cache) {
+            context& ctx = m_kernel;
+            ctx.pop_to_base_lvl();
+            unsigned num = ctx.get_num_asserted_formulas();
+            if (ctx.inconsistent() || num == 0 || ctx.assigned_literals().empty())
+                return;
+            ast_manager& m = this->m();
+            obj_hashtable<expr> premises;
+            scoped_ptr<unit_cache_entry> e = alloc(unit_cache_entry, m);
+            for (unsigned i = 0; i < num; i++) {
+                expr* f = ctx.get_asserted_formula(i);
+                e->m_premises.push_back(f);
+                premises.insert(f);
+            }
+            for (literal lit : ctx.assigned_literals()) {
+                if (e->m_units.size() >= unit_cache::max_units)
+                    break;
+                expr_ref u(ctx.bool_var2expr(lit.var()), m);
+                if (lit.sign())
+                    u = m.mk_not(u);
+                if (!premises.contains(u))
+                    e->m_units.push_back(u);
+            }
+            if (e->m_units.empty())
+                return;
+            // an entry for the same premise set is superseded.
+            for (unsigned i = 0; i < cache.m_entries.size(); i++) {
+                unit_cache_entry* old = cache.m_entries[i];
+                if (old->m_premises.size() == premises.size() &&
+                    all_of(old->m_premises, [&](expr* f) { return premises.contains(f); })) {
+                    dealloc(old);
+                    cache.m_entries.erase(cache.m_entries.begin() + i);
+                    break;
+                }
+            }
+            if (cache.m_entries.size() >= unit_cache::max_entries) {
+                dealloc(cache.m_entries[0]);
+                cache.m_entries.erase(cache.m_entries.begin());
+            }
+            cache.m_entries.push_back(e.detach());
+        }
+
+        unit_cache* detach_unit_cache() {
+            if (unit_cache_enabled()) {
+                if (!m_unit_cache)
+                    m_unit_cache = alloc(unit_cache);
+                m_unit_cache->m_generation++;
+                harvest_units(*m_unit_cache);
+            }
+            unit_cache* c = m_unit_cache;
+            m_unit_cache = nullptr;
+            return c;
+        }
+
+        void replay_units() {
+            if (!m_unit_cache || !unit_cache_enabled())
+                return;
+            context& ctx = m_kernel;
+            obj_hashtable<expr> asserted;
+            unsigned num = ctx.get_num_asserted_formulas();
+            for (unsigned i = 0; i < num; i++)
+                asserted.insert(ctx.get_asserted_formula(i));
+            for (unit_cache_entry* e : m_unit_cache->m_entries) {
+                if (e->m_replayed_gen == m_unit_cache->m_generation)
+                    continue;
+                if (!all_of(e->m_premises, [&](expr* f) { return asserted.contains(f); }))
+                    continue;
+                e->m_replayed_gen = m_unit_cache->m_generation;
+                IF_VERBOSE(10, verbose_stream() << "(smt.kernel :replay-units " << e->m_units.size() << ")\n");
+                for (expr* u : e->m_units)
+                    ctx.assert_expr(u);
+            }
+        }
      
         ast_manager & m() const {
             return m_kernel.get_manager();
@@ -64,6 +184,8 @@ namespace smt {
     }
 
     void  kernel::copy(kernel& src, kernel& dst) {
+        src.m_imp->flush_pending_scopes();
+        dst.m_imp->flush_pending_scopes();
         context::copy(src.m_imp->m_kernel, dst.m_imp->m_kernel);
     }
 
@@ -76,15 +198,20 @@ namespace smt {
     }
 
     void kernel::assert_expr(expr * e) {
+        m_imp->flush_pending_scopes();
         m_imp->m_kernel.assert_expr(e);
     }
 
     void kernel::assert_expr(expr_ref_vector const& es) {
-        for (unsigned i = 0; i < es.size(); ++i) 
+        if (es.empty())
+            return;
+        m_imp->flush_pending_scopes();
+        for (unsigned i = 0; i < es.size(); ++i)
             m_imp->m_kernel.assert_expr(es[i]);
     }
 
     void kernel::assert_expr(expr * e, proof * pr) {
+        m_imp->flush_pending_scopes();
         m_imp->m_kernel.assert_expr(e, pr);
     }
 
@@ -97,23 +224,31 @@ namespace smt {
     }
 
     void kernel::push() {
-        m_imp->m_kernel.push();
+        m_imp->m_pending_scopes++;
     }
 
     void kernel::pop(unsigned num_scopes) {
-        m_imp->m_kernel.pop(num_scopes);
+        unsigned pending = std::min(num_scopes, m_imp->m_pending_scopes);
+        m_imp->m_pending_scopes -= pending;
+        num_scopes -= pending;
+        if (num_scopes > 0)
+            m_imp->m_kernel.pop(num_scopes);
     }
 
     unsigned kernel::get_scope_level() const {
-        return m_imp->m_kernel.get_scope_level();
+        return m_imp->m_kernel.get_scope_level() + m_imp->m_pending_scopes;
     }
 
     void kernel::reset() {
         ast_manager & _m = m();
         smt_params& fps = m_imp->m_kernel.get_fparams();
         params_ref ps = m_imp->m_params;
+        // the unit cache survives the reset; detaching also harvests the
+        // base-level consequences of the query being discarded.
+        unit_cache* cache = m_imp->detach_unit_cache();
         m_imp->~imp();
-        m_imp = new (m_imp) imp(_m, fps, ps);        
+        m_imp = new (m_imp) imp(_m, fps, ps);
+        m_imp->m_unit_cache = cache;
     }
 
     bool kernel::inconsistent() {
@@ -121,28 +256,37 @@ namespace smt {
     }
 
     lbool kernel::setup_and_check() {
+        m_imp->flush_pending_scopes();
+        m_imp->replay_units();
         return m_imp->m_kernel.setup_and_check();
     }
 
     lbool kernel::check(unsigned num_assumptions, expr * const * assumptions) {
+        m_imp->flush_pending_scopes();
+        m_imp->replay_units();
         lbool r = m_imp->m_kernel.check(num_assumptions, assumptions);
         TRACE("smt_kernel", tout << "check result: " << r << "\n";);
         return r;
     }
 
     lbool kernel::check(expr_ref_vector const& cube, vector<expr_ref_vector> const& clauses) {
+        m_imp->flush_pending_scopes();
+        m_imp->replay_units();
         return m_imp->m_kernel.check(cube, clauses);
     }
 
     lbool kernel::get_consequences(expr_ref_vector const& assumptions, expr_ref_vector const& vars, expr_ref_vector& conseq, expr_ref_vector& unfixed) {
+        m_imp->flush_pending_scopes();
         return m_imp->m_kernel.get_consequences(assumptions, vars, conseq, unfixed);
     }
 
     lbool kernel::preferred_sat(expr_ref_vector const& asms, vector<expr_ref_vector>& cores) {
+        m_imp->flush_pending_scopes();
         return m_imp->m_kernel.preferred_sat(asms, cores);
     }
 
     lbool kernel::find_mutexes(expr_ref_vector const& vars, vector<expr_ref_vector>& mutexes) {
+        m_imp->flush_pending_scopes();
         return m_imp->m_kernel.find_mutexes(vars, mutexes);
     }
 
@@ -199,11 +343,13 @@ namespace smt {
     }
 
     expr_ref kernel::next_cube() {
+        m_imp->flush_pending_scopes();
         lookahead lh(m_imp->m_kernel);
         return lh.choose();
     }        
 
     expr_ref_vector kernel::cubes(unsigned depth) {
+        m_imp->flush_pending_scopes();
         lookahead lh(m_imp->m_kernel);
         return lh.choose_rec(depth);
     }        
@@ -255,6 +401,9 @@ namespace smt {
     }
 
     context & kernel::get_context() {
+        // external users manipulate the context directly; pending scopes
+        // must be materialized before they do.
+        m_imp->flush_pending_scopes();
         return m_imp->m_kernel;
     }
 
@@ -295,6 +444,7 @@ namespace smt {
     }
 
     void kernel::user_propagate_register_expr(expr* e) {
+        m_imp->flush_pending_scopes();
         m_imp->m_kernel.user_propagate_register_expr(e);
     }        
 
@@ -94,6 +94,10 @@ namespace smt {
         
         /**
            \brief Create a backtracking point (aka scope level).
+
+           The scope is created lazily: the underlying context is only pushed
+           when an assertion lands in the scope or a check is started, so a
+           push that is popped before either happens costs O(1).
         */
         void push();
 
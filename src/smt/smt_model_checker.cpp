@@ -49,10 +49,12 @@ namespace smt {
         m_iteration_idx(0),
         m_curr_model(nullptr),
         m_fresh_exprs(m),
+        m_diff_round(false),
         m_pinned_exprs(m) {
     }
 
     model_checker::~model_checker() {
+        reset_model_diff();
         m_aux_context = nullptr; // delete aux context before fparams
         m_fparams = nullptr;
     }
@@ -453,6 +455,12 @@ namespace smt {
 
         init_aux_context();
 
+        if (m_params.m_mbqi_model_diff) {
+            collect_interps();
+            // the first round checks everything: m_passed_quantifiers is empty.
+            m_diff_round = true;
+        }
+
         bool found_relevant = false;
         unsigned num_failures = 0;
 
@@ -469,8 +477,12 @@ namespace smt {
             num_failures = 1;
             // this time force expanding recursive function definitions
             // that are not forced true in the current model.
+            m_diff_round = false;
             check_quantifiers(found_relevant, num_failures);
         }
+        m_diff_round = false;
+        if (m_params.m_mbqi_model_diff)
+            m_prev_interps.swap(m_curr_interps);
         if (num_failures == 0)
             m_curr_model->cleanup();
         if (m_params.m_mbqi_trace) {
@@ -493,6 +505,98 @@ namespace smt {
     // using multi-patterns.
     //
 
+    /**
+       \brief Collect the terms defining the interpretation of f in the
+       current model: the entry arguments and results followed by the else
+       case. Interpretations are built from hash-consed terms, so as long
+       as the collected terms are kept pinned, two interpretations are
+       equal iff they produce identical term sequences.
+    */
+    void model_checker::interp_exprs(func_decl * f, expr_ref_vector & es) const {
+        if (f->get_arity() == 0) {
+            es.push_back(m_curr_model->get_const_interp(f));
+            return;
+        }
+        func_interp * fi = m_curr_model->get_func_interp(f);
+        if (!fi)
+            return;
+        for (unsigned i = 0; i < fi->num_entries(); i++) {
+            func_entry const * e = fi->get_entry(i);
+            for (unsigned j = 0; j < f->get_arity(); j++)
+                es.push_back(e->get_arg(j));
+            es.push_back(e->get_result());
+        }
+        es.push_back(fi->get_else());
+    }
+
+    void model_checker::reset_interps(obj_map<func_decl, expr_ref_vector *> & interps) {
+        for (auto const & kv : interps)
+            dealloc(kv.m_value);
+        interps.reset();
+    }
+
+    void model_checker::collect_interps() {
+        reset_interps(m_curr_interps);
+        unsigned num = m_curr_model->get_num_constants();
+        for (unsigned i = 0; i < num; i++) {
+            func_decl * f = m_curr_model->get_constant(i);
+            expr_ref_vector * es = alloc(expr_ref_vector, m);
+            interp_exprs(f, *es);
+            m_curr_interps.insert(f, es);
+        }
+        num = m_curr_model->get_num_functions();
+        for (unsigned i = 0; i < num; i++) {
+            func_decl * f = m_curr_model->get_function(i);
+            expr_ref_vector * es = alloc(expr_ref_vector, m);
+            interp_exprs(f, *es);
+            m_curr_interps.insert(f, es);
+        }
+    }
+
+    func_decl_set const & model_checker::quantifier_decls(quantifier * q) {
+        func_decl_set * s = nullptr;
+        if (!m_quantifier_decls.find(q, s)) {
+            s = alloc(func_decl_set);
+            collect_uninterp_decls(m, q->get_expr(), *s);
+            m_quantifier_decls.insert(q, s);
+        }
+        return *s;
+    }
+
+    /**
+       \brief Return true if every declaration occurring in q is interpreted
+       in both the previous and the current model by the same terms.
+       Whether q has a counterexample only depends on the model, so a
+       quantifier that passed the previous round does not have to be
+       re-checked in that case.
+    */
+    bool model_checker::is_unchanged(quantifier * q) {
+        for (func_decl * f : quantifier_decls(q)) {
+            expr_ref_vector * prev = nullptr;
+            expr_ref_vector * curr = nullptr;
+            if (!m_prev_interps.find(f, prev))
+                return false;
+            if (!m_curr_interps.find(f, curr))
+                return false;
+            if (prev->size() != curr->size())
+                return false;
+            for (unsigned i = 0; i < prev->size(); i++)
+                if (prev->get(i) != curr->get(i))
+                    return false;
+        }
+        return true;
+    }
+
+    void model_checker::reset_model_diff() {
+        reset_interps(m_prev_interps);
+        reset_interps(m_curr_interps);
+        m_passed_quantifiers.reset();
+        for (auto const & kv : m_quantifier_decls)
+            dealloc(kv.m_value);
+        m_quantifier_decls.reset();
+        m_diff_round = false;
+    }
+
     void model_checker::check_quantifiers(bool& found_relevant, unsigned& num_failures) {
         for (quantifier * q : *m_qm) {
             if (!(m_qm->mbqi_enabled(q) &&
@@ -502,6 +606,12 @@ namespace smt {
                 continue;
             }
 
+            if (m_diff_round && m_passed_quantifiers.contains(q) && is_unchanged(q)) {
+                TRACE("model_checker", tout << "skipping unchanged quantifier " << mk_pp(q, m) << "\n";);
+                found_relevant = true;
+                continue;
+            }
+
             TRACE("model_checker",
                   tout << "Check: " << mk_pp(q, m) << "\n";
                   tout << m_context->get_assignment(q) << "\n";);
@@ -516,6 +626,10 @@ namespace smt {
                 }
                 TRACE("model_checker", tout << "checking quantifier " << mk_pp(q, m) << " failed\n";);
                 num_failures++;
+                m_passed_quantifiers.erase(q);
+            }
+            else {
+                m_passed_quantifiers.insert(q);
             }
         }
     }
@@ -523,6 +637,8 @@ namespace smt {
     void model_checker::init_search_eh() {
         m_max_cexs = m_params.m_mbqi_max_cexs;
         m_iteration_idx = 0;
+        // quantifiers and declarations recorded in a previous search may have been deleted.
+        reset_model_diff();
     }
 
     void model_checker::restart_eh() {
@@ -543,6 +659,7 @@ namespace smt {
 
     void model_checker::reset() {
         reset_new_instances();
+        reset_model_diff();
     }
 
     void model_checker::assert_new_instances() {
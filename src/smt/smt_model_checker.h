@@ -23,6 +23,7 @@ Revision History:
 #include "util/obj_hashtable.h"
 #include "ast/ast.h"
 #include "ast/array_decl_plugin.h"
+#include "ast/func_decl_dependencies.h"
 #include "ast/normal_forms/defined_names.h"
 #include "smt/params/qi_params.h"
 #include "smt/params/smt_params.h"
@@ -67,6 +68,23 @@ namespace smt {
         bool check(quantifier * q);
         void check_quantifiers(bool& found_relevant, unsigned& num_failures);
 
+        // Model diffing between MBQI rounds (mbqi.model_diff): a quantifier
+        // that passed the previous round is only re-checked if one of the
+        // declarations occurring in it changed interpretation in the
+        // current model. The interpretation terms are pinned, so comparing
+        // them by identity against the previous round is exact.
+        obj_map<func_decl, expr_ref_vector *> m_prev_interps;
+        obj_map<func_decl, expr_ref_vector *> m_curr_interps;
+        obj_hashtable<quantifier>            m_passed_quantifiers;
+        obj_map<quantifier, func_decl_set *> m_quantifier_decls;
+        bool                                 m_diff_round;
+        void interp_exprs(func_decl * f, expr_ref_vector & es) const;
+        void collect_interps();
+        static void reset_interps(obj_map<func_decl, expr_ref_vector *> & interps);
+        func_decl_set const & quantifier_decls(quantifier * q);
+        bool is_unchanged(quantifier * q);
+        void reset_model_diff();
+
         struct instance {
             quantifier * m_q;
             unsigned     m_generation;
@@ -17,6 +17,7 @@ Author:
 
 
 #include "util/scoped_ptr_vector.h"
+#include "util/thread_affinity.h"
 #include "ast/ast_util.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_ll_pp.h"
@@ -43,6 +44,12 @@ namespace smt {
 
         lbool result = l_undef;
         unsigned num_threads = std::min((unsigned) std::thread::hardware_concurrency(), ctx.get_fparams().m_threads);
+        // In deterministic mode workers run to their full conflict budget instead
+        // of being canceled by the first finisher, and the answer is committed in
+        // thread order after the round barrier. Each worker is single-threaded
+        // with a fixed seed and unit exchange only happens at the barrier, so the
+        // result no longer depends on thread scheduling.
+        bool deterministic = ctx.get_fparams().m_threads_deterministic;
         flet<unsigned> _nt(ctx.m_fparams.m_threads, 1);
         unsigned thread_max_conflicts = ctx.get_fparams().m_threads_max_conflicts;
         unsigned max_conflicts = ctx.get_fparams().m_max_conflicts;
@@ -64,6 +71,11 @@ namespace smt {
         scoped_ptr_vector<ast_manager> pms;
         scoped_ptr_vector<context> pctxs;
         vector<expr_ref_vector> pasms;
+        // Per-thread translations are kept alive across sharing rounds so that
+        // the translation caches persist: rebuilding them each round forces a
+        // full re-translation of the shared DAG per round on large benchmarks.
+        scoped_ptr_vector<ast_translation> tr2pctx;  // ctx.m -> pctxs[i]->m
+        scoped_ptr_vector<ast_translation> tr2ctx;   // pctxs[i]->m -> ctx.m
 
         ast_manager& m = ctx.m;
         scoped_limits sl(m.limit());
@@ -87,8 +99,9 @@ namespace smt {
             context& new_ctx = *pctxs.back();
             context::copy(ctx, new_ctx, true);
             new_ctx.set_random_seed(i + ctx.get_fparams().m_random_seed);
-            ast_translation tr(m, *new_m);
-            pasms.push_back(tr(asms));
+            tr2pctx.push_back(alloc(ast_translation, m, *new_m));
+            tr2ctx.push_back(alloc(ast_translation, *new_m, m));
+            pasms.push_back((*tr2pctx[i])(asms));
             sl.push_child(&(new_m->limit()));
         }
 
@@ -111,7 +124,7 @@ namespace smt {
             for (unsigned i = 0; i < num_threads; ++i) {
                 context& pctx = *pctxs[i];
                 pctx.pop_to_base_lvl();
-                ast_translation tr(pctx.m, ctx.m);
+                ast_translation & tr = *tr2ctx[i];
                 unsigned sz = pctx.assigned_literals().size();
                 for (unsigned j = unit_lim[i]; j < sz; ++j) {
                     literal lit = pctx.assigned_literals()[j];
@@ -128,7 +141,7 @@ namespace smt {
             unsigned sz = unit_trail.size();
             for (unsigned i = 0; i < num_threads; ++i) {
                 context& pctx = *pctxs[i];
-                ast_translation tr(ctx.m, pctx.m);
+                ast_translation & tr = *tr2pctx[i];
                 for (unsigned j = unit_lim[i]; j < sz; ++j) {
                     expr_ref src(ctx.m), dst(pctx.m);
                     dst = tr(unit_trail.get(j));
@@ -140,6 +153,7 @@ namespace smt {
         };
 
         std::mutex mux;
+        svector<lbool> thread_results(num_threads, l_undef);
 
         auto worker_thread = [&](int i) {
             try {
@@ -148,25 +162,52 @@ namespace smt {
                 expr_ref_vector lasms(pasms[i]);
                 expr_ref c(pm);
 
-                pctx.get_fparams().m_max_conflicts = std::min(thread_max_conflicts, max_conflicts);
-                if (num_rounds > 0 && (pctx.get_fparams().m_threads_cube_frequency % num_rounds) == 0) 
-                    cube(pctx, lasms, c);
-                IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i; 
-                           if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
-                           if (c) verbose_stream() << " :cube " << mk_bounded_pp(c, pm, 3);
-                           verbose_stream() << ")\n";);
-                lbool r = pctx.check(lasms.size(), lasms.data());
-                
-                if (r == l_undef && pctx.m_num_conflicts >= max_conflicts) 
-                    ; // no-op
-                else if (r == l_undef && pctx.m_num_conflicts >= thread_max_conflicts) 
-                    return;
-                else if (r == l_false && pctx.unsat_core().contains(c)) {
-                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(c, pm, 3) << ")");
-                    pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                // A worker whose cube is refuted below budget picks a fresh
+                // cube and keeps searching; the round budget is shared across
+                // all cubes the worker attempts, so rounds stay bounded while
+                // no thread idles at the round barrier after an easy cube.
+                unsigned consumed = 0;
+                lbool r = l_undef;
+                while (true) {
+                    pctx.get_fparams().m_max_conflicts = std::min(thread_max_conflicts - consumed, max_conflicts);
+                    if (consumed > 0 || (num_rounds > 0 && (pctx.get_fparams().m_threads_cube_frequency % num_rounds) == 0))
+                        cube(pctx, lasms, c);
+                    IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i;
+                               if (num_rounds > 0) verbose_stream() << " :round " << num_rounds;
+                               if (c) verbose_stream() << " :cube " << mk_bounded_pp(c, pm, 3);
+                               verbose_stream() << ")\n";);
+                    r = pctx.check(lasms.size(), lasms.data());
+                    consumed += pctx.m_num_conflicts;
+
+                    if (r == l_undef && pctx.m_num_conflicts >= max_conflicts)
+                        break; // global budget exhausted: record undef below
+                    if (r == l_undef && consumed >= thread_max_conflicts)
+                        return;
+                    if (r == l_false && c && pctx.unsat_core().contains(c)) {
+                        IF_VERBOSE(1, verbose_stream() << "(smt.thread " << i << " :learn " << mk_bounded_pp(c, pm, 3) << ")");
+                        pctx.assert_expr(mk_not(mk_and(pctx.unsat_core())));
+                        if (done || consumed >= thread_max_conflicts)
+                            return;
+                        lasms.reset();
+                        lasms.append(pasms[i]);
+                        c.reset();
+                        continue;
+                    }
+                    break;
+                }
+
+
+                if (deterministic) {
+                    std::lock_guard<std::mutex> lock(mux);
+                    thread_results[i] = r;
+                    // global budget exhausted: end the round loop with undef,
+                    // unless another worker produced a definitive answer.
+                    if (r == l_undef && pctx.m_num_conflicts >= max_conflicts && finished_id == UINT_MAX) {
+                        finished_id = i;
+                        done = true;
+                    }
                     return;
-                } 
-                
+                }
 
                 bool first = false;
                 {
@@ -215,13 +256,28 @@ namespace smt {
         // for debugging:  num_threads = 1;
 
         while (true) {
+            for (unsigned i = 0; i < num_threads; ++i)
+                thread_results[i] = l_undef;
             vector<std::thread> threads(num_threads);
             for (unsigned i = 0; i < num_threads; ++i) {
                 threads[i] = std::thread([&, i]() { worker_thread(i); });
+                if (ctx.get_fparams().m_threads_affinity)
+                    set_thread_affinity(threads[i], i);
             }
             for (auto & th : threads) {
                 th.join();
             }
+            if (deterministic) {
+                // commit results in canonical thread order, independently of finish order
+                for (unsigned i = 0; i < num_threads; ++i) {
+                    if (thread_results[i] != l_undef) {
+                        finished_id = i;
+                        result = thread_results[i];
+                        done = true;
+                        break;
+                    }
+                }
+            }
             if (done) break;
 
             collect_units();
@@ -241,9 +297,9 @@ namespace smt {
             }
         }        
 
-        model_ref mdl;        
+        model_ref mdl;
         context& pctx = *pctxs[finished_id];
-        ast_translation tr(*pms[finished_id], m);
+        ast_translation & tr = *tr2ctx[finished_id];
         switch (result) {
         case l_true: 
             pctx.get_model(mdl);
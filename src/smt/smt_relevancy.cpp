@@ -145,10 +145,16 @@ namespace smt {
         };
         svector<scope>                 m_scopes;
         bool                           m_propagating;
+        // In lazy mode propagation is deferred until relevancy is queried.
+        // The generations record whether expressions were marked since the last batch.
+        bool                           m_lazy;
+        unsigned                       m_mark_gen;
+        unsigned                       m_propagate_gen;
 
         relevancy_propagator_imp(context & ctx):
             relevancy_propagator(ctx), m_qhead(0), m_relevant_exprs(ctx.get_manager()),
-            m_propagating(false) {}
+            m_propagating(false), m_lazy(ctx.get_fparams().m_relevancy_lazy),
+            m_mark_gen(0), m_propagate_gen(0) {}
 
         ~relevancy_propagator_imp() override {
             undo_trail(0);
@@ -239,9 +245,13 @@ namespace smt {
         }
         
         bool is_relevant_core(expr * n) const { return m_is_relevant.contains(n->get_id()); }
-        
+
         bool is_relevant(expr * n) const override {
-            return !enabled() || is_relevant_core(n);
+            if (!enabled())
+                return true;
+            if (m_lazy && m_propagate_gen != m_mark_gen)
+                const_cast<relevancy_propagator_imp*>(this)->force_propagate();
+            return is_relevant_core(n);
         }
 
         void push() override {
@@ -301,6 +311,7 @@ namespace smt {
         void set_relevant(expr * n) {
             m_is_relevant.insert(n->get_id());
             m_relevant_exprs.push_back(n);
+            m_mark_gen++;
             m_context.relevant_eh(n);
         }
 
@@ -444,7 +455,24 @@ namespace smt {
            relevant expressions.
         */
         void propagate() override {
-            if (m_propagating) {  
+            if (m_lazy) {
+                // propagation is deferred until relevancy is queried, see is_relevant
+                return;
+            }
+            propagate_core();
+        }
+
+        /**
+           \brief Process the pending batch of marked expressions and record
+           that the propagated state is in sync with the marks.
+        */
+        void force_propagate() {
+            propagate_core();
+            m_propagate_gen = m_mark_gen;
+        }
+
+        void propagate_core() {
+            if (m_propagating) {
                 return;  
             }  
             flet<bool> l_prop(m_propagating, true);  
@@ -488,7 +516,8 @@ namespace smt {
         }
 
         bool can_propagate() const override {
-            return m_qhead < m_relevant_exprs.size();
+            // in lazy mode the pending marks are processed on demand
+            return !m_lazy && m_qhead < m_relevant_exprs.size();
         }
 
         void assign_eh(expr * n, bool val) override {
@@ -594,6 +623,8 @@ namespace smt {
         }
         
         bool check_relevancy(expr_ref_vector const & v) const override {
+            if (m_lazy)
+                const_cast<relevancy_propagator_imp*>(this)->force_propagate();
             SASSERT(!can_propagate());
             ast_manager & m = get_manager();
             unsigned sz = v.size();
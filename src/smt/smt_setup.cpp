@@ -641,6 +641,11 @@ namespace smt {
                 else
                     m_context.register_plugin(alloc(smt::theory_frdl, m_context));
             }
+            else if (int_only && m_params.m_arith_fixnum && st.arith_k_sum_is_small64()) {
+                // the constant sum exceeds the 32-bit budget of theory_fidl but
+                // fits comfortably in 64 bits; arithmetic is overflow-checked.
+                m_context.register_plugin(alloc(smt::theory_idl64, m_context));
+            }
             else {
                 if (int_only)
                     m_context.register_plugin(alloc(smt::theory_idl, m_context));
@@ -665,7 +670,11 @@ namespace smt {
             break;
         case arith_solver_id::AS_UTVPI:
             m_params.m_arith_eq2ineq  = true;
-            if (int_only)
+            if (int_only && m_params.m_arith_fixnum && st.arith_k_sum_is_small64())
+                // constants fit in 64-bit machine integers even after the
+                // UTVPI encoding doubles them; arithmetic is overflow-checked.
+                m_context.register_plugin(alloc(smt::theory_iutvpi64, m_context));
+            else if (int_only)
                 m_context.register_plugin(alloc(smt::theory_iutvpi, m_context));
             else
                 m_context.register_plugin(alloc(smt::theory_rutvpi, m_context));
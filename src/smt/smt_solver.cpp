@@ -275,6 +275,7 @@ namespace {
             if (!m_minimizing_core && smt_params_helper(get_params()).core_minimize()) {
                 scoped_minimize_core scm(*this);
                 mus mus(*this);
+                mus.set_core_callback(unsat_core_eh());
                 mus.add_soft(r.size(), r.data());
                 expr_ref_vector r2(m);
                 if (l_true == mus.get_mus(r2)) {
@@ -132,7 +132,7 @@ namespace smt {
 
             scoped_trace_stream(theory& th, literal lit): m(th.get_manager()) {
                 if (m.has_trace_stream()) {
-                    literal_vector lits;
+                    literal_buffer lits;
                     lits.push_back(lit);
                     th.log_axiom_instantiation(lits);
                 }
@@ -140,7 +140,7 @@ namespace smt {
 
             scoped_trace_stream(theory& th, literal lit1, literal lit2): m(th.get_manager()) {
                 if (m.has_trace_stream()) {
-                    literal_vector lits;
+                    literal_buffer lits;
                     lits.push_back(lit1);
                     lits.push_back(lit2);
                     th.log_axiom_instantiation(lits);
@@ -149,7 +149,7 @@ namespace smt {
 
             scoped_trace_stream(theory& th, std::function<literal(void)>& fn): m(th.get_manager()) {
                 if (m.has_trace_stream()) {
-                    literal_vector ls;
+                    literal_buffer ls;
                     ls.push_back(fn());
                     th.log_axiom_instantiation(ls);
                 }
@@ -274,6 +274,24 @@ namespace smt {
         virtual void restart_eh() {
         }
 
+        /**
+           \brief This method is invoked just before a restart unwinds the
+           search back to the search level. Theories whose expensive internal
+           state does not follow the scope stack may capture it here and
+           reinstall it in resume_eh. State kept in scoped containers survives
+           the unwinding on its own and does not need to be checkpointed.
+        */
+        virtual void snapshot_eh() {
+        }
+
+        /**
+           \brief This method is invoked after a restart has unwound the
+           search, before restart_eh is dispatched. Theories reinstall state
+           captured by snapshot_eh here.
+        */
+        virtual void resume_eh() {
+        }
+
         /**
            \brief This method is called by smt_context before the search starts
            to get any extra assumptions the theory wants to use.
@@ -20,6 +20,7 @@ Revision History:
 
 #include "util/list.h"
 #include "util/vector.h"
+#include "util/buffer.h"
 #include "util/hashtable.h"
 #include "util/lbool.h"
 #include "util/sat_literal.h"
@@ -47,6 +48,9 @@ namespace smt {
     typedef ptr_vector<enode> enode_vector;
     typedef std::pair<enode *, enode *> enode_pair;
     typedef svector<enode_pair> enode_pair_vector;
+    // small-buffer variant for short-lived antecedent lists: no heap
+    // allocation as long as the list stays within the inline capacity.
+    typedef sbuffer<enode_pair> enode_pair_buffer;
 
     class theory;
 
@@ -35,6 +35,78 @@ Notes:
 
 typedef obj_map<expr, expr *> expr2expr_map;
 
+/**
+   \brief Model converter that delays model construction.
+
+   Instead of extracting the model from the kernel when the tactic
+   returns sat, the kernel is kept alive (with its frozen search state)
+   and the model is built on first use of the converter. Clients that
+   only check satisfiability never pay for model construction; the
+   price is that the kernel is retained until the converter is applied
+   or destroyed.
+*/
+class lazy_smt_model_converter : public model_converter {
+    // the kernel holds a reference to the smt_params it was created with,
+    // so the converter owns the parameters as well; m_kernel is declared
+    // after m_fparams so that the kernel is destroyed first.
+    scoped_ptr<smt_params>  m_fparams;
+    scoped_ptr<smt::kernel> m_kernel;
+    model_converter_ref     m_mc;
+
+    void force() {
+        if (!m_kernel)
+            return;
+        model_ref md;
+        m_kernel->get_model(md);
+        buffer<symbol> r;
+        m_kernel->get_relevant_labels(nullptr, r);
+        labels_vec rv;
+        rv.append(r.size(), r.data());
+        m_mc = model_and_labels2model_converter(md.get(), rv);
+        m_kernel = nullptr;
+        m_fparams = nullptr;
+    }
+
+public:
+    lazy_smt_model_converter(smt::kernel * k, smt_params * fp): m_fparams(fp), m_kernel(k) {}
+
+    void operator()(model_ref & md) override {
+        force();
+        if (m_mc)
+            (*m_mc)(md);
+    }
+
+    void operator()(labels_vec & r) override {
+        force();
+        if (m_mc)
+            (*m_mc)(r);
+    }
+
+    void operator()(expr_ref & fml) override {
+        force();
+        if (m_mc)
+            (*m_mc)(fml);
+    }
+
+    void get_units(obj_map<expr, bool> & fmls) override {
+        force();
+        if (m_mc)
+            m_mc->get_units(fmls);
+    }
+
+    model_converter * translate(ast_translation & translator) override {
+        force();
+        return m_mc ? m_mc->translate(translator) : nullptr;
+    }
+
+    void display(std::ostream & out) override {
+        if (m_mc)
+            m_mc->display(out);
+        else
+            out << "(lazy-smt-model-converter)\n";
+    }
+};
+
 
 class smt_tactic : public tactic {
     ast_manager&                 m;
@@ -47,6 +119,7 @@ class smt_tactic : public tactic {
     progress_callback*           m_callback = nullptr;
     bool                         m_candidate_models = false;
     bool                         m_fail_if_inconclusive = false;
+    bool                         m_lazy_models = false;
 
 public:
     smt_tactic(ast_manager& m, params_ref const & p):
@@ -79,6 +152,7 @@ public:
         smt_params_helper _p(p);
         m_candidate_models     = _p.candidate_models();
         m_fail_if_inconclusive = p.get_bool("fail_if_inconclusive", true);
+        m_lazy_models          = p.get_bool("lazy_models", false);
     }
 
     void updt_params(params_ref const & p) override {
@@ -95,6 +169,7 @@ public:
 
     void collect_param_descrs(param_descrs & r) override {
         r.insert("fail_if_inconclusive", CPK_BOOL, "(default: true) fail if found unsat (sat) for under (over) approximated goal.");
+        r.insert("lazy_models", CPK_BOOL, "(default: false) keep the solver alive on sat and build the model only when the model converter is used.");
         smt_params_helper::collect_param_descrs(r);
     }
 
@@ -123,14 +198,17 @@ public:
 
     struct scoped_init_ctx {
         smt_tactic & m_owner;
-        smt_params   m_params; // smt-setup overwrites parameters depending on the current assertions.
+        // smt-setup overwrites parameters depending on the current assertions.
+        // The kernel references the smt_params, so they are heap-allocated and
+        // handed over together with the kernel when models are built lazily.
+        scoped_ptr<smt_params> m_params;
         params_ref   m_params_ref;
 
         scoped_init_ctx(smt_tactic & o, ast_manager & m):m_owner(o) {
-            m_params = o.fparams();
+            m_params = alloc(smt_params, o.fparams());
             m_params_ref.reset();
             m_params_ref.append(o.params());
-            smt::kernel * new_ctx = alloc(smt::kernel, m, m_params, m_params_ref);
+            smt::kernel * new_ctx = alloc(smt::kernel, m, *m_params, m_params_ref);
             TRACE("smt_tactic", tout << "logic: " << o.m_logic << "\n";);
             new_ctx->set_logic(o.m_logic);
             if (o.m_callback) {
@@ -140,12 +218,20 @@ public:
         }
 
         ~scoped_init_ctx() {
+            smt::kernel * d = detach();
+            if (d)
+                dealloc(d);
+        }
+
+        smt::kernel * detach() {
             smt::kernel * d = m_owner.m_ctx;
             m_owner.m_ctx = nullptr;
             m_owner.m_user_ctx = nullptr;
+            return d;
+        }
 
-            if (d)
-                dealloc(d);
+        smt_params * detach_params() {
+            return m_params.detach();
         }
     };
 
@@ -224,21 +310,29 @@ public:
                 // the empty assertion set is trivially satifiable.
                 in->reset();
                 result.push_back(in.get());
+                if (m_ctx->canceled())
+                    throw tactic_exception(Z3_CANCELED_MSG);
                 // store the model in a no-op model converter, and filter fresh Booleans
                 if (in->models_enabled()) {
-                    model_ref md;
-                    m_ctx->get_model(md);
-                    buffer<symbol> r;
-                    m_ctx->get_relevant_labels(nullptr, r);
-                    labels_vec rv;
-                    rv.append(r.size(), r.data());
                     model_converter_ref mc;
-                    mc = model_and_labels2model_converter(md.get(), rv);
+                    if (m_lazy_models && !m_user_ctx) {
+                        // hand the kernel and its parameters over to the
+                        // converter; the model is extracted when (and if)
+                        // the converter is applied.
+                        mc = alloc(lazy_smt_model_converter, init.detach(), init.detach_params());
+                    }
+                    else {
+                        model_ref md;
+                        m_ctx->get_model(md);
+                        buffer<symbol> r;
+                        m_ctx->get_relevant_labels(nullptr, r);
+                        labels_vec rv;
+                        rv.append(r.size(), r.data());
+                        mc = model_and_labels2model_converter(md.get(), rv);
+                    }
                     mc = concat(fmc.get(), mc.get());
                     in->add(mc.get());
                 }
-                if (m_ctx->canceled()) 
-                    throw tactic_exception(Z3_CANCELED_MSG);                
                 return;
             }
             case l_false: {
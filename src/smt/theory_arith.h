@@ -956,6 +956,7 @@ namespace smt {
         bool            m_model_depends_on_computed_epsilon;
         unsigned        m_nl_rounds;
         bool            m_nl_gb_exhausted;
+        unsigned_vector m_gb_last_input;   // signature of the last Grobner input that saturated without progress
         unsigned        m_nl_strategy_idx; // for fairness
         expr_ref_vector m_nl_new_exprs;
         typedef obj_map<expr, unsigned> var2num_occs;
@@ -1035,6 +1036,7 @@ namespace smt {
         bool internalize_gb_eq(grobner::equation const * eq);
         enum gb_result { GB_PROGRESS, GB_NEW_EQ, GB_FAIL };
         gb_result compute_grobner(svector<theory_var> const & nl_cluster);
+        void gb_input_signature(grobner & gb, unsigned_vector & sig) const;
         bool compute_basis_loop(grobner & gb);
         void compute_basis(grobner&, bool&);
         void update_statistics(grobner&);
@@ -2239,6 +2239,29 @@ void theory_arith<Ext>::compute_basis(grobner& gb, bool& warn) {
         warn = true;
     }
 }
+/**
+   \brief Signature of the input equations of the Grobner module. Asserted
+   monomials are sorted by the term order, so the signature also reflects the
+   variable order chosen by init_grobner_var_order. Per-equation hashes are
+   sorted since equation sets iterate in allocation order.
+*/
+template<typename Ext>
+void theory_arith<Ext>::gb_input_signature(grobner & gb, unsigned_vector & sig) const {
+    ptr_vector<grobner::equation> eqs;
+    gb.get_equations(eqs);
+    for (grobner::equation const * eq : eqs) {
+        unsigned h = 17;
+        for (unsigned i = 0; i < eq->get_num_monomials(); ++i) {
+            grobner::monomial const * mon = eq->get_monomial(i);
+            h = combine_hash(h, mon->get_coeff().hash());
+            for (unsigned j = 0; j < mon->get_degree(); ++j)
+                h = combine_hash(h, mon->get_var(j)->get_id());
+        }
+        sig.push_back(h);
+    }
+    std::sort(sig.begin(), sig.end());
+}
+
 /**
    \brief Compute Grobner basis, return true if a conflict or new fixed variables were detected.
 */
@@ -2249,6 +2272,16 @@ typename theory_arith<Ext>::gb_result theory_arith<Ext>::compute_grobner(svector
     grobner gb(get_manager(), m_dep_manager);
     init_grobner(nl_cluster, gb);
     TRACE("non_linear", display(tout););
+    // Saturation is deterministic in the input basis. When a final check
+    // re-enters with the same equations, which is common when progress is
+    // driven by other theories, the previous run already saturated without
+    // finding anything and is not repeated.
+    unsigned_vector gb_sig;
+    gb_input_signature(gb, gb_sig);
+    if (gb_sig == m_gb_last_input) {
+        TRACE("grobner", tout << "skipping unchanged grobner input\n";);
+        return GB_FAIL;
+    }
     bool warn            = false;
     unsigned next_weight = MAX_DEFAULT_WEIGHT + 1; // next weight using during perturbation phase.
     ptr_vector<grobner::equation> eqs;    
@@ -2265,8 +2298,11 @@ typename theory_arith<Ext>::gb_result theory_arith<Ext>::compute_grobner(svector
         if (get_gb_eqs_and_look_for_conflict(eqs, gb))
             return GB_PROGRESS;
     }
-    while(scan_for_linear(eqs, gb) && m_params.m_nl_arith_gb_perturbate && 
+    while(scan_for_linear(eqs, gb) && m_params.m_nl_arith_gb_perturbate &&
           (!m_nl_gb_exhausted) && try_to_modify_eqs(eqs, gb, next_weight));
+    // only a completed, progress-free run is recorded; cancelled runs above
+    // return without a signature and are retried.
+    m_gb_last_input = std::move(gb_sig);
     return GB_FAIL;
 }
 
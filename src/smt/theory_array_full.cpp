@@ -35,6 +35,7 @@ namespace smt {
     theory_array_full::~theory_array_full() {
         std::for_each(m_var_data_full.begin(), m_var_data_full.end(), delete_proc<var_data_full>());
         m_var_data_full.reset();
+        reset_spines();
     }
 
     theory* theory_array_full::mk_fresh(context* new_ctx) { 
@@ -215,6 +216,7 @@ namespace smt {
         std::for_each(m_var_data_full.begin(), m_var_data_full.end(), delete_proc<var_data_full>());
         m_var_data_full.reset();
         m_eqs.reset();
+        reset_spines();
     }
 
     void theory_array_full::display_var(std::ostream & out, theory_var v) const {
@@ -386,6 +388,7 @@ namespace smt {
               display_var(tout, v);
               );
         theory_array::add_parent_select(v,s);
+        instantiate_select_store_chain_axiom(s);
         v = find(v);
         var_data_full* d_full = m_var_data_full[v];
         var_data* d = m_var_data[v];
@@ -687,6 +690,78 @@ namespace smt {
     }
 
 
+    theory_array_full::spine_info* theory_array_full::get_spine_info(app* store) {
+        SASSERT(is_store(store));
+        spine_info* info = nullptr;
+        if (m_spines.find(store, info)) {
+            return info;
+        }
+        info = alloc(spine_info);
+        expr* cur = store;
+        while (is_app(cur) && is_store(to_app(cur)) &&
+               to_app(cur)->get_num_args() == 3 &&
+               m.is_unique_value(to_app(cur)->get_arg(1))) {
+            app* frame = to_app(cur);
+            if (!info->m_index2store.contains(frame->get_arg(1))) {
+                info->m_index2store.insert(frame->get_arg(1), frame);
+            }
+            cur = frame->get_arg(0);
+        }
+        info->m_base = cur;
+        m_spines.insert(store, info);
+        return info;
+    }
+
+    void theory_array_full::reset_spines() {
+        for (auto const& kv : m_spines) {
+            dealloc(kv.m_value);
+        }
+        m_spines.reset();
+    }
+
+    //
+    // Assert shortcut axiom over a store chain:
+    // select(store(..store(b, i_1, v_1).., i_n, v_n), j) = select(b', j)
+    // where b' is the outermost frame of the chain storing j, or the base
+    // of the chain if no frame stores j.
+    //
+    // The axiom is valid when j and all skipped indices are unique values:
+    // distinct unique values denote distinct elements. A select over a deep
+    // chain of concrete stores then produces a single axiom instead of one
+    // read-over-write axiom per frame; the skipped frames keep their axioms
+    // delayed and are only expanded through the usual final check.
+    //
+    bool theory_array_full::instantiate_select_store_chain_axiom(enode* sl) {
+        app* select = sl->get_expr();
+        SASSERT(is_select(select));
+        if (select->get_num_args() != 2) {
+            return false;
+        }
+        expr* a = select->get_arg(0);
+        expr* j = select->get_arg(1);
+        if (!is_app(a) || !is_store(to_app(a)) || !m.is_unique_value(j)) {
+            return false;
+        }
+        spine_info* info = get_spine_info(to_app(a));
+        app* frame = nullptr;
+        expr* tgt = info->m_index2store.find(j, frame) ? frame : info->m_base;
+        if (tgt == a || tgt == to_app(a)->get_arg(0)) {
+            // depth <= 1: covered by the ordinary store axioms.
+            return false;
+        }
+        if (!ctx.add_fingerprint(this, m_select_chain_fingerprint, 1, &sl)) {
+            return false;
+        }
+        m_stats.m_num_select_chain_axiom++;
+        expr* args[2] = { tgt, j };
+        expr* sel2 = mk_select(2, args);
+        TRACE("array", tout << "new select-store-chain axiom...\n";
+              tout << "select: " << mk_bounded_pp(select, m) << "\n";
+              tout << "frame:  " << mk_bounded_pp(sel2, m) << "\n";);
+        ctx.internalize(sel2, false);
+        return try_assign_eq(select, sel2);
+    }
+
     //
     // Assert axiom:
     // select(as-array f, i_1, ..., i_n) = (f i_1 ... i_n)
@@ -871,8 +946,9 @@ namespace smt {
         unsigned num_old_vars = get_old_num_vars(num_scopes);
         theory_array::pop_scope_eh(num_scopes);
         std::for_each(m_var_data_full.begin() + num_old_vars, m_var_data_full.end(), delete_proc<var_data_full>());
-        m_var_data_full.shrink(num_old_vars);        
+        m_var_data_full.shrink(num_old_vars);
         m_eqs.reset();
+        reset_spines();
     }
 
     void theory_array_full::collect_statistics(::statistics & st) const {
@@ -883,6 +959,7 @@ namespace smt {
         st.update("array def store", m_stats.m_num_default_store_axiom);
         st.update("array def as-array", m_stats.m_num_default_as_array_axiom);
         st.update("array sel as-array", m_stats.m_num_select_as_array_axiom);
+        st.update("array sel chain", m_stats.m_num_select_chain_axiom);
         st.update("array def lambda", m_stats.m_num_default_lambda_axiom);
     }
 }
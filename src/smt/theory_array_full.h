@@ -43,6 +43,26 @@ namespace smt {
         static unsigned const m_default_const_fingerprint = UINT_MAX - 115;
         static unsigned const m_default_as_array_fingerprint = UINT_MAX - 116;
         static unsigned const m_default_lambda_fingerprint = UINT_MAX - 117;
+        static unsigned const m_select_chain_fingerprint = UINT_MAX - 118;
+
+        // --------------------------------------------------
+        // store chains
+        //
+        // Index over chains of stores whose indices are unique values.
+        // A select with a unique value index binds directly to the
+        // outermost frame of the chain writing that index (or to the
+        // base of the chain) with a single shortcut axiom instead of
+        // one read-over-write axiom per frame. The skipped frames keep
+        // their axioms delayed.
+        // --------------------------------------------------
+        struct spine_info {
+            expr*               m_base = nullptr; // first sub-array that is not a store indexed by a unique value
+            obj_map<expr, app*> m_index2store;    // outermost store frame per index value
+        };
+        obj_map<app, spine_info*> m_spines;
+
+        spine_info* get_spine_info(app* store);
+        void reset_spines();
 
     protected:
 
@@ -89,6 +109,7 @@ namespace smt {
         bool has_non_beta_as_array();
 
         bool instantiate_select_const_axiom(enode* select, enode* cnst);
+        bool instantiate_select_store_chain_axiom(enode* select);
         bool instantiate_select_as_array_axiom(enode* select, enode* arr);
         bool instantiate_select_map_axiom(enode* select, enode* map);
 
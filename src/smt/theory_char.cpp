@@ -398,7 +398,7 @@ namespace smt {
         TRACE("seq", tout << "enforce ackerman " << v << " " << w << "\n";);
         literal eq = mk_literal(m.mk_eq(get_expr(v), get_expr(w)));
         ctx.mark_as_relevant(eq);
-        literal_vector lits;
+        literal_buffer lits;
         init_bits(v);
         init_bits(w);
         auto& a = get_ebits(v);
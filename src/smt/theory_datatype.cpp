@@ -269,6 +269,7 @@ namespace smt {
         ctx.attach_th_var(n, this, r);
         if (is_constructor(n)) {
             d->m_constructor = n;
+            ++m_oc_generation;
             assert_accessor_axioms(n);
         }
         else if (is_update_field(n)) {
@@ -480,14 +481,17 @@ namespace smt {
         force_push();
         int num_vars = get_num_vars();
         final_check_status r = FC_DONE;
-        final_check_st _guard(this); 
+        final_check_st _guard(this);
+        unsigned gen = m_oc_generation;
+        bool recheck = m_oc_checked_generation != gen;
+        m_oc_external_edge = false;
         for (int v = 0; v < num_vars; v++) {
             if (v == static_cast<int>(m_find.find(v))) {
                 enode * node = get_enode(v);
                 sort* s = node->get_sort();
                 if (!m_util.is_datatype(s))
                     continue;
-                if (m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
+                if (recheck && m_util.is_recursive(s) && !oc_cycle_free(node) && occurs_check(node)) {
                     // conflict was detected... 
                     // return...
                     return FC_CONTINUE;
@@ -503,6 +507,8 @@ namespace smt {
                 }
             }
         }
+        if (recheck && !m_oc_external_edge)
+            m_oc_checked_generation = gen;
         return r;
     }
 
@@ -634,14 +640,16 @@ namespace smt {
                 oc_push_stack(arg);
             }
             else if (m_sutil.is_seq(s, se) && m_util.is_datatype(se)) {
+                m_oc_external_edge = true;
                 enode* sibling;
                 for (enode* sarg : get_seq_args(arg, sibling)) {
-                    if (process_arg(sarg)) 
+                    if (process_arg(sarg))
                         return true;
                 }
             }
             else if (m_autil.is_array(s) && m_util.is_datatype(get_array_range(s))) {
-                for (enode* aarg : get_array_args(arg)) 
+                m_oc_external_edge = true;
+                for (enode* aarg : get_array_args(arg))
                     if (process_arg(aarg))
                         return true;
             }
@@ -743,6 +751,8 @@ namespace smt {
         theory::reset_eh();
         m_util.reset();
         m_stats.reset();
+        m_oc_generation = 1;
+        m_oc_checked_generation = 0;
     }
 
     bool theory_datatype::is_shared(theory_var v) const {
@@ -852,6 +862,7 @@ namespace smt {
         // v1 is the new root
         TRACE("datatype", tout << "merging v" << v1 << " v" << v2 << "\n";);
         SASSERT(v1 == static_cast<int>(m_find.find(v1)));
+        ++m_oc_generation;
         var_data * d1 = m_var_data[v1];
         var_data * d2 = m_var_data[v2];
         if (d2->m_constructor != nullptr) {
@@ -940,8 +951,8 @@ namespace smt {
         }
         CTRACE("datatype", d->m_recognizers.empty(), ctx.display(tout););
         SASSERT(!d->m_recognizers.empty());
-        literal_vector lits;
-        enode_pair_vector eqs;
+        literal_buffer lits;
+        enode_pair_buffer eqs;
         ptr_vector<enode>::const_iterator it  = d->m_recognizers.begin();
         ptr_vector<enode>::const_iterator end = d->m_recognizers.end();
         for (unsigned idx = 0; it != end; ++it, ++idx) {
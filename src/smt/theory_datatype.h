@@ -104,6 +104,18 @@ namespace smt {
             ~final_check_st();
         };
 
+        // Incremental acyclicity checking: cycles can only be introduced by
+        // merging datatype classes or attaching a constructor to a class.
+        // m_oc_generation is bumped on each such event; a final check whose
+        // occurs checks all succeed stamps m_oc_checked_generation, and
+        // subsequent final checks at the same generation skip the traversal.
+        // Cycles through arrays and sequences can be created by foreign
+        // theory merges we do not observe, so a pass that explores such
+        // container edges (m_oc_external_edge) is never stamped as checked.
+        unsigned              m_oc_generation = 1;
+        unsigned              m_oc_checked_generation = 0;
+        bool                  m_oc_external_edge = false;
+
         enode * oc_get_cstor(enode * n);
         bool occurs_check(enode * n);
         bool occurs_check_enter(enode * n);
@@ -479,6 +479,7 @@ namespace smt {
         
         numeral new_dist;
         row & t_row                = m_matrix[t];
+        row & s_row                = m_matrix[s];
         typename row::iterator it           = t_row.begin();
         typename row::iterator end          = t_row.end();
         typename f_targets::iterator fbegin = m_f_targets.begin();
@@ -487,7 +488,7 @@ namespace smt {
             if (it->m_edge_id != null_edge_id && x != s) {
                 new_dist    = k;
                 new_dist   += it->m_distance;
-                cell & s_x  = m_matrix[s][x];
+                cell & s_x  = s_row[x];
                 TRACE("ddl", 
                       tout << "s: #" << get_enode(s)->get_owner_id() << " x: #" << get_enode(x)->get_owner_id() << " new_dist: " << new_dist << "\n";
                       tout << "already has edge: " << s_x.m_edge_id << "  old dist: " << s_x.m_distance << "\n";);
@@ -500,7 +501,10 @@ namespace smt {
         }
         
         typename f_targets::iterator fend = target;
-        
+
+        if (fbegin == fend)
+            return;
+
         // For each node y such that y --> s, and for each node x in F,
         // check whether d(y, s) + new_dist(x) < d(y, x).
         typename matrix::iterator it2    = m_matrix.begin();
@@ -511,13 +515,24 @@ namespace smt {
                 cell & c = r[s];
                 if (c.m_edge_id != null_edge_id) {
                     numeral const & d_y_s = c.m_distance;
+                    // The matrix is kept transitively closed, so if
+                    // d(y, s) + k does not improve d(y, t), then for every x in F
+                    // d(y, s) + k + d(t, x) >= d(y, t) + d(t, x) >= d(y, x),
+                    // and the whole row can be skipped.
+                    cell & y_t = r[t];
+                    if (y_t.m_edge_id != null_edge_id) {
+                        new_dist  = d_y_s;
+                        new_dist += k;
+                        if (!(new_dist < y_t.m_distance))
+                            continue;
+                    }
                     target = fbegin;
                     for (; target != fend; ++target) {
                         theory_var x = target->m_target;
                         if (x != y) {
                             new_dist  = d_y_s;
                             new_dist += target->m_new_distance;
-                            cell & y_x = m_matrix[y][x];
+                            cell & y_x = r[x];
                             if (y_x.m_edge_id == null_edge_id || new_dist < y_x.m_distance) {
                                 m_cell_trail.push_back(cell_trail(y, x, y_x.m_edge_id, y_x.m_distance));
                                 y_x.m_edge_id  = new_edge_id;
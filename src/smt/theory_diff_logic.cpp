@@ -27,6 +27,7 @@ namespace smt {
 
 template class theory_diff_logic<idl_ext>;
 template class theory_diff_logic<sidl_ext>;
+template class theory_diff_logic<sidl64_ext>;
 template class theory_diff_logic<rdl_ext>;
 template class theory_diff_logic<srdl_ext>;
 
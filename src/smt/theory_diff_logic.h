@@ -26,6 +26,7 @@ Revision History:
 #include "util/inf_int_rational.h"
 #include "util/s_integer.h"
 #include "util/inf_s_integer.h"
+#include "util/checked_int64.h"
 #include "util/map.h"
 #include "ast/arith_decl_plugin.h"
 #include "model/numeral_factory.h"
@@ -390,6 +391,15 @@ namespace smt {
         numeral m_epsilon { 1 };
     };
 
+    // 64-bit machine integers with overflow checking, for integer problems
+    // whose constant sum is too large for s_integer but fits in int64.
+    struct sidl64_ext {
+        static const bool m_int_theory = true;
+        typedef checked_int64<true> numeral;
+        typedef checked_int64<true> fin_numeral;
+        numeral m_epsilon { 1 };
+    };
+
     struct rdl_ext {
         static const bool m_int_theory = false;
         typedef inf_int_rational numeral;
@@ -405,6 +415,7 @@ namespace smt {
 
     typedef theory_diff_logic<idl_ext>  theory_idl;
     typedef theory_diff_logic<sidl_ext> theory_fidl;
+    typedef theory_diff_logic<sidl64_ext> theory_idl64;
     typedef theory_diff_logic<rdl_ext> theory_rdl;
     typedef theory_diff_logic<srdl_ext> theory_frdl;
 };
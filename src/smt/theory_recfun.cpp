@@ -34,7 +34,8 @@ namespace smt {
           m_util(m_plugin.u()), 
           m_disabled_guards(m),
           m_enabled_guards(m),
-          m_preds(m) {
+          m_preds(m),
+          m_subst(m) {
         }
 
     theory_recfun::~theory_recfun() {
@@ -89,9 +90,10 @@ namespace smt {
         theory::reset_eh();
         m_disabled_guards.reset();
         m_enabled_guards.reset();
-        for (auto & kv : m_guard2pending) 
+        for (auto & kv : m_guard2pending)
             dealloc(kv.m_value);
         m_guard2pending.reset();
+        m_subst.reset();
     }
 
     /*
@@ -226,8 +228,10 @@ namespace smt {
         expr_ref_vector const & args,
         expr * e) {
         SASSERT(is_standard_order(vars));
-        var_subst subst(m, true);
-        expr_ref new_body = subst(e, args);
+        expr ** bindings = m_subst(e, args.size());
+        for (unsigned i = 0; i < args.size(); ++i)
+            bindings[i] = args.get(i);
+        expr_ref new_body = m_subst();
         ctx.get_rewriter()(new_body); // simplify
         set_depth_rec(depth + 1, new_body);
         return new_body;
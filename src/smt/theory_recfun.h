@@ -23,6 +23,7 @@ Revision History:
 #include "smt/smt_context.h"
 #include "ast/ast_pp.h"
 #include "ast/recfun_decl_plugin.h"
+#include "ast/rewriter/cached_var_subst.h"
 
 namespace smt {
 
@@ -45,6 +46,9 @@ namespace smt {
         expr_ref_vector          m_preds;
         unsigned_vector          m_preds_lim;
         unsigned                 m_num_rounds { 0 };
+        // instantiation cache: definitions are unfolded with the same
+        // (body, arguments) combinations over and over across rounds.
+        cached_var_subst         m_subst;
 
         typedef recfun::propagation_item propagation_item;
 
@@ -255,8 +255,7 @@ theory_seq::theory_seq(context& ctx):
     m_eq_id(0),
     m_find(*this),
     m_offset_eq(*this, m),
-    m_overlap_lhs(m),
-    m_overlap_rhs(m),
+    m_overlap_trail(m),
     m_factory(nullptr),
     m_exclude(m),
     m_axioms(m),
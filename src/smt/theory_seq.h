@@ -25,6 +25,7 @@ Revision History:
 #include "ast/ast_trail.h"
 #include "util/scoped_vector.h"
 #include "util/scoped_ptr_vector.h"
+#include "util/map.h"
 #include "ast/rewriter/seq_rewriter.h"
 #include "util/union_find.h"
 #include "util/obj_ref_hashtable.h"
@@ -334,8 +335,21 @@ namespace smt {
         th_union_find              m_find;
         seq_offset_eq              m_offset_eq;
 
-        obj_ref_map<ast_manager, expr, bool>    m_overlap_lhs;
-        obj_ref_map<ast_manager, expr, bool>    m_overlap_rhs;
+        // overlap memo keyed by the equation sides directly (ls ++ nullptr ++ rs),
+        // so cache probes do not construct concatenation and equality terms.
+        struct align_hash {
+            unsigned operator()(ptr_vector<expr> const& v) const {
+                unsigned h = 17;
+                for (expr* e : v)
+                    h = combine_hash(h, e ? e->get_id() : 0);
+                return h;
+            }
+        };
+        typedef map<ptr_vector<expr>, bool, align_hash, default_eq<ptr_vector<expr>>> align_cache;
+        align_cache                m_overlap_lhs;
+        align_cache                m_overlap_rhs;
+        expr_ref_vector            m_overlap_trail; // pins expressions occurring in memo keys
+        ptr_vector<expr>           m_align_key;     // scratch buffer for memo probes
 
 
         seq_factory*               m_factory;    // value factory
@@ -439,6 +453,8 @@ namespace smt {
         bool branch_binary_variable(depeq const& e);
         bool can_align_from_lhs(expr_ref_vector const& ls, expr_ref_vector const& rs);
         bool can_align_from_rhs(expr_ref_vector const& ls, expr_ref_vector const& rs);
+        void mk_align_key(expr_ref_vector const& ls, expr_ref_vector const& rs);
+        void save_align_result(align_cache& table, bool result);
         bool branch_ternary_variable_rhs(depeq const& e);
         bool branch_ternary_variable_lhs(depeq const& e);
         literal mk_alignment(expr* e1, expr* e2);
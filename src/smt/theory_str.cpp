@@ -101,6 +101,8 @@ namespace smt {
         regex_automata.clear();
         for (auto& kv: var_to_char_subterm_map) dealloc(kv.m_value);
         for (auto& kv: uninterpreted_to_char_subterm_map) dealloc(kv.m_value);
+        for (auto& kv: contain_automaton_map) dealloc(kv.second);
+        contain_automaton_map.clear();
     }
 
     void theory_str::init() {
@@ -133,6 +135,8 @@ namespace smt {
         contains_map.reset();
         contain_pair_bool_map.reset();
         contain_pair_idx_map.reset();
+        for (auto& kv: contain_automaton_map) dealloc(kv.second);
+        contain_automaton_map.clear();
 
         m_automata.reset();
         regex_automata.reset();
@@ -1197,6 +1201,23 @@ namespace smt {
         assert_axiom(finalAxiom);
     }
 
+    bool theory_str::const_str_contains(zstring const& haystackStr, zstring const& needleStr) {
+        // for short haystacks the direct scan beats building and probing an index
+        static const unsigned contain_automaton_min_length = 32;
+        if (haystackStr.length() < contain_automaton_min_length || needleStr.length() > haystackStr.length()) {
+            return haystackStr.contains(needleStr);
+        }
+        str_suffix_automaton * aut;
+        auto it = contain_automaton_map.find(haystackStr);
+        if (it != contain_automaton_map.end()) {
+            aut = it->second;
+        } else {
+            aut = alloc(str_suffix_automaton, haystackStr);
+            contain_automaton_map[haystackStr] = aut;
+        }
+        return aut->contains(needleStr);
+    }
+
     void theory_str::instantiate_axiom_Contains(enode * e) {
         ast_manager & m = get_manager();
 
@@ -1212,7 +1233,7 @@ namespace smt {
         zstring haystackStr, needleStr;
         if (u.str.is_string(ex->get_arg(0), haystackStr) && u.str.is_string(ex->get_arg(1), needleStr)) {
             TRACE("str", tout << "eval constant Contains term " << mk_pp(ex, m) << std::endl;);
-            if (haystackStr.contains(needleStr)) {
+            if (const_str_contains(haystackStr, needleStr)) {
                 assert_axiom(ex);
             } else {
                 assert_axiom(mk_not(m, ex));
@@ -4888,7 +4909,7 @@ namespace smt {
 
                         TRACE("t_str_detail", tout << "strConst = " << strConst << ", subStrConst = " << subStrConst << "\n";);
 
-                        if (strConst.contains(subStrConst)) {
+                        if (const_str_contains(strConst, subStrConst)) {
                             //implyR = ctx.mk_eq(ctx, boolVar, Z3_mk_true(ctx));
                             implyR = boolVar;
                         } else {
@@ -4912,7 +4933,7 @@ namespace smt {
                             for (auto const& cst : constList) {
                                 zstring pieceStr;
                                 u.str.is_string(cst, pieceStr);
-                                if (!strConst.contains(pieceStr)) {
+                                if (!const_str_contains(strConst, pieceStr)) {
                                     counterEgFound = true;
                                     if (aConcat != substrAst) {
                                         litems.push_back(ctx.mk_eq_atom(substrAst, aConcat));
@@ -4951,7 +4972,7 @@ namespace smt {
                         zstring strConst, subStrConst;
                         u.str.is_string(strValue, strConst);
                         u.str.is_string(constNode, subStrConst);
-                        if (strConst.contains(subStrConst)) {
+                        if (const_str_contains(strConst, subStrConst)) {
                             //implyR = Z3_mk_eq(ctx, boolVar, Z3_mk_true(ctx));
                             implyR = boolVar;
                         } else {
@@ -5016,7 +5037,7 @@ namespace smt {
                                 for (auto cst : constList) {
                                     zstring pieceStr;
                                     u.str.is_string(cst, pieceStr);
-                                    if (!strConst.contains(pieceStr)) {
+                                    if (!const_str_contains(strConst, pieceStr)) {
                                         TRACE("str", tout << "Inconsistency found!" << std::endl;);
                                         counterEgFound = true;
                                         if (aConcat != substrAst) {
@@ -5609,7 +5630,7 @@ namespace smt {
                 for (size_t i = 0; i < strCnt; i++) {
                     zstring strVal;
                     if (u.str.is_string(strVec[i], strVal)) {
-                        if (strVal.contains(subStrVal)) {
+                        if (const_str_contains(strVal, subStrVal)) {
                             return true;
                         }
                     }
@@ -85,6 +85,74 @@ public:
 // NSB: added operator[] and contains to obj_pair_hashtable
 class theory_str_contain_pair_bool_map_t : public obj_pair_map<expr, expr, expr*> {};
 
+/*
+ * Suffix automaton over a string literal. The automaton recognizes exactly
+ * the substrings of the literal, so a containment query is answered in time
+ * linear in the needle instead of rescanning the haystack for every needle.
+ * theory_str caches one automaton per haystack literal and uses it whenever
+ * the same literal is tested against many candidate substrings.
+ */
+class str_suffix_automaton {
+    struct state {
+        int      m_link;
+        unsigned m_len;
+        std::map<unsigned, int> m_next;
+        state(int link, unsigned len) : m_link(link), m_len(len) {}
+    };
+    std::vector<state> m_states;
+    int m_last;
+
+    void extend(unsigned ch) {
+        int cur = static_cast<int>(m_states.size());
+        m_states.push_back(state(-1, m_states[m_last].m_len + 1));
+        int p = m_last;
+        while (p != -1 && m_states[p].m_next.count(ch) == 0) {
+            m_states[p].m_next[ch] = cur;
+            p = m_states[p].m_link;
+        }
+        if (p == -1) {
+            m_states[cur].m_link = 0;
+        } else {
+            int q = m_states[p].m_next[ch];
+            if (m_states[p].m_len + 1 == m_states[q].m_len) {
+                m_states[cur].m_link = q;
+            } else {
+                int clone = static_cast<int>(m_states.size());
+                state cl = m_states[q];
+                cl.m_len = m_states[p].m_len + 1;
+                m_states.push_back(cl);
+                while (p != -1 && m_states[p].m_next[ch] == q) {
+                    m_states[p].m_next[ch] = clone;
+                    p = m_states[p].m_link;
+                }
+                m_states[q].m_link = clone;
+                m_states[cur].m_link = clone;
+            }
+        }
+        m_last = cur;
+    }
+
+public:
+    str_suffix_automaton(zstring const& s) : m_last(0) {
+        m_states.push_back(state(-1, 0));
+        for (unsigned i = 0; i < s.length(); ++i) {
+            extend(s[i]);
+        }
+    }
+
+    bool contains(zstring const& needle) const {
+        int cur = 0;
+        for (unsigned i = 0; i < needle.length(); ++i) {
+            auto it = m_states[cur].m_next.find(needle[i]);
+            if (it == m_states[cur].m_next.end()) {
+                return false;
+            }
+            cur = it->second;
+        }
+        return true;
+    }
+};
+
 template<typename Ctx>
 class binary_search_trail : public trail {
     obj_map<expr, ptr_vector<expr> > & target;
@@ -435,6 +503,8 @@ protected:
 
     theory_str_contain_pair_bool_map_t contain_pair_bool_map;
     obj_map<expr, std::set<std::pair<expr*, expr*> > > contain_pair_idx_map;
+    // suffix automata over haystack literals, built lazily by const_str_contains()
+    std::map<zstring, str_suffix_automaton*> contain_automaton_map;
 
     // regex automata
     scoped_ptr_vector<eautomaton> m_automata;
@@ -613,6 +683,7 @@ protected:
     bool check_length_concat_var(expr * concat, expr * var);
     bool check_length_var_var(expr * var1, expr * var2);
     void check_contain_in_new_eq(expr * n1, expr * n2);
+    bool const_str_contains(zstring const& haystackStr, zstring const& needleStr);
     void check_contain_by_eqc_val(expr * varNode, expr * constNode);
     void check_contain_by_substr(expr * varNode, expr_ref_vector & willEqClass);
     void check_contain_by_eq_nodes(expr * n1, expr * n2);
@@ -607,6 +607,10 @@ namespace smt {
                                 || (current_assignment == l_false && !aut.get_polarity())) {
                             if (aut_inter == nullptr) {
                                 aut_inter = aut.get_automaton();
+                            } else if (m_mk_aut.is_product_empty(aut_inter, aut.get_automaton()) == l_true) {
+                                // lazy exploration detected emptiness; skip materializing the product
+                                aut_inter = m_mk_aut.mk_empty_automaton();
+                                m_automata.push_back(aut_inter);
                             } else {
                                 aut_inter = m_mk_aut.mk_product(aut_inter, aut.get_automaton());
                                 m_automata.push_back(aut_inter);
@@ -624,6 +628,10 @@ namespace smt {
                             // this discards length information
                             if (aut_inter == nullptr) {
                                 aut_inter = aut_c;
+                            } else if (m_mk_aut.is_product_empty(aut_inter, aut_c) == l_true) {
+                                // lazy exploration detected emptiness; skip materializing the product
+                                aut_inter = m_mk_aut.mk_empty_automaton();
+                                m_automata.push_back(aut_inter);
                             } else {
                                 aut_inter = m_mk_aut.mk_product(aut_inter, aut_c);
                                 m_automata.push_back(aut_inter);
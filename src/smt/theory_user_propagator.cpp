@@ -78,9 +78,12 @@ void theory_user_propagator::add_expr(expr* term, bool ensure_enode) {
 
     ctx.attach_th_var(n, this, v);
     literal_vector explain;
-    if (ctx.is_fixed(n, r, explain))
-        m_prop.push_back(prop_info(explain, v, r));
-    
+    if (ctx.is_fixed(n, r, explain)) {
+        unsigned lits_offset = m_jlit_pool.size();
+        m_jlit_pool.append(explain);
+        m_prop.push_back(prop_info(m_id_pool.size(), m_eq_pool.size(), lits_offset, explain.size(), v, r));
+    }
+
 }
 
 void theory_user_propagator::propagate_cb(
@@ -92,9 +95,14 @@ void theory_user_propagator::propagate_cb(
 
     expr_ref _conseq(conseq, m);
     ctx.get_rewriter()(conseq, _conseq);
-    if (ctx.lit_internalized(_conseq) && ctx.get_assignment(ctx.get_literal(_conseq)) == l_true) 
+    if (ctx.lit_internalized(_conseq) && ctx.get_assignment(ctx.get_literal(_conseq)) == l_true)
         return;
-    m_prop.push_back(prop_info(num_fixed, fixed_ids, num_eqs, eq_lhs, eq_rhs, _conseq));    
+    unsigned ids_offset = m_id_pool.size();
+    m_id_pool.append(num_fixed, fixed_ids);
+    unsigned eqs_offset = m_eq_pool.size();
+    for (unsigned i = 0; i < num_eqs; ++i)
+        m_eq_pool.push_back(std::make_pair(eq_lhs[i], eq_rhs[i]));
+    m_prop.push_back(prop_info(ids_offset, num_fixed, eqs_offset, num_eqs, m_jlit_pool.size(), _conseq));
 }
 
 void theory_user_propagator::register_cb(expr* e) {
@@ -162,7 +170,12 @@ void theory_user_propagator::new_fixed_eh(theory_var v, expr* value, unsigned nu
         return;
     m_fixed.insert(v);
     ctx.push_trail(insert_map<uint_set, unsigned>(m_fixed, v));
-    m_id2justification.setx(v, literal_vector(num_lits, jlits), literal_vector());
+    // reuse the justification buffer of v across re-fixings to avoid
+    // a fresh allocation per fixed event
+    m_id2justification.reserve(v + 1);
+    literal_vector& jlits_v = m_id2justification[v];
+    jlits_v.reset();
+    jlits_v.append(num_lits, jlits);
     try {
          m_fixed_eh(m_user_context, this, var2expr(v), value);
      }
@@ -286,6 +299,13 @@ void theory_user_propagator::pop_scope_eh(unsigned num_scopes) {
         return;
     theory::pop_scope_eh(num_scopes);
     unsigned old_sz = m_prop_lim.size() - num_scopes;
+    if (m_prop_lim[old_sz] < m_prop.size()) {
+        // trim the pools to the state recorded by the first discarded entry
+        prop_info const& p = m_prop[m_prop_lim[old_sz]];
+        m_id_pool.shrink(p.m_ids_offset);
+        m_eq_pool.shrink(p.m_eqs_offset);
+        m_jlit_pool.shrink(p.m_lits_offset);
+    }
     m_prop.shrink(m_prop_lim[old_sz]);
     m_prop_lim.shrink(old_sz);
     old_sz = m_to_add_lim.size() - num_scopes;
@@ -300,20 +320,24 @@ bool theory_user_propagator::can_propagate() {
 
 void theory_user_propagator::propagate_consequence(prop_info const& prop) {
     justification* js;
-    m_lits.reset();   
+    m_lits.reset();
     m_eqs.reset();
-    for (expr* id : prop.m_ids)
-        m_lits.append(m_id2justification[expr2var(id)]);
-    for (auto const& [a,b] : prop.m_eqs)
+    expr* const* ids = m_id_pool.data() + prop.m_ids_offset;
+    auto const* eqs = m_eq_pool.data() + prop.m_eqs_offset;
+    for (unsigned i = 0; i < prop.m_num_ids; ++i)
+        m_lits.append(m_id2justification[expr2var(ids[i])]);
+    for (unsigned i = 0; i < prop.m_num_eqs; ++i) {
+        auto const& [a, b] = eqs[i];
         if (a != b)
             m_eqs.push_back(enode_pair(get_enode(expr2var(a)), get_enode(expr2var(b))));
+    }
     DEBUG_CODE(for (auto const& [a, b] : m_eqs) VERIFY(a->get_root() == b->get_root()););
-    DEBUG_CODE(for (expr* e : prop.m_ids) VERIFY(m_fixed.contains(expr2var(e))););
+    DEBUG_CODE(for (unsigned i = 0; i < prop.m_num_ids; ++i) VERIFY(m_fixed.contains(expr2var(ids[i]))););
     DEBUG_CODE(for (literal lit : m_lits) VERIFY(ctx.get_assignment(lit) == l_true););
-    
+
     TRACE("user_propagate", tout << "propagating #" << prop.m_conseq->get_id() << ": " << prop.m_conseq << "\n";
           for (auto const& [a,b] : m_eqs) tout << enode_pp(a, ctx) << " == " << enode_pp(b, ctx) << "\n";
-          for (expr* e : prop.m_ids) tout << mk_pp(e, m) << "\n";
+          for (unsigned i = 0; i < prop.m_num_ids; ++i) tout << mk_pp(ids[i], m) << "\n";
           for (literal lit : m_lits) tout << lit << "\n");
     
     if (m.is_false(prop.m_conseq)) {
@@ -360,7 +384,11 @@ void theory_user_propagator::propagate_consequence(prop_info const& prop) {
 }
 
 void theory_user_propagator::propagate_new_fixed(prop_info const& prop) {
-    new_fixed_eh(prop.m_var, prop.m_conseq, prop.m_lits.size(), prop.m_lits.data());
+    // copy the justification out of the pool: the push callback invoked from
+    // within new_fixed_eh may register new propagations and relocate the pool
+    m_fixed_lits.reset();
+    m_fixed_lits.append(prop.m_num_lits, m_jlit_pool.data() + prop.m_lits_offset);
+    new_fixed_eh(prop.m_var, prop.m_conseq, m_fixed_lits.size(), m_fixed_lits.data());
 }
 
 
@@ -29,25 +29,38 @@ Notes:
 namespace smt {
     class theory_user_propagator : public theory, public user_propagator::callback {
 
+        // Propagations are recorded as fixed-size entries referencing slices of
+        // shared pools (m_id_pool, m_eq_pool, m_jlit_pool) instead of carrying
+        // their own vectors. The pools follow the scoping of m_prop: every entry
+        // records the pool sizes at the time it was pushed, so popping m_prop
+        // also trims the pools. This keeps the propagation path free of heap
+        // allocation in steady state; with millions of callbacks per query the
+        // per-entry vectors dominated the cost of fixed/eq tracking.
         struct prop_info {
-            ptr_vector<expr>                       m_ids;
+            unsigned                               m_ids_offset;
+            unsigned                               m_num_ids;
+            unsigned                               m_eqs_offset;
+            unsigned                               m_num_eqs;
+            unsigned                               m_lits_offset;
+            unsigned                               m_num_lits;
             expr_ref                               m_conseq;
-            svector<std::pair<expr*, expr*>>       m_eqs;
-            literal_vector                         m_lits;
-            theory_var                             m_var = null_theory_var;            
-            prop_info(unsigned num_fixed, expr* const* fixed_ids,
-                      unsigned num_eqs, expr* const* eq_lhs, expr* const* eq_rhs, expr_ref const& c):
-                m_ids(num_fixed, fixed_ids),
-                m_conseq(c) {
-                for (unsigned i = 0; i < num_eqs; ++i)
-                    m_eqs.push_back(std::make_pair(eq_lhs[i], eq_rhs[i]));
-            }
-            
-            prop_info(literal_vector const& lits, theory_var v, expr_ref const& val):
+            theory_var                             m_var = null_theory_var;
+            prop_info(unsigned ids_offset, unsigned num_ids,
+                      unsigned eqs_offset, unsigned num_eqs,
+                      unsigned lits_offset, expr_ref const& c):
+                m_ids_offset(ids_offset), m_num_ids(num_ids),
+                m_eqs_offset(eqs_offset), m_num_eqs(num_eqs),
+                m_lits_offset(lits_offset), m_num_lits(0),
+                m_conseq(c) {}
+
+            prop_info(unsigned ids_offset, unsigned eqs_offset,
+                      unsigned lits_offset, unsigned num_lits,
+                      theory_var v, expr_ref const& val):
+                m_ids_offset(ids_offset), m_num_ids(0),
+                m_eqs_offset(eqs_offset), m_num_eqs(0),
+                m_lits_offset(lits_offset), m_num_lits(num_lits),
                 m_conseq(val),
-                m_lits(lits),
                 m_var(v) {}
-                
         };
 
         struct stats {
@@ -71,10 +84,14 @@ namespace smt {
         unsigned               m_qhead = 0;
         uint_set               m_fixed;
         vector<prop_info>      m_prop;
+        ptr_vector<expr>                 m_id_pool;   // shared storage for prop_info fixed ids
+        svector<std::pair<expr*, expr*>> m_eq_pool;   // shared storage for prop_info equalities
+        literal_vector                   m_jlit_pool; // shared storage for prop_info justification literals
         unsigned_vector        m_prop_lim;
         vector<literal_vector> m_id2justification;
         unsigned               m_num_scopes = 0;
         literal_vector         m_lits;
+        literal_vector         m_fixed_lits;
         enode_pair_vector      m_eqs;
         stats                  m_stats;
         expr_ref_vector        m_var2expr;
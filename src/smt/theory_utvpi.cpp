@@ -21,6 +21,7 @@ namespace smt {
 
     template class theory_utvpi<idl_ext>;
     template class theory_utvpi<rdl_ext>;
+    template class theory_utvpi<sidl64_ext>;
 
     // similar to test_diff_logic:
 
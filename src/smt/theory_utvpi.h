@@ -358,6 +358,9 @@ namespace smt {
 
     typedef theory_utvpi<rdl_ext>  theory_rutvpi;
     typedef theory_utvpi<idl_ext>  theory_iutvpi;
+    // machine-integer weights for integer problems whose constants are small;
+    // arithmetic is overflow-checked, see sidl64_ext.
+    typedef theory_utvpi<sidl64_ext> theory_iutvpi64;
 };
 
 
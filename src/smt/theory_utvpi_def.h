@@ -438,8 +438,8 @@ namespace smt {
             }
             th_var v1 = to_var(i);
             th_var v2 = neg(v1);
-            rational r1 = m_graph.get_assignment(v1).get_rational();
-            rational r2 = m_graph.get_assignment(v2).get_rational();
+            rational r1 = m_graph.get_assignment(v1).get_rational().to_rational();
+            rational r2 = m_graph.get_assignment(v2).get_rational().to_rational();
             SASSERT(r1.is_int());
             SASSERT(r2.is_int());
             if (r1.is_even() == r2.is_even()) {
@@ -690,8 +690,8 @@ namespace smt {
     bool theory_utvpi<Ext>::is_parity_ok(unsigned i) const {
         th_var v1 = to_var(i);
         th_var v2 = neg(v1);
-        rational r1 = m_graph.get_assignment(v1).get_rational();
-        rational r2 = m_graph.get_assignment(v2).get_rational();
+        rational r1 = m_graph.get_assignment(v1).get_rational().to_rational();
+        rational r2 = m_graph.get_assignment(v2).get_rational().to_rational();
         return r1.is_even() == r2.is_even();
     }
 
@@ -902,7 +902,7 @@ namespace smt {
         numeral val1 = m_graph.get_assignment(to_var(v));
         numeral val2 = m_graph.get_assignment(neg(to_var(v)));
         numeral val = val1 - val2;
-        rational num = val.get_rational() + (m_delta * val.get_infinitesimal().to_rational());
+        rational num = val.get_rational().to_rational() + (m_delta * val.get_infinitesimal().to_rational());
         num = num/rational(2);
         SASSERT(!is_int || num.is_int());
         TRACE("utvpi", 
@@ -939,7 +939,7 @@ namespace smt {
             numeral src = m_graph.get_assignment(m_graph.get_source(i));
             numeral b = tgt - src - w;
             SASSERT(b.is_nonpos());
-            rational eps_r = b.get_infinitesimal();
+            rational eps_r = b.get_infinitesimal().to_rational();
 
             // Given: b <= 0
             // suppose that 0 < b.eps
@@ -949,7 +949,7 @@ namespace smt {
             // <=>
             //      -b.num/b.eps >= delta
             if (eps_r.is_pos()) {
-                rational num_r = -b.get_rational();
+                rational num_r = -b.get_rational().to_rational();
                 SASSERT(num_r.is_pos());
                 rational new_delta = num_r/(4*eps_r);
                 if (new_delta < m_delta) {
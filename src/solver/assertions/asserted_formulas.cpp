@@ -27,6 +27,7 @@ Revision History:
 #include "ast/macros/quasi_macros.h"
 #include "ast/occurs.h"
 #include "ast/bv_decl_plugin.h"
+#include "ast/decl_collector.h"
 #include "solver/assertions/asserted_formulas.h"
 
 
@@ -63,6 +64,7 @@ asserted_formulas::asserted_formulas(ast_manager & m, smt_params & sp, params_re
     m_nnf_cnf(*this),
     m_apply_quasi_macros(*this),
     m_flatten_clauses(*this),
+    m_coi_stratify(*this),
     m_lazy_scopes(0) {
 
     m_macro_finder = alloc(macro_finder, m, m_macro_manager);
@@ -306,6 +308,7 @@ void asserted_formulas::reduce() {
     if (!invoke(m_elim_bvs_from_quantifiers)) return;
     if (!invoke(m_reduce_asserted_formulas)) return;
     if (!invoke(m_flatten_clauses)) return;
+    if (!invoke(m_coi_stratify)) return;
 //    if (!invoke(m_propagate_values)) return;
 
     IF_VERBOSE(10, verbose_stream() << "(smt.simplifier-done :num-exprs " << get_total_size() << ")\n";);
@@ -429,6 +432,72 @@ void asserted_formulas::flatten_clauses() {
     }
 }
 
+/**
+   \brief order the not-yet-internalized assertions goal-first by symbol reachability.
+   The goal stratum consists of the assertions at the last scope level (the final
+   assertion when no scopes are active). Assertions are grouped into strata by
+   breadth-first reachability over shared uninterpreted symbols; unreachable
+   assertions stay asserted but are internalized last. Reordering a conjunction is
+   sound, and when the goal stratum is inconsistent by itself the solver detects
+   the conflict before internalizing the unrelated part of a large prelude.
+*/
+void asserted_formulas::coi_stratify() {
+    unsigned sz = m_formulas.size();
+    unsigned n  = sz - m_qhead;
+    if (n <= 2)
+        return;
+    decl_collector collector(m);
+    obj_map<func_decl, unsigned_vector> sym2fmls;
+    vector<ptr_vector<func_decl>> fml_syms;
+    for (unsigned i = 0; i < n; ++i) {
+        collector.reset();
+        collector.visit(m_formulas[m_qhead + i].get_fml());
+        ptr_vector<func_decl> syms;
+        for (func_decl* f : collector.get_func_decls()) {
+            syms.push_back(f);
+            sym2fmls.insert_if_not_there(f, unsigned_vector()).push_back(i);
+        }
+        fml_syms.push_back(std::move(syms));
+    }
+    unsigned goal_begin = std::max(m_qhead, get_formulas_last_level());
+    if (goal_begin <= m_qhead || goal_begin >= sz)
+        goal_begin = sz - 1;
+    unsigned_vector order;
+    bool_vector reachable(n, false);
+    for (unsigned i = goal_begin - m_qhead; i < n; ++i) {
+        reachable[i] = true;
+        order.push_back(i);
+    }
+    obj_hashtable<func_decl> visited_syms;
+    for (unsigned head = 0; head < order.size(); ++head) {
+        for (func_decl* f : fml_syms[order[head]]) {
+            if (visited_syms.contains(f))
+                continue;
+            visited_syms.insert(f);
+            for (unsigned j : sym2fmls[f]) {
+                if (!reachable[j]) {
+                    reachable[j] = true;
+                    order.push_back(j);
+                }
+            }
+        }
+    }
+    unsigned num_reachable = order.size();
+    for (unsigned i = 0; i < n; ++i)
+        if (!reachable[i])
+            order.push_back(i);
+    bool change = false;
+    for (unsigned i = 0; i < n && !change; ++i)
+        change = order[i] != i;
+    if (!change)
+        return;
+    IF_VERBOSE(10, verbose_stream() << "(smt.coi-stratify :reachable " << num_reachable << " :dormant " << n - num_reachable << ")\n";);
+    vector<justified_expr> new_fmls;
+    for (unsigned i : order)
+        new_fmls.push_back(m_formulas[m_qhead + i]);
+    swap_asserted_formulas(new_fmls);
+}
+
 
 void asserted_formulas::apply_quasi_macros() {
     TRACE("before_quasi_macros", display(tout););
@@ -673,7 +742,7 @@ void asserted_formulas::compute_depth(expr* e) {
     while (!todo.empty()) {
         e = todo.back();
         unsigned d = 0;
-        if (m_expr2depth.contains(e)) {
+        if (m_expr2depth.get(e->get_id(), 0) != 0) {
             todo.pop_back();
             continue;
         }
@@ -681,8 +750,8 @@ void asserted_formulas::compute_depth(expr* e) {
             app* a = to_app(e);
             bool visited = true;
             for (expr* arg : *a) {
-                unsigned d1 = 0;
-                if (m_expr2depth.find(arg, d1)) {
+                unsigned d1 = m_expr2depth.get(arg->get_id(), 0);
+                if (d1 != 0) {
                     d = std::max(d, d1);
                 }
                 else {
@@ -695,7 +764,7 @@ void asserted_formulas::compute_depth(expr* e) {
             }
         }
         todo.pop_back();
-        m_expr2depth.insert(e, d + 1);
+        m_expr2depth.setx(e->get_id(), d + 1, 0);
     }
 }
 
@@ -64,7 +64,7 @@ class asserted_formulas {
         bool                    m_inconsistent_old;
     };
     svector<scope>              m_scopes;
-    obj_map<expr, unsigned>     m_expr2depth;
+    unsigned_vector             m_expr2depth; // expr-id -> depth, 0 for not computed
 
     class simplify_fmls {
     protected:
@@ -181,6 +181,15 @@ class asserted_formulas {
     };
     void flatten_clauses();
 
+    class coi_stratify_fn : public simplify_fmls {
+    public:
+        coi_stratify_fn(asserted_formulas& af): simplify_fmls(af, "coi-stratify") {}
+        void operator()() override { af.coi_stratify(); }
+        bool should_apply() const override { return af.m_smt_params.m_coi_ordering; }
+        void simplify(justified_expr const& j, expr_ref& n, proof_ref& p) override { UNREACHABLE(); }
+    };
+    void coi_stratify();
+
 #define MK_SIMPLIFIERA(NAME, FUNCTOR, MSG, APP, ARG, REDUCE)            \
     class NAME : public simplify_fmls {                                 \
     public:                                                             \
@@ -224,6 +233,7 @@ class asserted_formulas {
     nnf_cnf_fn                  m_nnf_cnf;
     apply_quasi_macros_fn       m_apply_quasi_macros;
     flatten_clauses_fn          m_flatten_clauses;
+    coi_stratify_fn             m_coi_stratify;
     unsigned                    m_lazy_scopes;
 
     void force_push();
@@ -248,7 +258,7 @@ class asserted_formulas {
     bool update_substitution(expr* n, proof* p);
     bool is_gt(expr* lhs, expr* rhs);
     void compute_depth(expr* e);
-    unsigned depth(expr* e) { return m_expr2depth[e]; }
+    unsigned depth(expr* e) { return m_expr2depth.get(e->get_id(), 0); }
 
     void init(unsigned num_formulas, expr * const * formulas, proof * const * prs);
 
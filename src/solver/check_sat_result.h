@@ -43,22 +43,30 @@ protected:
     proof_ref_vector m_log;
     proof_ref        m_proof;
     unsigned    m_ref_count = 0;
-    lbool       m_status = l_undef; 
+    lbool       m_status = l_undef;
     model_converter_ref m_mc0;
+    // model attached directly by the owner (e.g. from a result cache); it
+    // takes precedence over get_model_core and is already converted.
+    model_ref   m_cached_model;
     double      m_time = 0;
 public:
     check_sat_result(ast_manager& m): m(m), m_log(m), m_proof(m) {}
     virtual ~check_sat_result() = default;
     void inc_ref() { m_ref_count++; }
     void dec_ref() { SASSERT(m_ref_count > 0); m_ref_count--; if (m_ref_count == 0) dealloc(this); }
-    lbool set_status(lbool r) { return m_status = r; }
+    lbool set_status(lbool r) { m_cached_model = nullptr; return m_status = r; }
     lbool status() const { return m_status; }
+    void set_cached_model(model* mdl) { m_cached_model = mdl; }
     virtual void collect_statistics(statistics & st) const = 0;
     virtual void get_unsat_core(expr_ref_vector & r) = 0;
     void set_model_converter(model_converter* mc) { m_mc0 = mc; }
     model_converter* mc0() const { return m_mc0.get(); }
     virtual void get_model_core(model_ref & m) = 0;
     void get_model(model_ref & m) {
+        if (m_cached_model) {
+            m = m_cached_model;
+            return;
+        }
         get_model_core(m);
         if (m && mc0()) (*mc0())(m);
     }
@@ -21,11 +21,19 @@ Notes:
 #include "util/scoped_timer.h"
 #include "util/common_msgs.h"
 #include "ast/ast_pp.h"
+#include "ast/static_features.h"
 #include "solver/solver.h"
+#include "solver/combined_solver.h"
 #include "solver/combined_solver_params.hpp"
 #include <atomic>
 #define PS_VB_LVL 15
 
+static combined_solver_cost_fn g_cost_fn = nullptr;
+
+void set_combined_solver_cost_fn(combined_solver_cost_fn fn) {
+    g_cost_fn = fn;
+}
+
 /**
    \brief Implementation of the solver API that combines two given solvers.
 
@@ -158,6 +166,12 @@ public:
         m_solver1->set_produce_models(f);
         m_solver2->set_produce_models(f);
     }
+
+    void set_unsat_core_eh(std::function<void(expr_ref_vector const&)> const& eh) override {
+        solver::set_unsat_core_eh(eh);
+        m_solver1->set_unsat_core_eh(eh);
+        m_solver2->set_unsat_core_eh(eh);
+    }
     
     void assert_expr_core(expr * t) override {
         if (m_check_sat_executed)
@@ -248,6 +262,24 @@ public:
             IF_VERBOSE(PS_VB_LVL, verbose_stream() << "(combined-solver \"solver 2 failed, trying solver1\")\n";);
         }
         
+        if (g_cost_fn && !m_inc_mode) {
+            // An installed scorer overrides the fixed "solver 1 for fresh
+            // queries" strategy: pick the core with the smaller predicted
+            // cost and surface both predictions for external schedulers.
+            static_features ft(get_manager());
+            unsigned sz = get_num_assertions();
+            for (unsigned i = 0; i < sz; i++)
+                ft.collect(get_assertion(i));
+            double c1 = g_cost_fn(ft, 0);
+            double c2 = g_cost_fn(ft, 1);
+            IF_VERBOSE(1, verbose_stream() << "(combined-solver :predicted-cost-solver1 " << c1
+                       << " :predicted-cost-solver2 " << c2 << ")\n";);
+            if (c2 >= 0 && (c1 < 0 || c2 < c1)) {
+                IF_VERBOSE(PS_VB_LVL, verbose_stream() << "(combined-solver \"using solver 2 (predicted cheaper)\")\n";);
+                return m_solver2->check_sat_core(num_assumptions, assumptions);
+            }
+        }
+
         IF_VERBOSE(PS_VB_LVL, verbose_stream() << "(combined-solver \"using solver 1\")\n";);
         m_use_solver1_results = true;
         return m_solver1->check_sat_core(num_assumptions, assumptions);
@@ -24,8 +24,23 @@ Notes:
 
 class solver;
 class solver_factory;
+struct static_features;
 
 solver * mk_combined_solver(solver * s1, solver * s2, params_ref const & p);
 solver_factory * mk_combined_solver_factory(solver_factory * f1, solver_factory * f2);
 
+/**
+   \brief Pluggable query-cost scorer.
+
+   Given the structural features of the asserted formulas, return the
+   predicted cost of solving the query with the given core (0: solver1,
+   the non-incremental core, 1: solver2, the incremental core). A negative
+   result means "no prediction". When a scorer is installed, the combined
+   solver picks the core with the smaller predicted cost for fresh
+   non-incremental queries and reports the predictions in the verbose
+   stream; without one the fixed strategy is unchanged.
+*/
+typedef double (*combined_solver_cost_fn)(static_features const & ft, unsigned solver_idx);
+void set_combined_solver_cost_fn(combined_solver_cost_fn fn);
+
 
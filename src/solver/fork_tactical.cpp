@@ -0,0 +1,398 @@
+/*++
+Copyright (c) 2023 Microsoft Corporation
+
+Module Name:
+
+    fork_tactical.cpp
+
+Abstract:
+
+    Fork-based cube-and-conquer tactic.
+
+    The parent internalizes the problem once and extracts cubes using
+    solver::cube. Each batch of cubes is solved by forked worker
+    processes that share the parent's state copy-on-write, so no
+    serialization of the formula takes place. Workers report per-cube
+    results and learned unit literals over a pipe; unit literals are
+    identified by the ast identifier of their atom, which the parent
+    and the children agree on because the parent pins the atoms of the
+    input problem before forking. A crashing worker only loses the
+    results of its own cubes.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2023-01-20
+
+--*/
+
+#include "util/uint_set.h"
+#include "ast/ast_util.h"
+#include "ast/for_each_expr.h"
+#include "ast/converters/model_converter.h"
+#include "solver/solver.h"
+#include "tactic/tactic.h"
+#include "tactic/tactical.h"
+#include "solver/fork_tactical.h"
+#include "solver/parallel_params.hpp"
+
+class non_fork_tactic : public tactic {
+public:
+    non_fork_tactic(solver* s, params_ref const& p) {
+    }
+
+    char const* name() const override { return "fork_tactic"; }
+
+    void operator()(const goal_ref & g, goal_ref_buffer & result) override {
+        throw default_exception("fork-based solving is only supported on POSIX platforms");
+    }
+    tactic * translate(ast_manager & m) override { return nullptr; }
+    void cleanup() override {}
+};
+
+#ifdef _WINDOWS
+
+tactic * mk_fork_tactic(solver* s, params_ref const& p) {
+    return alloc(non_fork_tactic, s, p);
+}
+
+#else
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <errno.h>
+
+class fork_tactic : public tactic {
+
+    // Pipe protocol: fixed size records of three words.
+    static const unsigned MSG_RESULT = 0; // m_arg1 = cube index, m_arg2 = lbool + 1
+    static const unsigned MSG_UNIT   = 1; // m_arg1 = atom identifier, m_arg2 = sign
+
+    struct msg {
+        unsigned m_tag;
+        unsigned m_arg1;
+        unsigned m_arg2;
+    };
+
+    solver_ref  m_solver;
+    params_ref  m_params;
+    std::string m_reason_undef;
+
+    static bool write_msg(int fd, msg const& m) {
+        char const* p = reinterpret_cast<char const*>(&m);
+        size_t todo = sizeof(m);
+        while (todo > 0) {
+            ssize_t n = write(fd, p, todo);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            p += n;
+            todo -= n;
+        }
+        return true;
+    }
+
+    static bool read_msg(int fd, msg& m) {
+        char* p = reinterpret_cast<char*>(&m);
+        size_t todo = sizeof(m);
+        while (todo > 0) {
+            ssize_t n = read(fd, p, todo);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            if (n == 0)
+                return false;
+            p += n;
+            todo -= n;
+        }
+        return true;
+    }
+
+    /**
+       Collect the Boolean sub-terms of the input problem, indexed by ast
+       identifier. The identifier of a pinned ast is never recycled, so a
+       child process and the parent assign the same meaning to every
+       identifier in the table, regardless of the terms the child creates
+       while solving.
+    */
+    static void collect_atoms(ast_manager& m, expr_ref_vector const& clauses, u_map<expr*>& atoms, expr_ref_vector& pinned) {
+        struct proc {
+            ast_manager&     m;
+            u_map<expr*>&    m_atoms;
+            expr_ref_vector& m_pinned;
+            proc(ast_manager& m, u_map<expr*>& atoms, expr_ref_vector& pinned):
+                m(m), m_atoms(atoms), m_pinned(pinned) {}
+            void operator()(app* a) {
+                if (m.is_bool(a) && !m.is_true(a) && !m.is_false(a)) {
+                    m_atoms.insert(a->get_id(), a);
+                    m_pinned.push_back(a);
+                }
+            }
+            void operator()(ast* a) {}
+        };
+        proc p(m, atoms, pinned);
+        expr_fast_mark1 visited;
+        for (expr* f : clauses)
+            quick_for_each_expr(p, visited, f);
+    }
+
+    /**
+       Worker body. Solves every stride'th cube of the batch, reporting
+       unit literals learned over pinned atoms before each result. Runs in
+       the forked child; must not return into the parent's control flow.
+    */
+    static void run_child(solver& s, vector<expr_ref_vector> const& cubes, unsigned w, unsigned stride, u_map<expr*> const& atoms, int fd) {
+        ast_manager& m = s.get_manager();
+        uint_set sent;
+        for (unsigned i = w; i < cubes.size(); i += stride) {
+            lbool r = s.check_sat(cubes[i]);
+            expr_ref_vector units = s.get_units();
+            for (expr* u : units) {
+                unsigned sign = 0;
+                expr* a = u;
+                if (m.is_not(u)) {
+                    a = to_app(u)->get_arg(0);
+                    sign = 1;
+                }
+                expr* b = nullptr;
+                if (!atoms.find(a->get_id(), b) || b != a)
+                    continue;
+                if (sent.contains(a->get_id()))
+                    continue;
+                sent.insert(a->get_id());
+                if (!write_msg(fd, msg{ MSG_UNIT, a->get_id(), sign }))
+                    return;
+            }
+            if (!write_msg(fd, msg{ MSG_RESULT, i, static_cast<unsigned>(r + 1) }))
+                return;
+            if (r == l_true)
+                return;
+        }
+    }
+
+    /**
+       Fork workers over a batch of cubes and aggregate their verdicts.
+       Units reported by children are asserted into the parent's solver;
+       they are consequences of the input problem, so they strengthen
+       later batches soundly. Returns l_true if a satisfiable cube was
+       found and re-checked in the parent (for the model), l_undef
+       otherwise; cubes without a l_false verdict set has_undef.
+    */
+    lbool conquer_batch(ast_manager& m, solver& s, vector<expr_ref_vector> const& cubes, unsigned num_workers,
+                        u_map<expr*> const& atoms, bool& has_undef, model_ref& mdl) {
+        unsigned n = std::min(num_workers, cubes.size());
+        svector<int>   fds;
+        svector<pid_t> pids;
+        for (unsigned w = 0; w < n; ++w) {
+            int fd[2];
+            if (pipe(fd) != 0)
+                throw default_exception("failed to create pipe for fork-based solving");
+            pid_t pid = fork();
+            if (pid < 0) {
+                close(fd[0]);
+                close(fd[1]);
+                for (unsigned j = 0; j < fds.size(); ++j)
+                    close(fds[j]);
+                throw default_exception("failed to fork cube worker");
+            }
+            if (pid == 0) {
+                close(fd[0]);
+                try {
+                    run_child(s, cubes, w, n, atoms, fd[1]);
+                }
+                catch (...) {
+                }
+                close(fd[1]);
+                _exit(0);
+            }
+            close(fd[1]);
+            fds.push_back(fd[0]);
+            pids.push_back(pid);
+        }
+
+        svector<lbool>  results(cubes.size(), l_undef);
+        expr_ref_vector units(m);
+        for (unsigned w = 0; w < n; ++w) {
+            msg r;
+            while (read_msg(fds[w], r)) {
+                switch (r.m_tag) {
+                case MSG_RESULT:
+                    if (r.m_arg1 < results.size())
+                        results[r.m_arg1] = static_cast<lbool>(static_cast<int>(r.m_arg2) - 1);
+                    break;
+                case MSG_UNIT: {
+                    expr* a = nullptr;
+                    if (atoms.find(r.m_arg1, a))
+                        units.push_back(r.m_arg2 ? mk_not(m, a) : a);
+                    break;
+                }
+                default:
+                    break;
+                }
+            }
+            close(fds[w]);
+        }
+        for (unsigned w = 0; w < n; ++w) {
+            int status = 0;
+            if (waitpid(pids[w], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+                // the worker crashed or was killed; its unreported cubes stay undef.
+                IF_VERBOSE(1, verbose_stream() << "(tactic.fork :worker " << w << " :status abnormal)\n";);
+            }
+        }
+
+        for (expr* u : units)
+            s.assert_expr(u);
+        IF_VERBOSE(2, verbose_stream() << "(tactic.fork :cubes " << cubes.size() << " :units " << units.size() << ")\n";);
+
+        for (unsigned i = 0; i < results.size(); ++i) {
+            if (results[i] != l_true)
+                continue;
+            // models do not survive the process boundary; re-check the
+            // satisfiable cube in the parent to reconstruct one.
+            lbool r = s.check_sat(cubes[i]);
+            if (r == l_true) {
+                s.get_model(mdl);
+                return l_true;
+            }
+            has_undef = true;
+        }
+        for (unsigned i = 0; i < results.size(); ++i)
+            if (results[i] == l_undef)
+                has_undef = true;
+        return l_undef;
+    }
+
+    lbool solve(ast_manager& m, solver& cuber, solver& worker, u_map<expr*> const& atoms, model_ref& mdl) {
+        parallel_params pp(m_params);
+        unsigned num_workers = pp.fork_workers();
+        if (num_workers == 0) {
+            long nproc = sysconf(_SC_NPROCESSORS_ONLN);
+            num_workers = nproc > 0 ? static_cast<unsigned>(nproc) : 1;
+            num_workers = std::min(num_workers, pp.threads_max());
+        }
+        num_workers = std::max(1u, num_workers);
+        unsigned batch_size = std::max(1u, pp.conquer_batch_size());
+
+        expr_ref_vector vars(m);
+        vector<expr_ref_vector> cubes;
+        bool closed = false;
+        bool has_undef = false;
+
+        while (!closed) {
+            if (!m.inc())
+                return l_undef;
+            cubes.reset();
+            while (cubes.size() < batch_size) {
+                expr_ref_vector c = cuber.cube(vars, UINT_MAX);
+                if (c.empty()) {
+                    // the cuber gave up; the uncovered part of the search space is unknown.
+                    has_undef = true;
+                    closed = true;
+                    break;
+                }
+                if (m.is_false(c.back())) {
+                    closed = true;
+                    break;
+                }
+                if (c.size() == 1 && m.is_true(c.back())) {
+                    // no case split is available; solve the remainder in the parent.
+                    lbool r = worker.check_sat(0, nullptr);
+                    if (r == l_true) {
+                        worker.get_model(mdl);
+                        return l_true;
+                    }
+                    if (r == l_undef)
+                        has_undef = true;
+                    closed = true;
+                    break;
+                }
+                cubes.push_back(c);
+            }
+            if (cubes.empty())
+                break;
+            if (l_true == conquer_batch(m, worker, cubes, num_workers, atoms, has_undef, mdl))
+                return l_true;
+        }
+        if (has_undef) {
+            m_reason_undef = "fork workers returned unknown";
+            return l_undef;
+        }
+        return l_false;
+    }
+
+public:
+
+    fork_tactic(solver* s, params_ref const& p):
+        m_solver(s),
+        m_params(p) {
+    }
+
+    char const* name() const override { return "fork_tactic"; }
+
+    void operator()(const goal_ref & g, goal_ref_buffer & result) override {
+        fail_if_proof_generation("fork-tactic", g);
+        fail_if_unsat_core_generation("fork-tactic", g);
+        ast_manager& m = g->m();
+        if (m.has_trace_stream())
+            throw default_exception("fork tactic does not work with trace");
+        m_reason_undef.clear();
+
+        expr_ref_vector clauses(m);
+        for (unsigned i = 0; i < g->size(); ++i)
+            clauses.push_back(g->form(i));
+
+        // separate solvers for cubing and conquering: check-sat calls
+        // would otherwise invalidate the cube enumeration state.
+        solver_ref cuber = m_solver->translate(m, m_params);
+        solver_ref worker = m_solver->translate(m, m_params);
+        for (expr* f : clauses) {
+            cuber->assert_expr(f);
+            worker->assert_expr(f);
+        }
+
+        u_map<expr*>    atoms;
+        expr_ref_vector pinned(m);
+        collect_atoms(m, clauses, atoms, pinned);
+
+        model_ref mdl;
+        lbool is_sat = solve(m, *cuber.get(), *worker.get(), atoms, mdl);
+        switch (is_sat) {
+        case l_true:
+            g->reset();
+            if (g->models_enabled())
+                g->add(model2model_converter(mdl.get()));
+            break;
+        case l_false:
+            g->assert_expr(m.mk_false());
+            break;
+        case l_undef:
+            if (!m.inc())
+                throw tactic_exception(Z3_CANCELED_MSG);
+            if (!m_reason_undef.empty())
+                throw tactic_exception(m_reason_undef.c_str());
+            break;
+        }
+        result.push_back(g.get());
+    }
+
+    void cleanup() override {}
+
+    tactic* translate(ast_manager& m) override {
+        solver* s = m_solver->translate(m, m_params);
+        return alloc(fork_tactic, s, m_params);
+    }
+
+    void updt_params(params_ref const & p) override {
+        m_params.copy(p);
+    }
+};
+
+tactic * mk_fork_tactic(solver* s, params_ref const& p) {
+    return alloc(fork_tactic, s, p);
+}
+
+#endif
@@ -0,0 +1,23 @@
+/*++
+Copyright (c) 2023 Microsoft Corporation
+
+Module Name:
+
+    fork_tactical.h
+
+Abstract:
+
+    Fork-based cube-and-conquer tactic. Workers are forked processes
+    sharing the parent's internalized state copy-on-write.
+
+Author:
+
+    Nikolaj Bjorner (nbjorner) 2023-01-20
+
+--*/
+#pragma once
+
+class tactic;
+class solver;
+
+tactic * mk_fork_tactic(solver* s, params_ref const& p);
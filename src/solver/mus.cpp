@@ -38,6 +38,7 @@ struct mus::imp {
     expr_ref_vector          m_soft;
     vector<rational>         m_weights;
     rational                 m_weight;
+    std::function<void(expr_ref_vector const&)> m_core_callback;
 
     imp(solver& s): 
         m_solver(s), m(s.get_manager()), m_lit2expr(m),  m_assumptions(m), m_soft(m)
@@ -67,6 +68,23 @@ struct mus::imp {
         m_assumptions.push_back(lit);
     }
 
+    void set_core_callback(std::function<void(expr_ref_vector const&)> const& cb) {
+        m_core_callback = cb;
+    }
+
+    // mus + unknown is an unsat core at every iteration of get_mus1.
+    // Report it whenever it became strictly smaller than the last
+    // reported core, so consumers can overlap their own processing
+    // with the remaining minimization.
+    void report_core(expr_ref_vector const& mus, ptr_vector<expr> const& unknown, unsigned& last_reported) {
+        if (!m_core_callback || mus.size() + unknown.size() >= last_reported)
+            return;
+        last_reported = mus.size() + unknown.size();
+        expr_ref_vector core(mus);
+        core.append(unknown.size(), unknown.data());
+        m_core_callback(core);
+    }
+
     lbool get_mus(expr_ref_vector& mus) {
         m_model.reset();
         mus.reset();
@@ -80,8 +98,9 @@ struct mus::imp {
     lbool get_mus1(expr_ref_vector& mus) {
         ptr_vector<expr> unknown(m_lit2expr.size(), m_lit2expr.data());
         expr_ref_vector core_exprs(m);
+        unsigned last_reported = unknown.size();
         TRACE("mus", m_solver.display(tout););
-        while (!unknown.empty()) { 
+        while (!unknown.empty()) {
             IF_VERBOSE(12, verbose_stream() << "(mus reducing core: " << unknown.size() << " new core: " << mus.size() << ")\n";);
             TRACE("mus", display_vec(tout << "core:  ", unknown); display_vec(tout << "mus:   ", mus););
             expr* lit = unknown.back();
@@ -120,6 +139,7 @@ struct mus::imp {
                 }
                 break;
             }
+            report_core(mus, unknown, last_reported);
         }
         // SASSERT(is_core(mus));
         return l_true;
@@ -364,6 +384,10 @@ void mus::add_assumption(expr* lit) {
     return m_imp->add_assumption(lit);
 }
 
+void mus::set_core_callback(std::function<void(expr_ref_vector const&)> const& cb) {
+    m_imp->set_core_callback(cb);
+}
+
 
 lbool mus::get_mus(expr_ref_vector& mus) {
     return m_imp->get_mus(mus);
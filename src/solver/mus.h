@@ -18,6 +18,8 @@ Notes:
 --*/
 #pragma once
 
+#include <functional>
+
 class mus {
     struct imp;
     imp * m_imp;
@@ -46,8 +48,16 @@ class mus {
      */
     void add_assumption(expr* lit);
 
+    /**
+       Register a callback that is invoked with every strictly smaller
+       candidate core encountered while get_mus runs. Each reported vector
+       is an unsat core (modulo the added assumptions), so consumers can
+       process it while minimization proceeds.
+    */
+    void set_core_callback(std::function<void(expr_ref_vector const&)> const& cb);
+
     lbool get_mus(expr_ref_vector& mus);
-    
+
     void reset();
     
     /**
@@ -29,6 +29,7 @@ Notes:
 --*/
 
 #include "util/scoped_ptr_vector.h"
+#include "util/thread_affinity.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_util.h"
 #include "ast/ast_translation.h"
@@ -37,6 +38,7 @@ Notes:
 #include "tactic/tactic.h"
 #include "tactic/tactical.h"
 #include "solver/parallel_tactical.h"
+#include "solver/fork_tactical.h"
 #include "solver/parallel_params.hpp"
 
 
@@ -58,6 +60,9 @@ public:
 #ifdef SINGLE_THREAD
 
 tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
+    parallel_params pp(p);
+    if (pp.fork_enable())
+        return mk_fork_tactic(s, p);
     return alloc(non_parallel_tactic, s, p);
 }
 
@@ -733,11 +738,15 @@ private:
         s.collect_statistics(m_stats);
     }
 
-    lbool solve(model_ref& mdl) {        
+    lbool solve(model_ref& mdl) {
         add_branches(1);
+        parallel_params pp(m_params);
         vector<std::thread> threads;
-        for (unsigned i = 0; i < m_num_threads; ++i) 
+        for (unsigned i = 0; i < m_num_threads; ++i) {
             threads.push_back(std::thread([this]() { run_solver(); }));
+            if (pp.threads_affinity())
+                set_thread_affinity(threads.back(), i);
+        }
         for (std::thread& t : threads) 
             t.join();
         m_queue.stats(m_stats);
@@ -873,6 +882,9 @@ public:
 
 
 tactic * mk_parallel_tactic(solver* s, params_ref const& p) {
+    parallel_params pp(p);
+    if (pp.fork_enable())
+        return mk_fork_tactic(s, p);
     return alloc(parallel_tactic, s, p);
 }
 
@@ -19,6 +19,7 @@ Notes:
 #include "util/common_msgs.h"
 #include "util/stopwatch.h"
 #include "ast/ast_util.h"
+#include "ast/ast_translation.h"
 #include "ast/ast_pp.h"
 #include "ast/ast_pp_util.h"
 #include "ast/display_dimacs.h"
@@ -27,6 +28,9 @@ Notes:
 #include "params/solver_params.hpp"
 #include "model/model_evaluator.h"
 #include "model/model_params.hpp"
+#ifndef SINGLE_THREAD
+#include <thread>
+#endif
 
 
 unsigned solver::get_num_assertions() const {
@@ -311,8 +315,50 @@ expr_ref_vector solver::get_non_units() {
 }
 
 
+unsigned solver::goal_fingerprint(unsigned num_assumptions, expr * const * assumptions) const {
+    // sum the structural hashes so that the fingerprint does not depend
+    // on the order of assertions or assumptions.
+    unsigned num_assertions = get_num_assertions();
+    unsigned h_asserted = 0, h_assumed = 0;
+    for (unsigned i = 0; i < num_assertions; ++i)
+        h_asserted += get_assertion(i)->hash();
+    for (unsigned i = 0; i < num_assumptions; ++i)
+        h_assumed += assumptions[i]->hash();
+    return combine_hash(h_asserted, combine_hash(h_assumed, num_assertions + num_assumptions));
+}
+
+void solver::goal_key(unsigned num_assumptions, expr * const * assumptions, expr_ref_vector & goal) const {
+    unsigned num_assertions = get_num_assertions();
+    for (unsigned i = 0; i < num_assertions; ++i)
+        goal.push_back(get_assertion(i));
+    for (unsigned i = 0; i < num_assumptions; ++i)
+        goal.push_back(assumptions[i]);
+    std::sort(goal.data(), goal.data() + goal.size(), ast_lt_proc());
+}
+
 lbool solver::check_sat(unsigned num_assumptions, expr * const * assumptions) {
     lbool r = l_undef;
+    unsigned fingerprint = 0;
+    expr_ref_vector goal(get_manager());
+    // verdicts are cached without proofs or unsat cores, so do not
+    // serve or record them when a caller could ask for those.
+    bool use_cache = m_result_cache && !get_manager().proofs_enabled();
+    if (use_cache) {
+        fingerprint = goal_fingerprint(num_assumptions, assumptions);
+        goal_key(num_assumptions, assumptions, goal);
+        model_ref mdl;
+        r = m_result_cache->find(fingerprint, goal, mdl);
+        // a l_true verdict is only usable when the model to hand back was
+        // cached with it, and a l_false verdict only when no unsat core
+        // can be requested.
+        if ((r == l_true && mdl) || (r == l_false && num_assumptions == 0)) {
+            set_status(r);
+            set_cached_model(mdl.get());
+            return r;
+        }
+        r = l_undef;
+    }
+    set_cached_model(nullptr);
     scoped_solver_time _st(*this);
     try {
         r = check_sat_core(num_assumptions, assumptions);
@@ -324,11 +370,71 @@ lbool solver::check_sat(unsigned num_assumptions, expr * const * assumptions) {
         throw;
     }
     if (r == l_undef && !get_manager().inc()) {
-        dump_state(num_assumptions, assumptions);        
+        dump_state(num_assumptions, assumptions);
+    }
+    if (use_cache && (r == l_true || (r == l_false && num_assumptions == 0))) {
+        model_ref mdl;
+        if (r == l_true)
+            get_model(mdl);
+        m_result_cache->insert(fingerprint, goal, r, mdl.get());
     }
     return r;
 }
 
+void solver::check_sat_batch(expr_ref_vector const& goals, svector<lbool>& results, unsigned num_threads) {
+    results.reset();
+    results.resize(goals.size(), l_undef);
+#ifndef SINGLE_THREAD
+    if (num_threads > 1 && goals.size() > 1) {
+        num_threads = std::min(num_threads, goals.size());
+        ast_manager& m = get_manager();
+        ptr_vector<ast_manager> managers;
+        sref_vector<solver> workers;
+        vector<expr_ref_vector> worker_goals;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            ast_manager* new_m = alloc(ast_manager, m, true);
+            managers.push_back(new_m);
+            workers.push_back(translate(*new_m, params_ref()));
+            ast_translation tr(m, *new_m);
+            expr_ref_vector gs(*new_m);
+            for (expr* g : goals)
+                gs.push_back(tr(g));
+            worker_goals.push_back(gs);
+        }
+        vector<std::thread> threads;
+        for (unsigned t = 0; t < num_threads; ++t) {
+            threads.push_back(std::thread([&, t]() {
+                solver& w = *workers[t];
+                for (unsigned i = t; i < goals.size(); i += num_threads) {
+                    try {
+                        w.push();
+                        w.assert_expr(worker_goals[t].get(i));
+                        results[i] = w.check_sat();
+                        w.pop(1);
+                    }
+                    catch (...) {
+                        // leave results[i] at l_undef; the worker may be
+                        // in an unusable state, stop handing it goals.
+                        break;
+                    }
+                }
+            }));
+        }
+        for (std::thread& th : threads)
+            th.join();
+        workers.reset();
+        std::for_each(managers.begin(), managers.end(), delete_proc<ast_manager>());
+        return;
+    }
+#endif
+    for (unsigned i = 0; i < goals.size(); ++i) {
+        push();
+        assert_expr(goals.get(i));
+        results[i] = check_sat();
+        pop(1);
+    }
+}
+
 void solver::dump_state(unsigned sz, expr* const* assumptions) {
     if ((symbol::null != m_cancel_backup_file) &&
         !m_cancel_backup_file.is_numerical() && 
@@ -35,6 +35,35 @@ public:
 
 solver_factory * mk_smt_strategic_solver_factory(symbol const & logic = symbol::null);
 
+/**
+   \brief Pluggable cache for check-sat results. The key is the goal itself:
+   the assertions and assumptions sorted by term identifier, so two queries
+   over the same goal multiset produce identical key vectors. The
+   fingerprint (\sa solver::goal_fingerprint) is a hash of the key provided
+   for cheap bucketing only — equal fingerprints do NOT imply equal goals,
+   and implementations must compare the goal vectors exactly before
+   reporting a hit. The cache is owned by the client that installs it, must
+   outlive the solver, and is only usable with solvers sharing its
+   ast_manager.
+*/
+class solver_result_cache {
+public:
+    virtual ~solver_result_cache() = default;
+
+    /**
+       \brief Retrieve the cached verdict for \c goal, which must compare
+       equal (element-wise) to the stored key vector. Return l_undef on a
+       miss. On a l_true hit \c mdl may be set to the cached model (or left
+       null when no model was stored).
+    */
+    virtual lbool find(unsigned fingerprint, expr_ref_vector const& goal, model_ref& mdl) = 0;
+
+    /**
+       \brief Record verdict \c r for \c goal. \c mdl may be null.
+    */
+    virtual void insert(unsigned fingerprint, expr_ref_vector const& goal, lbool r, model* mdl) = 0;
+};
+
 solver* mk_smt2_solver(ast_manager& m, params_ref const& p, symbol const& logic = symbol::null);
 
 /**
@@ -51,6 +80,8 @@ solver* mk_smt2_solver(ast_manager& m, params_ref const& p, symbol const& logic
 class solver : public check_sat_result, public user_propagator::core {
     params_ref  m_params;
     symbol      m_cancel_backup_file;
+    std::function<void(expr_ref_vector const&)> m_unsat_core_eh;
+    solver_result_cache* m_result_cache = nullptr;
 public:
     solver(ast_manager& m): check_sat_result(m) {}
 
@@ -157,6 +188,32 @@ public:
 
     lbool check_sat(unsigned num_assumptions, expr * const * assumptions);
 
+    /**
+       \brief Canonical fingerprint of the current goal: the assertion stack
+       together with the given assumptions. It is invariant under assertion
+       reordering (hashes are combined commutatively) and under renaming of
+       bound variables (structural hashes use de-Bruijn indices). Renamed
+       free constants hash differently.
+    */
+    unsigned goal_fingerprint(unsigned num_assumptions, expr * const * assumptions) const;
+
+    /**
+       \brief Canonical cache key of the current goal: the assertions
+       followed by the assumptions, sorted by term identifier. Equal goal
+       multisets produce identical key vectors within one ast_manager.
+    */
+    void goal_key(unsigned num_assumptions, expr * const * assumptions, expr_ref_vector & goal) const;
+
+    /**
+       \brief Install a result cache consulted by check_sat before invoking
+       the solver and updated with definite verdicts. Pass nullptr to
+       detach. The cache is bypassed when proofs are enabled and for
+       unsatisfiable verdicts under assumptions, where callers may demand a
+       proof or an unsat core that the cache does not store.
+       \sa solver_result_cache.
+    */
+    void set_result_cache(solver_result_cache* c) { m_result_cache = c; }
+
     lbool check_sat(expr_ref_vector const& asms) { return check_sat(asms.size(), asms.data()); }
     
     lbool check_sat(app_ref_vector const& asms) { return check_sat(asms.size(), (expr* const*)asms.data()); }
@@ -175,13 +232,35 @@ public:
         return l_undef;
     }
 
+    /**
+       \brief Check each goal in \c goals against the shared prelude on the
+       current assertion stack. The prelude is internalized and preprocessed
+       once; each goal is checked in its own backtracking scope so only the
+       per-goal state is rebuilt between checks. With num_threads > 1 the
+       solver is cloned per thread via translate and goals are distributed
+       over the clones. results[i] is the verdict for goals[i]; models and
+       cores are not retained across the batch.
+    */
+    virtual void check_sat_batch(expr_ref_vector const& goals, svector<lbool>& results, unsigned num_threads = 1);
+
     /**
        \brief Set a progress callback procedure that is invoked by this solver during check_sat.
-       
+
        This is essentially for backward compatibility and integration with VCC tools.
     */
     virtual void set_progress_callback(progress_callback * callback) = 0;
-    
+
+    /**
+       \brief Set a callback that is invoked with every strictly smaller
+       intermediate core produced while get_unsat_core minimizes the core
+       (\c core.minimize). Consumers can start acting on a partial core
+       while the remaining minimization is still running. The final,
+       minimal core is returned by get_unsat_core as usual.
+    */
+    virtual void set_unsat_core_eh(std::function<void(expr_ref_vector const&)> const& eh) { m_unsat_core_eh = eh; }
+
+    std::function<void(expr_ref_vector const&)> const& unsat_core_eh() const { return m_unsat_core_eh; }
+
     /**
        \brief Return the number of assertions in the assertion stack.
     */
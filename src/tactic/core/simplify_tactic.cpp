@@ -49,6 +49,10 @@ struct simplify_tactic::imp {
             return;
         expr_ref   new_curr(m());
         proof_ref  new_pr(m());
+        // One bulk construction scope for the whole goal: the per-formula
+        // scopes opened by th_rewriter nest inside it, so the candidate arena
+        // is recycled once per goal instead of once per formula.
+        ast_manager::scoped_bulk bulk(m());
         unsigned size = g.size();
         for (unsigned idx = 0; idx < size; idx++) {
             if (g.inconsistent())
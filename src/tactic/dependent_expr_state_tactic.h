@@ -18,6 +18,7 @@ Author:
 #pragma once
 #include "tactic/tactic.h"
 #include "ast/simplifiers/dependent_expr_state.h"
+#include "ast/simplifiers/seq_simplifier.h"
 
 class dependent_expr_state_tactic : public tactic, public dependent_expr_state {
 public:
@@ -29,14 +30,21 @@ private:
     goal_ref        m_goal;
     dependent_expr  m_dep;
     statistics      m_st;
-    factoryTy       m_factory;
+    svector<factoryTy> m_factories;
     expr_ref_vector m_frozen;
     scoped_ptr<dependent_expr_simplifier>   m_simp;
     scoped_ptr<model_reconstruction_trail>  m_model_trail;
 
     void init() {
         if (!m_simp) {
-            m_simp = m_factory(m, m_params, *this);
+            if (m_factories.size() == 1)
+                m_simp = m_factories[0](m, m_params, *this);
+            else {
+                seq_simplifier* seq = alloc(seq_simplifier, m, m_params, *this);
+                for (auto f : m_factories)
+                    seq->add_simplifier(f(m, m_params, *this));
+                m_simp = seq;
+            }
             m_st.reset();
             push();
             for (expr* e : m_frozen)
@@ -53,10 +61,44 @@ public:
         m(m),
         m_params(p),
         m_dep(m, m.mk_true(), nullptr, nullptr),
-        m_factory(f),
+        m_frozen(m)
+    {
+        m_factories.push_back(f);
+    }
+
+    dependent_expr_state_tactic(ast_manager& m, params_ref const& p, svector<factoryTy> const& fs) :
+        dependent_expr_state(m),
+        m(m),
+        m_params(p),
+        m_dep(m, m.mk_true(), nullptr, nullptr),
+        m_factories(fs),
         m_frozen(m)
     {}
 
+    /**
+    * Fuse two dependent-expr tactics into one tactic that runs their
+    * simplifiers as a single pass over a shared goal, instead of
+    * materializing an intermediate goal between the stages.
+    * Consumes the arguments and returns ownership of the fused tactic,
+    * or nullptr when the arguments cannot be fused.
+    */
+    static tactic* fuse(tactic* t1, tactic* t2) {
+        auto* d1 = dynamic_cast<dependent_expr_state_tactic*>(t1);
+        auto* d2 = dynamic_cast<dependent_expr_state_tactic*>(t2);
+        if (!d1 || !d2)
+            return nullptr;
+        // do not fuse tactics that already carry state
+        if (d1->m_simp || d2->m_simp || !d1->m_frozen.empty() || !d2->m_frozen.empty())
+            return nullptr;
+        params_ref p = d1->m_params;
+        p.append(d2->m_params);
+        svector<factoryTy> fs(d1->m_factories);
+        fs.append(d2->m_factories);
+        tactic* r = alloc(dependent_expr_state_tactic, d1->m, p, fs);
+        tactic_ref _t1(t1), _t2(t2);
+        return r;
+    }
+
     ~dependent_expr_state_tactic() override {
         if (m_simp)
             pop(1);
@@ -108,7 +150,7 @@ public:
     }
 
     tactic* translate(ast_manager& m) override {
-        return alloc(dependent_expr_state_tactic, m, m_params, m_factory);
+        return alloc(dependent_expr_state_tactic, m, m_params, m_factories);
     }
 
     void operator()(goal_ref const& in,
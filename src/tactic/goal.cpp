@@ -23,6 +23,20 @@ Revision History:
 #include "ast/well_sorted.h"
 #include "ast/display_dimacs.h"
 #include "tactic/goal.h"
+#include <atomic>
+
+// Global generation counter for goal version stamps. Every assignment draws a
+// fresh value, so stamps are never reused across goals, not even when a goal
+// object is deallocated and its address recycled.
+#ifdef SINGLE_THREAD
+static unsigned g_goal_generation = 0;
+#else
+static std::atomic<unsigned> g_goal_generation;
+#endif
+
+void goal::bump_version() {
+    m_version = ++g_goal_generation;
+}
 
 goal::precision goal::mk_union(precision p1, precision p2) {
     if (p1 == PRECISE) return p2;
@@ -50,6 +64,7 @@ goal::goal(ast_manager & m, bool models_enabled, bool core_enabled):
     m_core_enabled(core_enabled),
     m_inconsistent(false),
     m_precision(PRECISE) {
+    bump_version();
     }
 
 goal::goal(ast_manager & m, bool proofs_enabled, bool models_enabled, bool core_enabled):
@@ -62,6 +77,7 @@ goal::goal(ast_manager & m, bool proofs_enabled, bool models_enabled, bool core_
     m_inconsistent(false),
     m_precision(PRECISE) {
     SASSERT(!proofs_enabled || m.proofs_enabled());
+    bump_version();
     }
 
 goal::goal(goal const & src):
@@ -73,6 +89,7 @@ goal::goal(goal const & src):
     m_core_enabled(src.unsat_core_enabled()),
     m_inconsistent(false),
     m_precision(PRECISE) {
+    bump_version();
     copy_from(src);
     }
 
@@ -87,6 +104,7 @@ goal::goal(goal const & src, bool):
     m_core_enabled(src.unsat_core_enabled()),
     m_inconsistent(false),
     m_precision(src.m_precision) {
+    bump_version();
     m_mc = src.m_mc.get();
     m_pc = src.m_pc.get();
     m_dc = src.m_dc.get();
@@ -110,15 +128,17 @@ void goal::copy_to(goal & target) const {
     SASSERT(target.m_core_enabled   == m_core_enabled);
     target.m_inconsistent         = m_inconsistent;
     target.m_precision            = mk_union(prec(), target.prec());
-    target.m_mc                   = m_mc.get(); 
-    target.m_pc                   = m_pc.get(); 
+    target.m_mc                   = m_mc.get();
+    target.m_pc                   = m_pc.get();
     target.m_dc                   = m_dc.get();
+    target.bump_version();
 }
 
 void goal::push_back(expr * f, proof * pr, expr_dependency * d) {
     SASSERT(!proofs_enabled() || pr);
     if (m().is_true(f))
         return;
+    bump_version();
     if (m().is_false(f)) {
         // Make sure pr and d are not deleted by the m().del(...) statements.
         proof_ref saved_pr(m());
@@ -285,6 +305,7 @@ void goal::get_formulas(expr_ref_vector & result) const {
 void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
     if (m_inconsistent)
         return;
+    bump_version();
     if (proofs_enabled()) {
         SASSERT(pr);
         if (!pr)
@@ -322,6 +343,7 @@ void goal::update(unsigned i, expr * f, proof * pr, expr_dependency * d) {
 }
 
 void goal::reset_core() {
+    bump_version();
     m().del(m_forms);
     m().del(m_proofs);
     m().del(m_dependencies);
@@ -473,6 +495,7 @@ unsigned goal::num_exprs() const {
 
 void goal::shrink(unsigned j) {
     SASSERT(j <= size());
+    bump_version();
     unsigned sz = size();
     for (unsigned i = j; i < sz; i++)
         m().pop_back(m_forms);
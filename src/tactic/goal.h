@@ -59,6 +59,7 @@ protected:
     expr_array            m_forms;
     expr_array            m_proofs;
     expr_dependency_array m_dependencies;
+    unsigned              m_version;           // stamp updated whenever the set of formulas changes; used to memoize expensive goal inspections.
     // attributes
     unsigned              m_depth:26;          // depth of the goal in the goal tree.
     unsigned              m_models_enabled:1;  // model generation is enabled.
@@ -77,6 +78,7 @@ protected:
     unsigned get_not_idx(expr * f) const;
     void shrink(unsigned j);
     void reset_core();
+    void bump_version();
     bool is_literal(expr* f) const;
     
 public:
@@ -99,6 +101,10 @@ public:
     bool unsat_core_enabled() const { return m_core_enabled; }
     bool inconsistent() const { return m_inconsistent; }
     precision prec() const { return static_cast<precision>(m_precision); }
+    // Version stamp of the current set of formulas. Stamps are drawn from a global
+    // generation counter, so no two goal states share a stamp: a cached result keyed
+    // by the stamp remains valid exactly as long as the goal is not modified.
+    unsigned version() const { return m_version; }
     
     void set_depth(unsigned d) { m_depth = d; }
     void inc_depth() { m_depth++; }
@@ -247,64 +247,110 @@ probe * mk_div(probe * p1, probe * p2) {
     return alloc(div_probe, p1, p2);
 }
 
-struct is_non_propositional_predicate {
-    struct found {};
-    ast_manager & m;
-
-    is_non_propositional_predicate(ast_manager & _m):m(_m) {}
-    void operator()(var *) { throw found();  }
-    void operator()(quantifier *) { throw found(); }
-    void operator()(app * n) {
-        if (!m.is_bool(n))
-            throw found();
-
-        family_id fid = n->get_family_id();
-        if (fid == m.get_basic_family_id())
-            return;
-
-        if (is_uninterp_const(n))
-            return;
+/**
+   \brief Features shared by the formula-class probes
+   (is_propositional, is_qfbv, is_qfufbv, is_qfaufbv).
+
+   Strategy selection typically consults several of these probes on the same
+   unmodified goal (see e.g. default_tactic), and each of them used to
+   traverse the whole goal from scratch. The collector below evaluates all
+   four class tests in a single traversal, and the result is memoized per
+   thread keyed by the goal and its version stamp, so the remaining probes
+   are answered without revisiting any formula.
+*/
+struct goal_class_info {
+    bool m_non_propositional = false;
+    bool m_non_qfbv = false;
+    bool m_non_qfaufbv = false;
+    bool m_non_qfufbv = false;
+
+    bool all_set() const { return m_non_propositional && m_non_qfbv && m_non_qfaufbv && m_non_qfufbv; }
+};
 
+struct goal_class_collector {
+    struct found {}; // raised as soon as every class has been excluded.
+    ast_manager &     m;
+    bv_util           m_bv_util;
+    array_util        m_array_util;
+    goal_class_info & m_info;
+
+    goal_class_collector(ast_manager & _m, goal_class_info & info):
+        m(_m), m_bv_util(_m), m_array_util(_m), m_info(info) {}
+
+    void set_all() {
+        m_info.m_non_propositional = true;
+        m_info.m_non_qfbv          = true;
+        m_info.m_non_qfaufbv       = true;
+        m_info.m_non_qfufbv        = true;
         throw found();
     }
-};
-
-struct is_non_qfbv_predicate {
-    struct found {};
-    ast_manager & m;
-    bv_util       u;
-
-    is_non_qfbv_predicate(ast_manager & _m):m(_m), u(m) {}
 
-    void operator()(var *) { throw found();  }
+    void operator()(var *) { set_all(); }
 
-    void operator()(quantifier *) { throw found(); }
+    void operator()(quantifier *) { set_all(); }
 
     void operator()(app * n) {
-        if (!m.is_bool(n) && !u.is_bv(n))
+        bool is_bool    = m.is_bool(n);
+        bool is_bv      = m_bv_util.is_bv(n);
+        family_id fid   = n->get_family_id();
+        bool basic_fid  = fid == m.get_basic_family_id();
+        bool bv_fid     = fid == m_bv_util.get_family_id();
+        // QF_BV treats the undefined division/remainder operators as uninterpreted.
+        bool bv_div0    = bv_fid &&
+            (n->get_decl_kind() == OP_BSDIV0 ||
+             n->get_decl_kind() == OP_BUDIV0 ||
+             n->get_decl_kind() == OP_BSREM0 ||
+             n->get_decl_kind() == OP_BUREM0 ||
+             n->get_decl_kind() == OP_BSMOD0);
+
+        if (!(is_bool && (basic_fid || is_uninterp_const(n))))
+            m_info.m_non_propositional = true;
+        if (!((is_bool || is_bv) && (basic_fid || (bv_fid && !bv_div0) || is_uninterp_const(n))))
+            m_info.m_non_qfbv = true;
+        if (!((is_bool || is_bv) && (basic_fid || bv_fid || is_uninterp(n))))
+            m_info.m_non_qfufbv = true;
+        if (!((is_bool || is_bv || m_array_util.is_array(n)) &&
+              (basic_fid || bv_fid || fid == m_array_util.get_family_id() || is_uninterp(n))))
+            m_info.m_non_qfaufbv = true;
+        if (m_info.all_set())
             throw found();
-        family_id fid = n->get_family_id();
-        if (fid == m.get_basic_family_id())
-            return;
-        if (fid == u.get_family_id()) {
-            if (n->get_decl_kind() == OP_BSDIV0 ||
-                n->get_decl_kind() == OP_BUDIV0 ||
-                n->get_decl_kind() == OP_BSREM0 ||
-                n->get_decl_kind() == OP_BUREM0 ||
-                n->get_decl_kind() == OP_BSMOD0)
-                throw found();
-            return;
-        }
-        if (is_uninterp_const(n))
-            return;
-        throw found();
     }
 };
 
+static goal_class_info collect_goal_class_info(goal const & g) {
+    struct cache {
+        goal const *    m_goal = nullptr;
+        unsigned        m_version = 0;
+        goal_class_info m_info;
+    };
+#ifdef SINGLE_THREAD
+    static cache c;
+#else
+    static thread_local cache c;
+#endif
+    if (c.m_goal == &g && c.m_version == g.version())
+        return c.m_info;
+    goal_class_info info;
+    goal_class_collector proc(g.m(), info);
+    try {
+        expr_fast_mark1 visited;
+        unsigned sz = g.size();
+        for (unsigned i = 0; i < sz; i++)
+            quick_for_each_expr(proc, visited, g.form(i));
+    }
+    catch (const goal_class_collector::found &) {
+        // every class has already been excluded; the remaining formulas are irrelevant.
+    }
+    c.m_goal    = &g;
+    c.m_version = g.version();
+    c.m_info    = info;
+    return info;
+}
+
 class is_propositional_probe : public probe {
 public:
     result operator()(goal const & g) override {
-        return !test<is_non_propositional_predicate>(g);
+        return !collect_goal_class_info(g).m_non_propositional;
     }
 };
 
@@ -312,7 +358,7 @@ public:
 class is_qfbv_probe : public probe {
 public:
     result operator()(goal const & g) override {
-        return !test<is_non_qfbv_predicate>(g);
+        return !collect_goal_class_info(g).m_non_qfbv;
     }
 };
 
@@ -324,37 +370,10 @@ probe * mk_is_qfbv_probe() {
     return alloc(is_qfbv_probe);
 }
 
-struct is_non_qfaufbv_predicate {
-    struct found {};
-    ast_manager & m;
-    bv_util       m_bv_util;
-    array_util    m_array_util;
-
-    is_non_qfaufbv_predicate(ast_manager & _m) : m(_m), m_bv_util(_m), m_array_util(_m) {}
-
-    void operator()(var *) { throw found(); }
-
-    void operator()(quantifier *) { throw found(); }
-
-    void operator()(app * n) {
-        if (!m.is_bool(n) && !m_bv_util.is_bv(n) && !m_array_util.is_array(n))
-            throw found();
-        family_id fid = n->get_family_id();
-        if (fid == m.get_basic_family_id())
-            return;
-        if (fid == m_bv_util.get_family_id() || fid == m_array_util.get_family_id())
-            return;
-        if (is_uninterp(n))
-            return;
-
-        throw found();
-    }
-};
-
 class is_qfaufbv_probe : public probe {
 public:
     result operator()(goal const & g) override {
-        return !test<is_non_qfaufbv_predicate>(g);
+        return !collect_goal_class_info(g).m_non_qfaufbv;
     }
 };
 
@@ -363,36 +382,10 @@ probe * mk_is_qfaufbv_probe() {
 }
 
 
-struct is_non_qfufbv_predicate {
-    struct found {};
-    ast_manager & m;
-    bv_util       m_bv_util;
-
-    is_non_qfufbv_predicate(ast_manager & _m) : m(_m), m_bv_util(_m) {}
-
-    void operator()(var *) { throw found(); }
-
-    void operator()(quantifier *) { throw found(); }
-
-    void operator()(app * n) {
-        if (!m.is_bool(n) && !m_bv_util.is_bv(n))
-            throw found();
-        family_id fid = n->get_family_id();
-        if (fid == m.get_basic_family_id())
-            return;
-        if (fid == m_bv_util.get_family_id())
-            return;
-        if (is_uninterp(n))
-            return;
-
-        throw found();
-    }
-};
-
 class is_qfufbv_probe : public probe {
 public:
     result operator()(goal const & g) override {
-        return !test<is_non_qfufbv_predicate>(g);
+        return !collect_goal_class_info(g).m_non_qfufbv;
     }
 };
 
@@ -66,6 +66,7 @@ void sls_engine::updt_params(params_ref const & _p) {
     m_restart_base = p.restart_base();
     m_restart_next = m_restart_base;
     m_restart_init = p.restart_init();
+    m_restart_best = p.restart_best();
 
     m_early_prune = p.early_prune();
     m_random_offset = p.random_offset();
@@ -572,10 +573,20 @@ lbool sls_engine::operator()() {
 
         if (res == l_undef)
         {
-            if (m_restart_init)
-                m_tracker.randomize(m_assertions);
-            else
-                m_tracker.reset(m_assertions);
+            if (m_tracker.get_top_sum() > m_tracker.get_best_top_sum())
+                m_tracker.save_best_assignment();
+
+            // Andreas: Every second restart resumes from the best assignment observed
+            // so far instead of reinitializing; the remaining restarts diversify as before.
+            bool resumed = m_restart_best && (m_stats.m_restarts & 1) &&
+                           m_tracker.restore_best_assignment();
+            if (!resumed)
+            {
+                if (m_restart_init)
+                    m_tracker.randomize(m_assertions);
+                else
+                    m_tracker.reset(m_assertions);
+            }
         }
     } while (res != l_true && m_stats.m_restarts++ < m_max_restarts);
 
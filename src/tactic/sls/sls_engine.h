@@ -79,6 +79,7 @@ protected:
     unsigned        m_restart_base;
     unsigned        m_restart_next;
     unsigned        m_restart_init;
+    unsigned        m_restart_best;
     unsigned        m_early_prune;
     unsigned        m_random_offset;
     unsigned        m_rescore;
@@ -83,6 +83,9 @@ private:
     obj_map<expr, unsigned> m_weights;
     double                  m_top_sum;
     obj_hashtable<expr>   m_temp_seen;
+    ptr_vector<func_decl> m_best_decls;
+    scoped_mpz_vector     m_best_values;
+    double                m_best_top_sum;
 
 public:    
     sls_tracker(ast_manager & m, bv_util & bvu, unsynch_mpz_manager & mm, powers & p) :
@@ -93,7 +96,9 @@ public:
         m_random_bits_cnt(0),        
         m_zero(m_mpz_manager.mk_z(0)),
         m_one(m_mpz_manager.mk_z(1)),
-        m_two(m_mpz_manager.mk_z(2)) {
+        m_two(m_mpz_manager.mk_z(2)),
+        m_best_values(m_mpz_manager),
+        m_best_top_sum(0.0) {
     }
             
     ~sls_tracker() {
@@ -459,6 +464,11 @@ public:
             setup_occs(as[i]);
         }
 
+        // forget the best assignment of a previous invocation
+        m_best_decls.reset();
+        m_best_values.reset();
+        m_best_top_sum = 0.0;
+
         // initialize ucb total touched value (individual ones are always initialized to 1)
         m_touched = m_ucb_init ? as.size() : 1;
     }
@@ -648,7 +658,33 @@ public:
         for (entry_point_type::iterator it = m_entry_points.begin(); it != m_entry_points.end(); it++) {
             set_value(it->m_value, m_zero);
         }
-    }              
+    }
+
+    /* Andreas: Restarts throw the current assignment away completely. Remembering the
+       best-scoring assignment seen so far allows the engine to resume from it instead
+       of starting over from scratch. */
+    void save_best_assignment() {
+        m_best_decls.reset();
+        m_best_values.reset();
+        for (entry_point_type::iterator it = m_entry_points.begin(); it != m_entry_points.end(); it++) {
+            m_best_decls.push_back(it->m_key);
+            m_best_values.push_back(get_value(it->m_key));
+        }
+        m_best_top_sum = m_top_sum;
+    }
+
+    inline double get_best_top_sum() {
+        return m_best_top_sum;
+    }
+
+    bool restore_best_assignment() {
+        if (m_best_decls.empty())
+            return false;
+        for (unsigned i = 0; i < m_best_decls.size(); i++)
+            set_value(m_best_decls[i], m_best_values[i]);
+        TRACE("sls", tout << "Restored model:" << std::endl; show_model(tout); );
+        return true;
+    }
 
     void setup_occs(expr * n, bool negated = false) {
         if (m_manager.is_bool(n))
@@ -21,6 +21,7 @@ Notes:
 #include "util/scoped_ptr_vector.h"
 #include "tactic/tactical.h"
 #include "tactic/goal_proof_converter.h"
+#include "tactic/dependent_expr_state_tactic.h"
 #ifndef SINGLE_THREAD
 #include <thread>
 #endif
@@ -216,6 +217,11 @@ public:
 };
 
 tactic * and_then(tactic * t1, tactic * t2) {
+    // adjacent dependent-expr simplifier tactics are run as a single
+    // pass over a shared goal instead of materializing a goal per stage
+    tactic * fused = dependent_expr_state_tactic::fuse(t1, t2);
+    if (fused)
+        return fused;
     return alloc(and_then_tactical, t1, t2);
 }
 
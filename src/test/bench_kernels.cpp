@@ -0,0 +1,164 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    bench_kernels.cpp
+
+Abstract:
+
+    Micro-benchmarks for hot kernels on synthetic workloads.
+    Each benchmark prints one JSON object per line; archived runs are
+    compared with scripts/bench_compare.py to gate on regressions.
+
+--*/
+
+#include "util/stopwatch.h"
+#include "util/rlimit.h"
+#include "util/rational.h"
+#include "util/mpq.h"
+#include "sat/sat_solver.h"
+#include "ast/reg_decl_plugins.h"
+#include "ast/arith_decl_plugin.h"
+#include "ast/rewriter/th_rewriter.h"
+#include "ast/euf/euf_egraph.h"
+#include "math/simplex/sparse_matrix_def.h"
+#include "math/simplex/simplex.h"
+#include "math/simplex/simplex_def.h"
+#include <iostream>
+#include <iomanip>
+
+static void report(char const* name, unsigned iterations, double seconds) {
+    std::cout << "{\"benchmark\": \"" << name << "\""
+              << ", \"iterations\": " << iterations
+              << ", \"time_ms\": " << std::fixed << std::setprecision(3) << (1000.0 * seconds)
+              << "}" << std::endl;
+}
+
+// propagate a long chain of binary clauses into a conflict, repeatedly
+static void bench_sat_propagate() {
+    unsigned const num_vars = 20000;
+    unsigned const num_checks = 50;
+    params_ref p;
+    reslimit rlim;
+    sat::solver s(p, rlim);
+    for (unsigned i = 0; i <= num_vars; ++i)
+        s.mk_var();
+    for (unsigned i = 1; i < num_vars; ++i)
+        s.mk_clause(sat::literal(i, true), sat::literal(i + 1, false));
+    // closing the cycle makes the chain unsatisfiable under the assumption
+    s.mk_clause(sat::literal(num_vars, true), sat::literal(1, true));
+    sat::literal assumption(1, false);
+    stopwatch sw;
+    sw.start();
+    for (unsigned i = 0; i < num_checks; ++i)
+        VERIFY(l_false == s.check(1, &assumption));
+    sw.stop();
+    report("sat_propagate", num_checks, sw.get_seconds());
+}
+
+// rewrite freshly built arithmetic terms so that the rewriter cache never hits
+static void bench_rewriter() {
+    unsigned const num_rounds = 2000;
+    ast_manager m;
+    reg_decl_plugins(m);
+    arith_util a(m);
+    th_rewriter rw(m);
+    expr_ref x(m.mk_const(symbol("x"), a.mk_int()), m);
+    expr_ref y(m.mk_const(symbol("y"), a.mk_int()), m);
+    stopwatch sw;
+    sw.start();
+    for (unsigned i = 0; i < num_rounds; ++i) {
+        expr_ref k1(a.mk_int(i), m), k2(a.mk_int(i + 1), m);
+        expr_ref t(a.mk_add(a.mk_mul(a.mk_add(x, k1), a.mk_add(y, k2)),
+                            a.mk_mul(k2, a.mk_add(x, y)),
+                            a.mk_mul(x, x)), m);
+        expr_ref r(m);
+        rw(t, r);
+    }
+    sw.stop();
+    report("rewriter_process_app", num_rounds, sw.get_seconds());
+}
+
+// accumulate rationals with growing denominators to exercise gcd normalization
+static void bench_mpq_add() {
+    unsigned const num_adds = 200000;
+    unsynch_mpq_manager m;
+    scoped_mpq sum(m), inc(m);
+    stopwatch sw;
+    sw.start();
+    for (unsigned i = 1; i <= num_adds; ++i) {
+        m.set(inc, 1, i % 1024 + 1);
+        m.add(sum, inc, sum);
+    }
+    sw.stop();
+    report("mpq_add", num_adds, sw.get_seconds());
+}
+
+// drive the simplex tableau to feasibility over a banded constraint system
+static void bench_simplex() {
+    typedef simplex::simplex<simplex::mpz_ext> Simplex;
+    unsigned const num_rounds = 20;
+    unsigned const num_base_vars = 60;
+    stopwatch sw;
+    sw.start();
+    for (unsigned round = 0; round < num_rounds; ++round) {
+        reslimit rl;
+        Simplex S(rl);
+        mpq_inf one(mpq(1), mpq(0));
+        for (unsigned i = 0; i + 1 < num_base_vars; ++i) {
+            // x_i + x_{i+1} - s_i = 0, s_i >= 1
+            unsigned vars[3] = { i, i + 1, num_base_vars + i };
+            mpz coeffs[3] = { mpz(1), mpz(1 + (int)(i % 3)), mpz(-1) };
+            S.ensure_var(i);
+            S.ensure_var(i + 1);
+            S.ensure_var(num_base_vars + i);
+            S.set_lower(num_base_vars + i, one);
+            S.add_row(num_base_vars + i, 3, vars, coeffs);
+        }
+        VERIFY(l_true == S.make_feasible());
+    }
+    sw.stop();
+    report("simplex_make_feasible", num_rounds, sw.get_seconds());
+}
+
+// merge the leaves of a wide congruence graph and undo, repeatedly
+static void bench_egraph_merge() {
+    unsigned const num_rounds = 200;
+    unsigned const width = 400;
+    ast_manager m;
+    reg_decl_plugins(m);
+    euf::egraph g(m);
+    sort_ref S(m.mk_uninterpreted_sort(symbol("S")), m);
+    func_decl_ref f(m.mk_func_decl(symbol("f"), S.get(), S.get()), m);
+    expr_ref_vector pinned(m);
+    euf::enode_vector leaves;
+    for (unsigned i = 0; i < width; ++i) {
+        expr_ref a(m.mk_fresh_const("a", S), m);
+        pinned.push_back(a);
+        euf::enode* n = g.mk(a, 0, 0, nullptr);
+        expr_ref fa(m.mk_app(f, a.get()), m);
+        pinned.push_back(fa);
+        g.mk(fa, 0, 1, &n);
+        leaves.push_back(n);
+    }
+    stopwatch sw;
+    sw.start();
+    for (unsigned round = 0; round < num_rounds; ++round) {
+        g.push();
+        for (unsigned i = 1; i < width; ++i)
+            g.merge(leaves[0], leaves[i], nullptr);
+        g.propagate();
+        g.pop(1);
+    }
+    sw.stop();
+    report("egraph_merge", num_rounds, sw.get_seconds());
+}
+
+void tst_bench_kernels() {
+    bench_sat_propagate();
+    bench_rewriter();
+    bench_mpq_add();
+    bench_simplex();
+    bench_egraph_merge();
+}
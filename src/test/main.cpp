@@ -197,6 +197,7 @@ int main(int argc, char ** argv) {
     TST(buffer);
     TST(chashtable);
     TST(egraph);
+    TST(bench_kernels);
     TST(ex);
     TST(nlarith_util);
     TST(api_bug);
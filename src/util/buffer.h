@@ -257,6 +257,29 @@ public:
         append(other);
         return *this;
     }
+
+    buffer & operator=(buffer && other) noexcept {
+        if (this == &other)
+            return *this;
+        destroy();
+        if (other.m_buffer == reinterpret_cast<T*>(other.m_initial_buffer)) {
+            m_buffer   = reinterpret_cast<T*>(m_initial_buffer);
+            m_pos      = 0;
+            m_capacity = INITIAL_SIZE;
+            for (unsigned i = 0, sz = other.size(); i < sz; ++i) {
+                push_back(std::move(other.m_buffer[i]));
+            }
+        }
+        else {
+            m_buffer          = other.m_buffer;
+            m_pos             = other.m_pos;
+            m_capacity        = other.m_capacity;
+            other.m_buffer    = reinterpret_cast<T*>(other.m_initial_buffer);
+            other.m_pos       = 0;
+            other.m_capacity  = INITIAL_SIZE;
+        }
+        return *this;
+    }
 };
 
 // note that the append added is actually not an addition over its base class buffer,
@@ -37,6 +37,11 @@ public:
 
     checked_int64(): m_value(0) {}
     checked_int64(int64_t v): m_value(v) {}
+    explicit checked_int64(rational const& r) {
+        if (CHECK && !r.is_int64())
+            throw overflow_exception();
+        m_value = r.get_int64();
+    }
 
     class overflow_exception : public z3_exception {
         char const * msg() const override { return "checked_int64 overflow/underflow";}
@@ -57,6 +62,14 @@ public:
 
     int64_t get_int64() const { return m_value; }
 
+    void reset() { m_value = 0; }
+
+    // interface shared with the rational-valued numerals of diff-logic
+    static bool is_rational() { return true; }
+    checked_int64 const& get_rational() const { return *this; }
+    checked_int64 get_infinitesimal() const { return zero(); }
+    rational to_rational() const { return rational(m_value, rational::i64()); }
+
     checked_int64 abs() const { 
         if (m_value >= 0) {
             return *this; 
@@ -21,6 +21,8 @@ Notes:
 #include "util/gparams.h"
 #include "util/util.h"
 #include "util/memory_manager.h"
+#include "util/phase_trace.h"
+#include "util/self_profiler.h"
 
 void env_params::updt_params() {
     params_ref const& p = gparams::get_ref();
@@ -31,7 +33,9 @@ void env_params::updt_params() {
     memory::set_high_watermark(p.get_uint("memory_high_watermark", 0));
     unsigned mb = p.get_uint("memory_high_watermark_mb", 0);
     if (mb > 0)
-        memory::set_high_watermark(megabytes_to_bytes(mb));    
+        memory::set_high_watermark(megabytes_to_bytes(mb));
+    phase_trace::enable(p.get_str("phase_trace_file", ""));
+    self_profiler::enable(p.get_bool("self_profile", false));
 }
 
 void env_params::collect_param_descrs(param_descrs & d) {
@@ -41,4 +45,6 @@ void env_params::collect_param_descrs(param_descrs & d) {
     d.insert("memory_max_alloc_count", CPK_UINT, "set hard upper limit for memory allocations, if 0 then there is no limit", "0");
     d.insert("memory_high_watermark", CPK_UINT, "set high watermark for memory consumption (in bytes), if 0 then there is no limit", "0");
     d.insert("memory_high_watermark_mb", CPK_UINT, "set high watermark for memory consumption (in megabytes), if 0 then there is no limit", "0");
+    d.insert("phase_trace_file", CPK_STRING, "file to write a chrome://tracing compatible trace of solver phase transitions (restarts, gc, simplify rounds), if empty then tracing is disabled", "");
+    d.insert("self_profile", CPK_BOOL, "attribute solver time to coarse subsystems with a sampling profiler and report the breakdown in the statistics (POSIX only)", "false");
 }
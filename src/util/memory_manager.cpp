@@ -127,11 +127,28 @@ void memory::set_high_watermark(size_t watermark) {
     g_memory_watermark = watermark;
 }
 
+static void (*g_memory_pressure_callback)(bool) = nullptr;
+static bool g_memory_above_watermark = false;
+
+void memory::set_pressure_callback(void (*cb)(bool above)) {
+    // This method is only safe to invoke at initialization time, that is, before the threads are created.
+    g_memory_pressure_callback = cb;
+}
+
 bool memory::above_high_watermark() {
     if (g_memory_watermark == 0)
         return false;
-    lock_guard lock(*g_memory_mux);
-    return g_memory_watermark < g_memory_alloc_size;
+    bool above, transition;
+    {
+        lock_guard lock(*g_memory_mux);
+        above = g_memory_watermark < g_memory_alloc_size;
+        transition = above != g_memory_above_watermark;
+        g_memory_above_watermark = above;
+    }
+    // the callback is invoked outside of the lock so that it may allocate
+    if (transition && g_memory_pressure_callback)
+        g_memory_pressure_callback(above);
+    return above;
 }
 
 // The following methods are only safe to invoke at 
@@ -53,6 +53,9 @@ public:
     static void initialize(size_t max_size);
     static void set_high_watermark(size_t watermak);
     static bool above_high_watermark();
+    // callback invoked when polling observes that memory consumption
+    // crossed the high watermark in either direction
+    static void set_pressure_callback(void (*cb)(bool above));
     static void set_max_size(size_t max_size);
     static void set_max_alloc_count(size_t max_count);
     static void finalize(bool shutdown = true);
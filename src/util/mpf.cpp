@@ -20,6 +20,7 @@ Revision History:
 #include<sstream>
 #include<iomanip>
 #include "util/mpf.h"
+#include "util/hwf.h"
 
 mpf::mpf() :
     ebits(0),
@@ -58,9 +59,20 @@ void mpf::swap(mpf & other) {
 
 mpf_manager::mpf_manager() :
     m_mpz_manager(m_mpq_manager),
+    m_hwf(alloc(hwf_manager)),
     m_powers2(m_mpz_manager) {
 }
 
+mpf_manager::~mpf_manager() {
+    dealloc(m_hwf);
+}
+
+void mpf_manager::set_hw_result(double r, mpf & o) {
+    set(o, 11, 53, r);
+    if (is_nan(o))
+        mk_nan(11, 53, o); // hardware NaN payloads are not canonical
+}
+
 void mpf_manager::set(mpf & o, unsigned ebits, unsigned sbits, int value) {
     static_assert(sizeof(int) == 4, "assume integers are 4 bytes");
 
@@ -459,11 +471,27 @@ bool mpf_manager::gte(mpf const & x, mpf const & y) {
 }
 
 void mpf_manager::add(mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf & o) {
-    add_sub(rm, x, y, o, false);
+    if (is_hw_double(x) && rm != MPF_ROUND_NEAREST_TAWAY) {
+        hwf a, b, r;
+        m_hwf->set(a, to_double(x));
+        m_hwf->set(b, to_double(y));
+        m_hwf->add(rm, a, b, r);
+        set_hw_result(m_hwf->to_double(r), o);
+    }
+    else
+        add_sub(rm, x, y, o, false);
 }
 
 void mpf_manager::sub(mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf & o) {
-    add_sub(rm, x, y, o, true);
+    if (is_hw_double(x) && rm != MPF_ROUND_NEAREST_TAWAY) {
+        hwf a, b, r;
+        m_hwf->set(a, to_double(x));
+        m_hwf->set(b, to_double(y));
+        m_hwf->sub(rm, a, b, r);
+        set_hw_result(m_hwf->to_double(r), o);
+    }
+    else
+        add_sub(rm, x, y, o, true);
 }
 
 void mpf_manager::add_sub(mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf & o, bool sub) {
@@ -586,6 +614,15 @@ void mpf_manager::mul(mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf &
     TRACE("mpf_dbg", tout << "X = " << to_string(x) << std::endl;);
     TRACE("mpf_dbg", tout << "Y = " << to_string(y) << std::endl;);
 
+    if (is_hw_double(x) && rm != MPF_ROUND_NEAREST_TAWAY) {
+        hwf a, b, r;
+        m_hwf->set(a, to_double(x));
+        m_hwf->set(b, to_double(y));
+        m_hwf->mul(rm, a, b, r);
+        set_hw_result(m_hwf->to_double(r), o);
+        return;
+    }
+
     if (is_nan(x))
         mk_nan(x.ebits, x.sbits, o);
     else if (is_nan(y))
@@ -661,6 +698,15 @@ void mpf_manager::div(mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf &
     TRACE("mpf_dbg", tout << "X = " << to_string(x) << std::endl;);
     TRACE("mpf_dbg", tout << "Y = " << to_string(y) << std::endl;);
 
+    if (is_hw_double(x) && rm != MPF_ROUND_NEAREST_TAWAY) {
+        hwf a, b, r;
+        m_hwf->set(a, to_double(x));
+        m_hwf->set(b, to_double(y));
+        m_hwf->div(rm, a, b, r);
+        set_hw_result(m_hwf->to_double(r), o);
+        return;
+    }
+
     if (is_nan(x))
         mk_nan(x.ebits, x.sbits, o);
     else if (is_nan(y))
@@ -744,6 +790,16 @@ void mpf_manager::fma(mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf co
     TRACE("mpf_dbg", tout << "Y = " << to_string(y) << std::endl;);
     TRACE("mpf_dbg", tout << "Z = " << to_string(z) << std::endl;);
 
+    if (is_hw_double(x) && rm != MPF_ROUND_NEAREST_TAWAY) {
+        hwf a, b, c, r;
+        m_hwf->set(a, to_double(x));
+        m_hwf->set(b, to_double(y));
+        m_hwf->set(c, to_double(z));
+        m_hwf->fma(rm, a, b, c, r);
+        set_hw_result(m_hwf->to_double(r), o);
+        return;
+    }
+
     if (is_nan(x) || is_nan(y) || is_nan(z))
         mk_nan(x.ebits, x.sbits, o);
     else if (is_pinf(x)) {
@@ -1002,6 +1058,14 @@ void mpf_manager::sqrt(mpf_rounding_mode rm, mpf const & x, mpf & o) {
 
     TRACE("mpf_dbg", tout << "X = " << to_string(x) << std::endl;);
 
+    if (is_hw_double(x) && rm != MPF_ROUND_NEAREST_TAWAY) {
+        hwf a, r;
+        m_hwf->set(a, to_double(x));
+        m_hwf->sqrt(rm, a, r);
+        set_hw_result(m_hwf->to_double(r), o);
+        return;
+    }
+
     if (is_nan(x))
         mk_nan(x.ebits, x.sbits, o);
     else if (is_pinf(x))
@@ -26,6 +26,8 @@ Revision History:
 #include "util/scoped_numeral_vector.h"
 #include "util/hash.h"
 
+class hwf_manager;
+
 typedef enum {
     MPF_ROUND_NEAREST_TEVEN,
     MPF_ROUND_NEAREST_TAWAY,
@@ -63,6 +65,7 @@ public:
     typedef mpf numeral;
 
     mpf_manager();
+    ~mpf_manager();
 
     void reset(mpf & o, unsigned ebits, unsigned sbits) { set(o, ebits, sbits, 0); }
     void set(mpf & o, unsigned ebits, unsigned sbits, int value);
@@ -219,6 +222,13 @@ protected:
 
     void unpack(mpf & o, bool normalize);
     void add_sub(mpf_rounding_mode rm, mpf const & x, mpf const & y, mpf & o, bool sub);
+
+    // Fast path for the double format (ebits == 11, sbits == 53): fold through
+    // the hardware FPU instead of the mpz-based machinery. The hardware does
+    // not support MPF_ROUND_NEAREST_TAWAY; callers fall back to the exact
+    // implementation for that mode and for all other formats.
+    bool is_hw_double(mpf const & x) const { return x.ebits == 11 && x.sbits == 53; }
+    void set_hw_result(double r, mpf & o);
     void round(mpf_rounding_mode rm, mpf & o);
     void round_sqrt(mpf_rounding_mode rm, mpf & o);
 
@@ -227,6 +237,8 @@ protected:
 
     void mk_round_inf(mpf_rounding_mode rm, mpf & o);
 
+    hwf_manager * m_hwf; // hardware fast path for the double format
+
     // Convert x into a mpz numeral. zm is the manager that owns o.
     void to_mpz(mpf const & x, unsynch_mpz_manager & zm, mpz & o);
     void to_mpz(mpf const & x, scoped_mpz & o) { to_mpz(x, o.m(), o); }
@@ -96,22 +96,53 @@ bool mpn_manager::sub(mpn_digit const * a, unsigned lnga,
     return true; // return k != 0?
 }
 
+#define DIGIT_BITS (sizeof(mpn_digit)*8)
+#define HALF_BITS (sizeof(mpn_digit)*4)
+
+// Below this operand length (in digits) schoolbook multiplication wins over
+// the recursion and bookkeeping overhead of Karatsuba.
+static const unsigned KARATSUBA_THRESHOLD = 32;
+
+// Add t (lngt digits) into c, propagating the carry into the digits above.
+// c must have room for the carry, i.e. the true value of the sum must fit
+// in lngc digits.
+static void mpn_add_into(mpn_digit * c, unsigned lngc, mpn_digit const * t, unsigned lngt) {
+    SASSERT(lngt <= lngc);
+    mpn_double_digit carry = 0;
+    unsigned i = 0;
+    for (; i < lngt; i++) {
+        carry += (mpn_double_digit) c[i] + (mpn_double_digit) t[i];
+        c[i] = (mpn_digit) carry;
+        carry >>= DIGIT_BITS;
+    }
+    for (; carry != 0; i++) {
+        SASSERT(i < lngc);
+        carry += (mpn_double_digit) c[i];
+        c[i] = (mpn_digit) carry;
+        carry >>= DIGIT_BITS;
+    }
+}
+
 bool mpn_manager::mul(mpn_digit const * a, unsigned lnga,
                       mpn_digit const * b, unsigned lngb,
                       mpn_digit * c) const {
     trace(a, lnga, b, lngb, "*");
-    // Essentially Knuth's Algorithm M. 
-    // Perhaps implement a more efficient version, see e.g., Knuth, Section 4.3.3.    
+    mul_core(a, lnga, b, lngb, c);
+    trace_nl(c, lnga+lngb);
+    return true;
+}
+
+void mpn_manager::mul_schoolbook(mpn_digit const * a, unsigned lnga,
+                                 mpn_digit const * b, unsigned lngb,
+                                 mpn_digit * c) const {
+    // Essentially Knuth's Algorithm M.
     unsigned i;
     mpn_digit k;
 
-#define DIGIT_BITS (sizeof(mpn_digit)*8)
-#define HALF_BITS (sizeof(mpn_digit)*4)
-
     for (unsigned i = 0; i < lnga; i++)
         c[i] = 0;
 
-    for (unsigned j = 0; j < lngb; j++) {        
+    for (unsigned j = 0; j < lngb; j++) {
         mpn_digit const & v_j = b[j];
         if (v_j == 0) { // This branch may be omitted according to Knuth.
             c[j+lnga] = 0;
@@ -119,21 +150,86 @@ bool mpn_manager::mul(mpn_digit const * a, unsigned lnga,
         else {
             k = 0;
             for (i = 0; i < lnga; i++) {
-                mpn_digit const & u_i = a[i];                 
+                mpn_digit const & u_i = a[i];
                 mpn_double_digit t;
-                t = ((mpn_double_digit)u_i * (mpn_double_digit)v_j) + 
-                    (mpn_double_digit) c[i+j] + 
+                t = ((mpn_double_digit)u_i * (mpn_double_digit)v_j) +
+                    (mpn_double_digit) c[i+j] +
                     (mpn_double_digit) k;
-                
+
                 c[i+j] = (t << DIGIT_BITS) >> DIGIT_BITS;
                 k = t >> DIGIT_BITS;
             }
             c[j+lnga] = k;
-        }        
+        }
     }
-    
-    trace_nl(c, lnga+lngb);
-    return true;
+}
+
+/**
+   \brief Multiply a and b into c (lnga+lngb digits). Dispatches between
+   schoolbook multiplication for short operands, Karatsuba for balanced long
+   operands, and a blockwise decomposition of the longer operand otherwise.
+*/
+void mpn_manager::mul_core(mpn_digit const * a, unsigned lnga,
+                           mpn_digit const * b, unsigned lngb,
+                           mpn_digit * c) const {
+    if (lnga < lngb) {
+        std::swap(a, b);
+        std::swap(lnga, lngb);
+    }
+    // lnga >= lngb
+    if (lngb < KARATSUBA_THRESHOLD) {
+        mul_schoolbook(a, lnga, b, lngb, c);
+        return;
+    }
+    if (lnga == lngb) {
+        mul_karatsuba(a, b, lnga, c);
+        return;
+    }
+    // Split a into blocks of lngb digits, multiply each block by b and
+    // accumulate the shifted partial products.
+    for (unsigned i = 0; i < lnga + lngb; i++)
+        c[i] = 0;
+    mpn_sbuffer t(2 * lngb, 0);
+    for (unsigned off = 0; off < lnga; off += lngb) {
+        unsigned ln = std::min(lngb, lnga - off);
+        if (ln == lngb)
+            mul_karatsuba(a + off, b, lngb, t.data());
+        else
+            mul_core(a + off, ln, b, lngb, t.data());
+        mpn_add_into(c + off, lnga + lngb - off, t.data(), ln + lngb);
+    }
+}
+
+/**
+   \brief Karatsuba multiplication of two n-digit numbers into c (2n digits).
+   With a = a1*B^h + a0 and b = b1*B^h + b0, the product is computed from the
+   three half-size products z0 = a0*b0, z2 = a1*b1 and
+   z1 = (a0+a1)*(b0+b1) - z0 - z2.
+*/
+void mpn_manager::mul_karatsuba(mpn_digit const * a, mpn_digit const * b,
+                                unsigned n, mpn_digit * c) const {
+    if (n < KARATSUBA_THRESHOLD) {
+        mul_schoolbook(a, n, b, n, c);
+        return;
+    }
+    unsigned h = n / 2;     // length of the low halves
+    unsigned k = n - h;     // length of the high halves, k >= h
+    // z0 and z2 are computed directly into their final position.
+    mul_core(a, h, b, h, c);
+    mul_core(a + h, k, b + h, k, c + 2 * h);
+    // z1 = (a0+a1)*(b0+b1) - z0 - z2
+    mpn_sbuffer sa(k + 1, 0), sb(k + 1, 0), z1(2 * (k + 1), 0);
+    unsigned lsa, lsb;
+    add(a, h, a + h, k, sa.data(), k + 1, &lsa);
+    add(b, h, b + h, k, sb.data(), k + 1, &lsb);
+    mul_core(sa.data(), lsa, sb.data(), lsb, z1.data());
+    unsigned lz1 = 2 * (k + 1); // upper digits beyond lsa+lsb are zero
+    mpn_digit borrow;
+    sub(z1.data(), lz1, c, 2 * h, z1.data(), &borrow);
+    SASSERT(borrow == 0);
+    sub(z1.data(), lz1, c + 2 * h, 2 * k, z1.data(), &borrow);
+    SASSERT(borrow == 0);
+    mpn_add_into(c + h, 2 * n - h, z1.data(), lz1);
 }
 
 #define MASK_FIRST (~((mpn_digit)(-1) >> 1))
@@ -71,6 +71,17 @@ private:
                mpn_digit * quot, mpn_digit * rem,
                mpn_sbuffer & ms, mpn_sbuffer & ab) const;
 
+    void mul_core(mpn_digit const * a, unsigned lnga,
+                  mpn_digit const * b, unsigned lngb,
+                  mpn_digit * c) const;
+
+    void mul_schoolbook(mpn_digit const * a, unsigned lnga,
+                        mpn_digit const * b, unsigned lngb,
+                        mpn_digit * c) const;
+
+    void mul_karatsuba(mpn_digit const * a, mpn_digit const * b,
+                       unsigned n, mpn_digit * c) const;
+
     void trace(mpn_digit const * a, unsigned lnga,
                mpn_digit const * b, unsigned lngb,
                const char * op) const;
@@ -788,6 +788,10 @@ public:
 
     void power(mpq const & a, unsigned p, mpq & b);
 
+    void mod2k(mpz & a, unsigned k) { mpz_manager<SYNCH>::mod2k(a, k); }
+
+    void mod2k(mpq & a, unsigned k) { SASSERT(is_int(a) && !is_neg(a)); mpz_manager<SYNCH>::mod2k(a.m_num, k); }
+
     bool is_power_of_two(mpz const & a, unsigned & shift) { return mpz_manager<SYNCH>::is_power_of_two(a, shift); }
 
     bool is_power_of_two(mpq const & a, unsigned & shift) { return is_int(a) && is_power_of_two(a.m_num, shift); }
@@ -243,30 +243,6 @@ void mpz_manager<SYNCH>::del(mpz_manager<SYNCH>* m, mpz & a) {
     } 
 }
 
-template<bool SYNCH>
-void mpz_manager<SYNCH>::add(mpz const & a, mpz const & b, mpz & c) {
-    STRACE("mpz", tout << "[mpz] " << to_string(a) << " + " << to_string(b) << " == ";); 
-    if (is_small(a) && is_small(b)) {
-        set_i64(c, i64(a) + i64(b));
-    }
-    else {
-        big_add(a, b, c);
-    }
-    STRACE("mpz", tout << to_string(c) << "\n";);
-}
-
-template<bool SYNCH>
-void mpz_manager<SYNCH>::sub(mpz const & a, mpz const & b, mpz & c) {
-    STRACE("mpz", tout << "[mpz] " << to_string(a) << " - " << to_string(b) << " == ";); 
-    if (is_small(a) && is_small(b)) {
-        set_i64(c, i64(a) - i64(b));
-    }
-    else {
-        big_sub(a, b, c);
-    }
-    STRACE("mpz", tout << to_string(c) << "\n";);
-}
-
 template<bool SYNCH>
 void mpz_manager<SYNCH>::set_big_i64(mpz & c, int64_t v) {
 #ifndef _MP_GMP
@@ -500,19 +476,7 @@ void mpz_manager<SYNCH>::set_digits(mpz & target, unsigned sz, digit_t const * d
 }
 
 template<bool SYNCH>
-void mpz_manager<SYNCH>::mul(mpz const & a, mpz const & b, mpz & c) {
-    STRACE("mpz", tout << "[mpz] " << to_string(a) << " * " << to_string(b) << " == ";); 
-    if (is_small(a) && is_small(b)) {
-        set_i64(c, i64(a) * i64(b));
-    }
-    else {
-        big_mul(a, b, c);
-    }
-    STRACE("mpz", tout << to_string(c) << "\n";);
-}
-
 // d <- a + b*c
-template<bool SYNCH>
 void mpz_manager<SYNCH>::addmul(mpz const & a, mpz const & b, mpz const & c, mpz & d) {
     if (is_one(b)) {
         add(a, c, d);
@@ -2104,7 +2068,47 @@ void mpz_manager<SYNCH>::machine_div2k(mpz & a, unsigned k) {
     mk_big(a);
     mpz_swap(*a.m_ptr, m_tmp);
     MPZ_END_CRITICAL();
-#endif    
+#endif
+}
+
+template<bool SYNCH>
+void mpz_manager<SYNCH>::mod2k(mpz & a, unsigned k) {
+    SASSERT(is_nonneg(a));
+    if (is_zero(a))
+        return;
+    if (k == 0) {
+        set(a, 0);
+        return;
+    }
+    if (is_small(a)) {
+        if (k < 31)
+            a.m_val &= (1 << k) - 1;
+        return;
+    }
+#ifndef _MP_GMP
+    unsigned digit_shift = k / (8 * sizeof(digit_t));
+    unsigned bit_shift   = k % (8 * sizeof(digit_t));
+    mpz_cell * c         = a.m_ptr;
+    if (digit_shift >= c->m_size)
+        return;
+    unsigned new_sz      = digit_shift + (bit_shift != 0 ? 1 : 0);
+    if (new_sz == 0) {
+        set(a, 0);
+        return;
+    }
+    digit_t * ds         = c->m_digits;
+    if (bit_shift != 0)
+        ds[digit_shift] &= (static_cast<digit_t>(1) << bit_shift) - 1;
+    c->m_size = new_sz;
+    normalize(a);
+#else
+    ensure_mpz_t a1(a);
+    MPZ_BEGIN_CRITICAL();
+    mpz_fdiv_r_2exp(m_tmp, a1(), k);
+    mk_big(a);
+    mpz_swap(*a.m_ptr, m_tmp);
+    MPZ_END_CRITICAL();
+#endif
 }
 
 template<bool SYNCH>
@@ -406,15 +406,40 @@ public:
 
     static void del(mpz_manager* m, mpz & a);
     
-    void add(mpz const & a, mpz const & b, mpz & c);
+    // The small x small cases are resolved inline: two small values fit in
+    // int64 without overflow, so arithmetic-heavy clients (theory_arith,
+    // math/lp) never pay a call, let alone reach GMP, on pure machine-integer
+    // problems. Only mixed or large operands go out of line.
+    void add(mpz const & a, mpz const & b, mpz & c) {
+        STRACE("mpz", tout << "[mpz] " << to_string(a) << " + " << to_string(b) << " == ";);
+        if (is_small(a) && is_small(b))
+            set_i64(c, i64(a) + i64(b));
+        else
+            big_add(a, b, c);
+        STRACE("mpz", tout << to_string(c) << "\n";);
+    }
+
+    void sub(mpz const & a, mpz const & b, mpz & c) {
+        STRACE("mpz", tout << "[mpz] " << to_string(a) << " - " << to_string(b) << " == ";);
+        if (is_small(a) && is_small(b))
+            set_i64(c, i64(a) - i64(b));
+        else
+            big_sub(a, b, c);
+        STRACE("mpz", tout << to_string(c) << "\n";);
+    }
 
-    void sub(mpz const & a, mpz const & b, mpz & c);
-    
     void inc(mpz & a) { add(a, mpz(1), a); }
 
     void dec(mpz & a) { add(a, mpz(-1), a); }
 
-    void mul(mpz const & a, mpz const & b, mpz & c);
+    void mul(mpz const & a, mpz const & b, mpz & c) {
+        STRACE("mpz", tout << "[mpz] " << to_string(a) << " * " << to_string(b) << " == ";);
+        if (is_small(a) && is_small(b))
+            set_i64(c, i64(a) * i64(b));
+        else
+            big_mul(a, b, c);
+        STRACE("mpz", tout << to_string(c) << "\n";);
+    }
 
     // d <- a + b*c
     void addmul(mpz const & a, mpz const & b, mpz const & c, mpz & d);
@@ -651,7 +676,15 @@ public:
     void machine_div2k(mpz & a, unsigned k);
 
     void machine_div2k(mpz const & a, unsigned k, mpz & r) { set(r, a); machine_div2k(r, k); }
-    
+
+    /**
+       \brief a <- a mod 2^k. a must be non-negative; the low k bits are kept in place,
+       so no modulus is materialized and no division is performed.
+    */
+    void mod2k(mpz & a, unsigned k);
+
+    void mod2k(mpz const & a, unsigned k, mpz & r) { set(r, a); mod2k(r, k); }
+
     void mul2k(mpz & a, unsigned k);
 
     void mul2k(mpz const & a, unsigned k, mpz & r) { set(r, a); mul2k(r, k); }
@@ -30,10 +30,49 @@ inline char * alloc_page(size_t s) { char * r = alloc_svect(char, s+PAGE_HEADER_
 
 inline void del_page(char * page) { dealloc_svect(page - PAGE_HEADER_SZ); }
 
+/**
+   \brief Pool of default pages released by destroyed regions and stacks.
+
+   Conflict resolution and quantifier instantiation create and destroy
+   millions of short-lived regions; without the pool every one of them pays
+   a round trip through the allocator for its first page. The pool is
+   thread-local, so it is accessed without synchronization, and it is capped
+   so that an idle thread retains a bounded amount of memory. Pages kept in
+   the pool remain accounted by the memory manager.
+*/
+static const unsigned MAX_PAGE_POOL_SIZE = 128;
+
+namespace {
+    struct page_pool {
+        char *   m_pages = nullptr;
+        unsigned m_size  = 0;
+        ~page_pool() {
+            while (m_pages) {
+                char * prev = prev_page(m_pages);
+                del_page(m_pages);
+                m_pages = prev;
+            }
+        }
+    };
+}
+
+#ifdef SINGLE_THREAD
+static page_pool g_page_pool;
+#else
+static thread_local page_pool g_page_pool;
+#endif
+
 void del_pages(char * page) {
     while (page != nullptr) {
         char * prev = prev_page(page);
-        del_page(page);
+        if (is_default_page(page) && g_page_pool.m_size < MAX_PAGE_POOL_SIZE) {
+            set_page_header(page, g_page_pool.m_pages, true);
+            g_page_pool.m_pages = page;
+            g_page_pool.m_size++;
+        }
+        else {
+            del_page(page);
+        }
         page = prev;
     }
 }
@@ -44,6 +83,11 @@ char * allocate_default_page(char * prev, char * & free_pages) {
         r = free_pages;
         free_pages = prev_page(free_pages);
     }
+    else if (g_page_pool.m_pages) {
+        r = g_page_pool.m_pages;
+        g_page_pool.m_pages = prev_page(r);
+        g_page_pool.m_size--;
+    }
     else {
         r = alloc_page(DEFAULT_PAGE_SIZE);
     }
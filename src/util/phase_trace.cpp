@@ -0,0 +1,181 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    phase_trace.cpp
+
+Abstract:
+
+    Opt-in streaming trace of coarse solver phase transitions.
+
+--*/
+#include "util/phase_trace.h"
+#include "util/mutex.h"
+#include "util/vector.h"
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+bool phase_trace::g_enabled = false;
+
+namespace {
+
+    struct trace_event {
+        char const * m_name;
+        uint64_t     m_ts; // nanoseconds since tracing was enabled
+        char         m_ph; // 'B' (begin), 'E' (end) or 'i' (instant)
+    };
+
+    // Cap on buffered events per thread; events beyond the cap are counted
+    // and reported as dropped, so a runaway phase cannot exhaust memory.
+    static const unsigned MAX_EVENTS_PER_THREAD = 1 << 20;
+
+    struct trace_buffer;
+
+    // Global registry of per-thread buffers. The registry mutex is taken
+    // only when a thread records its first event, when a thread exits and
+    // when the trace is written; recording an event itself touches only
+    // thread-local state.
+    struct trace_registry {
+        mutex                      m_mux;
+        ptr_vector<trace_buffer>   m_buffers;
+        svector<trace_event>       m_retired;       // events of threads that already exited
+        svector<unsigned>          m_retired_tids;  // per-retired-event thread id
+        std::string                m_file_name;
+        unsigned                   m_next_tid = 0;
+        uint64_t                   m_dropped = 0;
+        std::chrono::steady_clock::time_point m_start;
+        ~trace_registry();
+        void write_trace();
+    };
+
+    static trace_registry & registry() {
+        // Function-local so that thread-local buffers, which are constructed
+        // later, are destroyed (and retire their events) first.
+        static trace_registry r;
+        return r;
+    }
+
+    struct trace_buffer {
+        svector<trace_event> m_events;
+        unsigned             m_tid;
+        uint64_t             m_dropped = 0;
+
+        trace_buffer() {
+            trace_registry & r = registry();
+            lock_guard lock(r.m_mux);
+            m_tid = r.m_next_tid++;
+            r.m_buffers.push_back(this);
+        }
+
+        ~trace_buffer() {
+            trace_registry & r = registry();
+            lock_guard lock(r.m_mux);
+            for (trace_event const & e : m_events) {
+                r.m_retired.push_back(e);
+                r.m_retired_tids.push_back(m_tid);
+            }
+            r.m_dropped += m_dropped;
+            r.m_buffers.erase(this);
+        }
+    };
+
+#ifdef SINGLE_THREAD
+    static trace_buffer * g_buffer = nullptr;
+#else
+    static thread_local trace_buffer * g_buffer = nullptr;
+#endif
+
+    static void record(char const * name, char ph) {
+        if (!g_buffer)
+            g_buffer = alloc(trace_buffer); // freed by the thread-local owner below
+        trace_buffer & b = *g_buffer;
+        if (b.m_events.size() >= MAX_EVENTS_PER_THREAD) {
+            b.m_dropped++;
+            return;
+        }
+        uint64_t ts = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - registry().m_start).count();
+        trace_event e = { name, ts, ph };
+        b.m_events.push_back(e);
+    }
+
+    // Owns the thread-local buffer so that its events are retired into the
+    // registry when the thread exits.
+    struct trace_buffer_owner {
+        ~trace_buffer_owner() {
+            dealloc(g_buffer);
+            g_buffer = nullptr;
+        }
+    };
+#ifdef SINGLE_THREAD
+    static trace_buffer_owner g_buffer_owner;
+#else
+    static thread_local trace_buffer_owner g_buffer_owner;
+#endif
+
+    static void write_event(std::ofstream & out, trace_event const & e, unsigned tid, bool & first) {
+        if (!first)
+            out << ",\n";
+        first = false;
+        // chrome://tracing expects microseconds; keep nanosecond resolution
+        // in the fractional part.
+        unsigned frac = static_cast<unsigned>(e.m_ts % 1000);
+        out << "{\"name\":\"" << e.m_name << "\",\"cat\":\"phase\",\"ph\":\"" << e.m_ph
+            << "\",\"ts\":" << (e.m_ts / 1000) << "."
+            << (frac / 100) << ((frac / 10) % 10) << (frac % 10)
+            << ",\"pid\":1,\"tid\":" << tid;
+        if (e.m_ph == 'i')
+            out << ",\"s\":\"t\"";
+        out << "}";
+    }
+
+    void trace_registry::write_trace() {
+        if (m_file_name.empty())
+            return;
+        std::ofstream out(m_file_name);
+        if (!out)
+            return;
+        out << "[\n";
+        bool first = true;
+        for (unsigned i = 0; i < m_retired.size(); ++i)
+            write_event(out, m_retired[i], m_retired_tids[i], first);
+        for (trace_buffer * b : m_buffers) {
+            for (trace_event const & e : b->m_events)
+                write_event(out, e, b->m_tid, first);
+            m_dropped += b->m_dropped;
+            b->m_dropped = 0;
+        }
+        out << "\n]\n";
+    }
+
+    trace_registry::~trace_registry() {
+        write_trace();
+    }
+}
+
+void phase_trace::enable(char const * file_name) {
+    trace_registry & r = registry();
+    lock_guard lock(r.m_mux);
+    r.m_file_name = file_name ? file_name : "";
+    if (!g_enabled && !r.m_file_name.empty())
+        r.m_start = std::chrono::steady_clock::now();
+    g_enabled = !r.m_file_name.empty();
+}
+
+void phase_trace::instant(char const * name) {
+    if (g_enabled)
+        record(name, 'i');
+}
+
+void phase_trace::begin(char const * name) {
+    if (g_enabled)
+        record(name, 'B');
+}
+
+void phase_trace::end(char const * name) {
+    if (g_enabled)
+        record(name, 'E');
+}
@@ -0,0 +1,54 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    phase_trace.h
+
+Abstract:
+
+    Opt-in streaming trace of coarse solver phase transitions
+    (restarts, garbage collection, simplification rounds).
+
+    Events are appended to per-thread buffers without synchronization and
+    carry nanosecond timestamps. When the process shuts down the collected
+    events are written as a JSON array that chrome://tracing and compatible
+    viewers can load. Tracing is enabled by setting the global parameter
+    phase_trace_file to the name of the output file; when disabled every
+    recording call reduces to a flag test.
+
+--*/
+#pragma once
+
+class phase_trace {
+    friend class scoped_phase_trace;
+    static bool g_enabled;
+    static void begin(char const * name);
+    static void end(char const * name);
+public:
+    // Route events to the given file, written when the process shuts down.
+    // An empty file name disables tracing.
+    static void enable(char const * file_name);
+
+    static bool enabled() { return g_enabled; }
+
+    // Record an instantaneous phase transition, e.g. a restart.
+    static void instant(char const * name);
+};
+
+/**
+   \brief Records the duration of a phase: a begin event on construction
+   and the matching end event on destruction.
+*/
+class scoped_phase_trace {
+    char const * m_name;
+public:
+    scoped_phase_trace(char const * name): m_name(name) {
+        if (phase_trace::enabled())
+            phase_trace::begin(m_name);
+    }
+    ~scoped_phase_trace() {
+        if (phase_trace::enabled())
+            phase_trace::end(m_name);
+    }
+};
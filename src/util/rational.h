@@ -238,8 +238,14 @@ public:
     }
 
     friend inline rational mod2k(rational const & a, unsigned k) {
-        if (a.is_nonneg() && a.is_int() && a.bitsize() <= k) 
-            return a;
+        if (a.is_nonneg() && a.is_int()) {
+            if (a.bitsize() <= k)
+                return a;
+            // keep the low k bits in place instead of dividing by 2^k
+            rational r(a);
+            rational::m().mod2k(r.m_val, k);
+            return r;
+        }
         return mod(a, power_of_two(k));
     }
 
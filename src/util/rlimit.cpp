@@ -35,7 +35,11 @@ reslimit::reslimit():
     m_cancel(0),
     m_suspend(false),
     m_count(0),
-    m_limit(std::numeric_limits<uint64_t>::max()) {
+    m_limit(std::numeric_limits<uint64_t>::max()),
+    m_budget(0),
+    m_parent(nullptr),
+    m_budget_chunk(0),
+    m_budget_cap(std::numeric_limits<uint64_t>::max()) {
 }
 
 uint64_t reslimit::count() const {
@@ -44,12 +48,39 @@ uint64_t reslimit::count() const {
 
 bool reslimit::inc() {
     ++m_count;
-    return not_canceled();
+    return not_canceled() || refill_budget();
 }
 
 bool reslimit::inc(unsigned offset) {
     m_count += offset;
-    return not_canceled();
+    return not_canceled() || refill_budget();
+}
+
+void reslimit::set_budget(uint64_t amount, unsigned chunk) {
+    m_budget = amount;
+    m_budget_chunk = chunk;
+}
+
+uint64_t reslimit::draw_budget(uint64_t chunk) {
+    uint64_t avail = m_budget.load(std::memory_order_relaxed);
+    while (avail > 0) {
+        uint64_t take = std::min(avail, chunk);
+        if (m_budget.compare_exchange_weak(avail, avail - take))
+            return take;
+    }
+    return 0;
+}
+
+bool reslimit::refill_budget() {
+    reslimit* p = m_parent;
+    if (!p || m_cancel != 0 || m_count >= m_budget_cap)
+        return false;
+    uint64_t take = p->draw_budget(p->m_budget_chunk);
+    if (take == 0)
+        return false;
+    // the increment that triggered the refill consumes one token.
+    m_limit = std::min(m_count + take - 1, m_budget_cap);
+    return true;
 }
 
 void reslimit::push(unsigned delta_limit) {
@@ -82,11 +113,22 @@ char const* reslimit::get_cancel_msg() const {
 
 void reslimit::push_child(reslimit* r) {
     lock_guard lock(*g_rlimit_mux);
-    m_children.push_back(r);    
+    m_children.push_back(r);
+    if (m_budget_chunk != 0) {
+        r->m_parent     = this;
+        r->m_budget_cap = r->m_limit;
+        // exhaust the local allowance so that the next inc() draws a chunk.
+        r->m_limit      = std::min(r->m_limit, r->m_count);
+    }
 }
 
 void reslimit::pop_child() {
     lock_guard lock(*g_rlimit_mux);
+    reslimit* r = m_children.back();
+    if (r->m_parent == this) {
+        r->m_parent = nullptr;
+        r->m_limit  = r->m_budget_cap;
+    }
     m_children.pop_back();    
 }
 
@@ -35,8 +35,17 @@ class reslimit {
     uint64_t        m_limit;
     svector<uint64_t> m_limits;
     ptr_vector<reslimit> m_children;
+    // Token bucket shared with attached children: each child draws a chunk
+    // of the budget with a single atomic operation when its local allowance
+    // runs out, so inc() never touches state shared between threads.
+    std::atomic<uint64_t> m_budget;
+    reslimit*             m_parent;
+    unsigned              m_budget_chunk;
+    uint64_t              m_budget_cap;
 
     void set_cancel(unsigned f);
+    uint64_t draw_budget(uint64_t chunk);
+    bool refill_budget();
     friend class scoped_suspend_rlimit;
 
 public:
@@ -46,6 +55,14 @@ public:
     void push_child(reslimit* r);
     void pop_child();
 
+    /**
+       \brief Arm a budget shared by children attached after this call.
+       Children consume the budget in chunks of \c chunk counter increments;
+       the whole family stops when the budget is exhausted. Must be armed
+       before the children start running.
+    */
+    void set_budget(uint64_t amount, unsigned chunk = 10000);
+
     bool inc();
     bool inc(unsigned offset);
     uint64_t count() const;
@@ -22,6 +22,7 @@ Revision History:
 #include "util/scoped_timer.h"
 #include "util/mutex.h"
 #include "util/util.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <climits>
@@ -33,44 +34,52 @@ Revision History:
 #include <pthread.h>
 #endif
 
-enum scoped_timer_work_state { IDLE = 0, WORKING = 1, EXITING = 2 };
+// All scoped timers are serviced by a single shared thread that sleeps
+// until the earliest pending deadline. Timer states are pooled so that
+// arming and disarming a timer does not allocate in the common case.
+
+enum scoped_timer_work_state { ARMED = 0, FIRING = 1, DONE = 2 };
 
 struct scoped_timer_state {
-    std::thread m_thread;
-    std::timed_mutex m_mutex;
     event_handler * eh;
-    unsigned ms;
+    std::chrono::steady_clock::time_point deadline;
     std::atomic<scoped_timer_work_state> work;
-    std::condition_variable_any cv;
 };
 
-static std::vector<scoped_timer_state*> available_workers;
-static std::mutex workers;
-static atomic<unsigned> num_workers(0);
-
-static void thread_func(scoped_timer_state *s) {
-    workers.lock();
-    while (true) {
-        s->cv.wait(workers, [=]{ return s->work != IDLE; });
-        workers.unlock();
-
-        if (s->work == EXITING)
-            return;
-
-        auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(s->ms);
+// min-heap of armed timers ordered by deadline
+static std::vector<scoped_timer_state*> timer_heap;
+static std::vector<scoped_timer_state*> free_states;
+static std::mutex timer_mutex;
+static std::condition_variable timer_cv;
+static std::thread timer_thread;
+static bool thread_running = false;
+static bool thread_exiting = false;
+
+static bool deadline_after(scoped_timer_state const * s1, scoped_timer_state const * s2) {
+    return s1->deadline > s2->deadline;
+}
 
-        while (!s->m_mutex.try_lock_until(end)) {
-            if (std::chrono::steady_clock::now() >= end) {
-                s->eh->operator()(TIMEOUT_EH_CALLER);
-                goto next;
-            }
+static void thread_func() {
+    std::unique_lock<std::mutex> lock(timer_mutex);
+    while (!thread_exiting) {
+        if (timer_heap.empty()) {
+            timer_cv.wait(lock);
+            continue;
         }
-
-        s->m_mutex.unlock();
-
-    next:
-        s->work = IDLE;
-        workers.lock();
+        scoped_timer_state * s = timer_heap.front();
+        if (std::chrono::steady_clock::now() < s->deadline) {
+            timer_cv.wait_until(lock, s->deadline);
+            continue;
+        }
+        std::pop_heap(timer_heap.begin(), timer_heap.end(), deadline_after);
+        timer_heap.pop_back();
+        s->work = FIRING;
+        lock.unlock();
+        s->eh->operator()(TIMEOUT_EH_CALLER);
+        lock.lock();
+        s->work = DONE;
+        // wake destructors waiting for their handler to finish
+        timer_cv.notify_all();
     }
 }
 
@@ -79,35 +88,44 @@ scoped_timer::scoped_timer(unsigned ms, event_handler * eh) {
     if (ms == 0 || ms == UINT_MAX)
         return;
 
-    workers.lock();
-    if (available_workers.empty()) {
-        // start new thead
-        workers.unlock();
+    std::lock_guard<std::mutex> lock(timer_mutex);
+    if (free_states.empty()) {
         s = new scoped_timer_state;
-        ++num_workers;
-        init_state(ms, eh);
-        s->m_thread = std::thread(thread_func, s);
     }
     else {
-        // re-use existing thread
-        s = available_workers.back();
-        available_workers.pop_back();
-        init_state(ms, eh);
-        workers.unlock();
-        s->cv.notify_one();
+        s = free_states.back();
+        free_states.pop_back();
     }
+    init_state(ms, eh);
+    timer_heap.push_back(s);
+    std::push_heap(timer_heap.begin(), timer_heap.end(), deadline_after);
+    if (!thread_running) {
+        thread_exiting = false;
+        timer_thread = std::thread(thread_func);
+        thread_running = true;
+    }
+    timer_cv.notify_all();
 }
-    
+
 scoped_timer::~scoped_timer() {
     if (!s)
         return;
 
-    s->m_mutex.unlock();
-    while (s->work == WORKING)
-        std::this_thread::yield();
-    workers.lock();
-    available_workers.push_back(s);
-    workers.unlock();
+    std::unique_lock<std::mutex> lock(timer_mutex);
+    if (s->work == ARMED) {
+        // the timer did not fire; remove it from the heap
+        auto it = std::find(timer_heap.begin(), timer_heap.end(), s);
+        *it = timer_heap.back();
+        timer_heap.pop_back();
+        std::make_heap(timer_heap.begin(), timer_heap.end(), deadline_after);
+    }
+    else {
+        // the handler may still be running; it is not safe to recycle
+        // the state until the timer thread is done with it.
+        while (s->work == FIRING)
+            timer_cv.wait(lock);
+    }
+    free_states.push_back(s);
 }
 
 void scoped_timer::initialize() {
@@ -121,30 +139,25 @@ void scoped_timer::initialize() {
 }
 
 void scoped_timer::finalize() {
-    unsigned deleted = 0;
-    while (deleted < num_workers) {
-        workers.lock();
-        for (auto w : available_workers) {
-            w->work = EXITING;
-            w->cv.notify_one();
-        }
-        decltype(available_workers) cleanup_workers;
-        std::swap(available_workers, cleanup_workers);
-        workers.unlock();
-
-        for (auto w : cleanup_workers) {
-            ++deleted;
-            w->m_thread.join();
-            delete w;
-        }
+    bool running;
+    {
+        std::lock_guard<std::mutex> lock(timer_mutex);
+        running = thread_running;
+        thread_exiting = true;
+        timer_cv.notify_all();
     }
-    num_workers = 0;
-    available_workers.clear();
+    if (running)
+        timer_thread.join();
+    std::lock_guard<std::mutex> lock(timer_mutex);
+    thread_running = false;
+    thread_exiting = false;
+    for (auto st : free_states)
+        delete st;
+    free_states.clear();
 }
 
 void scoped_timer::init_state(unsigned ms, event_handler * eh) {
-    s->ms = ms;
     s->eh = eh;
-    s->m_mutex.lock();
-    s->work = WORKING;
+    s->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    s->work = ARMED;
 }
@@ -0,0 +1,111 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    self_profiler.cpp
+
+Abstract:
+
+    Opt-in sampling profiler that attributes solver time to coarse
+    subsystems.
+
+--*/
+#include "util/self_profiler.h"
+#include <atomic>
+#include <cstring>
+#ifndef _WINDOWS
+#include <signal.h>
+#include <sys/time.h>
+#endif
+
+bool self_profiler::g_enabled = false;
+
+namespace {
+
+    // sampling period of the profiling timer; 1ms of consumed CPU time
+    // per sample keeps the interrupt overhead well below 1%.
+    static const unsigned SAMPLE_PERIOD_USEC = 1000;
+
+    // per-subsystem sample counts. Plain lock-free atomics so that the
+    // signal handler stays async-signal-safe.
+    static std::atomic<uint64_t> g_samples[self_profiler::SUB_NUM];
+
+#ifdef SINGLE_THREAD
+    static unsigned g_tag = self_profiler::SUB_OTHER;
+#else
+    static thread_local unsigned g_tag = self_profiler::SUB_OTHER;
+#endif
+
+    static char const * tag_name(unsigned s) {
+        switch (s) {
+        case self_profiler::SUB_SAT_PROPAGATE: return "self profile sat.propagate";
+        case self_profiler::SUB_SMT_PROPAGATE: return "self profile smt.propagate";
+        case self_profiler::SUB_EMATCH:        return "self profile smt.ematch";
+        case self_profiler::SUB_REWRITE:       return "self profile rewrite";
+        case self_profiler::SUB_ARITH:         return "self profile arith";
+        default:                               return "self profile other";
+        }
+    }
+
+#ifndef _WINDOWS
+    static void on_prof_signal(int) {
+        // charge the sample to the tag of the interrupted thread
+        g_samples[g_tag].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void set_timer(unsigned period_usec) {
+        itimerval tv;
+        memset(&tv, 0, sizeof(tv));
+        tv.it_interval.tv_usec = period_usec;
+        tv.it_value.tv_usec = period_usec;
+        setitimer(ITIMER_PROF, &tv, nullptr);
+    }
+#endif
+}
+
+void self_profiler::enable(bool flag) {
+    if (flag == g_enabled)
+        return;
+#ifndef _WINDOWS
+    if (flag) {
+        struct sigaction sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sa_handler = on_prof_signal;
+        sa.sa_flags = SA_RESTART;
+        if (sigaction(SIGPROF, &sa, nullptr) != 0)
+            return;
+        for (auto & s : g_samples)
+            s.store(0, std::memory_order_relaxed);
+        set_timer(SAMPLE_PERIOD_USEC);
+    }
+    else {
+        set_timer(0);
+    }
+    g_enabled = flag;
+#endif
+}
+
+void self_profiler::collect_statistics(statistics & st) {
+    if (!g_enabled)
+        return;
+    uint64_t total = 0;
+    for (auto const & s : g_samples)
+        total += s.load(std::memory_order_relaxed);
+    if (total == 0)
+        return;
+    for (unsigned i = 0; i < SUB_NUM; ++i) {
+        uint64_t n = g_samples[i].load(std::memory_order_relaxed);
+        if (n > 0)
+            st.update(tag_name(i), static_cast<double>(n) / total);
+    }
+}
+
+void scoped_profile_tag::push(self_profiler::subsystem s) {
+    m_old = g_tag;
+    g_tag = s;
+}
+
+void scoped_profile_tag::pop() {
+    g_tag = m_old;
+}
@@ -0,0 +1,72 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    self_profiler.h
+
+Abstract:
+
+    Opt-in sampling profiler that attributes solver time to coarse
+    subsystems.
+
+    A profiling timer periodically interrupts the process and charges the
+    sample to the subsystem tag currently installed in the interrupted
+    thread. Tags are maintained by RAII scopes at a handful of entry
+    points (SAT propagation, E-matching, rewriting, arithmetic); time
+    outside any scope is reported as "other". The breakdown is added to
+    the statistics printed at the end of a query. Sampling is enabled by
+    the global parameter self_profile and relies on POSIX profiling
+    timers; on other platforms enabling it has no effect. When disabled,
+    entering a scope reduces to a flag test.
+
+--*/
+#pragma once
+
+#include "util/statistics.h"
+
+class self_profiler {
+    friend class scoped_profile_tag;
+    static bool g_enabled;
+public:
+    enum subsystem {
+        SUB_OTHER = 0,
+        SUB_SAT_PROPAGATE,
+        SUB_SMT_PROPAGATE,
+        SUB_EMATCH,
+        SUB_REWRITE,
+        SUB_ARITH,
+        SUB_NUM
+    };
+
+    // Start or stop the profiling timer.
+    static void enable(bool flag);
+
+    static bool enabled() { return g_enabled; }
+
+    // Add the per-subsystem sample counts to \c st.
+    static void collect_statistics(statistics & st);
+};
+
+/**
+   \brief Installs a subsystem tag for the duration of a scope; samples
+   taken while the scope is active are charged to the tag. Scopes nest:
+   the innermost active tag wins, and the previous tag is restored on
+   exit.
+*/
+class scoped_profile_tag {
+    unsigned m_old;
+    void push(self_profiler::subsystem s);
+    void pop();
+public:
+    scoped_profile_tag(self_profiler::subsystem s) {
+        if (self_profiler::enabled())
+            push(s);
+        else
+            m_old = UINT_MAX;
+    }
+    ~scoped_profile_tag() {
+        if (m_old != UINT_MAX)
+            pop();
+    }
+};
@@ -23,23 +23,46 @@ Revision History:
 #include "util/debug.h"
 #include "util/util.h"
 #include "util/vector.h"
+#include "util/mutex.h"
+#include "util/symbol.h"
+#include "util/statistics.h"
 #include<iomanip>
+#include<cstring>
 #ifdef Z3DEBUG
 # include <iostream>
 #endif
 
+static DECLARE_INIT_MUTEX(g_soa_registry_mutex);
+static small_object_allocator * g_soa_registry_head = nullptr;
+
 small_object_allocator::small_object_allocator(char const * id) {
     for (unsigned i = 0; i < NUM_SLOTS; i++) {
         m_chunks[i] = nullptr;
         m_free_list[i] = nullptr;
     }
-    DEBUG_CODE({
-        m_id = id;
-    });
+    m_id = id;
     m_alloc_size = 0;
+    m_max_alloc_size = 0;
+    {
+        lock_guard lock(*g_soa_registry_mutex);
+        m_prev_allocator = nullptr;
+        m_next_allocator = g_soa_registry_head;
+        if (g_soa_registry_head)
+            g_soa_registry_head->m_prev_allocator = this;
+        g_soa_registry_head = this;
+    }
 }
 
 small_object_allocator::~small_object_allocator() {
+    {
+        lock_guard lock(*g_soa_registry_mutex);
+        if (m_prev_allocator)
+            m_prev_allocator->m_next_allocator = m_next_allocator;
+        else
+            g_soa_registry_head = m_next_allocator;
+        if (m_next_allocator)
+            m_next_allocator->m_prev_allocator = m_prev_allocator;
+    }
     for (unsigned i = 0; i < NUM_SLOTS; i++) {
         chunk * c = m_chunks[i];
         while (c) {
@@ -106,6 +129,8 @@ void * small_object_allocator::allocate(size_t size) {
     return memory::allocate(size);
 #endif
     m_alloc_size += size;
+    if (m_alloc_size > m_max_alloc_size)
+        m_max_alloc_size = m_alloc_size;
     if (size >= SMALL_OBJ_SIZE - (1 << PTR_ALIGNMENT)) {
         return memory::allocate(size);
     }
@@ -244,3 +269,34 @@ void small_object_allocator::consolidate() {
                << " :memory " << std::fixed << std::setprecision(2) 
                << static_cast<double>(memory::get_allocation_size())/static_cast<double>(1024*1024) << ")" << std::endl;);
 }
+
+void small_object_allocator::collect_statistics(statistics & st) {
+    struct entry {
+        char const *       m_id;
+        unsigned long long m_size;
+        unsigned long long m_max_size;
+    };
+    svector<entry> entries;
+    {
+        lock_guard lock(*g_soa_registry_mutex);
+        for (small_object_allocator * a = g_soa_registry_head; a != nullptr; a = a->m_next_allocator) {
+            unsigned i = 0;
+            for (; i < entries.size(); i++)
+                if (strcmp(entries[i].m_id, a->m_id) == 0)
+                    break;
+            if (i == entries.size())
+                entries.push_back(entry{ a->m_id, 0, 0 });
+            entries[i].m_size     += a->m_alloc_size;
+            entries[i].m_max_size += a->m_max_alloc_size;
+        }
+    }
+    for (entry const & e : entries) {
+        // intern the keys in the symbol table: statistics stores the key pointers
+        std::string mem_key  = std::string("memory ") + e.m_id;
+        std::string peak_key = std::string("max memory ") + e.m_id;
+        unsigned long long mem     = (100 * e.m_size)/(1024 * 1024);
+        unsigned long long max_mem = (100 * e.m_max_size)/(1024 * 1024);
+        st.update(symbol(mem_key.c_str()).bare_str(), static_cast<double>(mem)/100.0);
+        st.update(symbol(peak_key.c_str()).bare_str(), static_cast<double>(max_mem)/100.0);
+    }
+}
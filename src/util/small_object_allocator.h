@@ -23,6 +23,8 @@ Revision History:
 #include "util/debug.h"
 #include "util/trace.h"
 
+class statistics;
+
 class small_object_allocator {
     static const unsigned CHUNK_SIZE     = (8192 - sizeof(void*)*2);
     static const unsigned SMALL_OBJ_SIZE = 256;
@@ -36,19 +38,28 @@ class small_object_allocator {
     chunk *     m_chunks[NUM_SLOTS];
     void  *     m_free_list[NUM_SLOTS];
     size_t      m_alloc_size;
-#ifdef Z3DEBUG
+    size_t      m_max_alloc_size;
     char const * m_id;
-#endif
+    // allocators are linked into a global registry used to attribute memory per subsystem
+    small_object_allocator * m_prev_allocator;
+    small_object_allocator * m_next_allocator;
 public:
     small_object_allocator(char const * id = "unknown");
     ~small_object_allocator();
     void reset();
     void * allocate(size_t size);
     void deallocate(size_t size, void * p);
+    char const * id() const { return m_id; }
     size_t get_allocation_size() const { return m_alloc_size; }
+    size_t get_max_allocation_size() const { return m_max_alloc_size; }
     size_t get_wasted_size() const;
     size_t get_num_free_objs() const;
     void consolidate();
+    /**
+       \brief Collect live-bytes and high-water statistics of all allocators,
+       aggregated by allocator id.
+    */
+    static void collect_statistics(statistics & st);
 };
 
 inline void * operator new(size_t s, small_object_allocator & r) { return r.allocate(s); }
@@ -92,6 +92,25 @@ void finalize_symbols() {
 
 #else
 
+/**
+   \brief Per-thread intern cache. Symbol creation is dominated by a small
+   working set of strings (operator and sort names, parameter keywords);
+   serving repeats from a thread-local direct-mapped cache avoids touching
+   the shared tables and their locks entirely. Cached pointers are interned
+   strings, which stay valid until finalize_symbols; the epoch check discards
+   entries that survived a symbol-table lifetime.
+*/
+namespace {
+struct local_symbol_cache {
+    static const unsigned num_entries = 512; // direct mapped, power of two
+    unsigned     m_epoch = 0;
+    char const * m_entries[num_entries] = { nullptr };
+};
+}
+
+static unsigned g_symbol_table_epoch = 0;
+static thread_local local_symbol_cache g_local_symbol_cache;
+
 struct internal_symbol_tables {
     unsigned sz;
     internal_symbol_table** tables;
@@ -109,8 +128,18 @@ struct internal_symbol_tables {
     }
 
     char const * get_str(char const * d) {
-        auto* table = tables[string_hash(d, static_cast<unsigned>(strlen(d)), 251) % sz];
-        return table->get_str(d);
+        unsigned hash = string_hash(d, static_cast<unsigned>(strlen(d)), 251);
+        local_symbol_cache & cache = g_local_symbol_cache;
+        if (cache.m_epoch != g_symbol_table_epoch) {
+            memset(cache.m_entries, 0, sizeof(cache.m_entries));
+            cache.m_epoch = g_symbol_table_epoch;
+        }
+        char const *& slot = cache.m_entries[hash & (local_symbol_cache::num_entries - 1)];
+        if (slot && strcmp(slot, d) == 0)
+            return slot;
+        auto* table = tables[hash % sz];
+        slot = table->get_str(d);
+        return slot;
     }
 };
 
@@ -121,13 +150,15 @@ void initialize_symbols() {
     if (!g_symbol_tables) {
         unsigned num_tables = 2 * std::min((unsigned) std::thread::hardware_concurrency(), 64u);
         g_symbol_tables = alloc(internal_symbol_tables, num_tables);
-        
+
     }
 }
 
 void finalize_symbols() {
     dealloc(g_symbol_tables);
     g_symbol_tables = nullptr;
+    // interned strings are gone; invalidate all thread-local caches
+    ++g_symbol_table_epoch;
 }
 #endif
 
@@ -0,0 +1,42 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    thread_affinity.cpp
+
+Abstract:
+
+    Pin worker threads of parallel solvers to distinct processors.
+
+--*/
+#ifndef SINGLE_THREAD
+
+#include "util/thread_affinity.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WINDOWS)
+#include <windows.h>
+#endif
+
+void set_thread_affinity(std::thread& t, unsigned i) {
+#if defined(__linux__)
+    unsigned num_cpus = std::thread::hardware_concurrency();
+    if (num_cpus == 0)
+        return;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(i % num_cpus, &cpus);
+    pthread_setaffinity_np(t.native_handle(), sizeof(cpu_set_t), &cpus);
+#elif defined(_WINDOWS)
+    SetThreadAffinityMask(t.native_handle(), static_cast<DWORD_PTR>(1) << (i % (8 * sizeof(DWORD_PTR))));
+#else
+    // no affinity API, e.g. macOS
+    (void) t;
+    (void) i;
+#endif
+}
+
+#endif
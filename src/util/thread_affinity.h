@@ -0,0 +1,29 @@
+/*++
+Copyright (c) 2026 Microsoft Corporation
+
+Module Name:
+
+    thread_affinity.h
+
+Abstract:
+
+    Pin worker threads of parallel solvers to distinct processors.
+    Pinned workers keep their caches warm and, on multi-socket machines,
+    their allocations become node-local by first touch since the memory
+    manager uses thread-local allocation.
+
+--*/
+#pragma once
+
+#ifndef SINGLE_THREAD
+
+#include <thread>
+
+/**
+   \brief pin thread t, the i'th worker of a pool, to a fixed processor.
+   Workers are spread round-robin over the available processors.
+   It is a no-op on platforms without an affinity API.
+*/
+void set_thread_affinity(std::thread& t, unsigned i);
+
+#endif
@@ -18,6 +18,7 @@ Revision History:
 --*/
 #include "util/trace.h"
 #include "util/str_hashtable.h"
+#include "util/map.h"
 
 #ifndef SINGLE_THREAD
 #include <mutex>
@@ -45,6 +46,12 @@ std::ofstream tout(".z3-trace");
 static bool g_enable_all_trace_tags = false;
 static str_hashtable* g_enabled_trace_tags = nullptr;
 
+// Stable per-tag flag cells. Each TRACE call site resolves its tag to a
+// cell once and afterwards tests a single boolean, so enabling and
+// disabling tags stays dynamic without a hashtable lookup per message.
+typedef map<char const*, bool*, str_hash_proc, str_eq_proc> trace_flag_map;
+static trace_flag_map* g_trace_flags = nullptr;
+
 static str_hashtable& get_enabled_trace_tags() {
     if (!g_enabled_trace_tags) {
         g_enabled_trace_tags = alloc(str_hashtable);
@@ -52,25 +59,57 @@ static str_hashtable& get_enabled_trace_tags() {
     return *g_enabled_trace_tags;
 }
 
+static trace_flag_map& get_trace_flags() {
+    if (!g_trace_flags) {
+        g_trace_flags = alloc(trace_flag_map);
+    }
+    return *g_trace_flags;
+}
+
 void finalize_trace() {
     dealloc(g_enabled_trace_tags);
     g_enabled_trace_tags = nullptr;
+    if (g_trace_flags) {
+        for (auto const& kv : *g_trace_flags)
+            dealloc(kv.m_value);
+        dealloc(g_trace_flags);
+        g_trace_flags = nullptr;
+    }
+}
+
+bool* get_trace_flag(const char * tag) {
+    bool* flag = nullptr;
+    if (!get_trace_flags().find(tag, flag)) {
+        flag = alloc(bool);
+        *flag = is_trace_enabled(tag);
+        get_trace_flags().insert(tag, flag);
+    }
+    return flag;
 }
 
 void enable_trace(const char * tag) {
     get_enabled_trace_tags().insert(tag);
+    bool* flag = nullptr;
+    if (g_trace_flags && g_trace_flags->find(tag, flag))
+        *flag = true;
 }
 
 void enable_all_trace(bool flag) {
     g_enable_all_trace_tags = flag;
+    if (g_trace_flags)
+        for (auto const& kv : *g_trace_flags)
+            *kv.m_value = flag || get_enabled_trace_tags().contains(kv.m_key);
 }
 
 void disable_trace(const char * tag) {
     get_enabled_trace_tags().erase(tag);
+    bool* flag = nullptr;
+    if (g_trace_flags && g_trace_flags->find(tag, flag))
+        *flag = g_enable_all_trace_tags;
 }
 
 bool is_trace_enabled(const char * tag) {
-    return g_enable_all_trace_tags || 
+    return g_enable_all_trace_tags ||
         (g_enabled_trace_tags && get_enabled_trace_tags().contains(tag));
 }
 
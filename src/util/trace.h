@@ -56,6 +56,9 @@ void enable_trace(const char * tag);
 void enable_all_trace(bool flag);
 void disable_trace(const char * tag);
 bool is_trace_enabled(const char * tag);
+// stable cell holding the enabled state of a tag; TRACE call sites
+// resolve their tag once and then test a single boolean per message.
+bool* get_trace_flag(const char * tag);
 void close_trace();
 void open_trace();
 void finalize_trace();
@@ -70,6 +73,7 @@ static inline void enable_trace(const char * tag) {}
 static inline void enable_all_trace(bool flag) {}
 static inline void disable_trace(const char * tag) {}
 static inline bool is_trace_enabled(const char * tag) { return false; }
+static inline bool* get_trace_flag(const char * tag) { static bool g_false = false; return &g_false; }
 static inline void close_trace() {}
 static inline void open_trace() {}
 static inline void finalize_trace() {}
@@ -80,10 +84,14 @@ static inline void finalize_trace() {}
 #define TRACEBODY(TAG, CODE) TRACEH(TAG); CODE; TRACEEND; tout.flush()
 #define STRACEBODY(CODE) CODE; tout.flush()
 
-#define TRACE(TAG, CODE) TRACE_CODE(if (is_trace_enabled(TAG)) { THREAD_LOCK(TRACEBODY(TAG, CODE)); })
+// Each call site caches the flag cell of its tag, so testing whether a
+// tag is enabled is a single load and branch per message.
+#define TRACE_TAG_ENABLED(TAG) (*[](){ static bool const* _z3_flag = get_trace_flag(TAG); return _z3_flag; }())
 
-#define STRACE(TAG, CODE) TRACE_CODE(if (is_trace_enabled(TAG)) { THREAD_LOCK(STRACEBODY(CODE)); })
+#define TRACE(TAG, CODE) TRACE_CODE(if (TRACE_TAG_ENABLED(TAG)) { THREAD_LOCK(TRACEBODY(TAG, CODE)); })
 
-#define SCTRACE(TAG, COND, CODE) TRACE_CODE(if (is_trace_enabled(TAG) && (COND)) { THREAD_LOCK(STRACEBODY(CODE)); })
+#define STRACE(TAG, CODE) TRACE_CODE(if (TRACE_TAG_ENABLED(TAG)) { THREAD_LOCK(STRACEBODY(CODE)); })
 
-#define CTRACE(TAG, COND, CODE) TRACE_CODE(if (is_trace_enabled(TAG) && (COND)) { THREAD_LOCK(TRACEBODY(TAG, CODE)); })
+#define SCTRACE(TAG, COND, CODE) TRACE_CODE(if (TRACE_TAG_ENABLED(TAG) && (COND)) { THREAD_LOCK(STRACEBODY(CODE)); })
+
+#define CTRACE(TAG, COND, CODE) TRACE_CODE(if (TRACE_TAG_ENABLED(TAG) && (COND)) { THREAD_LOCK(TRACEBODY(TAG, CODE)); })
@@ -22,10 +22,19 @@ Revision History:
 #include "util/region.h"
 #include "util/obj_ref.h"
 #include "util/vector.h"
+#include <new>
+#include <type_traits>
 
 
 class trail {
 public:
+    // Opt-in tag for trail_log: a subclass redeclares this as true to state
+    // that skipping its destructor is safe. The virtual destructor makes
+    // every trail formally non-trivially destructible, so this cannot be
+    // derived from a type trait; subclasses whose members need no cleanup
+    // set the tag and are then stored inline in the trail instead of being
+    // allocated in the region.
+    static constexpr bool s_inline = false;
     virtual ~trail() = default;
     virtual void undo() = 0;
 };
@@ -36,6 +45,8 @@ class value_trail : public trail {
     T   m_old_value;
 
 public:
+    static constexpr bool s_inline = std::is_trivially_destructible<T>::value;
+
     value_trail(T & value):
         m_value(value),
         m_old_value(value) {
@@ -60,6 +71,7 @@ class scoped_value_trail : public trail {
     Ts & m_values;
     
 public:
+    static constexpr bool s_inline = true;
     scoped_value_trail(T & value, Ts& values):
         m_value(value),
         m_values(values) {
@@ -75,6 +87,7 @@ public:
 class reset_flag_trail : public trail {
     bool & m_value;
 public:
+    static constexpr bool s_inline = true;
     reset_flag_trail(bool & value):
         m_value(value) {
     }
@@ -88,6 +101,7 @@ template<typename T>
 class set_ptr_trail : public trail {
     T * & m_ptr;
 public:
+    static constexpr bool s_inline = true;
     set_ptr_trail(T * & ptr):
         m_ptr(ptr) {
         SASSERT(m_ptr == 0);
@@ -103,6 +117,7 @@ class restore_vector : public trail {
     V& m_vector;
     unsigned m_old_size;
 public:
+    static constexpr bool s_inline = true;
     restore_vector(V& v):
         m_vector(v),
         m_old_size(v.size())
@@ -124,6 +139,7 @@ class vector_value_trail : public trail {
     unsigned                     m_idx;
     T                            m_old_value;
 public:
+    static constexpr bool s_inline = std::is_trivially_destructible<T>::value;
     vector_value_trail(vector<T, CallDestructors> & v, unsigned idx):
         m_vector(v),
         m_idx(idx),
@@ -142,6 +158,7 @@ class vector2_value_trail : public trail {
     unsigned        m_j;
     T               m_old_value;
 public:
+    static constexpr bool s_inline = std::is_trivially_destructible<T>::value;
     vector2_value_trail(V& v, unsigned i, unsigned j):
         m_vector(v),
         m_i(i),
@@ -160,6 +177,7 @@ class insert_obj_map : public trail {
     obj_map<D,R>&     m_map;
     D*                m_obj;
 public:
+    static constexpr bool s_inline = true;
     insert_obj_map(obj_map<D,R>& t, D* o) : m_map(t), m_obj(o) {}
     void undo() override { m_map.remove(m_obj); }
 };
@@ -170,6 +188,7 @@ class remove_obj_map : public trail {
     D*                m_obj;
     R                 m_value;
 public:
+    static constexpr bool s_inline = std::is_trivially_destructible<R>::value;
     remove_obj_map(obj_map<D,R>& t, D* o, R v) : m_map(t), m_obj(o), m_value(v) {}
     void undo() override { m_map.insert(m_obj, m_value); }
 };
@@ -179,6 +198,7 @@ class insert_map : public trail {
     M&            m_map;
     D             m_obj;
 public:
+    static constexpr bool s_inline = std::is_trivially_destructible<D>::value;
     insert_map(M& t, D o) : m_map(t), m_obj(o) {}
     void undo() override { m_map.remove(m_obj); }
 };
@@ -190,6 +210,7 @@ class insert_ref_map : public trail {
     M&            m_map;
     D             m_obj;
 public:
+    static constexpr bool s_inline = true;
     insert_ref_map(Mgr& m, M& t, D o) : m(m), m_map(t), m_obj(o) {}
     void undo() override { m_map.remove(m_obj); m.dec_ref(m_obj); }
 };
@@ -201,6 +222,7 @@ class insert_ref2_map : public trail {
     D*             m_obj;
     R*             m_val;
 public:
+    static constexpr bool s_inline = true;
     insert_ref2_map(Mgr& m, obj_map<D,R*>& t, D*o, R*r) : m(m), m_map(t), m_obj(o), m_val(r) {}
     void undo() override { m_map.remove(m_obj); m.dec_ref(m_obj); m.dec_ref(m_val); }
 };
@@ -210,6 +232,7 @@ template<typename V>
 class push_back_vector : public trail {
     V & m_vector;
 public:
+    static constexpr bool s_inline = true;
     push_back_vector(V & v):
         m_vector(v) {
     }
@@ -224,6 +247,7 @@ class set_vector_idx_trail : public trail {
     ptr_vector<T> & m_vector;
     unsigned                         m_idx;
 public:
+    static constexpr bool s_inline = true;
     set_vector_idx_trail(ptr_vector<T> & v, unsigned idx):
         m_vector(v),
         m_idx(idx) {
@@ -239,6 +263,7 @@ class pop_back_trail : public trail {
     vector<T, CallDestructors> & m_vector;
     T m_value;
 public:
+    static constexpr bool s_inline = std::is_trivially_destructible<T>::value;
     pop_back_trail(vector<T, CallDestructors> & v):
     m_vector(v),
     m_value(m_vector.back()) {
@@ -256,6 +281,7 @@ class pop_back2_trail : public trail {
     unsigned m_index;
     T m_value;
 public:
+    static constexpr bool s_inline = std::is_trivially_destructible<T>::value;
     pop_back2_trail(vector<T, CallDestructors> & v, unsigned index):
     m_vector(v),
     m_index(index),
@@ -273,6 +299,7 @@ template<typename T, bool CallDestructors=true>
 class push_back_trail : public trail {
     vector<T, CallDestructors> & m_vector;
 public:
+    static constexpr bool s_inline = true;
     push_back_trail(vector<T, CallDestructors> & v):
         m_vector(v) {
     }
@@ -288,6 +315,7 @@ class push_back2_trail : public trail {
     vector_t & m_vector;
     unsigned   m_index;
 public:
+    static constexpr bool s_inline = true;
     push_back2_trail(vector_t & v, unsigned index) :
     m_vector(v),
     m_index(index) {
@@ -303,6 +331,7 @@ class set_bitvector_trail : public trail {
     bool_vector & m_vector;
     unsigned        m_idx;
 public:
+    static constexpr bool s_inline = true;
     set_bitvector_trail(bool_vector & v, unsigned idx):
         m_vector(v),
         m_idx(idx) {
@@ -322,6 +351,7 @@ class history_trail : public trail {
     unsigned                     m_idx;
     vector<T, CallDestructors>& m_hist;
 public:
+    static constexpr bool s_inline = true;
     history_trail(vector<T, CallDestructors>& v, unsigned idx, vector<T, CallDestructors>& hist) :
         m_dst(v),
         m_idx(idx),
@@ -338,6 +368,7 @@ template<typename T>
 class new_obj_trail : public trail {
     T * m_obj;
 public:
+    static constexpr bool s_inline = true;
     new_obj_trail(T * obj):
         m_obj(obj) {
     }
@@ -365,6 +396,7 @@ class insert_obj_trail : public trail {
     obj_hashtable<T>& m_table;
     T*                m_obj;
 public:
+    static constexpr bool s_inline = true;
     insert_obj_trail(obj_hashtable<T>& t, T* o) : m_table(t), m_obj(o) {}
     void undo() override { m_table.remove(m_obj); }
 };
@@ -375,6 +407,7 @@ class remove_obj_trail : public trail {
     obj_hashtable<T>& m_table;
     T*                m_obj;
 public:
+    static constexpr bool s_inline = true;
     remove_obj_trail(obj_hashtable<T>& t, T* o) : m_table(t), m_obj(o) {}
     void undo() override { m_table.insert(m_obj); }
 };
@@ -391,27 +424,94 @@ inline void undo_trail_stack(ptr_vector<trail> & s, unsigned old_size) {
     s.shrink(old_size);
 }
 
+/**
+   \brief Backtracking trail that stores small trivially destructible undo
+   objects inline in a contiguous array and dispatches through a function
+   pointer instead of a virtual call. The common undo kinds (value restore,
+   vector pop, map insert/erase) fit the inline payload and set trail::s_inline
+   to state that their destructor can be skipped; larger kinds and kinds that
+   do not opt in fall back to objects allocated in the region supplied by the
+   owner, just like the previous ptr_vector<trail> based trails. Entries are
+   undone in reverse order of insertion down to an explicit mark.
+*/
+class trail_log {
+    struct entry {
+        void (*m_undo)(void *);
+        char   m_payload[4 * sizeof(void*)];
+    };
+    svector<entry> m_entries;
+    region &       m_region;
+public:
+    trail_log(region & r): m_region(r) {}
+
+    unsigned size() const { return m_entries.size(); }
+
+    template<typename TrailObject>
+    void push(TrailObject const & obj) {
+        m_entries.push_back(entry());
+        entry & e = m_entries.back();
+        if constexpr (sizeof(TrailObject) <= sizeof(e.m_payload) &&
+                      alignof(TrailObject) <= alignof(void*) &&
+                      TrailObject::s_inline) {
+            new (e.m_payload) TrailObject(obj);
+            // the dynamic type is known, so the virtual call is resolved statically.
+            e.m_undo = [](void * p) { reinterpret_cast<TrailObject*>(p)->TrailObject::undo(); };
+        }
+        else {
+            *reinterpret_cast<trail**>(e.m_payload) = new (m_region) TrailObject(obj);
+            e.m_undo = [](void * p) { (*reinterpret_cast<trail**>(p))->undo(); };
+        }
+    }
+
+    void push_ptr(trail * t) {
+        m_entries.push_back(entry());
+        entry & e = m_entries.back();
+        *reinterpret_cast<trail**>(e.m_payload) = t;
+        e.m_undo = [](void * p) { (*reinterpret_cast<trail**>(p))->undo(); };
+    }
+
+    void undo(unsigned old_size) {
+        SASSERT(old_size <= m_entries.size());
+        entry * begin = m_entries.data() + old_size;
+        entry * it    = m_entries.data() + m_entries.size();
+        while (it != begin) {
+            --it;
+            it->m_undo(it->m_payload);
+        }
+        m_entries.shrink(old_size);
+    }
+
+    // Drop entries without undoing them (e.g. when recovering from an
+    // interrupted operation whose effects were already rolled back by hand).
+    void shrink(unsigned old_size) {
+        SASSERT(old_size <= m_entries.size());
+        m_entries.shrink(old_size);
+    }
+};
+
 class trail_stack {
-    ptr_vector<trail>       m_trail_stack;
-    unsigned_vector         m_scopes;
     region                  m_region;
+    trail_log               m_trail_log;
+    unsigned_vector         m_scopes;
 public:
+    trail_stack(): m_trail_log(m_region) {}
+
     region & get_region() { return m_region; }
 
     void reset() {
         pop_scope(m_scopes.size());
         // Undo trail objects stored at lvl 0 (avoid memory leaks if lvl 0 contains new_obj_trail objects).
-        undo_trail_stack(m_trail_stack, 0);
+        m_trail_log.undo(0);
     }
 
-    void push_ptr(trail * t) { m_trail_stack.push_back(t); }
+    void push_ptr(trail * t) { m_trail_log.push_ptr(t); }
 
     template<typename TrailObject>
-    void push(TrailObject const & obj) { m_trail_stack.push_back(new (m_region) TrailObject(obj)); }
+    void push(TrailObject const & obj) { m_trail_log.push(obj); }
 
     unsigned get_num_scopes() const { return m_scopes.size(); }
 
-    void push_scope() { m_region.push_scope(); m_scopes.push_back(m_trail_stack.size()); }
+    void push_scope() { m_region.push_scope(); m_scopes.push_back(m_trail_log.size()); }
 
     void pop_scope(unsigned num_scopes) {
         if (num_scopes == 0) return;
@@ -419,7 +519,7 @@ public:
         SASSERT(num_scopes <= lvl);
         unsigned new_lvl  = lvl - num_scopes;
         unsigned old_size = m_scopes[new_lvl];
-        undo_trail_stack(m_trail_stack, old_size);
+        m_trail_log.undo(old_size);
         m_scopes.shrink(new_lvl);
         m_region.pop_scope(num_scopes);
     }
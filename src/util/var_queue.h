@@ -25,16 +25,35 @@ Revision History:
 class var_queue {
     typedef unsigned var;
 
+    /**
+       Activities are stored relative to a global scale generation: instead
+       of dividing every entry when activities overflow, the owner bumps the
+       generation counter and entries are normalized on comparison by the
+       number of rescales they have missed. Rescaling is O(1) and the heap
+       remains valid because normalized values shrink uniformly.
+    */
     struct lt {
-        svector<unsigned> & m_activity;
-    lt(svector<unsigned> & act):m_activity(act) {}
-        bool operator()(var v1, var v2) const { return m_activity[v1] > m_activity[v2]; }
+        static const unsigned rescale_bits = 14;
+        svector<unsigned> &       m_activity;
+        svector<unsigned> const & m_scale;        // scale generation of each entry of m_activity
+        unsigned const &          m_num_rescales; // global scale generation
+        lt(svector<unsigned> & act, svector<unsigned> const & scale, unsigned const & num_rescales):
+            m_activity(act), m_scale(scale), m_num_rescales(num_rescales) {}
+        unsigned act(var v) const {
+            unsigned d = m_num_rescales - m_scale[v];
+            if (d == 0)
+                return m_activity[v];
+            unsigned s = d * rescale_bits;
+            return s >= 32 ? 0 : m_activity[v] >> s;
+        }
+        bool operator()(var v1, var v2) const { return act(v1) > act(v2); }
     };
     heap<lt>  m_queue;
 public:
 
-    
-    var_queue(svector<unsigned> & act):m_queue(128, lt(act)) {}
+
+    var_queue(svector<unsigned> & act, svector<unsigned> const & scale, unsigned const & num_rescales):
+        m_queue(128, lt(act, scale, num_rescales)) {}
     
     void activity_increased_eh(var v) {
         if (m_queue.contains(v))
@@ -14,6 +14,8 @@ Author:
     Nikolaj Bjorner (nbjorner) 2021-01-26
 
 --*/
+#include <cstring>
+
 #include "util/gparams.h"
 #include "util/zstring.h"
 
@@ -127,10 +129,8 @@ zstring zstring::replace(zstring const& src, zstring const& dst) const {
     }
     bool found = false;
     for (unsigned i = 0; i < length(); ++i) {
-        bool eq = !found && i + src.length() <= length();
-        for (unsigned j = 0; eq && j < src.length(); ++j) {
-            eq = m_buffer[i+j] == src[j];
-        }
+        bool eq = !found && i + src.length() <= length() &&
+            0 == memcmp(m_buffer.data() + i, src.m_buffer.data(), src.length() * sizeof(unsigned));
         if (eq) {
             result.m_buffer.append(dst.m_buffer);
             found = true;
@@ -166,33 +166,19 @@ std::string zstring::encode() const {
 
 bool zstring::suffixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool suffix = true;
-    for (unsigned i = 0; suffix && i < length(); ++i) {
-        suffix = m_buffer[length()-i-1] == other[other.length()-i-1];
-    }
-    return suffix;
+    return 0 == memcmp(m_buffer.data(), 
+                       other.m_buffer.data() + other.length() - length(), 
+                       length() * sizeof(unsigned));
 }
 
 bool zstring::prefixof(zstring const& other) const {
     if (length() > other.length()) return false;
-    bool prefix = true;
-    for (unsigned i = 0; prefix && i < length(); ++i) {
-        prefix = m_buffer[i] == other[i];
-    }
-    return prefix;
+    return 0 == memcmp(m_buffer.data(), other.m_buffer.data(), length() * sizeof(unsigned));
 }
 
 bool zstring::contains(zstring const& other) const {
     if (other.length() > length()) return false;
-    unsigned last = length() - other.length();
-    bool cont = false;
-    for (unsigned i = 0; !cont && i <= last; ++i) {
-        cont = true;
-        for (unsigned j = 0; cont && j < other.length(); ++j) {
-            cont = other[j] == m_buffer[j+i];
-        }
-    }
-    return cont;
+    return indexofu(other, 0) >= 0;
 }
 
 int zstring::indexofu(zstring const& other, unsigned offset) const {
@@ -201,12 +187,12 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
     if (offset > other.length() + offset) return -1;
     if (other.length() + offset > length()) return -1;
     unsigned last = length() - other.length();
+    // scan for the first character; compare candidate windows word-wise
+    unsigned ch = other[0];
+    size_t sz = other.length() * sizeof(unsigned);
     for (unsigned i = offset; i <= last; ++i) {
-        bool prefix = true;
-        for (unsigned j = 0; prefix && j < other.length(); ++j) {
-            prefix = m_buffer[i + j] == other[j];
-        }
-        if (prefix) {
+        if (m_buffer[i] == ch && 
+            0 == memcmp(m_buffer.data() + i, other.m_buffer.data(), sz)) {
             return static_cast<int>(i);
         }
     }
@@ -216,12 +202,11 @@ int zstring::indexofu(zstring const& other, unsigned offset) const {
 int zstring::last_indexof(zstring const& other) const {
     if (other.length() == 0) return length();
     if (other.length() > length()) return -1;
+    unsigned ch = other[0];
+    size_t sz = other.length() * sizeof(unsigned);
     for (unsigned last = length() - other.length() + 1; last-- > 0; ) {
-        bool suffix = true;
-        for (unsigned j = 0; suffix && j < other.length(); ++j) {
-            suffix = m_buffer[last + j] == other[j];
-        }
-        if (suffix) {
+        if (m_buffer[last] == ch && 
+            0 == memcmp(m_buffer.data() + last, other.m_buffer.data(), sz)) {
             return static_cast<int>(last);
         }
     }
@@ -231,9 +216,9 @@ int zstring::last_indexof(zstring const& other) const {
 zstring zstring::extract(unsigned offset, unsigned len) const {
     zstring result;
     if (offset + len < offset) return result;
-    int last = std::min(offset+len, length());
-    for (int i = offset; i < last; ++i) {
-        result.m_buffer.push_back(m_buffer[i]);
+    unsigned last = std::min(offset + len, length());
+    if (offset < last) {
+        result.m_buffer.append(last - offset, m_buffer.data() + offset);
     }
     return result;
 }
@@ -251,15 +236,8 @@ zstring zstring::operator+(zstring const& other) const {
 
 bool zstring::operator==(const zstring& other) const {
     // two strings are equal iff they have the same length and characters
-    if (length() != other.length()) {
-        return false;
-    }
-    for (unsigned i = 0; i < length(); ++i) {
-        if (m_buffer[i] != other[i]) {
-            return false;
-        }
-    }
-    return true;
+    return length() == other.length() &&
+        0 == memcmp(m_buffer.data(), other.m_buffer.data(), length() * sizeof(unsigned));
 }
 
 bool zstring::operator!=(const zstring& other) const {